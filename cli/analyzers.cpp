@@ -0,0 +1,866 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "analyzers.h"
+
+#include <algorithm>
+#include <charconv>
+#include <iterator>
+#include <ostream>
+#include <thread>
+
+#include "dive_core/available_metrics.h"
+#include "dive_core/capture_diff.h"
+#include "dive_core/corpus_stats.h"
+#include "dive_core/data_core.h"
+#include "dive_core/dive_strings.h"
+#include "dive_core/perf_metrics_data.h"
+#include "dive_core/thread_pool.h"
+#include "nlohmann/json.hpp"
+#include "trace_stats/trace_stats.h"
+
+namespace Dive
+{
+namespace cli
+{
+
+namespace
+{
+
+// Events per chunk of the per-event analyzers
+constexpr size_t kMinEventsPerChunk = 1024;
+
+//--------------------------------------------------------------------------------------------------
+const char* GetRenderModeString(RenderModeType render_mode)
+{
+    switch (render_mode)
+    {
+    case RenderModeType::kDirect: return "DIRECT";
+    case RenderModeType::kBinningVis: return "BINNING_VIS";
+    case RenderModeType::kBinningDirect: return "BINNING_DIRECT";
+    case RenderModeType::kTiled: return "TILED";
+    case RenderModeType::kResolve: return "RESOLVE";
+    case RenderModeType::kDispatch: return "DISPATCH";
+    case RenderModeType::kUnknown: return "UNKNOWN";
+    }
+    return "UNKNOWN";
+}
+
+//--------------------------------------------------------------------------------------------------
+const char* GetEventTypeString(EventInfo::EventType type)
+{
+    using EventType = EventInfo::EventType;
+    switch (type)
+    {
+    case EventType::kDraw: return "DRAW";
+    case EventType::kDispatch: return "DISPATCH";
+    case EventType::kBlit: return "BLIT";
+    case EventType::kColorSysMemToGmemResolve: return "COLOR_SYSMEM_TO_GMEM_RESOLVE";
+    case EventType::kColorGmemToSysMemResolve: return "COLOR_GMEM_TO_SYSMEM_RESOLVE";
+    case EventType::kColorGmemToSysMemResolveAndClear:
+        return "COLOR_GMEM_TO_SYSMEM_RESOLVE_AND_CLEAR";
+    case EventType::kColorClearGmem: return "COLOR_CLEAR_GMEM";
+    case EventType::kDepthSysMemToGmemResolve: return "DEPTH_SYSMEM_TO_GMEM_RESOLVE";
+    case EventType::kDepthGmemToSysMemResolve: return "DEPTH_GMEM_TO_SYSMEM_RESOLVE";
+    case EventType::kDepthGmemToSysMemResolveAndClear:
+        return "DEPTH_GMEM_TO_SYSMEM_RESOLVE_AND_CLEAR";
+    case EventType::kDepthClearGmem: return "DEPTH_CLEAR_GMEM";
+    case EventType::kSysmemToGmemResolve: return "SYSMEM_TO_GMEM_RESOLVE";
+    case EventType::kWaitMemWrites: return "WAIT_MEM_WRITES";
+    case EventType::kWaitForIdle: return "WAIT_FOR_IDLE";
+    case EventType::kWaitForMe: return "WAIT_FOR_ME";
+    case EventType::kEventWriteStart: return "EVENT_WRITE_START";
+    case EventType::kEventWriteEnd: return "EVENT_WRITE_END";
+    }
+    return "UNKNOWN";
+}
+
+//--------------------------------------------------------------------------------------------------
+bool IsDirectOrBinningDraw(const EventInfo& info)
+{
+    return info.m_type == EventInfo::EventType::kDraw &&
+           (info.m_render_mode == RenderModeType::kDirect ||
+            info.m_render_mode == RenderModeType::kBinningVis ||
+            info.m_render_mode == RenderModeType::kBinningDirect);
+}
+
+//--------------------------------------------------------------------------------------------------
+// Fill table.m_rows with the rows of each event, computed on the shared ThreadPool.
+// add_rows(event_index, rows) appends the rows of one event.
+template<typename AddRows>
+bool AddEventRows(const Context&         context,
+                  const CaptureMetadata& meta_data,
+                  AnalysisTable&         table,
+                  AddRows&&              add_rows)
+{
+    ThreadPool& pool = ThreadPool::Shared();
+    size_t      event_count = meta_data.m_event_info.size();
+    std::vector<std::vector<std::vector<AnalysisTable::Value>>> chunk_rows(
+    ParallelForNumChunks(pool, event_count, kMinEventsPerChunk));
+    if (!ParallelForChunks(pool,
+                           context,
+                           0,
+                           event_count,
+                           kMinEventsPerChunk,
+                           [&](size_t chunk, size_t begin, size_t end) {
+                               for (size_t i = begin; i < end; ++i)
+                               {
+                                   add_rows(i, chunk_rows[chunk]);
+                               }
+                           }))
+    {
+        return false;
+    }
+    for (std::vector<std::vector<AnalysisTable::Value>>& rows : chunk_rows)
+    {
+        std::move(rows.begin(), rows.end(), std::back_inserter(table.m_rows));
+    }
+    return true;
+}
+
+// =================================================================================================
+// TraceStatsAnalyzer
+// =================================================================================================
+class TraceStatsAnalyzer : public Analyzer
+{
+public:
+    const char* GetName() const override { return "trace_stats"; }
+    const char* GetDescription() const override
+    {
+        return "draw, pass, shader and resolve counts, viewports and window scissors";
+    }
+    bool Run(const Context&       context,
+             const AnalysisInput& input,
+             AnalysisResult&      result) const override
+    {
+        CaptureStats capture_stats;
+        TraceStats().GatherTraceStats(context, input.m_meta_data, capture_stats);
+        if (context.Cancelled())
+        {
+            result.m_error = "Cancelled";
+            return false;
+        }
+
+        AnalysisTable stats{ "stats", { "stat", "value" }, {} };
+        for (const auto& [stat, description] : kStatMap)
+        {
+            // The descriptions are indented for PrintTraceStats()
+            std::string_view name = description;
+            name.remove_prefix(std::min(name.find_first_not_of('\t'), name.size()));
+            stats.m_rows.push_back({ std::string(name), capture_stats.m_stats_list[stat] });
+        }
+        result.m_tables.push_back(std::move(stats));
+
+        AnalysisTable viewports{ "viewports",
+                                 { "x", "y", "width", "height", "min_depth", "max_depth" },
+                                 {} };
+        for (const Viewport& viewport : capture_stats.m_viewports)
+        {
+            const VkViewport& vk_viewport = viewport.m_vk_viewport;
+            viewports.m_rows.push_back({ (double)vk_viewport.x,
+                                         (double)vk_viewport.y,
+                                         (double)vk_viewport.width,
+                                         (double)vk_viewport.height,
+                                         (double)vk_viewport.minDepth,
+                                         (double)vk_viewport.maxDepth });
+        }
+        result.m_tables.push_back(std::move(viewports));
+
+        AnalysisTable window_scissors{ "window_scissors",
+                                       { "tl_x", "tl_y", "br_x", "br_y" },
+                                       {} };
+        for (const WindowScissor& scissor : capture_stats.m_window_scissors)
+        {
+            window_scissors.m_rows.push_back({ (uint64_t)scissor.m_tl_x,
+                                               (uint64_t)scissor.m_tl_y,
+                                               (uint64_t)scissor.m_br_x,
+                                               (uint64_t)scissor.m_br_y });
+        }
+        result.m_tables.push_back(std::move(window_scissors));
+        return true;
+    }
+};
+
+// =================================================================================================
+// LrzAnalyzer
+// =================================================================================================
+class LrzAnalyzer : public Analyzer
+{
+public:
+    const char* GetName() const override { return "lrz"; }
+    const char* GetDescription() const override
+    {
+        return "draws with the depth test enabled but LRZ disabled (same check as lrz_validator)";
+    }
+    bool Run(const Context&       context,
+             const AnalysisInput& input,
+             AnalysisResult&      result) const override
+    {
+        const CaptureMetadata& meta_data = input.m_meta_data;
+        AnalysisTable          draws{ "draws",
+                                      { "event",
+                                        "description",
+                                        "depth_test",
+                                        "depth_write",
+                                        "depth_func",
+                                        "lrz_enabled",
+                                        "lrz_write",
+                                        "passed" },
+                                      {} };
+        auto add_rows = [&](size_t i, std::vector<std::vector<AnalysisTable::Value>>& rows) {
+            const EventInfo& info = meta_data.m_event_info[i];
+            auto event_state_it = meta_data.m_event_state.find(static_cast<EventStateId>(i));
+            if (!IsDirectOrBinningDraw(info) || event_state_it == meta_data.m_event_state.end())
+            {
+                return;
+            }
+            bool        depth_test = event_state_it->DepthTestEnabled();
+            bool        lrz_enabled = event_state_it->LRZEnabled();
+            VkCompareOp zfunc = event_state_it->DepthCompareOp();
+            // If the depth func is Always or Never, LRZ does not matter
+            bool passed = !depth_test || lrz_enabled || zfunc == VK_COMPARE_OP_NEVER ||
+                          zfunc == VK_COMPARE_OP_ALWAYS;
+            rows.push_back({ (uint64_t)i,
+                             info.m_str,
+                             depth_test,
+                             event_state_it->DepthWriteEnabled(),
+                             std::string(GetVkCompareOp(zfunc)),
+                             lrz_enabled,
+                             event_state_it->LRZWrite(),
+                             passed });
+        };
+        if (!AddEventRows(context, meta_data, draws, add_rows))
+        {
+            result.m_error = "Cancelled";
+            return false;
+        }
+
+        uint64_t num_failed = 0;
+        for (const std::vector<AnalysisTable::Value>& row : draws.m_rows)
+        {
+            num_failed += std::get<bool>(row.back()) ? 0 : 1;
+        }
+        result.m_tables.push_back(AnalysisTable{
+        "summary",
+        { "draws", "failed", "passed" },
+        { { (uint64_t)draws.m_rows.size(), num_failed, num_failed == 0 } } });
+        result.m_tables.push_back(std::move(draws));
+        return true;
+    }
+};
+
+// =================================================================================================
+// EventStateAnalyzer
+// =================================================================================================
+class EventStateAnalyzer : public Analyzer
+{
+public:
+    const char* GetName() const override { return "event_state"; }
+    const char* GetDescription() const override
+    {
+        return "render mode and main pipeline state of each draw and dispatch";
+    }
+    bool Run(const Context&       context,
+             const AnalysisInput& input,
+             AnalysisResult&      result) const override
+    {
+        const CaptureMetadata& meta_data = input.m_meta_data;
+        AnalysisTable          events{ "events",
+                                       { "event",
+                                         "description",
+                                         "submit",
+                                         "render_mode",
+                                         "num_indices",
+                                         "topology",
+                                         "cull_mode",
+                                         "depth_test",
+                                         "depth_write",
+                                         "depth_func",
+                                         "stencil_test",
+                                         "lrz_enabled",
+                                         "lrz_write" },
+                                       {} };
+        auto add_rows = [&](size_t i, std::vector<std::vector<AnalysisTable::Value>>& rows) {
+            const EventInfo& info = meta_data.m_event_info[i];
+            if (info.m_type != EventInfo::EventType::kDraw &&
+                info.m_type != EventInfo::EventType::kDispatch)
+            {
+                return;
+            }
+            std::vector<AnalysisTable::Value> row = { (uint64_t)i,
+                                                      info.m_str,
+                                                      (uint64_t)info.m_submit_index,
+                                                      std::string(
+                                                      GetRenderModeString(info.m_render_mode)),
+                                                      (uint64_t)info.m_num_indices };
+            auto event_state_it = meta_data.m_event_state.find(static_cast<EventStateId>(i));
+            if (event_state_it != meta_data.m_event_state.end())
+            {
+                row.push_back(std::string(GetVkPrimitiveTopology(event_state_it->Topology())));
+                row.push_back(std::string(GetVkCullModeFlags(event_state_it->CullMode())));
+                row.push_back(event_state_it->DepthTestEnabled());
+                row.push_back(event_state_it->DepthWriteEnabled());
+                row.push_back(std::string(GetVkCompareOp(event_state_it->DepthCompareOp())));
+                row.push_back(event_state_it->StencilTestEnabled());
+                row.push_back(event_state_it->LRZEnabled());
+                row.push_back(event_state_it->LRZWrite());
+            }
+            row.resize(events.m_columns.size(), std::string());
+            rows.push_back(std::move(row));
+        };
+        if (!AddEventRows(context, meta_data, events, add_rows))
+        {
+            result.m_error = "Cancelled";
+            return false;
+        }
+        result.m_tables.push_back(std::move(events));
+        return true;
+    }
+};
+
+// =================================================================================================
+// ShaderStatsAnalyzer
+// =================================================================================================
+class ShaderStatsAnalyzer : public Analyzer
+{
+public:
+    const char* GetName() const override { return "shader_stats"; }
+    const char* GetDescription() const override
+    {
+        return "stages, uses, instruction and GPR counts of each shader";
+    }
+    bool Run(const Context&       context,
+             const AnalysisInput& input,
+             AnalysisResult&      result) const override
+    {
+        const CaptureMetadata& meta_data = input.m_meta_data;
+        const size_t           num_shaders = meta_data.m_shaders.size();
+
+        // Stages (as a bit mask) and number of events of each shader
+        std::vector<uint32_t> stage_masks(num_shaders, 0);
+        std::vector<bool>     binning(num_shaders, false);
+        std::vector<uint64_t> num_events(num_shaders, 0);
+        for (const EventInfo& info : meta_data.m_event_info)
+        {
+            for (const ShaderReference& ref : info.m_shader_references)
+            {
+                if (ref.m_shader_index >= num_shaders)
+                {
+                    continue;
+                }
+                stage_masks[ref.m_shader_index] |= 1u << static_cast<uint32_t>(ref.m_stage);
+                if (ref.m_enable_mask & static_cast<uint32_t>(ShaderEnableBitMask::kBINNING))
+                {
+                    binning[ref.m_shader_index] = true;
+                }
+                ++num_events[ref.m_shader_index];
+            }
+        }
+
+        // Disassembling is the expensive part
+        if (!ParallelFor(ThreadPool::Shared(), context, 0, num_shaders, 1, [&](size_t i) {
+                meta_data.m_shaders[i].EagerEval();
+            }))
+        {
+            result.m_error = "Cancelled";
+            return false;
+        }
+
+        AnalysisTable shaders{ "shaders",
+                               { "shader",
+                                 "address",
+                                 "submit",
+                                 "stages",
+                                 "binning",
+                                 "num_events",
+                                 "num_instructions",
+                                 "num_gprs",
+                                 "size" },
+                               {} };
+        for (size_t i = 0; i < num_shaders; ++i)
+        {
+            const Disassembly& disassembly = meta_data.m_shaders[i];
+            std::string        stages;
+            for (uint32_t stage = 0; stage < (uint32_t)ShaderStage::kShaderStageCount; ++stage)
+            {
+                if (stage_masks[i] & (1u << stage))
+                {
+                    stages += (stages.empty() ? "" : "|");
+                    stages += kShaderStageStrings[stage];
+                }
+            }
+            shaders.m_rows.push_back({ (uint64_t)i,
+                                       disassembly.GetShaderAddr(),
+                                       (uint64_t)disassembly.GetSubmitIndex(),
+                                       stages,
+                                       (bool)binning[i],
+                                       num_events[i],
+                                       (uint64_t)disassembly.GetNumInstructions(),
+                                       (uint64_t)disassembly.GetGPRCount(),
+                                       disassembly.GetShaderSize() });
+        }
+        result.m_tables.push_back(std::move(shaders));
+        return true;
+    }
+};
+
+// =================================================================================================
+// PerfCountersAnalyzer
+// =================================================================================================
+class PerfCountersAnalyzer : public Analyzer
+{
+public:
+    const char* GetName() const override { return "perf_counters"; }
+    const char* GetDescription() const override
+    {
+        return "perf counters averaged per draw and correlated with the draws of the capture "
+               "(needs --perf-counters and --metrics)";
+    }
+    bool Run(const Context&       context,
+             const AnalysisInput& input,
+             AnalysisResult&      result) const override
+    {
+        if (input.m_perf_counters_file.empty() || input.m_metrics_description_file.empty())
+        {
+            result.m_error = "The perf counters and the metrics description files are required";
+            return false;
+        }
+        if (!input.m_submit_range.IsAll())
+        {
+            // The counters are of the draws of the whole capture, which is correlated by position
+            result.m_error = "The perf counters can't be correlated with a range of submits";
+            return false;
+        }
+        std::unique_ptr<AvailableMetrics> available_metrics = AvailableMetrics::LoadFromCsv(
+        input.m_metrics_description_file);
+        if (!available_metrics)
+        {
+            result.m_error = "Can't load " + input.m_metrics_description_file.string();
+            return false;
+        }
+        std::unique_ptr<PerfMetricsData> data = PerfMetricsData::LoadFromCsv(
+        input.m_perf_counters_file,
+        *available_metrics);
+        if (!data)
+        {
+            result.m_error = "Can't load " + input.m_perf_counters_file.string();
+            return false;
+        }
+
+        // The metric infos of `data` point into available_metrics, which outlives the provider
+        std::unique_ptr<PerfMetricsDataProvider> provider = PerfMetricsDataProvider::Create(
+        std::move(data));
+        provider->Analyze(&input.m_meta_data.m_command_hierarchy);
+
+        AnalysisTable draws{ "draws", { "draw" }, {} };
+        for (const std::string& header : provider->GetRecordHeader())
+        {
+            draws.m_columns.push_back(header);
+        }
+        const std::vector<PerfMetricsRecord>& records = provider->GetComputedRecords();
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            const PerfMetricsRecord& record = records[i];
+            std::optional<uint64_t>  draw = provider->GetDrawIndexFromComputedRecordIndex(i);
+            std::vector<AnalysisTable::Value> row = { draw ? AnalysisTable::Value(*draw) :
+                                                             AnalysisTable::Value(std::string()),
+                                                      record.m_context_id,
+                                                      record.m_process_id,
+                                                      record.m_frame_id,
+                                                      record.m_cmd_buffer_id,
+                                                      (uint64_t)record.m_draw_id,
+                                                      (uint64_t)record.m_draw_type,
+                                                      (uint64_t)record.m_draw_label,
+                                                      record.m_program_id,
+                                                      (uint64_t)record.m_lrz_state };
+            for (double value : record.m_metric_values)
+            {
+                row.push_back(value);
+            }
+            row.resize(draws.m_columns.size(), std::string());
+            draws.m_rows.push_back(std::move(row));
+        }
+        result.m_tables.push_back(std::move(draws));
+        return !context.Cancelled();
+    }
+};
+
+//--------------------------------------------------------------------------------------------------
+nlohmann::ordered_json ValueToJson(const AnalysisTable::Value& value)
+{
+    return std::visit([](const auto& v) { return nlohmann::ordered_json(v); }, value);
+}
+
+//--------------------------------------------------------------------------------------------------
+std::string ValueToCsv(const AnalysisTable::Value& value)
+{
+    if (const std::string* str = std::get_if<std::string>(&value))
+    {
+        if (str->find_first_of(",\"\r\n") == std::string::npos)
+        {
+            return *str;
+        }
+        std::string quoted = "\"";
+        for (char c : *str)
+        {
+            quoted += (c == '"') ? "\"\"" : std::string(1, c);
+        }
+        return quoted + "\"";
+    }
+    if (const bool* b = std::get_if<bool>(&value))
+    {
+        return *b ? "true" : "false";
+    }
+    if (const double* d = std::get_if<double>(&value))
+    {
+        // Shortest representation that reads back to the same value
+        char buffer[64];
+        auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), *d);
+        return std::string(buffer, end);
+    }
+    return std::visit(
+    [](const auto& v) -> std::string {
+        if constexpr (std::is_integral_v<std::decay_t<decltype(v)>>)
+        {
+            return std::to_string(v);
+        }
+        return {};
+    },
+    value);
+}
+
+}  // namespace
+
+//--------------------------------------------------------------------------------------------------
+const std::vector<const Analyzer*>& GetAnalyzers()
+{
+    static const TraceStatsAnalyzer           trace_stats;
+    static const LrzAnalyzer                  lrz;
+    static const EventStateAnalyzer           event_state;
+    static const ShaderStatsAnalyzer          shader_stats;
+    static const PerfCountersAnalyzer         perf_counters;
+    static const std::vector<const Analyzer*> analyzers = { &trace_stats,
+                                                            &lrz,
+                                                            &event_state,
+                                                            &shader_stats,
+                                                            &perf_counters };
+    return analyzers;
+}
+
+//--------------------------------------------------------------------------------------------------
+const Analyzer* FindAnalyzer(std::string_view name)
+{
+    for (const Analyzer* analyzer : GetAnalyzers())
+    {
+        if (name == analyzer->GetName())
+        {
+            return analyzer;
+        }
+    }
+    return nullptr;
+}
+
+//--------------------------------------------------------------------------------------------------
+std::vector<AnalysisResult> RunAnalyzers(const Context&                      context,
+                                         const AnalysisInput&                input,
+                                         const std::vector<const Analyzer*>& analyzers)
+{
+    std::vector<AnalysisResult> results(analyzers.size());
+
+    // Each analyzer gets its own thread and splits its work over the shared ThreadPool. They are
+    // not run as tasks of the pool themselves, since TraceStats::GatherTraceStats() blocks while
+    // its chunks run, which would starve a pool with few workers.
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < analyzers.size(); ++i)
+    {
+        results[i].m_analyzer = analyzers[i]->GetName();
+        threads.emplace_back([&, i]() {
+            results[i].m_success = analyzers[i]->Run(context, input, results[i]);
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    return results;
+}
+
+//--------------------------------------------------------------------------------------------------
+std::vector<AnalysisTable> GetCaptureDiffTables(const CaptureMetadata& meta_data_a,
+                                                const CaptureMetadata& meta_data_b,
+                                                const CaptureDiff&     diff)
+{
+    AnalysisTable summary{ "summary",
+                           { "aligned_events",
+                             "changed_events",
+                             "added_events",
+                             "removed_events" },
+                           {} };
+    summary.m_rows.push_back({ static_cast<uint64_t>(diff.m_num_aligned_events),
+                               static_cast<uint64_t>(diff.m_changed_events.size()),
+                               static_cast<uint64_t>(diff.m_added_events.size()),
+                               static_cast<uint64_t>(diff.m_removed_events.size()) });
+
+    AnalysisTable changed_events{ "changed_events",
+                                  { "event_a",
+                                    "event_b",
+                                    "type_a",
+                                    "type_b",
+                                    "num_indices_a",
+                                    "num_indices_b",
+                                    "num_state_changes",
+                                    "num_shader_changes",
+                                    "description" },
+                                  {} };
+    AnalysisTable state_changes{ "state_changes",
+                                 { "event_a", "event_b", "field", "value_a", "value_b" },
+                                 {} };
+    AnalysisTable shader_changes{ "shader_changes",
+                                  { "event_a",
+                                    "event_b",
+                                    "stage",
+                                    "binning",
+                                    "shader_a",
+                                    "shader_b",
+                                    "num_instructions_a",
+                                    "num_instructions_b",
+                                    "num_instructions_delta",
+                                    "num_gprs_a",
+                                    "num_gprs_b" },
+                                  {} };
+    // Unset state fields, and missing shaders, are reported as empty values
+    auto state_value = [](bool is_set, double value) -> AnalysisTable::Value {
+        return is_set ? AnalysisTable::Value(value) : AnalysisTable::Value(std::string());
+    };
+    auto shader_index = [](uint32_t index) -> AnalysisTable::Value {
+        return index != UINT32_MAX ? AnalysisTable::Value(static_cast<uint64_t>(index)) :
+                                     AnalysisTable::Value(std::string());
+    };
+    for (const EventDiff& event_diff : diff.m_changed_events)
+    {
+        uint64_t event_a = event_diff.m_event_a;
+        uint64_t event_b = event_diff.m_event_b;
+        changed_events.m_rows.push_back(
+        { event_a,
+          event_b,
+          std::string(GetEventTypeString(event_diff.m_type_a)),
+          std::string(GetEventTypeString(event_diff.m_type_b)),
+          static_cast<uint64_t>(event_diff.m_num_indices_a),
+          static_cast<uint64_t>(event_diff.m_num_indices_b),
+          static_cast<uint64_t>(event_diff.m_state_changes.size()),
+          static_cast<uint64_t>(event_diff.m_shader_changes.size()),
+          meta_data_b.m_event_info[event_diff.m_event_b].m_str });
+        for (const EventStateFieldChange& change : event_diff.m_state_changes)
+        {
+            state_changes.m_rows.push_back({ event_a,
+                                             event_b,
+                                             std::string(change.m_field),
+                                             state_value(change.m_is_set_a, change.m_value_a),
+                                             state_value(change.m_is_set_b, change.m_value_b) });
+        }
+        for (const ShaderChange& change : event_diff.m_shader_changes)
+        {
+            shader_changes.m_rows.push_back(
+            { event_a,
+              event_b,
+              std::string(kShaderStageStrings[static_cast<uint32_t>(change.m_stage)]),
+              change.m_binning,
+              shader_index(change.m_shader_index_a),
+              shader_index(change.m_shader_index_b),
+              change.m_num_instructions_a,
+              change.m_num_instructions_b,
+              static_cast<int64_t>(change.m_num_instructions_b) -
+              static_cast<int64_t>(change.m_num_instructions_a),
+              static_cast<uint64_t>(change.m_gpr_count_a),
+              static_cast<uint64_t>(change.m_gpr_count_b) });
+        }
+    }
+
+    auto events_table = [](const char*                  name,
+                           const CaptureMetadata&       meta_data,
+                           const std::vector<uint32_t>& events) {
+        AnalysisTable table{ name, { "event", "type", "description" }, {} };
+        for (uint32_t event : events)
+        {
+            const EventInfo& info = meta_data.m_event_info[event];
+            table.m_rows.push_back({ static_cast<uint64_t>(event),
+                                     std::string(GetEventTypeString(info.m_type)),
+                                     info.m_str });
+        }
+        return table;
+    };
+
+    AnalysisTable event_type_counts{ "event_type_counts",
+                                     { "type", "count_a", "count_b", "delta" },
+                                     {} };
+    for (const EventTypeCountChange& change : diff.m_type_count_changes)
+    {
+        event_type_counts.m_rows.push_back(
+        { std::string(GetEventTypeString(change.m_type)),
+          static_cast<uint64_t>(change.m_count_a),
+          static_cast<uint64_t>(change.m_count_b),
+          static_cast<int64_t>(change.m_count_b) - static_cast<int64_t>(change.m_count_a) });
+    }
+
+    std::vector<AnalysisTable> tables;
+    tables.push_back(std::move(summary));
+    tables.push_back(std::move(changed_events));
+    tables.push_back(std::move(state_changes));
+    tables.push_back(std::move(shader_changes));
+    tables.push_back(events_table("added_events", meta_data_b, diff.m_added_events));
+    tables.push_back(events_table("removed_events", meta_data_a, diff.m_removed_events));
+    tables.push_back(std::move(event_type_counts));
+    return tables;
+}
+
+//--------------------------------------------------------------------------------------------------
+std::vector<AnalysisTable> GetCorpusStatsTables(const CorpusStats& corpus_stats)
+{
+    uint32_t      num_metrics = CorpusStats::GetNumMetrics();
+    AnalysisTable captures_table{ "captures",
+                                  { "file", "file_size", "success", "error", "load_ms" },
+                                  {} };
+    for (uint32_t m = 0; m < num_metrics; ++m)
+    {
+        captures_table.m_columns.push_back(CorpusStats::GetMetricName(m));
+    }
+    for (const CorpusCaptureStats& capture_stats : corpus_stats.GetCaptures())
+    {
+        std::vector<AnalysisTable::Value> row = { capture_stats.m_file_name,
+                                                  capture_stats.m_file_size,
+                                                  capture_stats.m_success,
+                                                  capture_stats.m_error,
+                                                  capture_stats.m_load_ms };
+        for (uint32_t m = 0; m < num_metrics && capture_stats.m_success; ++m)
+        {
+            double value = CorpusStats::GetMetricValue(m, capture_stats);
+            if (CorpusStats::IsRatioMetric(m))
+            {
+                row.push_back(value);
+            }
+            else
+            {
+                row.push_back(static_cast<uint64_t>(value));
+            }
+        }
+        row.resize(captures_table.m_columns.size(), std::string());
+        captures_table.m_rows.push_back(std::move(row));
+    }
+
+    AnalysisTable distributions{ "distributions",
+                                 { "metric", "count", "min", "p10", "p50", "p90", "max", "mean" },
+                                 {} };
+    for (const CorpusMetricDistribution& distribution : corpus_stats.GetDistributions())
+    {
+        distributions.m_rows.push_back({ std::string(distribution.m_metric),
+                                         distribution.m_count,
+                                         distribution.m_min,
+                                         distribution.m_p10,
+                                         distribution.m_p50,
+                                         distribution.m_p90,
+                                         distribution.m_max,
+                                         distribution.m_mean });
+    }
+
+    AnalysisTable gpr_histogram{ "gpr_histogram", { "gprs", "shaders", "captures" }, {} };
+    for (const CorpusGprCount& gpr_count : corpus_stats.GetGprHistogram())
+    {
+        gpr_histogram.m_rows.push_back({ static_cast<uint64_t>(gpr_count.m_num_gprs),
+                                         gpr_count.m_num_shaders,
+                                         gpr_count.m_num_captures });
+    }
+
+    std::vector<AnalysisTable> tables;
+    tables.push_back(std::move(captures_table));
+    tables.push_back(std::move(distributions));
+    tables.push_back(std::move(gpr_histogram));
+    return tables;
+}
+
+//--------------------------------------------------------------------------------------------------
+void WriteAnalysisJson(std::ostream&                      ostream,
+                       const std::string&                 capture_file_name,
+                       const SubmitRange&                 submit_range,
+                       const std::vector<AnalysisResult>& results)
+{
+    nlohmann::ordered_json report;
+    report["capture"] = capture_file_name;
+    if (!submit_range.IsAll())
+    {
+        nlohmann::ordered_json& submits = report["submits"];
+        submits["first"] = submit_range.m_first;
+        submits["last"] = submit_range.m_last;
+        submits["note"] = GetSubmitRangeNote(submit_range);
+    }
+    nlohmann::ordered_json& analyzers = report["analyzers"];
+    analyzers = nlohmann::ordered_json::object();
+    for (const AnalysisResult& result : results)
+    {
+        nlohmann::ordered_json& analyzer = analyzers[result.m_analyzer];
+        analyzer["success"] = result.m_success;
+        if (!result.m_error.empty())
+        {
+            analyzer["error"] = result.m_error;
+        }
+        nlohmann::ordered_json& tables = analyzer["tables"];
+        tables = nlohmann::ordered_json::object();
+        for (const AnalysisTable& table : result.m_tables)
+        {
+            nlohmann::ordered_json rows = nlohmann::ordered_json::array();
+            for (const std::vector<AnalysisTable::Value>& row : table.m_rows)
+            {
+                nlohmann::ordered_json json_row = nlohmann::ordered_json::object();
+                for (size_t c = 0; c < table.m_columns.size() && c < row.size(); ++c)
+                {
+                    json_row[table.m_columns[c]] = ValueToJson(row[c]);
+                }
+                rows.push_back(std::move(json_row));
+            }
+            tables[table.m_name] = std::move(rows);
+        }
+    }
+    ostream << report.dump(2) << std::endl;
+}
+
+//--------------------------------------------------------------------------------------------------
+std::string GetSubmitRangeNote(const SubmitRange& submit_range)
+{
+    return "Only submits " + std::to_string(submit_range.m_first) + " to " +
+           std::to_string(submit_range.m_last) +
+           " were analyzed: the draw and event indices are relative to the first event of submit " +
+           std::to_string(submit_range.m_first) + ", not to the start of the capture";
+}
+
+//--------------------------------------------------------------------------------------------------
+void WriteAnalysisCsv(std::ostream& ostream, const AnalysisTable& table)
+{
+    for (size_t c = 0; c < table.m_columns.size(); ++c)
+    {
+        ostream << (c ? "," : "") << ValueToCsv(table.m_columns[c]);
+    }
+    ostream << "\n";
+    for (const std::vector<AnalysisTable::Value>& row : table.m_rows)
+    {
+        for (size_t c = 0; c < row.size(); ++c)
+        {
+            ostream << (c ? "," : "") << ValueToCsv(row[c]);
+        }
+        ostream << "\n";
+    }
+}
+
+}  // namespace cli
+}  // namespace Dive
@@ -0,0 +1,127 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "dive_core/common/emulate_pm4.h"
+#include "dive_core/context.h"
+
+namespace Dive
+{
+struct CaptureDiff;
+struct CaptureMetadata;
+class CorpusStats;
+
+namespace cli
+{
+
+//--------------------------------------------------------------------------------------------------
+// A table of results of an analyzer
+struct AnalysisTable
+{
+    using Value = std::variant<int64_t, uint64_t, double, bool, std::string>;
+
+    std::string                     m_name;
+    std::vector<std::string>        m_columns;
+    std::vector<std::vector<Value>> m_rows;
+};
+
+// What the analyzers share. The metadata is only read, by all analyzers at once.
+struct AnalysisInput
+{
+    const CaptureMetadata& m_meta_data;
+
+    // Perf counters collected with the capture, and the descriptions of the metrics, for the
+    // correlation of the counters with the draws. Empty if not provided.
+    std::filesystem::path m_perf_counters_file;
+    std::filesystem::path m_metrics_description_file;
+
+    // Submits which were parsed. The draw and event indices of the metadata start at the first
+    // event of m_first, unless all the submits were parsed.
+    SubmitRange m_submit_range;
+};
+
+struct AnalysisResult
+{
+    std::string                m_analyzer;
+    bool                       m_success = false;
+    std::string                m_error;
+    std::vector<AnalysisTable> m_tables;
+};
+
+class Analyzer
+{
+public:
+    virtual ~Analyzer() = default;
+
+    virtual const char* GetName() const = 0;
+    virtual const char* GetDescription() const = 0;
+
+    // Fill result.m_tables, or set result.m_error and return false. Called concurrently with the
+    // other analyzers, so it must not modify the input.
+    virtual bool Run(const Context&       context,
+                     const AnalysisInput& input,
+                     AnalysisResult&      result) const = 0;
+};
+
+// All the analyzers, in the order of their results
+const std::vector<const Analyzer*>& GetAnalyzers();
+
+// nullptr if there is no analyzer with this name
+const Analyzer* FindAnalyzer(std::string_view name);
+
+// Run the analyzers concurrently. The results are in the order of `analyzers`.
+std::vector<AnalysisResult> RunAnalyzers(const Context&                      context,
+                                         const AnalysisInput&                input,
+                                         const std::vector<const Analyzer*>& analyzers);
+
+// Tables of the differences between capture A and capture B: summary, changed_events,
+// state_changes, shader_changes, added_events, removed_events and event_type_counts
+std::vector<AnalysisTable> GetCaptureDiffTables(const CaptureMetadata& meta_data_a,
+                                                const CaptureMetadata& meta_data_b,
+                                                const CaptureDiff&     diff);
+
+// Tables of the stats of a corpus of captures:
+// - captures: one row per capture, sorted by file name
+// - distributions: count, min, p10, p50, p90, max and mean of each metric over the captures
+// - gpr_histogram: number of shaders, and of captures with such shaders, by GPR count
+std::vector<AnalysisTable> GetCorpusStatsTables(const CorpusStats& corpus_stats);
+
+// Write all the results as a single JSON document:
+// { "capture": ..., "submits": ..., "analyzers": { <analyzer>: { "success": ..., "error": ...,
+//   "tables": { <table>: [ { <column>: <value>, ... }, ... ] } } } }
+// "submits" is only there for a range of submits: { "first": ..., "last": ..., "note": ... }
+void WriteAnalysisJson(std::ostream&                      ostream,
+                       const std::string&                 capture_file_name,
+                       const SubmitRange&                 submit_range,
+                       const std::vector<AnalysisResult>& results);
+
+// What the indices of the results of a range of submits are relative to
+std::string GetSubmitRangeNote(const SubmitRange& submit_range);
+
+// Write one table as CSV, with a header row
+void WriteAnalysisCsv(std::ostream& ostream, const AnalysisTable& table);
+
+}  // namespace cli
+}  // namespace Dive
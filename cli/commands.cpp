@@ -14,14 +14,22 @@
  limitations under the License.
 */
 #include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <filesystem>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <string>
 
+#include "analyzers.h"
 #include "commands.h"
+#include "dive_core/capture_diff.h"
+#include "dive_core/command_hierarchy_search_index.h"
+#include "dive_core/corpus_stats.h"
+#include "dive_core/data_core.h"
 #include "format_output.h"
 
 namespace Dive
@@ -223,6 +231,717 @@ std::string ExtractCommand::Description() const
     return "extract the content of a dive file";
 }
 
+//--------------------------------------------------------------------------------------------------
+struct SearchCommand : Command
+{
+    SearchCommand();
+    static int  Run(const char* file_name, const CommandHierarchySearchQuery& query);
+    int         operator()(int argc, int at, char** argv) const override;
+    int         Help(int argc, int at, char** argv) const override;
+    std::string Description() const override;
+};
+
+SearchCommand::SearchCommand() :
+    Command("search", kNormal)
+{
+}
+
+int SearchCommand::Run(const char* file_name, const CommandHierarchySearchQuery& query)
+{
+    Dive::DataCore data_core(nullptr);
+    if (data_core.LoadPm4CaptureData(file_name) != Dive::CaptureData::LoadResult::kSuccess)
+    {
+        std::cerr << "Can't load " << file_name << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (!data_core.ParsePm4CaptureData())
+    {
+        std::cerr << "Can't parse " << file_name << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const Dive::CommandHierarchy&         command_hierarchy = data_core.GetCommandHierarchy();
+    Dive::CommandHierarchySearchIndex     search_index;
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    search_index.Build(command_hierarchy);
+    std::chrono::steady_clock::time_point built = std::chrono::steady_clock::now();
+
+    std::vector<uint64_t> node_indices;
+    if (!search_index.Search(query, node_indices))
+    {
+        std::cerr << "Invalid regular expression: " << query.m_text << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::chrono::steady_clock::time_point searched = std::chrono::steady_clock::now();
+
+    for (uint64_t node_index : node_indices)
+    {
+        std::cout << node_index << ": " << command_hierarchy.GetNodeDesc(node_index) << std::endl;
+    }
+    auto to_ms = [](std::chrono::steady_clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    };
+    std::cerr << node_indices.size() << " of " << command_hierarchy.size() << " nodes ("
+              << search_index.GetNumDistinctStrings() << " distinct descriptions), indexed in "
+              << to_ms(built - begin) << " ms, searched in " << to_ms(searched - built) << " ms"
+              << std::endl;
+    return EXIT_SUCCESS;
+}
+
+int SearchCommand::operator()(int argc, int at, char** argv) const
+{
+    CommandHierarchySearchQuery query;
+    const char*                 file_name = nullptr;
+    bool                        has_text = false;
+    for (int i = at + 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--regex")
+        {
+            query.m_is_regex = true;
+        }
+        else if (arg == "--case-sensitive")
+        {
+            query.m_case_sensitive = true;
+        }
+        else if (arg == "--address" && i + 1 < argc)
+        {
+            // <addr> or <min>-<max>
+            std::string            range = argv[++i];
+            std::string::size_type dash = range.find('-');
+            query.m_min_address = strtoull(range.substr(0, dash).c_str(), nullptr, 0);
+            query.m_max_address = (dash == std::string::npos) ?
+                                  *query.m_min_address :
+                                  strtoull(range.substr(dash + 1).c_str(), nullptr, 0);
+        }
+        else if (arg == "--opcode" && i + 1 < argc)
+        {
+            query.m_opcode = static_cast<uint8_t>(strtoul(argv[++i], nullptr, 0));
+        }
+        else if (file_name == nullptr)
+        {
+            file_name = argv[i];
+        }
+        else if (!has_text)
+        {
+            query.m_text = arg;
+            has_text = true;
+        }
+        else
+        {
+            file_name = nullptr;
+            break;
+        }
+    }
+    if (file_name == nullptr || (!has_text && !query.HasPacketFilter()))
+    {
+        Help(argc, at, argv);
+        return EXIT_FAILURE;
+    }
+    return Run(file_name, query);
+}
+
+int SearchCommand::Help(int argc, int at, char** argv) const
+{
+    std::cout << "usage: " << ProgramName(argv[0]) << " " << GetName()
+              << " [--regex] [--case-sensitive] [--address <addr>|<min>-<max>] [--opcode <op>]"
+                 " <.rd> [<text>]"
+              << std::endl;
+    std::cout << "  prints the index and description of the matching nodes" << std::endl;
+    std::cout << "  --regex: <text> is an ECMAScript regular expression" << std::endl;
+    std::cout << "  --case-sensitive: otherwise only the case of ASCII letters is ignored"
+              << std::endl;
+    std::cout << "  --address: only the packets at this address or in this range" << std::endl;
+    std::cout << "  --opcode: only the packets with this opcode" << std::endl;
+    return EXIT_SUCCESS;
+}
+
+std::string SearchCommand::Description() const
+{
+    return "search the command hierarchy of a capture";
+}
+
+//--------------------------------------------------------------------------------------------------
+// "<first>" or "<first>-<last>"
+bool ParseSubmitRange(const std::string& arg, SubmitRange& submit_range)
+{
+    char*         end = nullptr;
+    unsigned long first = strtoul(arg.c_str(), &end, 0);
+    unsigned long last = first;
+    if (end != arg.c_str() && *end == '-')
+    {
+        const char* last_str = end + 1;
+        last = strtoul(last_str, &end, 0);
+        if (end == last_str)
+        {
+            return false;
+        }
+    }
+    if (end == arg.c_str() || *end != '\0' || last < first || last >= UINT32_MAX)
+    {
+        return false;
+    }
+    submit_range.m_first = static_cast<uint32_t>(first);
+    submit_range.m_last = static_cast<uint32_t>(last);
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+struct AnalyzeCommand : Command
+{
+    struct Options
+    {
+        const char*                  m_file_name = nullptr;
+        SubmitRange                  m_submit_range;
+        std::vector<const Analyzer*> m_analyzers;
+        bool                         m_csv = false;
+        std::string                  m_output;
+        std::filesystem::path        m_perf_counters_file;
+        std::filesystem::path        m_metrics_description_file;
+    };
+
+    AnalyzeCommand();
+    static int  Run(const Options& options);
+    static bool WriteResults(const Options&                     options,
+                             const std::vector<AnalysisResult>& results);
+    int         operator()(int argc, int at, char** argv) const override;
+    int         Help(int argc, int at, char** argv) const override;
+    std::string Description() const override;
+};
+
+AnalyzeCommand::AnalyzeCommand() :
+    Command("analyze", kNormal)
+{
+}
+
+int AnalyzeCommand::Run(const Options& options)
+{
+    auto to_ms = [](std::chrono::steady_clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    };
+
+    // Load and parse once, the analyzers share the metadata
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    Dive::DataCore                        data_core(nullptr);
+    if (data_core.LoadPm4CaptureData(options.m_file_name) !=
+        Dive::CaptureData::LoadResult::kSuccess)
+    {
+        std::cerr << "Can't load " << options.m_file_name << std::endl;
+        return EXIT_FAILURE;
+    }
+    data_core.SetSubmitRange(options.m_submit_range);
+    if (!data_core.ParsePm4CaptureData())
+    {
+        std::cerr << "Can't parse " << options.m_file_name << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::chrono::steady_clock::time_point parsed = std::chrono::steady_clock::now();
+
+    AnalysisInput input{ data_core.GetCaptureMetadata(),
+                         options.m_perf_counters_file,
+                         options.m_metrics_description_file,
+                         options.m_submit_range };
+    std::vector<AnalysisResult> results = RunAnalyzers(Context::Background(),
+                                                       input,
+                                                       options.m_analyzers);
+    std::chrono::steady_clock::time_point analyzed = std::chrono::steady_clock::now();
+
+    bool success = WriteResults(options, results);
+    for (const AnalysisResult& result : results)
+    {
+        if (!result.m_success)
+        {
+            std::cerr << result.m_analyzer << " failed: " << result.m_error << std::endl;
+            success = false;
+        }
+    }
+    std::cerr << "Parsed in " << to_ms(parsed - begin) << " ms, analyzed in "
+              << to_ms(analyzed - parsed) << " ms" << std::endl;
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+bool AnalyzeCommand::WriteResults(const Options&                     options,
+                                  const std::vector<AnalysisResult>& results)
+{
+    if (!options.m_csv)
+    {
+        if (options.m_output.empty())
+        {
+            WriteAnalysisJson(std::cout, options.m_file_name, options.m_submit_range, results);
+            return true;
+        }
+        std::ofstream file(options.m_output);
+        WriteAnalysisJson(file, options.m_file_name, options.m_submit_range, results);
+        return file.good();
+    }
+
+    // One CSV per table, as <analyzer>_<table>.csv in the output directory, or one after the
+    // other on the standard output
+    if (!options.m_submit_range.IsAll())
+    {
+        std::string note = GetSubmitRangeNote(options.m_submit_range);
+        if (options.m_output.empty())
+        {
+            std::cout << "# " << note << std::endl << std::endl;
+        }
+        else
+        {
+            std::cerr << note << std::endl;
+        }
+    }
+    std::error_code error;
+    if (!options.m_output.empty())
+    {
+        std::filesystem::create_directories(options.m_output, error);
+    }
+    if (error)
+    {
+        std::cerr << "Can't create " << options.m_output << ": " << error.message() << std::endl;
+        return false;
+    }
+    bool success = true;
+    for (const AnalysisResult& result : results)
+    {
+        for (const AnalysisTable& table : result.m_tables)
+        {
+            std::string name = result.m_analyzer + "_" + table.m_name;
+            if (options.m_output.empty())
+            {
+                std::cout << "# " << name << std::endl;
+                WriteAnalysisCsv(std::cout, table);
+                std::cout << std::endl;
+                continue;
+            }
+            std::ofstream file(std::filesystem::path(options.m_output) / (name + ".csv"));
+            WriteAnalysisCsv(file, table);
+            success = success && file.good();
+        }
+    }
+    return success;
+}
+
+int AnalyzeCommand::operator()(int argc, int at, char** argv) const
+{
+    Options options;
+    bool    list = false;
+    bool    valid = true;
+    for (int i = at + 1; i < argc && valid; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--list")
+        {
+            list = true;
+        }
+        else if (arg == "--analyzers" && i + 1 < argc)
+        {
+            std::string names = argv[++i];
+            for (std::string::size_type start = 0; start <= names.size();)
+            {
+                std::string::size_type comma = std::min(names.find(',', start), names.size());
+                std::string            name = names.substr(start, comma - start);
+                start = comma + 1;
+                if (name == "all")
+                {
+                    options.m_analyzers = GetAnalyzers();
+                }
+                else if (const Analyzer* analyzer = FindAnalyzer(name))
+                {
+                    options.m_analyzers.push_back(analyzer);
+                }
+                else
+                {
+                    std::cerr << "Unknown analyzer " << name << std::endl;
+                    valid = false;
+                }
+            }
+        }
+        else if (arg == "--format" && i + 1 < argc)
+        {
+            std::string format = argv[++i];
+            options.m_csv = (format == "csv");
+            valid = options.m_csv || format == "json";
+        }
+        else if ((arg == "-o" || arg == "--output") && i + 1 < argc)
+        {
+            options.m_output = argv[++i];
+        }
+        else if (arg == "--perf-counters" && i + 1 < argc)
+        {
+            options.m_perf_counters_file = argv[++i];
+        }
+        else if (arg == "--metrics" && i + 1 < argc)
+        {
+            options.m_metrics_description_file = argv[++i];
+        }
+        else if (arg == "--submits" && i + 1 < argc)
+        {
+            valid = ParseSubmitRange(argv[++i], options.m_submit_range);
+        }
+        else if (options.m_file_name == nullptr)
+        {
+            options.m_file_name = argv[i];
+        }
+        else
+        {
+            valid = false;
+        }
+    }
+    if (list)
+    {
+        for (const Analyzer* analyzer : GetAnalyzers())
+        {
+            std::cout << analyzer->GetName() << ": " << analyzer->GetDescription() << std::endl;
+        }
+        return EXIT_SUCCESS;
+    }
+    if (!valid || options.m_file_name == nullptr)
+    {
+        Help(argc, at, argv);
+        return EXIT_FAILURE;
+    }
+    if (!options.m_submit_range.IsAll() && !options.m_perf_counters_file.empty())
+    {
+        std::cerr << "--perf-counters can't be used with --submits: the perf counters are"
+                     " correlated with the draws of the whole capture"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (options.m_analyzers.empty())
+    {
+        // Everything that can run with the given inputs
+        for (const Analyzer* analyzer : GetAnalyzers())
+        {
+            if (strcmp(analyzer->GetName(), "perf_counters") != 0 ||
+                !options.m_perf_counters_file.empty())
+            {
+                options.m_analyzers.push_back(analyzer);
+            }
+        }
+    }
+    return Run(options);
+}
+
+int AnalyzeCommand::Help(int argc, int at, char** argv) const
+{
+    std::cout << "usage: " << ProgramName(argv[0]) << " " << GetName()
+              << " [--analyzers <name>,...|all] [--format json|csv] [-o <path>]"
+                 " [--perf-counters <.csv> --metrics <.csv>] [--submits <first>[-<last>]] <.rd>"
+              << std::endl;
+    std::cout << "  loads the capture once and runs the analyzers concurrently on it" << std::endl;
+    std::cout << "  --list: list the analyzers" << std::endl;
+    std::cout << "  --analyzers: analyzers to run, all by default (perf_counters only with"
+                 " --perf-counters)"
+              << std::endl;
+    std::cout << "  --format: json (default), or csv with one table per analyzer result"
+              << std::endl;
+    std::cout << "  -o,--output <path>: json file, or directory of csv files, instead of stdout"
+              << std::endl;
+    std::cout << "  --perf-counters: perf counters collected with the capture" << std::endl;
+    std::cout << "  --metrics: descriptions of the perf counter metrics" << std::endl;
+    std::cout << "  --submits: only parse and analyze these submits (e.g. 12 or 12-15), much faster"
+                 " on large captures. The draw and event indices of the results are then relative"
+                 " to the first event of the range. Not with --perf-counters."
+              << std::endl;
+    return EXIT_SUCCESS;
+}
+
+std::string AnalyzeCommand::Description() const
+{
+    return "run analyzers on a capture and output JSON or CSV";
+}
+
+//--------------------------------------------------------------------------------------------------
+struct DiffCommand : Command
+{
+    DiffCommand();
+    static bool LoadCapture(const char* file_name, Dive::DataCore& data_core);
+    static int  Run(const char*                    file_name_a,
+                    const char*                    file_name_b,
+                    const CaptureDiffOptions&      diff_options,
+                    const AnalyzeCommand::Options& output_options);
+    int         operator()(int argc, int at, char** argv) const override;
+    int         Help(int argc, int at, char** argv) const override;
+    std::string Description() const override;
+};
+
+DiffCommand::DiffCommand() :
+    Command("diff", kNormal)
+{
+}
+
+bool DiffCommand::LoadCapture(const char* file_name, Dive::DataCore& data_core)
+{
+    if (data_core.LoadPm4CaptureData(file_name) != Dive::CaptureData::LoadResult::kSuccess)
+    {
+        std::cerr << "Can't load " << file_name << std::endl;
+        return false;
+    }
+    if (!data_core.ParsePm4CaptureData())
+    {
+        std::cerr << "Can't parse " << file_name << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int DiffCommand::Run(const char*                    file_name_a,
+                     const char*                    file_name_b,
+                     const CaptureDiffOptions&      diff_options,
+                     const AnalyzeCommand::Options& output_options)
+{
+    auto to_ms = [](std::chrono::steady_clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    };
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    Dive::DataCore                        data_core_a(nullptr);
+    Dive::DataCore                        data_core_b(nullptr);
+    if (!LoadCapture(file_name_a, data_core_a) || !LoadCapture(file_name_b, data_core_b))
+    {
+        return EXIT_FAILURE;
+    }
+    std::chrono::steady_clock::time_point parsed = std::chrono::steady_clock::now();
+
+    const CaptureMetadata& meta_data_a = data_core_a.GetCaptureMetadata();
+    const CaptureMetadata& meta_data_b = data_core_b.GetCaptureMetadata();
+    CaptureDiff            diff;
+    if (!DiffCaptures(Context::Background(), meta_data_a, meta_data_b, diff_options, diff))
+    {
+        return EXIT_FAILURE;
+    }
+    std::chrono::steady_clock::time_point compared = std::chrono::steady_clock::now();
+
+    AnalysisResult result;
+    result.m_analyzer = "diff";
+    result.m_success = true;
+    result.m_tables = GetCaptureDiffTables(meta_data_a, meta_data_b, diff);
+
+    // Reported as the result of a "diff" analyzer of the pair of captures
+    std::string             captures = std::string(file_name_a) + " " + file_name_b;
+    AnalyzeCommand::Options options = output_options;
+    options.m_file_name = captures.c_str();
+    if (!AnalyzeCommand::WriteResults(options, { result }))
+    {
+        return EXIT_FAILURE;
+    }
+    std::cerr << meta_data_a.m_event_info.size() << " and " << meta_data_b.m_event_info.size()
+              << " events, parsed in " << to_ms(parsed - begin) << " ms, compared in "
+              << to_ms(compared - parsed) << " ms" << std::endl;
+    return EXIT_SUCCESS;
+}
+
+int DiffCommand::operator()(int argc, int at, char** argv) const
+{
+    CaptureDiffOptions      diff_options;
+    AnalyzeCommand::Options output_options;
+    const char*             file_name_a = nullptr;
+    const char*             file_name_b = nullptr;
+    bool                    valid = true;
+    for (int i = at + 1; i < argc && valid; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--max-edit-distance" && i + 1 < argc)
+        {
+            diff_options.m_max_edit_distance = static_cast<uint32_t>(
+            strtoul(argv[++i], nullptr, 0));
+        }
+        else if (arg == "--format" && i + 1 < argc)
+        {
+            std::string format = argv[++i];
+            output_options.m_csv = (format == "csv");
+            valid = output_options.m_csv || format == "json";
+        }
+        else if ((arg == "-o" || arg == "--output") && i + 1 < argc)
+        {
+            output_options.m_output = argv[++i];
+        }
+        else if (file_name_a == nullptr)
+        {
+            file_name_a = argv[i];
+        }
+        else if (file_name_b == nullptr)
+        {
+            file_name_b = argv[i];
+        }
+        else
+        {
+            valid = false;
+        }
+    }
+    if (!valid || file_name_b == nullptr)
+    {
+        Help(argc, at, argv);
+        return EXIT_FAILURE;
+    }
+    return Run(file_name_a, file_name_b, diff_options, output_options);
+}
+
+int DiffCommand::Help(int argc, int at, char** argv) const
+{
+    std::cout << "usage: " << ProgramName(argv[0]) << " " << GetName()
+              << " [--max-edit-distance <n>] [--format json|csv] [-o <path>] <a.rd> <b.rd>"
+              << std::endl;
+    std::cout << "  aligns the events of capture b with the ones of capture a, by marker path,"
+                 " order and shaders, and reports the changed, added and removed events"
+              << std::endl;
+    std::cout << "  --max-edit-distance: max number of added + removed events of a marker path"
+                 " to align exactly (default "
+              << CaptureDiffOptions().m_max_edit_distance << ")" << std::endl;
+    std::cout << "  --format: json (default), or csv with one file per table" << std::endl;
+    std::cout << "  -o,--output <path>: json file, or directory of csv files, instead of stdout"
+              << std::endl;
+    return EXIT_SUCCESS;
+}
+
+std::string DiffCommand::Description() const
+{
+    return "compare two captures of the same workload";
+}
+
+//--------------------------------------------------------------------------------------------------
+struct CorpusStatsCommand : Command
+{
+    CorpusStatsCommand();
+    static int  Run(const std::vector<std::filesystem::path>& paths,
+                    const CorpusStatsOptions&                 stats_options,
+                    const AnalyzeCommand::Options&            output_options);
+    int         operator()(int argc, int at, char** argv) const override;
+    int         Help(int argc, int at, char** argv) const override;
+    std::string Description() const override;
+};
+
+CorpusStatsCommand::CorpusStatsCommand() :
+    Command("corpus-stats", kNormal)
+{
+}
+
+int CorpusStatsCommand::Run(const std::vector<std::filesystem::path>& paths,
+                            const CorpusStatsOptions&                 stats_options,
+                            const AnalyzeCommand::Options&            output_options)
+{
+    std::vector<std::filesystem::path> files = FindCaptureFiles(paths);
+    if (files.empty())
+    {
+        std::cerr << "No capture found" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::mutex  progress_mutex;
+    size_t      num_done = 0;
+    CorpusStats corpus_stats;
+    auto        on_capture_done = [&](const CorpusCaptureStats& capture_stats) {
+        std::lock_guard<std::mutex> lock(progress_mutex);
+        ++num_done;
+        std::cerr << "[" << num_done << "/" << files.size() << "] " << capture_stats.m_file_name;
+        if (capture_stats.m_success)
+        {
+            std::cerr << ": " << capture_stats.m_num_events << " events, loaded in "
+                      << capture_stats.m_load_ms << " ms" << std::endl;
+        }
+        else
+        {
+            std::cerr << ": " << capture_stats.m_error << std::endl;
+        }
+    };
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    GatherCorpusStats(Context::Background(), files, stats_options, corpus_stats, on_capture_done);
+    std::chrono::steady_clock::time_point gathered = std::chrono::steady_clock::now();
+
+    AnalysisResult result;
+    result.m_analyzer = "corpus_stats";
+    result.m_success = true;
+    result.m_tables = GetCorpusStatsTables(corpus_stats);
+
+    // Reported as the result of a "corpus_stats" analyzer of the given paths
+    std::string capture_paths;
+    for (const std::filesystem::path& path : paths)
+    {
+        capture_paths += (capture_paths.empty() ? "" : " ") + path.string();
+    }
+    AnalyzeCommand::Options options = output_options;
+    options.m_file_name = capture_paths.c_str();
+    if (!AnalyzeCommand::WriteResults(options, { result }))
+    {
+        return EXIT_FAILURE;
+    }
+    std::cerr << files.size() << " captures (" << corpus_stats.GetNumFailedCaptures()
+              << " failed) in " << std::chrono::duration<double>(gathered - begin).count()
+              << " s" << std::endl;
+    return EXIT_SUCCESS;
+}
+
+int CorpusStatsCommand::operator()(int argc, int at, char** argv) const
+{
+    CorpusStatsOptions                 stats_options;
+    AnalyzeCommand::Options            output_options;
+    std::vector<std::filesystem::path> paths;
+    bool                               valid = true;
+    for (int i = at + 1; i < argc && valid; ++i)
+    {
+        std::string arg = argv[i];
+        if ((arg == "-j" || arg == "--jobs") && i + 1 < argc)
+        {
+            stats_options.m_num_workers = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+        }
+        else if (arg == "--max-memory" && i + 1 < argc)
+        {
+            stats_options.m_memory_budget = strtoull(argv[++i], nullptr, 0) << 20;
+        }
+        else if (arg == "--cache")
+        {
+            stats_options.m_use_analysis_cache = true;
+        }
+        else if (arg == "--format" && i + 1 < argc)
+        {
+            std::string format = argv[++i];
+            output_options.m_csv = (format == "csv");
+            valid = output_options.m_csv || format == "json";
+        }
+        else if ((arg == "-o" || arg == "--output") && i + 1 < argc)
+        {
+            output_options.m_output = argv[++i];
+        }
+        else
+        {
+            paths.push_back(argv[i]);
+        }
+    }
+    if (!valid || paths.empty())
+    {
+        Help(argc, at, argv);
+        return EXIT_FAILURE;
+    }
+    return Run(paths, stats_options, output_options);
+}
+
+int CorpusStatsCommand::Help(int argc, int at, char** argv) const
+{
+    std::cout << "usage: " << ProgramName(argv[0]) << " " << GetName()
+              << " [-j <n>] [--max-memory <MB>] [--cache] [--format json|csv] [-o <path>]"
+                 " <dir|capture>..."
+              << std::endl;
+    std::cout << "  gathers the trace stats of each .rd/.dive capture, in parallel, and reports"
+                 " them per capture and as distributions over all the captures"
+              << std::endl;
+    std::cout << "  -j,--jobs: captures processed at once (default: number of hardware threads)"
+              << std::endl;
+    std::cout << "  --max-memory: memory budget of the captures loaded at once (default "
+              << (CorpusStatsOptions().m_memory_budget >> 20) << ")" << std::endl;
+    std::cout << "  --cache: load and save an analysis sidecar (<capture>.divecache) next to each"
+                 " capture, and the shader disassembly in the user cache directory, to skip the"
+                 " parsing of the captures on the next run"
+              << std::endl;
+    std::cout << "  --format: json (default), or csv with one file per table" << std::endl;
+    std::cout << "  -o,--output <path>: json file, or directory of csv files, instead of stdout"
+              << std::endl;
+    return EXIT_SUCCESS;
+}
+
+std::string CorpusStatsCommand::Description() const
+{
+    return "aggregate the stats of a corpus of captures";
+}
+
 //--------------------------------------------------------------------------------------------------
 struct PacketCommand : Command
 {
@@ -485,6 +1204,10 @@ template<typename T> const Command& CommandOf<T>::Get()
 
 template const Command& CommandOf<VersionCommand>::Get();
 template const Command& CommandOf<ExtractCommand>::Get();
+template const Command& CommandOf<SearchCommand>::Get();
+template const Command& CommandOf<AnalyzeCommand>::Get();
+template const Command& CommandOf<DiffCommand>::Get();
+template const Command& CommandOf<CorpusStatsCommand>::Get();
 template const Command& CommandOf<PacketCommand>::Get();
 template const Command& CommandOf<InfoCommand>::Get();
 template const Command& CommandOf<RawPM4Command>::Get();
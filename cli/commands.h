@@ -57,6 +57,10 @@ private:
 struct HelpCommand;
 struct VersionCommand;
 struct ExtractCommand;
+struct SearchCommand;
+struct AnalyzeCommand;
+struct DiffCommand;
+struct CorpusStatsCommand;
 
 // Internal utilities, originally from capture_reporter.
 // Hiding from user as they are not intended for normal end user flow.
@@ -31,6 +31,10 @@ int main(int argc, char** argv)
         &CommandOf<HelpCommand>::Get(&commands),
         &CommandOf<VersionCommand>::Get(),
         &CommandOf<ExtractCommand>::Get(),
+        &CommandOf<SearchCommand>::Get(),
+        &CommandOf<AnalyzeCommand>::Get(),
+        &CommandOf<DiffCommand>::Get(),
+        &CommandOf<CorpusStatsCommand>::Get(),
         // Internal, use `divecli help --internal`
         // It's hidden to not cause confusion.
         &CommandOf<PacketCommand>::Get(),
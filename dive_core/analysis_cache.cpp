@@ -0,0 +1,749 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "analysis_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "common/dive_version.h"
+#include "data_core.h"
+#include "dive_core/common/hash_utils.h"
+
+namespace Dive
+{
+namespace
+{
+
+constexpr uint32_t kCacheFileMagic = 0x43415644;  // "DVAC"
+constexpr uint64_t kSectionAlignment = 16;
+
+enum SectionId : uint32_t
+{
+    kMiscSection,
+    kNodeTypesSection,
+    kNodeAuxInfoSection,
+    kNodeDescEndsSection,
+    kNodeDescCharsSection,
+    kEventNodeIndicesSection,
+    kShadersSection,
+    kBuffersSection,
+    kEventsSection,
+    kEventBufferIndicesSection,
+    kEventShaderReferencesSection,
+    kEventStrCharsSection,
+    kEventLogEntriesSection,
+    kEventLogCharsSection,
+    kEventStateSection,
+    kEventStateIsSetSection,
+
+    // One section per filter list type
+    kFilterExcludeIndicesSection = 0x100,
+
+    // One section per topology type and TopologyField
+    kTopologySection = 0x200,
+};
+
+enum TopologyField : uint32_t
+{
+    kChildrenListField,
+    kNodeChildrenField,
+    kNodeParentField,
+    kNodeChildIndexField,
+    kSharedChildrenIndicesField,
+    kNodeSharedChildrenField,
+    kStartSharedChildField,
+    kEndSharedChildField,
+    kRootNodeIndexField,
+    kTopologyFieldCount
+};
+
+uint32_t TopologySectionId(uint32_t topology, TopologyField field)
+{
+    return kTopologySection + topology * kTopologyFieldCount + field;
+}
+
+// Identifies the build that wrote a sidecar, so that a change of the parser or of the emulator
+// invalidates the sidecars written by other builds
+uint64_t GetBuildHash()
+{
+    static const uint64_t build_hash = HashUtils::HashContent(DIVE_VERSION_SHA1,
+                                                              std::strlen(DIVE_VERSION_SHA1));
+    return build_hash;
+}
+
+struct CacheFileHeader
+{
+    uint32_t m_magic;
+    uint32_t m_version;
+    uint64_t m_build_hash;
+    uint64_t m_capture_content_size;
+    uint64_t m_capture_content_hash;
+    uint32_t m_num_sections;
+    uint32_t m_reserved;
+};
+
+struct SectionEntry
+{
+    uint32_t m_id;
+    uint32_t m_element_size;
+    uint64_t m_offset;  // From the start of the file
+    uint64_t m_count;   // Number of elements
+};
+
+struct MiscInfo
+{
+    uint64_t m_num_pm4_packets;
+    uint64_t m_event_state_size;
+    uint64_t m_event_state_capacity;
+};
+
+struct CachedShader
+{
+    uint64_t m_address;
+    uint32_t m_submit_index;
+    uint32_t m_reserved;
+};
+
+// Fixed-size part of an EventInfo. The variable-sized parts are in their own sections, and the
+// `_end` fields are the end offsets of the event's elements in those sections (the start offsets
+// being the end offsets of the previous event).
+struct CachedEvent
+{
+    uint32_t m_num_indices;
+    uint32_t m_submit_index;
+    uint32_t m_type;
+    uint32_t m_render_mode;
+    uint64_t m_buffer_indices_end[kShaderStageCount];
+    uint64_t m_shader_references_end;
+    uint64_t m_str_end;
+    uint64_t m_log_entries_end;
+};
+
+struct CachedLogEntry
+{
+    uint32_t m_type;
+    uint32_t m_category;
+    uint32_t m_code;
+    int32_t  m_line;
+    int32_t  m_ref_type;
+    uint32_t m_reserved;
+    uint64_t m_ref_id;
+    uint64_t m_file_end;
+    uint64_t m_short_desc_end;
+    uint64_t m_long_desc_end;
+};
+
+inline uint64_t AlignUp(uint64_t value)
+{
+    return (value + kSectionAlignment - 1) & ~(kSectionAlignment - 1);
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t AppendString(const char *str, std::vector<char> &chars)
+{
+    if (str != nullptr)
+    {
+        chars.insert(chars.end(), str, str + strlen(str));
+    }
+    return chars.size();
+}
+
+//--------------------------------------------------------------------------------------------------
+// LogEntry::m_file normally points to a __FILE__ literal, so the file names of loaded log entries
+// are kept alive until exit
+const char *InternFileName(std::string &&file_name)
+{
+    static std::mutex            mutex;
+    static std::set<std::string> file_names;
+    std::lock_guard<std::mutex>  lock(mutex);
+    return file_names.insert(std::move(file_name)).first->c_str();
+}
+
+}  // namespace
+
+// =================================================================================================
+// AnalysisCache::SectionWriter
+// =================================================================================================
+class AnalysisCache::SectionWriter
+{
+public:
+    // Add a section referencing `data`, which must stay valid until the writer is done
+    template<typename T> void AddArray(uint32_t id, const T *data, uint64_t count)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Sections are copied as raw bytes");
+        m_sections.push_back({ id, sizeof(T), data, count });
+    }
+
+    // Add a section owned by the writer
+    template<typename T> void AddArray(uint32_t id, std::vector<T> &&data)
+    {
+        auto owned_data = std::make_shared<std::vector<T>>(std::move(data));
+        AddArray(id, owned_data->data(), owned_data->size());
+        m_owned_data.push_back(std::move(owned_data));
+    }
+
+    bool Write(const std::string &file_name, const CaptureKey &key) const;
+
+private:
+    struct Section
+    {
+        uint32_t    m_id;
+        uint32_t    m_element_size;
+        const void *m_data;
+        uint64_t    m_count;
+    };
+
+    std::vector<Section>               m_sections;
+    std::vector<std::shared_ptr<void>> m_owned_data;
+};
+
+//--------------------------------------------------------------------------------------------------
+bool AnalysisCache::SectionWriter::Write(const std::string &file_name, const CaptureKey &key) const
+{
+    CacheFileHeader header = {};
+    header.m_magic = kCacheFileMagic;
+    header.m_version = kVersion;
+    header.m_build_hash = GetBuildHash();
+    header.m_capture_content_size = key.m_content_size;
+    header.m_capture_content_hash = key.m_content_hash;
+    header.m_num_sections = static_cast<uint32_t>(m_sections.size());
+
+    std::vector<SectionEntry> entries;
+    uint64_t offset = AlignUp(sizeof(CacheFileHeader) + sizeof(SectionEntry) * m_sections.size());
+    for (const Section &section : m_sections)
+    {
+        entries.push_back({ section.m_id, section.m_element_size, offset, section.m_count });
+        offset = AlignUp(offset + section.m_element_size * section.m_count);
+    }
+
+    // Write to a unique temporary file and rename it, so that a concurrent reader (e.g. another
+    // Dive instance opening the same capture) never sees a partially written sidecar
+    std::filesystem::path path(file_name);
+    std::ostringstream    temp_name;
+    temp_name << path.filename().string() << "." << std::this_thread::get_id() << "."
+              << std::chrono::steady_clock::now().time_since_epoch().count() << ".tmp";
+    std::filesystem::path temp_path = path.parent_path() / temp_name.str();
+    std::error_code       ec;
+    {
+        std::ofstream stream(temp_path, std::ios::binary | std::ios::trunc);
+        if (!stream.is_open())
+            return false;
+
+        const char kPadding[kSectionAlignment] = {};
+        uint64_t   position = sizeof(CacheFileHeader) + sizeof(SectionEntry) * entries.size();
+        stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        stream.write(reinterpret_cast<const char *>(entries.data()),
+                     sizeof(SectionEntry) * entries.size());
+        for (size_t i = 0; i < m_sections.size(); ++i)
+        {
+            stream.write(kPadding, entries[i].m_offset - position);
+            uint64_t size = m_sections[i].m_element_size * m_sections[i].m_count;
+            if (size > 0)
+            {
+                stream.write(static_cast<const char *>(m_sections[i].m_data), size);
+            }
+            position = entries[i].m_offset + size;
+        }
+        if (!stream)
+        {
+            stream.close();
+            std::filesystem::remove(temp_path, ec);
+            return false;
+        }
+    }
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec)
+    {
+        std::filesystem::remove(temp_path, ec);
+        return false;
+    }
+    return true;
+}
+
+// =================================================================================================
+// AnalysisCache::SectionReader
+// =================================================================================================
+class AnalysisCache::SectionReader
+{
+public:
+    // Read the sidecar and validate its header and section table against `key`
+    bool Open(const std::string &file_name, const CaptureKey &key);
+
+    // Access the elements of a section in the buffer read from the file
+    template<typename T> bool GetArray(uint32_t id, const T *&data, uint64_t &count) const
+    {
+        auto it = m_sections.find(id);
+        if (it == m_sections.end() || it->second.m_element_size != sizeof(T))
+            return false;
+        data = reinterpret_cast<const T *>(m_data.get() + it->second.m_offset);
+        count = it->second.m_count;
+        return true;
+    }
+
+    // Copy the elements of a section to a std::vector or a DiveVector
+    template<typename Container> bool ReadArray(uint32_t id, Container &container) const
+    {
+        using T = std::remove_reference_t<decltype(*container.data())>;
+        const T *data = nullptr;
+        uint64_t count = 0;
+        if (!GetArray(id, data, count))
+            return false;
+        // Some element types are not default-constructible
+        container.clear();
+        if (count > 0)
+        {
+            container.resize(count, data[0]);
+            std::memcpy(container.data(), data, sizeof(T) * count);
+        }
+        return true;
+    }
+
+    // Read a list of strings stored as end offsets plus concatenated characters
+    template<typename Container>
+    bool ReadStrings(uint32_t ends_id, uint32_t chars_id, Container &strings) const
+    {
+        const uint64_t *ends = nullptr;
+        const char     *chars = nullptr;
+        uint64_t        num_strings = 0, num_chars = 0;
+        if (!GetArray(ends_id, ends, num_strings) || !GetArray(chars_id, chars, num_chars))
+            return false;
+        strings.resize(num_strings);
+        uint64_t begin = 0;
+        for (uint64_t i = 0; i < num_strings; ++i)
+        {
+            if (ends[i] < begin || ends[i] > num_chars)
+                return false;
+            strings[i].assign(chars + begin, ends[i] - begin);
+            begin = ends[i];
+        }
+        return true;
+    }
+
+private:
+    std::unique_ptr<uint8_t[]>       m_data;
+    uint64_t                         m_size = 0;
+    std::map<uint32_t, SectionEntry> m_sections;
+};
+
+//--------------------------------------------------------------------------------------------------
+bool AnalysisCache::SectionReader::Open(const std::string &file_name, const CaptureKey &key)
+{
+    std::error_code ec;
+    m_size = std::filesystem::file_size(file_name, ec);
+    if (ec || m_size < sizeof(CacheFileHeader))
+        return false;
+
+    // Check the header before reading the whole file
+    std::ifstream stream(file_name, std::ios::binary);
+    if (!stream.is_open())
+        return false;
+    CacheFileHeader header;
+    if (!stream.read(reinterpret_cast<char *>(&header), sizeof(header)))
+        return false;
+    if (header.m_magic != kCacheFileMagic || header.m_version != kVersion ||
+        header.m_build_hash != GetBuildHash() ||
+        header.m_capture_content_size != key.m_content_size ||
+        header.m_capture_content_hash != key.m_content_hash)
+        return false;
+    if (header.m_num_sections > (m_size - sizeof(CacheFileHeader)) / sizeof(SectionEntry))
+        return false;
+
+    // operator new[] returns memory aligned for any fundamental type, so each (aligned) section
+    // can be accessed in place
+    m_data.reset(new uint8_t[m_size]);
+    std::memcpy(m_data.get(), &header, sizeof(header));
+    if (!stream.read(reinterpret_cast<char *>(m_data.get() + sizeof(header)),
+                     m_size - sizeof(header)))
+        return false;
+
+    const SectionEntry *entries = reinterpret_cast<const SectionEntry *>(m_data.get() +
+                                                                         sizeof(CacheFileHeader));
+    for (uint32_t i = 0; i < header.m_num_sections; ++i)
+    {
+        const SectionEntry &entry = entries[i];
+        if (entry.m_element_size == 0 || entry.m_offset % kSectionAlignment != 0 ||
+            entry.m_offset > m_size ||
+            entry.m_count > (m_size - entry.m_offset) / entry.m_element_size)
+            return false;
+        m_sections[entry.m_id] = entry;
+    }
+    return true;
+}
+
+// =================================================================================================
+// AnalysisCache
+// =================================================================================================
+std::string AnalysisCache::GetCacheFileName(const std::string &capture_file_name)
+{
+    return capture_file_name + ".divecache";
+}
+
+//--------------------------------------------------------------------------------------------------
+void AnalysisCache::SaveCommandHierarchy(const CommandHierarchy &command_hierarchy,
+                                         SectionWriter          &writer)
+{
+    const CommandHierarchy::Nodes &nodes = command_hierarchy.m_nodes;
+    writer.AddArray(kNodeTypesSection, nodes.m_node_type.data(), nodes.m_node_type.size());
+    writer.AddArray(kNodeAuxInfoSection, nodes.m_aux_info.data(), nodes.m_aux_info.size());
+    writer.AddArray(kEventNodeIndicesSection,
+                    nodes.m_event_node_indices.data(),
+                    nodes.m_event_node_indices.size());
+
+    std::vector<uint64_t> desc_ends;
+    std::vector<char>     desc_chars;
+    desc_ends.reserve(nodes.m_description.size());
+    for (const std::string &desc : nodes.m_description)
+    {
+        desc_ends.push_back(AppendString(desc.c_str(), desc_chars));
+    }
+    writer.AddArray(kNodeDescEndsSection, std::move(desc_ends));
+    writer.AddArray(kNodeDescCharsSection, std::move(desc_chars));
+
+    for (uint32_t filter = 0; filter < CommandHierarchy::kFilterListTypeCount; ++filter)
+    {
+        auto filter_type = static_cast<CommandHierarchy::FilterListType>(filter);
+        writer.AddArray(kFilterExcludeIndicesSection + filter,
+                        command_hierarchy.GetFilterExcludeIndices(filter_type));
+    }
+
+    for (uint32_t t = 0; t < CommandHierarchy::kTopologyTypeCount; ++t)
+    {
+        const SharedNodeTopology &topology = command_hierarchy.m_topology[t];
+        auto add_field = [&](TopologyField field, const auto &array) {
+            writer.AddArray(TopologySectionId(t, field), array.data(), array.size());
+        };
+        add_field(kChildrenListField, topology.m_children_list);
+        add_field(kNodeChildrenField, topology.m_node_children);
+        add_field(kNodeParentField, topology.m_node_parent);
+        add_field(kNodeChildIndexField, topology.m_node_child_index);
+        add_field(kSharedChildrenIndicesField, topology.m_shared_children_indices);
+        add_field(kNodeSharedChildrenField, topology.m_node_shared_children);
+        add_field(kStartSharedChildField, topology.m_start_shared_child);
+        add_field(kEndSharedChildField, topology.m_end_shared_child);
+        add_field(kRootNodeIndexField, topology.m_root_node_index);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+bool AnalysisCache::LoadCommandHierarchy(const SectionReader &reader,
+                                         CommandHierarchy    &command_hierarchy)
+{
+    CommandHierarchy::Nodes &nodes = command_hierarchy.m_nodes;
+    if (!reader.ReadArray(kNodeTypesSection, nodes.m_node_type) ||
+        !reader.ReadArray(kNodeAuxInfoSection, nodes.m_aux_info) ||
+        !reader.ReadArray(kEventNodeIndicesSection, nodes.m_event_node_indices) ||
+        !reader.ReadStrings(kNodeDescEndsSection, kNodeDescCharsSection, nodes.m_description))
+        return false;
+    uint64_t num_nodes = nodes.m_node_type.size();
+    if (nodes.m_aux_info.size() != num_nodes || nodes.m_description.size() != num_nodes)
+        return false;
+
+    for (uint32_t filter = 0; filter < CommandHierarchy::kFilterListTypeCount; ++filter)
+    {
+        const uint64_t *indices = nullptr;
+        uint64_t        num_indices = 0;
+        if (!reader.GetArray(kFilterExcludeIndicesSection + filter, indices, num_indices))
+            return false;
+        auto filter_type = static_cast<CommandHierarchy::FilterListType>(filter);
+        for (uint64_t i = 0; i < num_indices; ++i)
+        {
+            if (indices[i] >= num_nodes)
+                return false;
+            command_hierarchy.AddToFilterExcludeIndexList(indices[i], filter_type);
+        }
+    }
+
+    for (uint32_t t = 0; t < CommandHierarchy::kTopologyTypeCount; ++t)
+    {
+        SharedNodeTopology &topology = command_hierarchy.m_topology[t];
+        auto read_field = [&](TopologyField field, auto &array) {
+            return reader.ReadArray(TopologySectionId(t, field), array);
+        };
+        if (!read_field(kChildrenListField, topology.m_children_list) ||
+            !read_field(kNodeChildrenField, topology.m_node_children) ||
+            !read_field(kNodeParentField, topology.m_node_parent) ||
+            !read_field(kNodeChildIndexField, topology.m_node_child_index) ||
+            !read_field(kSharedChildrenIndicesField, topology.m_shared_children_indices) ||
+            !read_field(kNodeSharedChildrenField, topology.m_node_shared_children) ||
+            !read_field(kStartSharedChildField, topology.m_start_shared_child) ||
+            !read_field(kEndSharedChildField, topology.m_end_shared_child) ||
+            !read_field(kRootNodeIndexField, topology.m_root_node_index))
+            return false;
+
+        // Per-node arrays, see SharedNodeTopology::SetNumNodes()
+        if (topology.m_node_children.size() != num_nodes ||
+            topology.m_node_shared_children.size() != num_nodes ||
+            topology.m_node_parent.size() != num_nodes ||
+            topology.m_node_child_index.size() != num_nodes)
+            return false;
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool AnalysisCache::Save(const std::string     &cache_file_name,
+                         const CaptureKey      &key,
+                         const CaptureMetadata &metadata)
+{
+    SectionWriter writer;
+    SaveCommandHierarchy(metadata.m_command_hierarchy, writer);
+
+    std::vector<CachedShader> shaders;
+    shaders.reserve(metadata.m_shaders.size());
+    for (const Disassembly &shader : metadata.m_shaders)
+    {
+        shaders.push_back({ shader.GetShaderAddr(), shader.GetSubmitIndex(), 0 });
+    }
+    writer.AddArray(kShadersSection, std::move(shaders));
+    writer.AddArray(kBuffersSection, metadata.m_buffers.data(), metadata.m_buffers.size());
+
+    std::vector<CachedEvent>     events;
+    std::vector<uint32_t>        buffer_indices;
+    std::vector<ShaderReference> shader_references;
+    std::vector<char>            str_chars;
+    std::vector<CachedLogEntry>  log_entries;
+    std::vector<char>            log_chars;
+    events.reserve(metadata.m_event_info.size());
+    for (const EventInfo &event_info : metadata.m_event_info)
+    {
+        CachedEvent event = {};
+        event.m_num_indices = event_info.m_num_indices;
+        event.m_submit_index = event_info.m_submit_index;
+        event.m_type = static_cast<uint32_t>(event_info.m_type);
+        event.m_render_mode = static_cast<uint32_t>(event_info.m_render_mode);
+        for (uint32_t stage = 0; stage < kShaderStageCount; ++stage)
+        {
+            const std::vector<uint32_t> &indices = event_info.m_buffer_indices[stage];
+            buffer_indices.insert(buffer_indices.end(), indices.begin(), indices.end());
+            event.m_buffer_indices_end[stage] = buffer_indices.size();
+        }
+        shader_references.insert(shader_references.end(),
+                                 event_info.m_shader_references.begin(),
+                                 event_info.m_shader_references.end());
+        event.m_shader_references_end = shader_references.size();
+        event.m_str_end = AppendString(event_info.m_str.c_str(), str_chars);
+
+        const DeferredLog &log = event_info.m_metadata_log;
+        for (uint32_t i = 0; i < log.GetNumEntries(); ++i)
+        {
+            const ILog::LogEntry &entry = log.GetEntry(i);
+            CachedLogEntry        cached_entry = {};
+            cached_entry.m_type = static_cast<uint32_t>(entry.m_type);
+            cached_entry.m_category = static_cast<uint32_t>(entry.m_cat);
+            cached_entry.m_code = static_cast<uint32_t>(entry.m_code);
+            cached_entry.m_line = entry.m_line;
+            cached_entry.m_ref_type = static_cast<int32_t>(entry.m_ref.Type());
+            cached_entry.m_ref_id = entry.m_ref.Id();
+            cached_entry.m_file_end = AppendString(entry.m_file, log_chars);
+            cached_entry.m_short_desc_end = AppendString(entry.m_short_desc.c_str(), log_chars);
+            cached_entry.m_long_desc_end = AppendString(entry.m_long_desc.c_str(), log_chars);
+            log_entries.push_back(cached_entry);
+        }
+        event.m_log_entries_end = log_entries.size();
+        events.push_back(event);
+    }
+    writer.AddArray(kEventsSection, std::move(events));
+    writer.AddArray(kEventBufferIndicesSection, std::move(buffer_indices));
+    writer.AddArray(kEventShaderReferencesSection, std::move(shader_references));
+    writer.AddArray(kEventStrCharsSection, std::move(str_chars));
+    writer.AddArray(kEventLogEntriesSection, std::move(log_entries));
+    writer.AddArray(kEventLogCharsSection, std::move(log_chars));
+
+    const EventStateInfo &event_state = metadata.m_event_state;
+    writer.AddArray(kEventStateSection,
+                    static_cast<const uint8_t *>(event_state.RawBuffer()),
+                    event_state.RawBufferSize());
+    writer.AddArray(kEventStateIsSetSection,
+                    event_state.RawIsSetBuffer().data(),
+                    event_state.RawIsSetBuffer().size());
+
+    MiscInfo misc = {};
+    misc.m_num_pm4_packets = metadata.m_num_pm4_packets;
+    misc.m_event_state_size = event_state.size();
+    misc.m_event_state_capacity = event_state.capacity();
+    writer.AddArray(kMiscSection, &misc, 1);
+
+    return writer.Write(cache_file_name, key);
+}
+
+//--------------------------------------------------------------------------------------------------
+bool AnalysisCache::Load(const std::string    &cache_file_name,
+                         const CaptureKey     &key,
+                         const IMemoryManager &mem_manager,
+                         CaptureMetadata      &metadata)
+{
+    metadata = CaptureMetadata();
+    if (LoadImpl(cache_file_name, key, mem_manager, metadata))
+        return true;
+    metadata = CaptureMetadata();
+    return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool AnalysisCache::LoadImpl(const std::string    &cache_file_name,
+                             const CaptureKey     &key,
+                             const IMemoryManager &mem_manager,
+                             CaptureMetadata      &metadata)
+{
+    SectionReader reader;
+    if (!reader.Open(cache_file_name, key))
+        return false;
+
+    const MiscInfo *misc = nullptr;
+    uint64_t        misc_count = 0;
+    if (!reader.GetArray(kMiscSection, misc, misc_count) || misc_count != 1)
+        return false;
+    metadata.m_num_pm4_packets = misc->m_num_pm4_packets;
+
+    if (!LoadCommandHierarchy(reader, metadata.m_command_hierarchy))
+        return false;
+
+    // Shaders are re-created from the capture memory. Their disassembly comes from the
+    // ShaderDisassemblyCache.
+    const CachedShader *shaders = nullptr;
+    uint64_t            num_shaders = 0;
+    if (!reader.GetArray(kShadersSection, shaders, num_shaders))
+        return false;
+    for (uint64_t i = 0; i < num_shaders; ++i)
+    {
+        metadata.m_shaders.emplace_back(mem_manager,
+                                        shaders[i].m_submit_index,
+                                        shaders[i].m_address);
+    }
+
+    if (!reader.ReadArray(kBuffersSection, metadata.m_buffers))
+        return false;
+
+    const CachedEvent     *events = nullptr;
+    const uint32_t        *buffer_indices = nullptr;
+    const ShaderReference *shader_references = nullptr;
+    const char            *str_chars = nullptr;
+    const CachedLogEntry  *log_entries = nullptr;
+    const char            *log_chars = nullptr;
+    uint64_t               num_events = 0, num_buffer_indices = 0, num_shader_references = 0;
+    uint64_t               num_str_chars = 0, num_log_entries = 0, num_log_chars = 0;
+    if (!reader.GetArray(kEventsSection, events, num_events) ||
+        !reader.GetArray(kEventBufferIndicesSection, buffer_indices, num_buffer_indices) ||
+        !reader.GetArray(kEventShaderReferencesSection, shader_references, num_shader_references) ||
+        !reader.GetArray(kEventStrCharsSection, str_chars, num_str_chars) ||
+        !reader.GetArray(kEventLogEntriesSection, log_entries, num_log_entries) ||
+        !reader.GetArray(kEventLogCharsSection, log_chars, num_log_chars))
+        return false;
+
+    // Checks that [begin, end) is a valid range of a section of `count` elements, and advances
+    // `begin` to the start of the next range
+    auto next_range = [](uint64_t &begin, uint64_t end, uint64_t count, uint64_t &range_begin) {
+        if (end < begin || end > count)
+            return false;
+        range_begin = begin;
+        begin = end;
+        return true;
+    };
+
+    metadata.m_event_info.resize(num_events);
+    uint64_t buffer_index = 0, shader_reference_index = 0, str_index = 0, log_entry_index = 0;
+    uint64_t log_char_index = 0;
+    for (uint64_t e = 0; e < num_events; ++e)
+    {
+        const CachedEvent &event = events[e];
+        EventInfo         &event_info = metadata.m_event_info[e];
+        event_info.m_num_indices = event.m_num_indices;
+        event_info.m_submit_index = event.m_submit_index;
+        event_info.m_type = static_cast<EventInfo::EventType>(event.m_type);
+        event_info.m_render_mode = static_cast<RenderModeType>(event.m_render_mode);
+
+        uint64_t begin = 0;
+        for (uint32_t stage = 0; stage < kShaderStageCount; ++stage)
+        {
+            if (!next_range(buffer_index,
+                            event.m_buffer_indices_end[stage],
+                            num_buffer_indices,
+                            begin))
+                return false;
+            event_info.m_buffer_indices[stage].assign(buffer_indices + begin,
+                                                      buffer_indices + buffer_index);
+        }
+        if (!next_range(shader_reference_index,
+                        event.m_shader_references_end,
+                        num_shader_references,
+                        begin))
+            return false;
+        event_info.m_shader_references.assign(shader_references + begin,
+                                              shader_references + shader_reference_index);
+        if (!next_range(str_index, event.m_str_end, num_str_chars, begin))
+            return false;
+        event_info.m_str.assign(str_chars + begin, str_index - begin);
+
+        uint64_t first_log_entry = 0;
+        if (!next_range(log_entry_index, event.m_log_entries_end, num_log_entries, first_log_entry))
+            return false;
+        for (uint64_t i = first_log_entry; i < log_entry_index; ++i)
+        {
+            const CachedLogEntry &cached_entry = log_entries[i];
+            ILog::LogEntry        entry;
+            entry.m_type = static_cast<LogType>(cached_entry.m_type);
+            entry.m_cat = static_cast<LogCategory>(cached_entry.m_category);
+            entry.m_code = static_cast<LogCode>(cached_entry.m_code);
+            entry.m_ref = CrossRef(static_cast<CrossRefType>(cached_entry.m_ref_type),
+                                   cached_entry.m_ref_id);
+            entry.m_line = cached_entry.m_line;
+            if (!next_range(log_char_index, cached_entry.m_file_end, num_log_chars, begin))
+                return false;
+            entry.m_file = InternFileName(std::string(log_chars + begin, log_char_index - begin));
+            if (!next_range(log_char_index, cached_entry.m_short_desc_end, num_log_chars, begin))
+                return false;
+            entry.m_short_desc.assign(log_chars + begin, log_char_index - begin);
+            if (!next_range(log_char_index, cached_entry.m_long_desc_end, num_log_chars, begin))
+                return false;
+            entry.m_long_desc.assign(log_chars + begin, log_char_index - begin);
+            event_info.m_metadata_log.Log(entry);
+        }
+    }
+
+    const uint8_t *event_state_buffer = nullptr;
+    const uint8_t *event_state_is_set_buffer = nullptr;
+    uint64_t       event_state_buffer_size = 0, event_state_is_set_buffer_size = 0;
+    if (!reader.GetArray(kEventStateSection, event_state_buffer, event_state_buffer_size) ||
+        !reader.GetArray(kEventStateIsSetSection,
+                         event_state_is_set_buffer,
+                         event_state_is_set_buffer_size))
+        return false;
+    using EventStateIdType = EventStateInfo::Id::basic_type;
+    if (misc->m_event_state_capacity > std::numeric_limits<EventStateIdType>::max())
+        return false;
+    return metadata.m_event_state
+    .AssignRaw(static_cast<EventStateIdType>(misc->m_event_state_size),
+               static_cast<EventStateIdType>(misc->m_event_state_capacity),
+               event_state_buffer,
+               event_state_buffer_size,
+               event_state_is_set_buffer,
+               event_state_is_set_buffer_size);
+}
+
+}  // namespace Dive
@@ -0,0 +1,92 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Dive
+{
+struct CaptureMetadata;
+class CommandHierarchy;
+class IMemoryManager;
+
+//--------------------------------------------------------------------------------------------------
+// Sidecar file (<capture>.divecache) persisting the result of parsing a pm4 capture: the command
+// hierarchy, the per-event info and state, the buffers and the list of shaders. Reopening a capture
+// with a valid sidecar skips the emulation and the command hierarchy creation. The disassembly of
+// the shaders is persisted separately, by the ShaderDisassemblyCache.
+//
+// The file is a header, a table of sections, and the sections themselves. Each section is a flat
+// array in the in-memory layout of its element type, aligned to kSectionAlignment. Loading reads
+// the whole file into one buffer, then copies each section into the container it is loaded into
+// with a single memcpy, without parsing the elements one by one. The file is not memory-mapped,
+// and the metadata does not point into it. Variable-sized data (strings, per-event lists) is
+// stored as a concatenated array plus an array of end offsets.
+//
+// A sidecar is only used if it was created from a capture with the same content size and hash, by
+// the same build of Dive (its git revision, which covers changes of the parser and of the
+// emulator), and with the same kVersion. Bump kVersion whenever the layout of a persisted type
+// changes, since local builds with uncommitted changes share a revision.
+class AnalysisCache
+{
+public:
+    static constexpr uint32_t kVersion = 2;
+
+    // Identifies the capture a sidecar was created from. The content is hashed by the loader while
+    // it reads the capture (see Pm4CaptureData::SetHashContent), so that it is not read twice.
+    struct CaptureKey
+    {
+        uint64_t m_content_size = 0;
+        uint64_t m_content_hash = 0;
+    };
+
+    // Path of the sidecar of a capture file
+    static std::string GetCacheFileName(const std::string &capture_file_name);
+
+    // Write the metadata of a capture to a sidecar file. The file is written to a temporary file
+    // first and then renamed, so a partially written sidecar is never picked up.
+    static bool Save(const std::string     &cache_file_name,
+                     const CaptureKey      &key,
+                     const CaptureMetadata &metadata);
+
+    // Load the metadata of a capture from a sidecar file. The shaders reference `mem_manager`,
+    // which must be the memory of the capture the sidecar was created from.
+    // Returns false if the sidecar is missing, stale or corrupted, in which case `metadata` is
+    // reset.
+    static bool Load(const std::string    &cache_file_name,
+                     const CaptureKey     &key,
+                     const IMemoryManager &mem_manager,
+                     CaptureMetadata      &metadata);
+
+private:
+    class SectionWriter;
+    class SectionReader;
+
+    // The command hierarchy is private to its creators and to this class
+    static void SaveCommandHierarchy(const CommandHierarchy &command_hierarchy,
+                                     SectionWriter          &writer);
+    static bool LoadCommandHierarchy(const SectionReader &reader,
+                                     CommandHierarchy    &command_hierarchy);
+
+    static bool LoadImpl(const std::string    &cache_file_name,
+                         const CaptureKey     &key,
+                         const IMemoryManager &mem_manager,
+                         CaptureMetadata      &metadata);
+};
+
+}  // namespace Dive
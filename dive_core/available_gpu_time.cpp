@@ -18,6 +18,7 @@
 
 #include <filesystem>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -400,48 +401,40 @@ std::string AvailableGpuTiming::GetCell(int row, int col) const
         return "";
     }
 
+    return FormatCell(static_cast<uint32_t>(row), static_cast<ColumnType>(col));
+}
+
+std::string AvailableGpuTiming::FormatCell(uint32_t row, ColumnType column) const
+{
     std::stringstream ss;
+    const Entry&      entry = m_ordered_entries[row];
+    const Stats&      stats = m_stats[static_cast<uint8_t>(entry.object_type)][entry.per_frame_id];
 
-    if (col < 2)
+    switch (column)
     {
-        // First two columns are type and id
-        const Entry& entry = m_ordered_entries[row];
-
-        if (col == 0)
-        {
-            ss << GetObjectTypeString(entry.object_type);
-            return ss.str();
-        }
-
-        ss << entry.per_frame_id;
+    case ColumnType::kObjectType:
+    {
+        ss << GetObjectTypeString(entry.object_type);
         return ss.str();
     }
-
-    // Offset because QTableView first row (frame info) is index 0
-    auto ret = GetStatsByRow(row + 1);
-    if (!ret.has_value())
+    case ColumnType::kId:
     {
-        std::cerr << "GetStatsByRow() failed, row: " << row << std::endl;
-        return "";
+        ss << entry.per_frame_id;
+        return ss.str();
     }
-    Stats& stats = *ret;
-
-    switch (col)
-    {
-    case 2:
+    case ColumnType::kMeanMs:
     {
         ss << std::setprecision(kDisplayFloatPrecision) << std::fixed << stats.mean_ms;
         return ss.str();
     }
-    case 3:
+    case ColumnType::kMedianMs:
     {
         ss << std::setprecision(kDisplayFloatPrecision) << std::fixed << stats.median_ms;
         return ss.str();
     }
     default:
     {
-        std::cerr << "GetCell() OOB error, col: " << col << " expected: [2-" << (GetColumns() - 1)
-                  << "]" << std::endl;
+        std::cerr << "FormatCell() OOB error, col: " << static_cast<int>(column) << std::endl;
         return "";
     }
     }
@@ -110,7 +110,8 @@ public:
     // Get the header for a specific column
     std::string GetColumnHeader(int col) const;
 
-    // Get the statistic info for a specific cell
+    // Get the statistic info for a specific cell, formatted on each call. GpuTimingModel converts
+    // each cell once per load, rather than on every repaint.
     std::string GetCell(int row, int col) const;
 
     // Get the number of non-header rows in the CSV file
@@ -129,6 +130,9 @@ private:
     // Check m_ordered_entries against info stored in *_stats members
     void Validate();
 
+    // Format the given cell of the table
+    std::string FormatCell(uint32_t row, ColumnType column) const;
+
     // Preserved row order from file
     std::vector<Entry> m_ordered_entries = {};
 
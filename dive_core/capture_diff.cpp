@@ -0,0 +1,671 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "capture_diff.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include "command_hierarchy.h"
+#include "data_core.h"
+#include "dive_core/common/hash_utils.h"
+#include "event_state_fields.h"
+#include "thread_pool.h"
+
+namespace Dive
+{
+
+namespace
+{
+
+// Events of a capture whose signatures are computed by the same task
+constexpr size_t kMinEventsPerChunk = 1024;
+
+// Shaders of an event, by stage, for the binning pass and for the other passes
+constexpr uint32_t kNumShaderSlots = kShaderStageCount * 2;
+
+//--------------------------------------------------------------------------------------------------
+// The scalar fields of EventStateInfo which are compared (see DIVE_EVENT_STATE_SCALAR_FIELDS)
+struct StateField
+{
+    const char *m_name;
+    bool (*m_is_set)(const EventStateInfo &state, EventStateId id);
+    double (*m_value)(const EventStateInfo &state, EventStateId id);
+};
+
+#define DIVE_DIFF_STATE_FIELD(field)                                                               \
+    {                                                                                              \
+        #field,                                                                                    \
+        [](const EventStateInfo &state, EventStateId id) { return state.Is##field##Set(id); },     \
+        [](const EventStateInfo &state, EventStateId id) {                                         \
+            return static_cast<double>(state.field(id));                                           \
+        }                                                                                          \
+    },
+
+const StateField kStateFields[] = { DIVE_EVENT_STATE_SCALAR_FIELDS(DIVE_DIFF_STATE_FIELD) };
+
+#undef DIVE_DIFF_STATE_FIELD
+
+//--------------------------------------------------------------------------------------------------
+// Events of different kinds are never aligned with each other
+enum class EventKind
+{
+    kDraw,
+    kDispatch,
+    kBlit,
+    kResolveOrClear,
+    kSync,
+    kCount
+};
+
+EventKind GetEventKind(EventInfo::EventType type)
+{
+    switch (type)
+    {
+    case EventInfo::EventType::kDraw: return EventKind::kDraw;
+    case EventInfo::EventType::kDispatch: return EventKind::kDispatch;
+    case EventInfo::EventType::kBlit: return EventKind::kBlit;
+    default: return IsResolveOrClear(type) ? EventKind::kResolveOrClear : EventKind::kSync;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+// Index of the shader of each slot of the event, UINT32_MAX for the unused slots
+void GetShaderIndices(const EventInfo &event_info, uint32_t (&shader_indices)[kNumShaderSlots])
+{
+    const uint32_t kBinningMask = static_cast<uint32_t>(ShaderEnableBitMask::kBINNING);
+    std::fill(std::begin(shader_indices), std::end(shader_indices), UINT32_MAX);
+    for (const ShaderReference &ref : event_info.m_shader_references)
+    {
+        bool     binning = (ref.m_enable_mask & kBinningMask) != 0;
+        uint32_t slot = static_cast<uint32_t>(ref.m_stage) * 2 + (binning ? 1 : 0);
+        if (slot < kNumShaderSlots && shader_indices[slot] == UINT32_MAX)
+        {
+            shader_indices[slot] = ref.m_shader_index;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+const Disassembly *GetShader(const CaptureMetadata &meta_data, uint32_t shader_index)
+{
+    return shader_index < meta_data.m_shaders.size() ? &meta_data.m_shaders[shader_index] : nullptr;
+}
+
+//--------------------------------------------------------------------------------------------------
+// What the alignment compares: the type of the event and the content of its shaders
+uint64_t GetEventSignature(const CaptureMetadata &meta_data, uint32_t event_id)
+{
+    const EventInfo &event_info = meta_data.m_event_info[event_id];
+    uint32_t         shader_indices[kNumShaderSlots];
+    GetShaderIndices(event_info, shader_indices);
+
+    HashUtils::ContentHasher hasher;
+    hasher.UpdateValue(static_cast<uint32_t>(event_info.m_type));
+    for (uint32_t slot = 0; slot < kNumShaderSlots; ++slot)
+    {
+        const Disassembly *shader = GetShader(meta_data, shader_indices[slot]);
+        hasher.UpdateValue(shader_indices[slot] == UINT32_MAX);
+        hasher.UpdateValue(shader ? shader->GetContentHash() : 0);
+    }
+    return hasher.Finalize();
+}
+
+//--------------------------------------------------------------------------------------------------
+// Returns whether the 2 aligned events differ, in which case `event_diff` describes how
+bool CompareEvents(const CaptureMetadata &meta_data_a,
+                   uint32_t               event_a,
+                   const CaptureMetadata &meta_data_b,
+                   uint32_t               event_b,
+                   EventDiff             &event_diff)
+{
+    const EventInfo &info_a = meta_data_a.m_event_info[event_a];
+    const EventInfo &info_b = meta_data_b.m_event_info[event_b];
+    event_diff = EventDiff();
+    event_diff.m_event_a = event_a;
+    event_diff.m_event_b = event_b;
+    event_diff.m_type_a = info_a.m_type;
+    event_diff.m_type_b = info_b.m_type;
+    event_diff.m_num_indices_a = info_a.m_num_indices;
+    event_diff.m_num_indices_b = info_b.m_num_indices;
+
+    EventStateId          id_a(event_a);
+    EventStateId          id_b(event_b);
+    const EventStateInfo &state_a = meta_data_a.m_event_state;
+    const EventStateInfo &state_b = meta_data_b.m_event_state;
+    if (state_a.IsValidId(id_a) && state_b.IsValidId(id_b))
+    {
+        for (const StateField &field : kStateFields)
+        {
+            EventStateFieldChange change = { field.m_name,
+                                             field.m_is_set(state_a, id_a),
+                                             field.m_is_set(state_b, id_b),
+                                             0.0,
+                                             0.0 };
+            if (change.m_is_set_a)
+            {
+                change.m_value_a = field.m_value(state_a, id_a);
+            }
+            if (change.m_is_set_b)
+            {
+                change.m_value_b = field.m_value(state_b, id_b);
+            }
+            if (change.m_is_set_a != change.m_is_set_b || change.m_value_a != change.m_value_b)
+            {
+                event_diff.m_state_changes.push_back(change);
+            }
+        }
+    }
+
+    uint32_t shader_indices_a[kNumShaderSlots];
+    uint32_t shader_indices_b[kNumShaderSlots];
+    GetShaderIndices(info_a, shader_indices_a);
+    GetShaderIndices(info_b, shader_indices_b);
+    for (uint32_t slot = 0; slot < kNumShaderSlots; ++slot)
+    {
+        const Disassembly *shader_a = GetShader(meta_data_a, shader_indices_a[slot]);
+        const Disassembly *shader_b = GetShader(meta_data_b, shader_indices_b[slot]);
+        bool               used_a = shader_indices_a[slot] != UINT32_MAX;
+        bool               used_b = shader_indices_b[slot] != UINT32_MAX;
+        uint64_t           hash_a = shader_a ? shader_a->GetContentHash() : 0;
+        uint64_t           hash_b = shader_b ? shader_b->GetContentHash() : 0;
+        if (used_a == used_b && hash_a == hash_b)
+        {
+            continue;
+        }
+        ShaderChange change = {};
+        change.m_stage = static_cast<ShaderStage>(slot / 2);
+        change.m_binning = (slot % 2) != 0;
+        change.m_shader_index_a = shader_indices_a[slot];
+        change.m_shader_index_b = shader_indices_b[slot];
+        change.m_num_instructions_a = shader_a ? shader_a->GetNumInstructions() : 0;
+        change.m_num_instructions_b = shader_b ? shader_b->GetNumInstructions() : 0;
+        change.m_gpr_count_a = shader_a ? shader_a->GetGPRCount() : 0;
+        change.m_gpr_count_b = shader_b ? shader_b->GetGPRCount() : 0;
+        event_diff.m_shader_changes.push_back(change);
+    }
+
+    return info_a.m_type != info_b.m_type || info_a.m_num_indices != info_b.m_num_indices ||
+           !event_diff.m_state_changes.empty() || !event_diff.m_shader_changes.empty();
+}
+
+//--------------------------------------------------------------------------------------------------
+using IndexPairs = std::vector<std::pair<uint32_t, uint32_t>>;
+
+// Longest common subsequence of a[0, n) and b[0, m), with Myers' O((N + M) D) algorithm, where D
+// is the number of insertions and deletions. Appends the index pairs of the common elements to
+// `matches` in order, or returns false if D is over max_d.
+bool FindCommonSubsequence(const uint64_t *a,
+                           int64_t         n,
+                           const uint64_t *b,
+                           int64_t         m,
+                           int64_t         max_d,
+                           IndexPairs     &matches)
+{
+    // v[offset + k] is the furthest x reached on diagonal k = x - y
+    const int64_t        max = std::min(n + m, max_d);
+    const int64_t        offset = max + 1;
+    std::vector<int64_t> v(2 * max + 3, 0);
+
+    // The [-d, d] slice of v before each step d, to backtrack
+    std::vector<std::vector<int64_t>> trace;
+    for (int64_t d = 0; d <= max; ++d)
+    {
+        trace.emplace_back(v.begin() + offset - d, v.begin() + offset + d + 1);
+        for (int64_t k = -d; k <= d; k += 2)
+        {
+            bool    down = k == -d || (k != d && v[offset + k - 1] < v[offset + k + 1]);
+            int64_t x = down ? v[offset + k + 1] : v[offset + k - 1] + 1;
+            int64_t y = x - k;
+            while (x < n && y < m && a[x] == b[y])
+            {
+                ++x;
+                ++y;
+            }
+            v[offset + k] = x;
+            if (x < n || y < m)
+            {
+                continue;
+            }
+
+            size_t first_match = matches.size();
+            for (int64_t step = d; step > 0; --step)
+            {
+                const std::vector<int64_t> &prev = trace[step];
+                int64_t                     cur_k = x - y;
+                bool    prev_down = cur_k == -step ||
+                                 (cur_k != step && prev[cur_k - 1 + step] < prev[cur_k + 1 + step]);
+                int64_t prev_k = prev_down ? cur_k + 1 : cur_k - 1;
+                int64_t prev_x = prev[prev_k + step];
+                int64_t prev_y = prev_x - prev_k;
+                while (x > prev_x && y > prev_y)
+                {
+                    --x;
+                    --y;
+                    matches.emplace_back(static_cast<uint32_t>(x), static_cast<uint32_t>(y));
+                }
+                x = prev_x;
+                y = prev_y;
+            }
+            while (x > 0 && y > 0)
+            {
+                --x;
+                --y;
+                matches.emplace_back(static_cast<uint32_t>(x), static_cast<uint32_t>(y));
+            }
+            std::reverse(matches.begin() + first_match, matches.end());
+            return true;
+        }
+    }
+    return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Events of both captures with the same marker path
+struct MarkerGroup
+{
+    std::vector<uint32_t> m_events_a;
+    std::vector<uint32_t> m_events_b;
+};
+
+struct GroupAlignment
+{
+    IndexPairs            m_aligned;  // Event ids of A and B
+    std::vector<uint32_t> m_removed;
+    std::vector<uint32_t> m_added;
+};
+
+//--------------------------------------------------------------------------------------------------
+// Pair the events of the same kind of a[begin_a, end_a) and b[begin_b, end_b) by position,
+// keeping their order. The others are removed from a and added to b.
+void PairByKind(const std::vector<uint32_t>  &events_a,
+                const std::vector<EventKind> &kinds_a,
+                size_t                        begin_a,
+                size_t                        end_a,
+                const std::vector<uint32_t>  &events_b,
+                const std::vector<EventKind> &kinds_b,
+                size_t                        begin_b,
+                size_t                        end_b,
+                GroupAlignment               &alignment)
+{
+    std::vector<size_t> positions_b[static_cast<size_t>(EventKind::kCount)];
+    for (size_t j = begin_b; j < end_b; ++j)
+    {
+        positions_b[static_cast<size_t>(kinds_b[j])].push_back(j);
+    }
+
+    size_t            next_kind_positions[static_cast<size_t>(EventKind::kCount)] = {};
+    std::vector<bool> paired_b(end_b - begin_b, false);
+    size_t            next_b = begin_b;
+    for (size_t i = begin_a; i < end_a; ++i)
+    {
+        const std::vector<size_t> &positions = positions_b[static_cast<size_t>(kinds_a[i])];
+        size_t                    &next = next_kind_positions[static_cast<size_t>(kinds_a[i])];
+        while (next < positions.size() && positions[next] < next_b)
+        {
+            ++next;
+        }
+        if (next == positions.size())
+        {
+            alignment.m_removed.push_back(events_a[i]);
+            continue;
+        }
+        size_t j = positions[next++];
+        alignment.m_aligned.emplace_back(events_a[i], events_b[j]);
+        paired_b[j - begin_b] = true;
+        next_b = j + 1;
+    }
+    for (size_t j = begin_b; j < end_b; ++j)
+    {
+        if (!paired_b[j - begin_b])
+        {
+            alignment.m_added.push_back(events_b[j]);
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+void AlignGroup(const MarkerGroup            &group,
+                const std::vector<uint64_t>  &signatures_a,
+                const std::vector<uint64_t>  &signatures_b,
+                const std::vector<EventKind> &event_kinds_a,
+                const std::vector<EventKind> &event_kinds_b,
+                uint32_t                      max_edit_distance,
+                GroupAlignment               &alignment)
+{
+    const std::vector<uint32_t> &events_a = group.m_events_a;
+    const std::vector<uint32_t> &events_b = group.m_events_b;
+    size_t                       n = events_a.size();
+    size_t                       m = events_b.size();
+    std::vector<uint64_t>        sigs_a(n), sigs_b(m);
+    std::vector<EventKind>       kinds_a(n), kinds_b(m);
+    for (size_t i = 0; i < n; ++i)
+    {
+        sigs_a[i] = signatures_a[events_a[i]];
+        kinds_a[i] = event_kinds_a[events_a[i]];
+    }
+    for (size_t j = 0; j < m; ++j)
+    {
+        sigs_b[j] = signatures_b[events_b[j]];
+        kinds_b[j] = event_kinds_b[events_b[j]];
+    }
+
+    // Captures of the same workload mostly match, so skip the common prefix and suffix before
+    // looking for the differences
+    size_t prefix = 0;
+    while (prefix < n && prefix < m && sigs_a[prefix] == sigs_b[prefix])
+    {
+        alignment.m_aligned.emplace_back(events_a[prefix], events_b[prefix]);
+        ++prefix;
+    }
+    size_t suffix = 0;
+    while (suffix < n - prefix && suffix < m - prefix &&
+           sigs_a[n - 1 - suffix] == sigs_b[m - 1 - suffix])
+    {
+        alignment.m_aligned.emplace_back(events_a[n - 1 - suffix], events_b[m - 1 - suffix]);
+        ++suffix;
+    }
+
+    // Align the rest on identical events, then pair the events between those by kind. If the
+    // events are too different, only pair them by kind.
+    IndexPairs matches;
+    if (!FindCommonSubsequence(sigs_a.data() + prefix,
+                               static_cast<int64_t>(n - prefix - suffix),
+                               sigs_b.data() + prefix,
+                               static_cast<int64_t>(m - prefix - suffix),
+                               max_edit_distance,
+                               matches))
+    {
+        matches.clear();
+    }
+    size_t prev_a = prefix;
+    size_t prev_b = prefix;
+    for (const auto &match : matches)
+    {
+        size_t i = prefix + match.first;
+        size_t j = prefix + match.second;
+        PairByKind(events_a, kinds_a, prev_a, i, events_b, kinds_b, prev_b, j, alignment);
+        alignment.m_aligned.emplace_back(events_a[i], events_b[j]);
+        prev_a = i + 1;
+        prev_b = j + 1;
+    }
+    PairByKind(events_a,
+               kinds_a,
+               prev_a,
+               n - suffix,
+               events_b,
+               kinds_b,
+               prev_b,
+               m - suffix,
+               alignment);
+}
+
+//--------------------------------------------------------------------------------------------------
+bool ComputeSignatures(const Context          &context,
+                       const CaptureMetadata  &meta_data,
+                       std::vector<uint64_t>  &signatures,
+                       std::vector<EventKind> &kinds)
+{
+    size_t num_events = meta_data.m_event_info.size();
+    signatures.resize(num_events);
+    kinds.resize(num_events);
+    return ParallelFor(ThreadPool::Shared(),
+                       context,
+                       0,
+                       num_events,
+                       kMinEventsPerChunk,
+                       [&](size_t i) {
+                           signatures[i] = GetEventSignature(meta_data, static_cast<uint32_t>(i));
+                           kinds[i] = GetEventKind(meta_data.m_event_info[i].m_type);
+                       });
+}
+
+}  // namespace
+
+//--------------------------------------------------------------------------------------------------
+bool IsResolveOrClear(EventInfo::EventType type)
+{
+    switch (type)
+    {
+    case EventInfo::EventType::kColorSysMemToGmemResolve:
+    case EventInfo::EventType::kColorGmemToSysMemResolve:
+    case EventInfo::EventType::kColorGmemToSysMemResolveAndClear:
+    case EventInfo::EventType::kColorClearGmem:
+    case EventInfo::EventType::kDepthSysMemToGmemResolve:
+    case EventInfo::EventType::kDepthGmemToSysMemResolve:
+    case EventInfo::EventType::kDepthGmemToSysMemResolveAndClear:
+    case EventInfo::EventType::kDepthClearGmem:
+    case EventInfo::EventType::kSysmemToGmemResolve: return true;
+    default: return false;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+std::vector<std::string> GetEventMarkerPaths(const CommandHierarchy &command_hierarchy,
+                                             size_t                  num_events)
+{
+    std::vector<std::string> marker_paths(num_events);
+    if (command_hierarchy.size() == 0)
+    {
+        return marker_paths;
+    }
+
+    // Path of each marker node met so far, so that each one is only built once
+    std::unordered_map<uint64_t, std::string> node_paths;
+    std::vector<uint64_t>                     markers;
+
+    const SharedNodeTopology &topology = command_hierarchy.GetAllEventHierarchyTopology();
+    uint64_t num_nodes = std::min<uint64_t>(topology.GetNumNodes(), command_hierarchy.size());
+    for (uint64_t node_index = 0; node_index < num_nodes; ++node_index)
+    {
+        NodeType node_type = command_hierarchy.GetNodeType(node_index);
+        if (!IsDrawDispatchBlitNode(node_type) && node_type != NodeType::kSyncNode)
+        {
+            continue;
+        }
+        size_t event_index = command_hierarchy.GetEventIndex(node_index);
+        if (event_index == 0 || event_index > num_events)
+        {
+            continue;
+        }
+
+        std::string path;
+        markers.clear();
+        for (uint64_t parent = topology.GetParentNodeIndex(node_index); parent < num_nodes;
+             parent = topology.GetParentNodeIndex(parent))
+        {
+            if (command_hierarchy.GetNodeType(parent) != NodeType::kMarkerNode ||
+                command_hierarchy.GetMarkerNodeType(parent) !=
+                CommandHierarchy::MarkerType::kBeginEnd)
+            {
+                continue;
+            }
+            auto it = node_paths.find(parent);
+            if (it != node_paths.end())
+            {
+                path = it->second;
+                break;
+            }
+            markers.push_back(parent);
+        }
+        for (auto it = markers.rbegin(); it != markers.rend(); ++it)
+        {
+            if (!path.empty())
+            {
+                path += '/';
+            }
+            path += command_hierarchy.GetNodeDesc(*it);
+            node_paths[*it] = path;
+        }
+        marker_paths[event_index - 1] = std::move(path);
+    }
+    return marker_paths;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool DiffCaptures(const Context            &context,
+                  const CaptureMetadata    &meta_data_a,
+                  const CaptureMetadata    &meta_data_b,
+                  const CaptureDiffOptions &options,
+                  CaptureDiff              &diff)
+{
+    return DiffCaptures(context,
+                        meta_data_a,
+                        GetEventMarkerPaths(meta_data_a.m_command_hierarchy,
+                                            meta_data_a.m_event_info.size()),
+                        meta_data_b,
+                        GetEventMarkerPaths(meta_data_b.m_command_hierarchy,
+                                            meta_data_b.m_event_info.size()),
+                        options,
+                        diff);
+}
+
+//--------------------------------------------------------------------------------------------------
+bool DiffCaptures(const Context                  &context,
+                  const CaptureMetadata          &meta_data_a,
+                  const std::vector<std::string> &marker_paths_a,
+                  const CaptureMetadata          &meta_data_b,
+                  const std::vector<std::string> &marker_paths_b,
+                  const CaptureDiffOptions       &options,
+                  CaptureDiff                    &diff)
+{
+    DIVE_ASSERT(marker_paths_a.size() == meta_data_a.m_event_info.size());
+    DIVE_ASSERT(marker_paths_b.size() == meta_data_b.m_event_info.size());
+    diff = CaptureDiff();
+
+    // The shaders are compared by content hash, which needs them disassembled
+    for (const CaptureMetadata *meta_data : { &meta_data_a, &meta_data_b })
+    {
+        const std::deque<Disassembly> &shaders = meta_data->m_shaders;
+        if (!ParallelFor(ThreadPool::Shared(),
+                         context,
+                         0,
+                         shaders.size(),
+                         1,
+                         [&shaders](size_t i) { shaders[i].EagerEval(); }))
+        {
+            return false;
+        }
+    }
+
+    std::vector<uint64_t>  signatures_a, signatures_b;
+    std::vector<EventKind> kinds_a, kinds_b;
+    if (!ComputeSignatures(context, meta_data_a, signatures_a, kinds_a) ||
+        !ComputeSignatures(context, meta_data_b, signatures_b, kinds_b))
+    {
+        return false;
+    }
+
+    // Group the events by marker path, in order of first appearance
+    std::vector<MarkerGroup>                       groups;
+    std::unordered_map<std::string_view, uint32_t> group_indices;
+    auto get_group = [&](const std::string &marker_path) -> MarkerGroup & {
+        auto it = group_indices.emplace(marker_path, static_cast<uint32_t>(groups.size())).first;
+        if (it->second == groups.size())
+        {
+            groups.emplace_back();
+        }
+        return groups[it->second];
+    };
+    for (size_t i = 0; i < marker_paths_a.size(); ++i)
+    {
+        get_group(marker_paths_a[i]).m_events_a.push_back(static_cast<uint32_t>(i));
+    }
+    for (size_t i = 0; i < marker_paths_b.size(); ++i)
+    {
+        get_group(marker_paths_b[i]).m_events_b.push_back(static_cast<uint32_t>(i));
+    }
+
+    // The groups are independent
+    struct GroupResult
+    {
+        GroupAlignment         m_alignment;
+        std::vector<EventDiff> m_changed_events;
+    };
+    std::vector<GroupResult> results(groups.size());
+    if (!ParallelFor(ThreadPool::Shared(), context, 0, groups.size(), 1, [&](size_t g) {
+            GroupResult &result = results[g];
+            AlignGroup(groups[g],
+                       signatures_a,
+                       signatures_b,
+                       kinds_a,
+                       kinds_b,
+                       options.m_max_edit_distance,
+                       result.m_alignment);
+            for (const auto &aligned : result.m_alignment.m_aligned)
+            {
+                EventDiff event_diff;
+                if (CompareEvents(meta_data_a,
+                                  aligned.first,
+                                  meta_data_b,
+                                  aligned.second,
+                                  event_diff))
+                {
+                    result.m_changed_events.push_back(std::move(event_diff));
+                }
+            }
+        }))
+    {
+        return false;
+    }
+
+    for (GroupResult &result : results)
+    {
+        diff.m_num_aligned_events += static_cast<uint32_t>(result.m_alignment.m_aligned.size());
+        std::move(result.m_changed_events.begin(),
+                  result.m_changed_events.end(),
+                  std::back_inserter(diff.m_changed_events));
+        diff.m_removed_events.insert(diff.m_removed_events.end(),
+                                     result.m_alignment.m_removed.begin(),
+                                     result.m_alignment.m_removed.end());
+        diff.m_added_events.insert(diff.m_added_events.end(),
+                                   result.m_alignment.m_added.begin(),
+                                   result.m_alignment.m_added.end());
+    }
+    std::sort(diff.m_changed_events.begin(),
+              diff.m_changed_events.end(),
+              [](const EventDiff &lhs, const EventDiff &rhs) {
+                  return lhs.m_event_a < rhs.m_event_a;
+              });
+    std::sort(diff.m_removed_events.begin(), diff.m_removed_events.end());
+    std::sort(diff.m_added_events.begin(), diff.m_added_events.end());
+
+    constexpr size_t kNumEventTypes = static_cast<size_t>(EventInfo::EventType::kEventWriteEnd) + 1;
+    uint32_t         counts_a[kNumEventTypes] = {};
+    uint32_t         counts_b[kNumEventTypes] = {};
+    for (const EventInfo &event_info : meta_data_a.m_event_info)
+    {
+        ++counts_a[static_cast<uint32_t>(event_info.m_type)];
+    }
+    for (const EventInfo &event_info : meta_data_b.m_event_info)
+    {
+        ++counts_b[static_cast<uint32_t>(event_info.m_type)];
+    }
+    for (size_t type = 0; type < kNumEventTypes; ++type)
+    {
+        if (counts_a[type] != counts_b[type])
+        {
+            diff.m_type_count_changes.push_back(
+            { static_cast<EventInfo::EventType>(type), counts_a[type], counts_b[type] });
+        }
+    }
+    return true;
+}
+
+}  // namespace Dive
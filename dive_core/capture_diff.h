@@ -0,0 +1,135 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "capture_event_info.h"
+#include "context.h"
+
+namespace Dive
+{
+class CommandHierarchy;
+struct CaptureMetadata;
+
+//--------------------------------------------------------------------------------------------------
+// Comparison of two captures of the same workload, e.g. before and after a driver or app change.
+//
+// The events are first grouped by marker path (the names of the debug markers they are nested in),
+// then the events of each group are aligned in order, on their type and the content hashes of
+// their shaders. Left-over events of the same kind between two aligned events are paired by
+// position (e.g. a draw whose shader changed), and the rest are reported as added or removed.
+struct CaptureDiffOptions
+{
+    // Max number of added + removed events the alignment of a marker path looks for. Beyond that,
+    // the events of the path are paired by position, which keeps the cost linear when two
+    // captures have little in common.
+    uint32_t m_max_edit_distance = 1024;
+};
+
+struct EventStateFieldChange
+{
+    const char *m_field;  // Name of the EventStateInfo field
+    bool        m_is_set_a;
+    bool        m_is_set_b;
+    double      m_value_a;
+    double      m_value_b;
+};
+
+struct ShaderChange
+{
+    ShaderStage m_stage;
+    bool        m_binning;
+
+    // UINT32_MAX if the event has no shader for this stage in that capture
+    uint32_t m_shader_index_a;
+    uint32_t m_shader_index_b;
+    uint64_t m_num_instructions_a;
+    uint64_t m_num_instructions_b;
+    uint32_t m_gpr_count_a;
+    uint32_t m_gpr_count_b;
+};
+
+// An event of capture A aligned with an event of capture B, which differ
+struct EventDiff
+{
+    uint32_t             m_event_a;
+    uint32_t             m_event_b;
+    EventInfo::EventType m_type_a;
+    EventInfo::EventType m_type_b;
+    uint32_t             m_num_indices_a;
+    uint32_t             m_num_indices_b;
+
+    std::vector<EventStateFieldChange> m_state_changes;
+    std::vector<ShaderChange>          m_shader_changes;
+};
+
+struct EventTypeCountChange
+{
+    EventInfo::EventType m_type;
+    uint32_t             m_count_a;
+    uint32_t             m_count_b;
+};
+
+struct CaptureDiff
+{
+    // Number of events aligned between the 2 captures, including the ones without differences
+    uint32_t m_num_aligned_events = 0;
+
+    // Aligned events with different types, index counts, state or shaders, by event of A
+    std::vector<EventDiff> m_changed_events;
+
+    // Events only in A, and only in B, sorted
+    std::vector<uint32_t> m_removed_events;
+    std::vector<uint32_t> m_added_events;
+
+    // Event types (e.g. resolves and clears) whose number differs between the 2 captures
+    std::vector<EventTypeCountChange> m_type_count_changes;
+
+    bool HasDifferences() const
+    {
+        return !m_changed_events.empty() || !m_removed_events.empty() || !m_added_events.empty();
+    }
+};
+
+// Whether the event is a GMEM resolve or clear
+bool IsResolveOrClear(EventInfo::EventType type);
+
+// Marker path of each event, e.g. "Frame/Shadows/Cascade 0". Only begin/end debug markers are
+// part of the path. Empty for the events outside of any marker.
+std::vector<std::string> GetEventMarkerPaths(const CommandHierarchy &command_hierarchy,
+                                             size_t                  num_events);
+
+// Compare capture A with capture B. Returns false if cancelled.
+bool DiffCaptures(const Context            &context,
+                  const CaptureMetadata    &meta_data_a,
+                  const CaptureMetadata    &meta_data_b,
+                  const CaptureDiffOptions &options,
+                  CaptureDiff              &diff);
+
+// Same, with the marker path of each event given (one per event of each capture)
+bool DiffCaptures(const Context                  &context,
+                  const CaptureMetadata          &meta_data_a,
+                  const std::vector<std::string> &marker_paths_a,
+                  const CaptureMetadata          &meta_data_b,
+                  const std::vector<std::string> &marker_paths_b,
+                  const CaptureDiffOptions       &options,
+                  CaptureDiff                    &diff);
+
+}  // namespace Dive
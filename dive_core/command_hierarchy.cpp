@@ -34,6 +34,14 @@
 namespace Dive
 {
 
+namespace
+{
+template<typename T> uint64_t GetVectorMemoryUsage(const DiveVector<T> &vector)
+{
+    return vector.capacity() * sizeof(T);
+}
+}  // namespace
+
 // =================================================================================================
 // Topology
 // =================================================================================================
@@ -90,6 +98,13 @@ uint64_t Topology::GetNextNodeIndex(uint64_t node_index) const
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+uint64_t Topology::GetMemoryUsage() const
+{
+    return GetVectorMemoryUsage(m_children_list) + GetVectorMemoryUsage(m_node_children) +
+           GetVectorMemoryUsage(m_node_parent) + GetVectorMemoryUsage(m_node_child_index);
+}
+
 //--------------------------------------------------------------------------------------------------
 void Topology::SetNumNodes(uint64_t num_nodes)
 {
@@ -179,6 +194,15 @@ uint64_t SharedNodeTopology::GetSharedChildRootNodeIndex(uint64_t node_index) co
     return m_root_node_index[node_index];
 }
 
+//--------------------------------------------------------------------------------------------------
+uint64_t SharedNodeTopology::GetMemoryUsage() const
+{
+    return Topology::GetMemoryUsage() + GetVectorMemoryUsage(m_shared_children_indices) +
+           GetVectorMemoryUsage(m_node_shared_children) +
+           GetVectorMemoryUsage(m_start_shared_child) + GetVectorMemoryUsage(m_end_shared_child) +
+           GetVectorMemoryUsage(m_root_node_index);
+}
+
 //--------------------------------------------------------------------------------------------------
 void SharedNodeTopology::SetNumNodes(uint64_t num_nodes)
 {
@@ -375,6 +399,22 @@ SyncInfo CommandHierarchy::GetSyncNodeSyncInfo(uint64_t node_index) const
     return info.sync_node.m_sync_info;
 }
 
+//--------------------------------------------------------------------------------------------------
+uint64_t CommandHierarchy::GetGfxrCommandNodeArgsOffset(uint64_t node_index) const
+{
+    DIVE_ASSERT(node_index < m_nodes.m_aux_info.size());
+    DIVE_ASSERT(IsGfxrVulkanCommandNode(m_nodes.m_node_type[node_index]));
+    const AuxInfo &info = m_nodes.m_aux_info[node_index];
+    return info.gfxr_command_node.m_args_offset;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool CommandHierarchy::HasGfxrCommandArgs(uint64_t node_index) const
+{
+    DIVE_ASSERT(node_index < m_nodes.m_node_type.size());
+    return m_gfxr_arg_arena != nullptr && IsGfxrVulkanCommandNode(m_nodes.m_node_type[node_index]);
+}
+
 //--------------------------------------------------------------------------------------------------
 uint64_t CommandHierarchy::AddNode(NodeType type, std::string &&desc, AuxInfo aux_info)
 {
@@ -382,9 +422,109 @@ uint64_t CommandHierarchy::AddNode(NodeType type, std::string &&desc, AuxInfo au
 }
 
 //--------------------------------------------------------------------------------------------------
-uint64_t CommandHierarchy::AddGfxrNode(NodeType type, std::string &&desc)
+uint64_t CommandHierarchy::AddGfxrNode(NodeType type, std::string &&desc, AuxInfo aux_info)
+{
+    return m_nodes.AddGfxrNode(type, std::move(desc), aux_info);
+}
+
+//--------------------------------------------------------------------------------------------------
+std::vector<uint64_t> CommandHierarchy::GetFilterExcludeIndices(FilterListType filter_type) const
+{
+    const std::vector<bool> &exclude_bits = m_filter_exclude_bits[filter_type];
+    std::vector<uint64_t>    indices;
+    for (uint64_t node_index = 0; node_index < exclude_bits.size(); ++node_index)
+    {
+        if (exclude_bits[node_index])
+        {
+            indices.push_back(node_index);
+        }
+    }
+    return indices;
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t CommandHierarchy::GetMemoryUsage() const
+{
+    uint64_t memory_usage = GetVectorMemoryUsage(m_nodes.m_node_type) +
+                            GetVectorMemoryUsage(m_nodes.m_description) +
+                            GetVectorMemoryUsage(m_nodes.m_aux_info) +
+                            GetVectorMemoryUsage(m_nodes.m_event_node_indices);
+    // Short descriptions are stored inline (small string optimization), so this overestimates
+    for (const std::string &description : m_nodes.m_description)
+    {
+        memory_usage += description.capacity();
+    }
+    for (const std::vector<bool> &exclude_bits : m_filter_exclude_bits)
+    {
+        memory_usage += exclude_bits.capacity() / 8;
+    }
+    for (const SharedNodeTopology &topology : m_topology)
+    {
+        memory_usage += topology.GetMemoryUsage();
+    }
+    return memory_usage;
+}
+
+//--------------------------------------------------------------------------------------------------
+CommandHierarchy::FilteredTopology CommandHierarchy::ComputeFilteredTopology(
+const Topology &topology,
+FilterListType  filter_type) const
 {
-    return m_nodes.AddGfxrNode(type, std::move(desc));
+    FilteredTopology filtered;
+    uint64_t         num_nodes = topology.GetNumNodes();
+    filtered.m_num_children.resize(num_nodes, 0);
+    if (num_nodes == 0)
+    {
+        return filtered;
+    }
+
+    auto is_hidden = [&](uint64_t node_index) {
+        return GetNodeType(node_index) == NodeType::kGfxrVulkanSubmitNode ||
+               (filter_type != kFilterListTypeCount && IsFilterExcluded(node_index, filter_type));
+    };
+
+    // Depth-first, children in order, like a recursive walk of a tree view. The hidden draw/dispatch
+    // nodes are visited for m_draw_call_indices, but not counted or expanded.
+    struct StackEntry
+    {
+        uint64_t m_node_index;
+        bool     m_hidden;
+    };
+    std::vector<StackEntry> stack = { { Topology::kRootNodeIndex, false } };
+    while (!stack.empty())
+    {
+        StackEntry entry = stack.back();
+        stack.pop_back();
+        uint64_t node_index = entry.m_node_index;
+        if (node_index != Topology::kRootNodeIndex && IsDrawDispatchNode(GetNodeType(node_index)))
+        {
+            filtered.m_draw_call_indices.push_back(node_index);
+        }
+        if (entry.m_hidden)
+        {
+            continue;
+        }
+
+        uint64_t num_children = topology.GetNumChildren(node_index);
+        size_t   first_child = stack.size();
+        uint32_t num_shown_children = 0;
+        for (uint64_t child = 0; child < num_children; ++child)
+        {
+            uint64_t child_node_index = topology.GetChildNodeIndex(node_index, child);
+            if (!is_hidden(child_node_index))
+            {
+                stack.push_back({ child_node_index, false });
+                ++num_shown_children;
+            }
+            else if (IsDrawDispatchNode(GetNodeType(child_node_index)))
+            {
+                stack.push_back({ child_node_index, true });
+            }
+        }
+        filtered.m_num_children[node_index] = num_shown_children;
+        std::reverse(stack.begin() + first_child, stack.end());
+    }
+    return filtered;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -414,15 +554,15 @@ uint64_t CommandHierarchy::Nodes::AddNode(NodeType type, std::string &&desc, Aux
 }
 
 //--------------------------------------------------------------------------------------------------
-uint64_t CommandHierarchy::Nodes::AddGfxrNode(NodeType type, std::string &&desc)
+uint64_t CommandHierarchy::Nodes::AddGfxrNode(NodeType type, std::string &&desc, AuxInfo aux_info)
 {
     DIVE_ASSERT(m_node_type.size() == m_description.size());
 
     m_node_type.push_back(type);
     m_description.push_back(std::move(desc));
-    // Adds a dummy AuxInfo object to ensure the m_node_type, m_description, and m_aux_info sizes
-    // stay the same.
-    m_aux_info.push_back(AuxInfo(0));
+    // Only vulkan command nodes have a meaningful AuxInfo, the others get a dummy one to ensure
+    // the m_node_type, m_description, and m_aux_info sizes stay the same.
+    m_aux_info.push_back(aux_info);
     return m_node_type.size() - 1;
 }
 
@@ -508,6 +648,14 @@ CommandHierarchy::AuxInfo CommandHierarchy::AuxInfo::SyncNode(SyncType type, Syn
     return info;
 }
 
+//--------------------------------------------------------------------------------------------------
+CommandHierarchy::AuxInfo CommandHierarchy::AuxInfo::GfxrCommandNode(uint64_t args_offset)
+{
+    AuxInfo info(0);
+    info.gfxr_command_node.m_args_offset = args_offset;
+    return info;
+}
+
 // =================================================================================================
 // CommandHierarchyCreator
 // =================================================================================================
@@ -699,8 +847,7 @@ bool CommandHierarchyCreator::CreateTrees(EngineType             engine_type,
         }
         virtual bool IsValid(uint32_t submit_index, uint64_t addr, uint64_t size) const
         {
-            DIVE_ASSERT(false);
-            return true;
+            return (addr + size) <= (m_size_in_dwords * sizeof(uint32_t));
         }
 
     private:
@@ -725,10 +872,10 @@ bool CommandHierarchyCreator::CreateTrees(EngineType             engine_type,
     ib_info.m_skip = false;
     DiveVector<IndirectBufferInfo> ib_array;
     ib_array.push_back(ib_info);
-    const Dive::SubmitInfo submit_info(engine_type, queue_type, 0, false, std::move(ib_array));
-
-    DiveVector<SubmitInfo> submits{ submit_info };
-    TempMemoryManager      mem_manager(command_dwords, size_in_dwords);
+    // Not DiveVector's initializer list constructor, which copy-assigns into unconstructed elements
+    DiveVector<SubmitInfo> submits;
+    submits.push_back(SubmitInfo(engine_type, queue_type, 0, false, std::move(ib_array)));
+    TempMemoryManager mem_manager(command_dwords, size_in_dwords);
     if (!ProcessSubmits(submits, mem_manager))
     {
         return false;
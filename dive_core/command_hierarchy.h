@@ -20,6 +20,7 @@
 // =====================================================================================================================
 
 #pragma once
+#include <memory>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -36,6 +37,7 @@
 // Forward declarations
 struct PacketInfo;
 struct RegInfo;
+class DiveArgArena;
 
 namespace Dive
 {
@@ -86,6 +88,18 @@ constexpr bool IsDrawDispatchBlitNode(NodeType node_type)
     return node_type == NodeType::kDrawDispatchNode || node_type == NodeType::kBlitNode;
 }
 
+// Gfxr nodes created from a vulkan command, which have arguments
+constexpr bool IsGfxrVulkanCommandNode(NodeType node_type)
+{
+    return node_type == NodeType::kGfxrVulkanBeginCommandBufferNode ||
+           node_type == NodeType::kGfxrVulkanEndCommandBufferNode ||
+           node_type == NodeType::kGfxrVulkanCommandNode ||
+           node_type == NodeType::kGfxrVulkanDrawCommandNode ||
+           node_type == NodeType::kGfxrVulkanBeginRenderPassCommandNode ||
+           node_type == NodeType::kGfxrVulkanEndRenderPassCommandNode ||
+           node_type == NodeType::kGfxrBeginDebugUtilsLabelCommandNode;
+}
+
 //--------------------------------------------------------------------------------------------------
 // This is per-node graph topology info.
 class Topology
@@ -106,6 +120,14 @@ public:
     uint64_t GetChildNodeIndex(uint64_t node_index, uint64_t child_index) const;
     uint64_t GetNextNodeIndex(uint64_t node_index) const;
 
+    // Parent node-index and child index of all the nodes, GetNumNodes() elements each, for bulk
+    // access (e.g. the python bindings)
+    const uint64_t *GetParentNodeIndices() const { return m_node_parent.data(); }
+    const uint64_t *GetChildIndices() const { return m_node_child_index.data(); }
+
+    // Approximate heap memory used, in bytes
+    virtual uint64_t GetMemoryUsage() const;
+
 protected:
     struct ChildrenInfo
     {
@@ -144,6 +166,7 @@ private:
     friend class CommandHierarchy;
     friend class GfxrVulkanCommandHierarchyCreator;
     friend class DiveCommandHierarchyCreator;
+    friend class AnalysisCache;
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -170,10 +193,13 @@ public:
     // This returns that common root top level node
     uint64_t GetSharedChildRootNodeIndex(uint64_t node_index) const;
 
+    uint64_t GetMemoryUsage() const override;
+
 private:
     friend class CommandHierarchy;
     friend class CommandHierarchyCreator;
     friend class DiveCommandHierarchyCreator;
+    friend class AnalysisCache;
 
     // List of all children for shared nodes.
 
@@ -268,6 +294,12 @@ public:
     CommandHierarchy();
     ~CommandHierarchy();
 
+    // Moved along with the CaptureMetadata it is part of, e.g. by DataCore::SetCaptureMetadata()
+    CommandHierarchy(const CommandHierarchy &) = default;
+    CommandHierarchy(CommandHierarchy &&) = default;
+    CommandHierarchy &operator=(const CommandHierarchy &) = default;
+    CommandHierarchy &operator=(CommandHierarchy &&) = default;
+
     inline size_t size() const { return m_nodes.m_node_type.size(); }
 
     // The topologies are layed out such that the "normal" children contain non-packet nodes
@@ -298,10 +330,24 @@ public:
     bool             GetRegFieldNodeIsCe(uint64_t node_index) const;
     SyncType         GetSyncNodeSyncType(uint64_t node_index) const;
     SyncInfo         GetSyncNodeSyncInfo(uint64_t node_index) const;
+    uint64_t         GetGfxrCommandNodeArgsOffset(uint64_t node_index) const;
+
+    // Whether the arguments of a gfxr vulkan command node are available. To keep large gfxr
+    // captures cheap, the kGfxrVulkanCommandArgNode nodes are not part of this hierarchy: only a
+    // reference to the arguments is kept per command, and
+    // GfxrVulkanCommandHierarchyCreator::CreateArgTrees() creates the nodes of a single command
+    // when it is inspected.
+    bool HasGfxrCommandArgs(uint64_t node_index) const;
 
     // GetEventIndex returns sequence number for Event/Sync Nodes, 0 if not exist.
     size_t GetEventIndex(uint64_t node_index) const;
 
+    // Type of all the nodes, size() elements
+    const NodeType *GetNodeTypes() const { return m_nodes.m_node_type.data(); }
+
+    // Node-index of each event, sorted. GetEventIndex() is the position in it, plus 1.
+    const DiveVector<uint64_t> &GetEventNodeIndices() const { return m_nodes.m_event_node_indices; }
+
     // For kBinningPassOnly
     // - Keep Binning Pass
     // - Exclude all Tile&Resolve Passes (0 - N)
@@ -321,15 +367,41 @@ public:
         kFilterListTypeCount
     };
 
-    const std::unordered_set<uint64_t> &GetFilterExcludeIndices(FilterListType filter_type) const
+    // Whether the node (and so its descendants) is hidden by the filter
+    bool IsFilterExcluded(uint64_t node_index, FilterListType filter_type) const
     {
-        return m_filter_exclude_indices_list[filter_type];
+        const std::vector<bool> &exclude_bits = m_filter_exclude_bits[filter_type];
+        return node_index < exclude_bits.size() && exclude_bits[node_index];
     }
 
+    // Excluded nodes of the filter, in increasing order
+    std::vector<uint64_t> GetFilterExcludeIndices(FilterListType filter_type) const;
+
+    // Approximate heap memory used by the nodes and topologies, in bytes
+    uint64_t GetMemoryUsage() const;
+
+    // What a filter leaves of the "normal" children of a topology. The excluded nodes are hidden
+    // with their descendants, as are the kGfxrVulkanSubmitNodes, which only group the vulkan
+    // commands of a mixed capture.
+    struct FilteredTopology
+    {
+        // Number of the children left of each node of the topology
+        std::vector<uint32_t> m_num_children;
+        // Draw/dispatch nodes whose parent is left, in depth-first order. Excluded draw/dispatch
+        // nodes are kept, so that the position of a draw does not depend on the filter: the
+        // positions are correlated with the draw calls of the GFXR capture.
+        std::vector<uint64_t> m_draw_call_indices;
+    };
+
+    // kFilterListTypeCount only hides the kGfxrVulkanSubmitNodes
+    FilteredTopology ComputeFilteredTopology(const Topology &topology,
+                                             FilterListType  filter_type) const;
+
 private:
     friend class CommandHierarchyCreator;
     friend class GfxrVulkanCommandHierarchyCreator;
     friend class DiveCommandHierarchyCreator;
+    friend class AnalysisCache;
 
     enum TopologyType
     {
@@ -389,6 +461,11 @@ private:
             SyncInfo m_sync_info;
         } sync_node;
 
+        struct
+        {
+            uint64_t m_args_offset;  // Offset of the arguments in the DiveArgArena of the capture
+        } gfxr_command_node;
+
         uint64_t m_u64All;
 
         AuxInfo(uint64_t val);
@@ -402,6 +479,7 @@ private:
         static AuxInfo EventNode(uint32_t event_id);
         static AuxInfo MarkerNode(MarkerType type, uint32_t id = 0);
         static AuxInfo SyncNode(SyncType type, SyncInfo sync_info);
+        static AuxInfo GfxrCommandNode(uint64_t args_offset);
     };
     static_assert(sizeof(AuxInfo) == sizeof(uint64_t), "Unexpected size!");
 
@@ -415,21 +493,31 @@ private:
         DiveVector<uint64_t>    m_event_node_indices;
 
         uint64_t AddNode(NodeType type, std::string &&desc, AuxInfo aux_info);
-        uint64_t AddGfxrNode(NodeType type, std::string &&desc);
+        uint64_t AddGfxrNode(NodeType type, std::string &&desc, AuxInfo aux_info);
     };
 
     // Add a node and returns index of the added node
     uint64_t AddNode(NodeType type, std::string &&desc, AuxInfo aux_info);
     // Add a gfxr node and returns index of the added node
-    uint64_t AddGfxrNode(NodeType type, std::string &&desc);
+    uint64_t AddGfxrNode(NodeType type, std::string &&desc, AuxInfo aux_info = 0);
     void     AddToFilterExcludeIndexList(uint64_t index, FilterListType filter_mode)
     {
-        m_filter_exclude_indices_list[filter_mode].insert(index);
+        std::vector<bool> &exclude_bits = m_filter_exclude_bits[filter_mode];
+        if (index >= exclude_bits.size())
+        {
+            exclude_bits.resize(index + 1, false);
+        }
+        exclude_bits[index] = true;
     }
 
-    Nodes                        m_nodes;
-    std::unordered_set<uint64_t> m_filter_exclude_indices_list[kFilterListTypeCount];
-    SharedNodeTopology           m_topology[kTopologyTypeCount];
+    Nodes              m_nodes;
+    // Dense bitsets of the nodes excluded by each filter, so that a filtered view checks a row
+    // without hashing. They only extend to the last excluded node.
+    std::vector<bool>  m_filter_exclude_bits[kFilterListTypeCount];
+    SharedNodeTopology m_topology[kTopologyTypeCount];
+
+    // Arguments of the gfxr vulkan command nodes, see HasGfxrCommandArgs()
+    std::shared_ptr<const DiveArgArena> m_gfxr_arg_arena;
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -0,0 +1,409 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "command_hierarchy_search_index.h"
+
+#include <algorithm>
+#include <iterator>
+#include <regex>
+#include <unordered_map>
+
+#include "command_hierarchy.h"
+#include "dive_core/common/common.h"
+#include "thread_pool.h"
+
+namespace Dive
+{
+
+namespace
+{
+
+// Descriptions are short, so a chunk needs many of them to be worth a task
+constexpr size_t kMinStringsPerChunk = 4096;
+
+// How often the interning loop checks for cancellation
+constexpr uint64_t kCancellationCheckInterval = 1 << 16;
+
+inline char ToLower(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+std::string ToLower(std::string_view text)
+{
+    std::string lower(text);
+    for (char &c : lower)
+    {
+        c = ToLower(c);
+    }
+    return lower;
+}
+
+inline uint32_t LowerByte(char c)
+{
+    return static_cast<uint8_t>(ToLower(c));
+}
+
+// Sorted, distinct trigrams of the lowercased `text`
+void GetTrigrams(std::string_view text, std::vector<uint32_t> &trigrams)
+{
+    trigrams.clear();
+    for (size_t i = 0; i + 3 <= text.size(); ++i)
+    {
+        trigrams.push_back((LowerByte(text[i]) << 16) | (LowerByte(text[i + 1]) << 8) |
+                           LowerByte(text[i + 2]));
+    }
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+}
+
+// `lower_text` must be lowercased if the search is not case sensitive
+bool ContainsText(std::string_view string, std::string_view lower_text, bool case_sensitive)
+{
+    if (case_sensitive)
+    {
+        return string.find(lower_text) != std::string_view::npos;
+    }
+    return std::search(string.begin(),
+                       string.end(),
+                       lower_text.begin(),
+                       lower_text.end(),
+                       [](char a, char b) { return ToLower(a) == b; }) != string.end();
+}
+
+// Ids get_id(i), for i in [0, count), of the strings for which matches(string) is true, in order
+template<typename GetId, typename Matches>
+std::vector<uint32_t> FilterStrings(const std::vector<std::string_view> &strings,
+                                    size_t                               count,
+                                    GetId                              &&get_id,
+                                    Matches                            &&matches)
+{
+    ThreadPool                        &pool = ThreadPool::Shared();
+    std::vector<std::vector<uint32_t>> chunk_ids(
+    ParallelForNumChunks(pool, count, kMinStringsPerChunk));
+    ParallelForChunks(pool,
+                      Context::Background(),
+                      0,
+                      count,
+                      kMinStringsPerChunk,
+                      [&](size_t chunk, size_t begin, size_t end) {
+                          for (size_t i = begin; i < end; ++i)
+                          {
+                              uint32_t id = get_id(i);
+                              if (matches(strings[id]))
+                              {
+                                  chunk_ids[chunk].push_back(id);
+                              }
+                          }
+                      });
+
+    std::vector<uint32_t> ids;
+    for (const std::vector<uint32_t> &chunk : chunk_ids)
+    {
+        ids.insert(ids.end(), chunk.begin(), chunk.end());
+    }
+    return ids;
+}
+
+}  // namespace
+
+//--------------------------------------------------------------------------------------------------
+bool CommandHierarchySearchIndex::Build(const CommandHierarchy &command_hierarchy,
+                                        const Context          &context)
+{
+    *this = CommandHierarchySearchIndex();
+
+    uint64_t num_nodes = command_hierarchy.size();
+    DIVE_ASSERT(num_nodes <= UINT32_MAX);
+
+    // Intern the descriptions
+    std::vector<std::string_view> strings;
+    std::vector<uint32_t>         node_string_ids(num_nodes);
+    {
+        std::unordered_map<std::string_view, uint32_t> string_ids;
+        for (uint64_t node_index = 0; node_index < num_nodes; ++node_index)
+        {
+            if ((node_index % kCancellationCheckInterval) == 0 && context.Cancelled())
+            {
+                return false;
+            }
+            std::string_view desc = command_hierarchy.GetNodeDesc(node_index);
+            uint32_t         string_id = static_cast<uint32_t>(strings.size());
+            auto [it, inserted] = string_ids.try_emplace(desc, string_id);
+            if (inserted)
+            {
+                strings.push_back(desc);
+            }
+            node_string_ids[node_index] = it->second;
+        }
+    }
+
+    // Nodes of each string, in increasing order
+    std::vector<uint32_t> string_node_offsets(strings.size() + 1, 0);
+    for (uint32_t string_id : node_string_ids)
+    {
+        ++string_node_offsets[string_id + 1];
+    }
+    for (size_t i = 1; i < string_node_offsets.size(); ++i)
+    {
+        string_node_offsets[i] += string_node_offsets[i - 1];
+    }
+    std::vector<uint32_t> string_nodes(num_nodes);
+    {
+        std::vector<uint32_t> cursors(string_node_offsets.begin(), string_node_offsets.end() - 1);
+        for (uint64_t node_index = 0; node_index < num_nodes; ++node_index)
+        {
+            uint32_t &cursor = cursors[node_string_ids[node_index]];
+            string_nodes[cursor++] = static_cast<uint32_t>(node_index);
+        }
+    }
+
+    // (trigram, string id) pairs of the strings, in parallel
+    ThreadPool                        &pool = ThreadPool::Shared();
+    std::vector<std::vector<uint64_t>> chunk_entries(
+    ParallelForNumChunks(pool, strings.size(), kMinStringsPerChunk));
+    bool completed = ParallelForChunks(pool,
+                                       context,
+                                       0,
+                                       strings.size(),
+                                       kMinStringsPerChunk,
+                                       [&](size_t chunk, size_t begin, size_t end) {
+                                           std::vector<uint32_t> trigrams;
+                                           for (size_t id = begin; id < end; ++id)
+                                           {
+                                               GetTrigrams(strings[id], trigrams);
+                                               for (uint32_t trigram : trigrams)
+                                               {
+                                                   chunk_entries[chunk].push_back(
+                                                   (static_cast<uint64_t>(trigram) << 32) | id);
+                                               }
+                                           }
+                                       });
+    if (!completed)
+    {
+        return false;
+    }
+
+    size_t num_entries = 0;
+    for (const std::vector<uint64_t> &entries : chunk_entries)
+    {
+        num_entries += entries.size();
+    }
+    std::vector<uint64_t> entries;
+    entries.reserve(num_entries);
+    for (std::vector<uint64_t> &chunk : chunk_entries)
+    {
+        entries.insert(entries.end(), chunk.begin(), chunk.end());
+        chunk = std::vector<uint64_t>();
+    }
+    std::sort(entries.begin(), entries.end());
+    if (context.Cancelled())
+    {
+        return false;
+    }
+
+    // Posting lists of the trigrams
+    m_trigram_strings.resize(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        uint32_t trigram = static_cast<uint32_t>(entries[i] >> 32);
+        if (m_trigrams.empty() || m_trigrams.back() != trigram)
+        {
+            m_trigrams.push_back(trigram);
+            m_trigram_offsets.push_back(static_cast<uint32_t>(i));
+        }
+        m_trigram_strings[i] = static_cast<uint32_t>(entries[i]);
+    }
+    m_trigram_offsets.push_back(static_cast<uint32_t>(entries.size()));
+
+    m_strings = std::move(strings);
+    m_node_string_ids = std::move(node_string_ids);
+    m_string_node_offsets = std::move(string_node_offsets);
+    m_string_nodes = std::move(string_nodes);
+    m_command_hierarchy = &command_hierarchy;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool CommandHierarchySearchIndex::Search(const CommandHierarchySearchQuery &query,
+                                         std::vector<uint64_t>             &node_indices) const
+{
+    node_indices.clear();
+    if (!IsBuilt())
+    {
+        return false;
+    }
+
+    if (query.m_text.empty())
+    {
+        for (uint64_t node_index = 0; node_index < GetNumNodes(); ++node_index)
+        {
+            if (!query.HasPacketFilter() || NodeMatchesPacketFilter(query, node_index))
+            {
+                node_indices.push_back(node_index);
+            }
+        }
+        return true;
+    }
+
+    std::vector<uint32_t> string_ids;
+    if (!FindMatchingStrings(query, string_ids))
+    {
+        return false;
+    }
+    for (uint32_t string_id : string_ids)
+    {
+        for (uint32_t i = m_string_node_offsets[string_id];
+             i < m_string_node_offsets[string_id + 1];
+             ++i)
+        {
+            uint64_t node_index = m_string_nodes[i];
+            if (!query.HasPacketFilter() || NodeMatchesPacketFilter(query, node_index))
+            {
+                node_indices.push_back(node_index);
+            }
+        }
+    }
+    std::sort(node_indices.begin(), node_indices.end());
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool CommandHierarchySearchIndex::FindMatchingStrings(const CommandHierarchySearchQuery &query,
+                                                      std::vector<uint32_t> &string_ids) const
+{
+    auto all_strings = [](size_t i) { return static_cast<uint32_t>(i); };
+
+    if (query.m_is_regex)
+    {
+        std::regex::flag_type flags = std::regex::ECMAScript | std::regex::optimize;
+        if (!query.m_case_sensitive)
+        {
+            flags |= std::regex::icase;
+        }
+        std::regex regex;
+        try
+        {
+            regex = std::regex(query.m_text, flags);
+        }
+        catch (const std::regex_error &)
+        {
+            return false;
+        }
+        string_ids = FilterStrings(m_strings,
+                                   m_strings.size(),
+                                   all_strings,
+                                   [&regex](std::string_view string) {
+                                       return std::regex_search(string.begin(),
+                                                                string.end(),
+                                                                regex);
+                                   });
+        return true;
+    }
+
+    std::string text = query.m_case_sensitive ? query.m_text : ToLower(query.m_text);
+    auto        contains_text = [&text, &query](std::string_view string) {
+        return ContainsText(string, text, query.m_case_sensitive);
+    };
+    if (text.size() < kMinTextLengthForTrigrams)
+    {
+        string_ids = FilterStrings(m_strings, m_strings.size(), all_strings, contains_text);
+        return true;
+    }
+
+    // The trigrams only narrow down the candidates, which are then checked for the whole text
+    std::vector<uint32_t> candidates;
+    FindStringsWithTrigrams(text, candidates);
+    string_ids = FilterStrings(m_strings,
+                               candidates.size(),
+                               [&candidates](size_t i) { return candidates[i]; },
+                               contains_text);
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+void CommandHierarchySearchIndex::FindStringsWithTrigrams(std::string_view       text,
+                                                          std::vector<uint32_t> &string_ids) const
+{
+    string_ids.clear();
+
+    std::vector<uint32_t> trigrams;
+    GetTrigrams(text, trigrams);
+
+    // Posting list of each trigram, intersected from the shortest
+    struct PostingList
+    {
+        uint32_t m_begin;
+        uint32_t m_end;
+    };
+    std::vector<PostingList> posting_lists;
+    for (uint32_t trigram : trigrams)
+    {
+        auto it = std::lower_bound(m_trigrams.begin(), m_trigrams.end(), trigram);
+        if (it == m_trigrams.end() || *it != trigram)
+        {
+            return;
+        }
+        size_t i = it - m_trigrams.begin();
+        posting_lists.push_back({ m_trigram_offsets[i], m_trigram_offsets[i + 1] });
+    }
+    std::sort(posting_lists.begin(),
+              posting_lists.end(),
+              [](const PostingList &a, const PostingList &b) {
+                  return (a.m_end - a.m_begin) < (b.m_end - b.m_begin);
+              });
+
+    string_ids.assign(m_trigram_strings.begin() + posting_lists[0].m_begin,
+                      m_trigram_strings.begin() + posting_lists[0].m_end);
+    std::vector<uint32_t> intersection;
+    for (size_t i = 1; i < posting_lists.size() && !string_ids.empty(); ++i)
+    {
+        intersection.clear();
+        std::set_intersection(string_ids.begin(),
+                              string_ids.end(),
+                              m_trigram_strings.begin() + posting_lists[i].m_begin,
+                              m_trigram_strings.begin() + posting_lists[i].m_end,
+                              std::back_inserter(intersection));
+        std::swap(string_ids, intersection);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+bool CommandHierarchySearchIndex::NodeMatchesPacketFilter(const CommandHierarchySearchQuery &query,
+                                                          uint64_t node_index) const
+{
+    if (m_command_hierarchy->GetNodeType(node_index) != NodeType::kPacketNode)
+    {
+        return false;
+    }
+    uint64_t addr = m_command_hierarchy->GetPacketNodeAddr(node_index);
+    if (query.m_min_address.has_value() && addr < *query.m_min_address)
+    {
+        return false;
+    }
+    if (query.m_max_address.has_value() && addr > *query.m_max_address)
+    {
+        return false;
+    }
+    if (query.m_opcode.has_value() &&
+        m_command_hierarchy->GetPacketNodeOpcode(node_index) != *query.m_opcode)
+    {
+        return false;
+    }
+    return true;
+}
+
+}  // namespace Dive
@@ -0,0 +1,110 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "context.h"
+
+namespace Dive
+{
+class CommandHierarchy;
+
+//--------------------------------------------------------------------------------------------------
+struct CommandHierarchySearchQuery
+{
+    // Text to find in the node descriptions, or an ECMAScript regular expression if m_is_regex.
+    // An empty text matches every node.
+    std::string m_text;
+    bool        m_is_regex = false;
+    // A case-insensitive search only folds the ASCII letters of the UTF-8 text and descriptions,
+    // unlike QString::contains(Qt::CaseInsensitive). Non-ASCII letters must match exactly.
+    bool        m_case_sensitive = false;
+
+    // Only match the packet nodes whose address is in [m_min_address, m_max_address]
+    std::optional<uint64_t> m_min_address;
+    std::optional<uint64_t> m_max_address;
+
+    // Only match the packet nodes with this opcode
+    std::optional<uint8_t> m_opcode;
+
+    bool HasPacketFilter() const
+    {
+        return m_min_address.has_value() || m_max_address.has_value() || m_opcode.has_value();
+    }
+};
+
+//--------------------------------------------------------------------------------------------------
+// Full-text index of the node descriptions of a CommandHierarchy, so that a search does not visit
+// every node.
+//
+// Most nodes share their description with many others (e.g. the register and field nodes of the
+// packets), so the descriptions are interned first. The index maps each trigram of the
+// (ASCII-lowercased) distinct descriptions to the descriptions containing it. A text query looks up
+// the descriptions containing all its trigrams, and only checks those. Shorter texts and regular
+// expressions are checked against the distinct descriptions, not against every node.
+class CommandHierarchySearchIndex
+{
+public:
+    // Index `command_hierarchy`, which must outlive the index and must not change meanwhile.
+    // The work is split over the shared ThreadPool. Returns false if `context` was cancelled, the
+    // index is then left empty.
+    bool Build(const CommandHierarchy &command_hierarchy,
+               const Context          &context = Context::Background());
+
+    bool     IsBuilt() const { return m_command_hierarchy != nullptr; }
+    uint64_t GetNumNodes() const { return m_node_string_ids.size(); }
+    uint64_t GetNumDistinctStrings() const { return m_strings.size(); }
+
+    // Get the indices of the nodes matching `query`, in increasing order.
+    // Returns false if the index is not built or the regular expression is invalid.
+    bool Search(const CommandHierarchySearchQuery &query,
+                std::vector<uint64_t>             &node_indices) const;
+
+private:
+    static constexpr size_t kMinTextLengthForTrigrams = 3;
+
+    // Sorted ids of the distinct strings matching the text of the query
+    bool FindMatchingStrings(const CommandHierarchySearchQuery &query,
+                             std::vector<uint32_t>             &string_ids) const;
+    void FindStringsWithTrigrams(std::string_view text, std::vector<uint32_t> &string_ids) const;
+    bool NodeMatchesPacketFilter(const CommandHierarchySearchQuery &query,
+                                 uint64_t                           node_index) const;
+
+    const CommandHierarchy *m_command_hierarchy = nullptr;
+
+    // Distinct descriptions, viewing the strings of m_command_hierarchy
+    std::vector<std::string_view> m_strings;
+    // Node index -> string id
+    std::vector<uint32_t> m_node_string_ids;
+    // String id -> node indices, in increasing order, in
+    // m_string_nodes[m_string_node_offsets[id], m_string_node_offsets[id + 1])
+    std::vector<uint32_t> m_string_node_offsets;
+    std::vector<uint32_t> m_string_nodes;
+
+    // Sorted trigrams -> string ids, in increasing order, in
+    // m_trigram_strings[m_trigram_offsets[i], m_trigram_offsets[i + 1])
+    std::vector<uint32_t> m_trigrams;
+    std::vector<uint32_t> m_trigram_offsets;
+    std::vector<uint32_t> m_trigram_strings;
+};
+
+}  // namespace Dive
@@ -0,0 +1,126 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+
+#include "cache_utils.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+namespace Dive
+{
+namespace CacheUtils
+{
+namespace
+{
+
+// Value of an environment variable, or an empty path if it is not set
+std::filesystem::path GetEnvironmentPath(const char *name)
+{
+    const char *value = std::getenv(name);
+    return (value != nullptr && value[0] != '\0') ? std::filesystem::path(value) :
+                                                    std::filesystem::path();
+}
+
+}  // namespace
+
+//--------------------------------------------------------------------------------------------------
+std::filesystem::path GetUserCacheDirectory()
+{
+    std::filesystem::path cache_directory;
+#if defined(_WIN32)
+    cache_directory = GetEnvironmentPath("LOCALAPPDATA");
+#elif defined(__APPLE__)
+    if (std::filesystem::path home = GetEnvironmentPath("HOME"); !home.empty())
+    {
+        cache_directory = home / "Library" / "Caches";
+    }
+#else
+    cache_directory = GetEnvironmentPath("XDG_CACHE_HOME");
+    if (std::filesystem::path home = GetEnvironmentPath("HOME");
+        cache_directory.empty() && !home.empty())
+    {
+        cache_directory = home / ".cache";
+    }
+#endif
+    if (cache_directory.empty())
+    {
+        return cache_directory;
+    }
+    return cache_directory / "dive";
+}
+
+//--------------------------------------------------------------------------------------------------
+void PruneDirectory(const std::filesystem::path &directory,
+                    const std::string           &extension,
+                    uint64_t                     max_size)
+{
+    struct CachedFile
+    {
+        std::filesystem::path           m_path;
+        std::filesystem::file_time_type m_last_write_time;
+        uint64_t                        m_size;
+    };
+
+    std::error_code         ec;
+    std::vector<CachedFile> files;
+    uint64_t                total_size = 0;
+    for (const std::filesystem::directory_entry &entry :
+         std::filesystem::directory_iterator(directory, ec))
+    {
+        if (!entry.is_regular_file(ec) || entry.path().extension() != extension)
+        {
+            continue;
+        }
+        CachedFile file = { entry.path(), entry.last_write_time(ec), entry.file_size(ec) };
+        if (ec)
+        {
+            continue;
+        }
+        total_size += file.m_size;
+        files.push_back(std::move(file));
+    }
+    if (total_size <= max_size)
+    {
+        return;
+    }
+
+    std::sort(files.begin(), files.end(), [](const CachedFile &a, const CachedFile &b) {
+        return a.m_last_write_time < b.m_last_write_time;
+    });
+    for (const CachedFile &file : files)
+    {
+        if (total_size <= max_size)
+        {
+            break;
+        }
+        if (std::filesystem::remove(file.m_path, ec))
+        {
+            total_size -= file.m_size;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+void TouchFile(const std::filesystem::path &path)
+{
+    std::error_code ec;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+}
+
+}  // namespace CacheUtils
+}  // namespace Dive
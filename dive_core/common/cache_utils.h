@@ -0,0 +1,45 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace Dive
+{
+namespace CacheUtils
+{
+
+// Directory of the caches of the current user, e.g. "$XDG_CACHE_HOME/dive" or
+// "~/.cache/dive" on Linux, and "%LOCALAPPDATA%\dive" on Windows. Unlike the system temporary
+// directory, it is not shared with other users.
+// Returns an empty path if the current user has no such directory.
+std::filesystem::path GetUserCacheDirectory();
+
+// Delete the least recently modified files of `directory` with the given extension, until their
+// total size is at most `max_size` bytes. Other files are left alone.
+void PruneDirectory(const std::filesystem::path &directory,
+                    const std::string           &extension,
+                    uint64_t                     max_size);
+
+// Mark a cached file as recently used, so that PruneDirectory() deletes it last
+void TouchFile(const std::filesystem::path &path);
+
+}  // namespace CacheUtils
+}  // namespace Dive
@@ -860,8 +860,18 @@ uint32_t GetPacketSize(Pm4Header header)
 bool EmulateCallbacksBase::ProcessSubmits(const DiveVector<SubmitInfo> &submits,
                                           const IMemoryManager         &mem_manager)
 {
-    for (uint32_t submit_index = 0; submit_index < submits.size(); ++submit_index)
+    uint32_t end = static_cast<uint32_t>(submits.size());
+    if (m_submit_range.m_last < end)
     {
+        end = m_submit_range.m_last + 1;
+    }
+    for (uint32_t submit_index = m_submit_range.m_first; submit_index < end; ++submit_index)
+    {
+        if (m_context.Cancelled())
+        {
+            return false;
+        }
+
         const Dive::SubmitInfo &submit_info = submits[submit_index];
         OnSubmitStart(submit_index, submit_info);
 
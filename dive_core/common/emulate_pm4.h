@@ -30,6 +30,7 @@
 #include <optional>
 #include "adreno.h"
 #include "dive_core/common/pm4_packets/pfp_pm4_packets.h"
+#include "dive_core/context.h"
 #include "dive_core/stl_replacement.h"
 #include "gpudefs.h"
 
@@ -165,12 +166,34 @@ private:
     std::optional<ShaderEnableBit> m_shader_enable_bit = std::nullopt;
 };
 
+//--------------------------------------------------------------------------------------------------
+// Range of submits to process, from m_first to m_last included
+struct SubmitRange
+{
+    uint32_t m_first = 0;
+    uint32_t m_last = UINT32_MAX;
+
+    bool IsAll() const { return m_first == 0 && m_last == UINT32_MAX; }
+    bool Contains(uint32_t submit_index) const
+    {
+        return submit_index >= m_first && submit_index <= m_last;
+    }
+};
+
 //--------------------------------------------------------------------------------------------------
 class EmulateCallbacksBase
 {
 public:
     bool ProcessSubmits(const DiveVector<SubmitInfo> &submits, const IMemoryManager &mem_manager);
 
+    // Restrict ProcessSubmits() to a range of submits. The other submits are neither emulated nor
+    // reported. No state needs to be carried over from the skipped submits: each submit is
+    // emulated from a reset state, and the callbacks reset their tracking in OnSubmitStart().
+    void SetSubmitRange(const SubmitRange &submit_range) { m_submit_range = submit_range; }
+
+    // ProcessSubmits() fails once `context` is cancelled, checked between submits
+    void SetContext(const Context &context) { m_context = context; }
+
     // Callback on an IB start. Also called for all call/chain IBs
     // A return value of false indicates to the emulator to skip parsing this IB
     virtual bool OnIbStart(uint32_t                  submit_index,
@@ -210,6 +233,8 @@ public:
 
 protected:
     EmulateStateTracker m_state_tracker;
+    SubmitRange         m_submit_range;
+    Context             m_context;
 };
 
 //--------------------------------------------------------------------------------------------------
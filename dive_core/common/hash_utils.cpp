@@ -0,0 +1,150 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "hash_utils.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Dive
+{
+namespace HashUtils
+{
+namespace
+{
+
+constexpr uint64_t kPrime0 = 0x9e3779b97f4a7c15ull;
+constexpr uint64_t kPrime1 = 0xc2b2ae3d27d4eb4full;
+
+// splitmix64 finalizer: full avalanche of a 64-bit value
+inline uint64_t Mix(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+inline uint64_t RotateLeft(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+inline uint64_t ReadU64(const uint8_t *data)
+{
+    // The hash is defined on little-endian words, which is what all supported hosts use
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+}  // namespace
+
+//--------------------------------------------------------------------------------------------------
+ContentHasher::ContentHasher(uint64_t seed)
+{
+    for (size_t i = 0; i < kNumLanes; ++i)
+    {
+        m_lanes[i] = Mix(seed + kPrime0 * (i + 1));
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+void ContentHasher::ProcessBlock(const uint8_t *block)
+{
+    // Independent lanes keep several multiplies in flight
+    for (size_t i = 0; i < kNumLanes; ++i)
+    {
+        uint64_t word = ReadU64(block + i * sizeof(uint64_t));
+        m_lanes[i] = RotateLeft(m_lanes[i] ^ (word * kPrime1), 31) * kPrime0;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+ContentHasher &ContentHasher::Update(const void *data, size_t size)
+{
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    m_total_size += size;
+
+    if (m_pending_size > 0)
+    {
+        size_t copy_size = std::min(size, kBlockSize - m_pending_size);
+        std::memcpy(m_pending + m_pending_size, bytes, copy_size);
+        m_pending_size += copy_size;
+        bytes += copy_size;
+        size -= copy_size;
+        if (m_pending_size < kBlockSize)
+        {
+            return *this;
+        }
+        ProcessBlock(m_pending);
+        m_pending_size = 0;
+    }
+
+    while (size >= kBlockSize)
+    {
+        ProcessBlock(bytes);
+        bytes += kBlockSize;
+        size -= kBlockSize;
+    }
+
+    std::memcpy(m_pending, bytes, size);
+    m_pending_size = size;
+    return *this;
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t ContentHasher::Finalize() const
+{
+    uint64_t hash = m_total_size * kPrime0;
+    for (size_t i = 0; i < kNumLanes; ++i)
+    {
+        hash = Mix(hash ^ m_lanes[i]);
+    }
+
+    // Tail bytes, zero padded
+    uint8_t tail[kBlockSize] = {};
+    std::memcpy(tail, m_pending, m_pending_size);
+    for (size_t offset = 0; offset < m_pending_size; offset += sizeof(uint64_t))
+    {
+        hash = Mix(hash ^ (ReadU64(tail + offset) * kPrime1));
+    }
+    return hash;
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t HashContent(const void *data, size_t size, uint64_t seed)
+{
+    return ContentHasher(seed).Update(data, size).Finalize();
+}
+
+//--------------------------------------------------------------------------------------------------
+std::string HashToString(uint64_t hash)
+{
+    constexpr char kDigits[] = "0123456789abcdef";
+    std::string    result(16, '0');
+    for (int i = 15; i >= 0; --i)
+    {
+        result[i] = kDigits[hash & 0xf];
+        hash >>= 4;
+    }
+    return result;
+}
+
+}  // namespace HashUtils
+}  // namespace Dive
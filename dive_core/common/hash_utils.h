@@ -0,0 +1,64 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Dive
+{
+namespace HashUtils
+{
+
+// Stable 64-bit content hash, suitable for keys persisted on disk (unlike std::hash or
+// absl::Hash, the value does not change between runs or builds).
+// Not cryptographic: do not use it where collisions could be crafted.
+class ContentHasher
+{
+public:
+    explicit ContentHasher(uint64_t seed = 0);
+
+    ContentHasher &Update(const void *data, size_t size);
+
+    template<typename T> ContentHasher &UpdateValue(const T &value)
+    {
+        return Update(&value, sizeof(value));
+    }
+
+    uint64_t Finalize() const;
+
+private:
+    static constexpr size_t kNumLanes = 4;
+    static constexpr size_t kBlockSize = kNumLanes * sizeof(uint64_t);
+
+    void ProcessBlock(const uint8_t *block);
+
+    uint64_t m_lanes[kNumLanes];
+    uint8_t  m_pending[kBlockSize];
+    size_t   m_pending_size = 0;
+    uint64_t m_total_size = 0;
+};
+
+// Hash of a single buffer
+uint64_t HashContent(const void *data, size_t size, uint64_t seed = 0);
+
+// Fixed-width lowercase hex representation, e.g. for use in file names
+std::string HashToString(uint64_t hash);
+
+}  // namespace HashUtils
+}  // namespace Dive
@@ -0,0 +1,457 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "corpus_stats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iterator>
+#include <thread>
+
+#include "data_core.h"
+
+namespace Dive
+{
+
+namespace
+{
+
+// Rough ratio between the memory used by a loaded and parsed capture and the size of its file
+constexpr uint64_t kMemoryPerFileByte = 8;
+
+//--------------------------------------------------------------------------------------------------
+// A metric of a capture, whose distribution over the corpus is reported
+struct Metric
+{
+    const char *m_name;
+    bool        m_is_ratio;
+    double (*m_get)(const CorpusCaptureStats &capture_stats);
+};
+
+uint64_t GetNumDraws(const CorpusCaptureStats &capture_stats)
+{
+    const std::array<uint64_t, Stats::kNumStats> &stats = capture_stats.m_stats;
+    return stats[Stats::kBinningDraws] + stats[Stats::kDirectDraws] + stats[Stats::kTiledDraws];
+}
+
+// Ratio of the draws with a given stat, among the draws it is gathered for
+double GetDrawRatio(const CorpusCaptureStats &capture_stats, Stats::Type type, uint64_t num_draws)
+{
+    return num_draws ? static_cast<double>(capture_stats.m_stats[type]) / num_draws : 0.0;
+}
+
+#define DIVE_CORPUS_STAT(name, type)                                                               \
+    {                                                                                              \
+        name, false, [](const CorpusCaptureStats &capture_stats) {                                 \
+            return static_cast<double>(capture_stats.m_stats[type]);                               \
+        }                                                                                          \
+    }
+
+const Metric kMetrics[] = {
+    { "num_events",
+      false,
+      [](const CorpusCaptureStats &capture_stats) {
+          return static_cast<double>(capture_stats.m_num_events);
+      } },
+    { "draws",
+      false,
+      [](const CorpusCaptureStats &capture_stats) {
+          return static_cast<double>(GetNumDraws(capture_stats));
+      } },
+    DIVE_CORPUS_STAT("binning_draws", Stats::kBinningDraws),
+    DIVE_CORPUS_STAT("direct_draws", Stats::kDirectDraws),
+    DIVE_CORPUS_STAT("tiled_draws", Stats::kTiledDraws),
+    DIVE_CORPUS_STAT("dispatches", Stats::kDispatches),
+    DIVE_CORPUS_STAT("binning_passes", Stats::kNumBinningPasses),
+    DIVE_CORPUS_STAT("tiling_passes", Stats::kNumTilingPasses),
+    DIVE_CORPUS_STAT("resolves", Stats::kTotalResolves),
+    DIVE_CORPUS_STAT("color_sysmem_to_gmem_resolves", Stats::kColorSysMemToGmemResolves),
+    DIVE_CORPUS_STAT("color_gmem_to_sysmem_resolves", Stats::kColorGmemToSysMemResolves),
+    DIVE_CORPUS_STAT("depth_sysmem_to_gmem_resolves", Stats::kDepthSysMemToGmemResolves),
+    DIVE_CORPUS_STAT("depth_gmem_to_sysmem_resolves", Stats::kDepthGmemToSysMemResolves),
+    DIVE_CORPUS_STAT("color_gmem_clears", Stats::kColorClearGmemResolves),
+    DIVE_CORPUS_STAT("depth_gmem_clears", Stats::kDepthClearGmemResolves),
+    DIVE_CORPUS_STAT("wait_for_idle", Stats::kWaitForIdle),
+    // TraceStats gathers the LRZ stats of the direct and binning draws, and the depth stats of
+    // the binning draws
+    { "lrz_enabled_ratio",
+      true,
+      [](const CorpusCaptureStats &capture_stats) {
+          uint64_t num_draws = capture_stats.m_stats[Stats::kBinningDraws] +
+                               capture_stats.m_stats[Stats::kDirectDraws];
+          return GetDrawRatio(capture_stats, Stats::kLrzEnabled, num_draws);
+      } },
+    { "lrz_write_enabled_ratio",
+      true,
+      [](const CorpusCaptureStats &capture_stats) {
+          uint64_t num_draws = capture_stats.m_stats[Stats::kBinningDraws] +
+                               capture_stats.m_stats[Stats::kDirectDraws];
+          return GetDrawRatio(capture_stats, Stats::kLrzWriteEnabled, num_draws);
+      } },
+    { "depth_test_enabled_ratio",
+      true,
+      [](const CorpusCaptureStats &capture_stats) {
+          return GetDrawRatio(capture_stats,
+                              Stats::kDepthTestEnabled,
+                              capture_stats.m_stats[Stats::kBinningDraws]);
+      } },
+    DIVE_CORPUS_STAT("total_indices", Stats::kTotalIndices),
+    DIVE_CORPUS_STAT("shaders", Stats::kShaders),
+    DIVE_CORPUS_STAT("min_gprs", Stats::kMinGPRs),
+    DIVE_CORPUS_STAT("median_gprs", Stats::kMedianGPRs),
+    DIVE_CORPUS_STAT("max_gprs", Stats::kMaxGPRs),
+    DIVE_CORPUS_STAT("median_instructions", Stats::kMedianInstructions),
+    DIVE_CORPUS_STAT("max_instructions", Stats::kMaxInstructions),
+    DIVE_CORPUS_STAT("total_instructions", Stats::kTotalInstructions),
+};
+
+#undef DIVE_CORPUS_STAT
+
+//--------------------------------------------------------------------------------------------------
+// Nearest-rank percentile of sorted values
+double GetPercentile(const std::vector<double> &sorted_values, double percentile)
+{
+    size_t rank = static_cast<size_t>(percentile / 100.0 * (sorted_values.size() - 1) + 0.5);
+    return sorted_values[std::min(rank, sorted_values.size() - 1)];
+}
+
+//--------------------------------------------------------------------------------------------------
+// Bytes of captures loaded at once
+class MemoryBudget
+{
+public:
+    explicit MemoryBudget(uint64_t budget) :
+        m_budget(budget)
+    {
+    }
+
+    // Wait until `size` fits in the budget, or until nothing else is reserved if `size` is over
+    // the budget. Returns false if cancelled.
+    bool Acquire(const Context &context, uint64_t size)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (m_used != 0 && m_used + size > m_budget)
+        {
+            if (context.Cancelled())
+            {
+                return false;
+            }
+            m_condition_variable.wait_for(lock, std::chrono::milliseconds(10));
+        }
+        m_used += size;
+        return true;
+    }
+
+    void Release(uint64_t size)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_used -= size;
+        }
+        m_condition_variable.notify_all();
+    }
+
+private:
+    std::mutex              m_mutex;
+    std::condition_variable m_condition_variable;
+    uint64_t                m_budget;
+    uint64_t                m_used = 0;
+};
+
+}  // namespace
+
+// =================================================================================================
+// CorpusStats
+// =================================================================================================
+uint32_t CorpusStats::GetNumMetrics()
+{
+    return static_cast<uint32_t>(std::size(kMetrics));
+}
+
+//--------------------------------------------------------------------------------------------------
+const char *CorpusStats::GetMetricName(uint32_t metric)
+{
+    return kMetrics[metric].m_name;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool CorpusStats::IsRatioMetric(uint32_t metric)
+{
+    return kMetrics[metric].m_is_ratio;
+}
+
+//--------------------------------------------------------------------------------------------------
+double CorpusStats::GetMetricValue(uint32_t metric, const CorpusCaptureStats &capture_stats)
+{
+    return kMetrics[metric].m_get(capture_stats);
+}
+
+//--------------------------------------------------------------------------------------------------
+void CorpusStats::Add(CorpusCaptureStats &&capture_stats)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_captures.push_back(std::move(capture_stats));
+}
+
+//--------------------------------------------------------------------------------------------------
+void CorpusStats::Merge(CorpusStats &&other)
+{
+    if (&other == this)
+    {
+        return;
+    }
+    std::scoped_lock lock(m_mutex, other.m_mutex);
+    m_captures.insert(m_captures.end(),
+                      std::make_move_iterator(other.m_captures.begin()),
+                      std::make_move_iterator(other.m_captures.end()));
+    other.m_captures.clear();
+}
+
+//--------------------------------------------------------------------------------------------------
+size_t CorpusStats::GetNumCaptures() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_captures.size();
+}
+
+//--------------------------------------------------------------------------------------------------
+size_t CorpusStats::GetNumFailedCaptures() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::count_if(m_captures.begin(),
+                         m_captures.end(),
+                         [](const CorpusCaptureStats &capture_stats) {
+                             return !capture_stats.m_success;
+                         });
+}
+
+//--------------------------------------------------------------------------------------------------
+std::vector<CorpusCaptureStats> CorpusStats::GetCaptures() const
+{
+    std::vector<CorpusCaptureStats> captures;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        captures = m_captures;
+    }
+    std::sort(captures.begin(),
+              captures.end(),
+              [](const CorpusCaptureStats &lhs, const CorpusCaptureStats &rhs) {
+                  return lhs.m_file_name < rhs.m_file_name;
+              });
+    return captures;
+}
+
+//--------------------------------------------------------------------------------------------------
+std::vector<CorpusMetricDistribution> CorpusStats::GetDistributions() const
+{
+    std::vector<std::vector<double>> metric_values(std::size(kMetrics));
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const CorpusCaptureStats &capture_stats : m_captures)
+        {
+            for (size_t m = 0; m < std::size(kMetrics) && capture_stats.m_success; ++m)
+            {
+                metric_values[m].push_back(kMetrics[m].m_get(capture_stats));
+            }
+        }
+    }
+
+    std::vector<CorpusMetricDistribution> distributions;
+    for (size_t m = 0; m < std::size(kMetrics); ++m)
+    {
+        std::vector<double> &values = metric_values[m];
+        if (values.empty())
+        {
+            continue;
+        }
+        std::sort(values.begin(), values.end());
+        double sum = 0;
+        for (double value : values)
+        {
+            sum += value;
+        }
+        distributions.push_back({ kMetrics[m].m_name,
+                                  static_cast<uint64_t>(values.size()),
+                                  values.front(),
+                                  GetPercentile(values, 10),
+                                  GetPercentile(values, 50),
+                                  GetPercentile(values, 90),
+                                  values.back(),
+                                  sum / values.size() });
+    }
+    return distributions;
+}
+
+//--------------------------------------------------------------------------------------------------
+std::vector<CorpusGprCount> CorpusStats::GetGprHistogram() const
+{
+    std::map<uint32_t, CorpusGprCount> gpr_counts;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const CorpusCaptureStats &capture_stats : m_captures)
+        {
+            for (const auto &[num_gprs, num_shaders] : capture_stats.m_gpr_histogram)
+            {
+                CorpusGprCount &gpr_count = gpr_counts.try_emplace(num_gprs, num_gprs, 0, 0)
+                                            .first->second;
+                gpr_count.m_num_shaders += num_shaders;
+                gpr_count.m_num_captures++;
+            }
+        }
+    }
+
+    std::vector<CorpusGprCount> gpr_histogram;
+    for (const auto &[num_gprs, gpr_count] : gpr_counts)
+    {
+        gpr_histogram.push_back(gpr_count);
+    }
+    return gpr_histogram;
+}
+
+//--------------------------------------------------------------------------------------------------
+std::vector<std::filesystem::path> FindCaptureFiles(const std::vector<std::filesystem::path> &paths)
+{
+    auto is_capture = [](const std::filesystem::path &path) {
+        std::string extension = path.extension().string();
+        return extension == ".rd" || extension == ".dive";
+    };
+
+    std::vector<std::filesystem::path> files;
+    for (const std::filesystem::path &path : paths)
+    {
+        std::error_code error;
+        if (!std::filesystem::is_directory(path, error))
+        {
+            files.push_back(path);
+            continue;
+        }
+        for (auto it = std::filesystem::recursive_directory_iterator(path, error);
+             it != std::filesystem::recursive_directory_iterator();
+             it.increment(error))
+        {
+            if (it->is_regular_file(error) && is_capture(it->path()))
+            {
+                files.push_back(it->path());
+            }
+        }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+//--------------------------------------------------------------------------------------------------
+CorpusCaptureStats GatherCaptureStats(const Context               &context,
+                                      const std::filesystem::path &file,
+                                      const CorpusStatsOptions    &options)
+{
+    CorpusCaptureStats capture_stats;
+    capture_stats.m_file_name = file.string();
+    std::error_code error;
+    uint64_t        file_size = std::filesystem::file_size(file, error);
+    capture_stats.m_file_size = error ? 0 : file_size;
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    DataCore                              data_core(nullptr);
+    data_core.SetAnalysisCacheEnabled(options.m_use_analysis_cache);
+    if (data_core.LoadPm4CaptureData(capture_stats.m_file_name) !=
+        CaptureData::LoadResult::kSuccess)
+    {
+        capture_stats.m_error = "Can't load";
+        return capture_stats;
+    }
+    if (!data_core.ParsePm4CaptureData())
+    {
+        capture_stats.m_error = "Can't parse";
+        return capture_stats;
+    }
+    capture_stats.m_load_ms = std::chrono::duration<double, std::milli>(
+                              std::chrono::steady_clock::now() - begin)
+                              .count();
+
+    const CaptureMetadata &meta_data = data_core.GetCaptureMetadata();
+    CaptureStats           stats;
+    TraceStats().GatherTraceStats(context, meta_data, stats);
+    if (context.Cancelled())
+    {
+        capture_stats.m_error = "Cancelled";
+        return capture_stats;
+    }
+    capture_stats.m_stats = stats.m_stats_list;
+    capture_stats.m_num_events = meta_data.m_event_info.size();
+    for (const Disassembly &shader : meta_data.m_shaders)
+    {
+        ++capture_stats.m_gpr_histogram[shader.GetGPRCount()];
+    }
+    capture_stats.m_success = true;
+    return capture_stats;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool GatherCorpusStats(const Context                                         &context,
+                       const std::vector<std::filesystem::path>              &files,
+                       const CorpusStatsOptions                              &options,
+                       CorpusStats                                           &corpus_stats,
+                       const std::function<void(const CorpusCaptureStats &)> &on_capture_done)
+{
+    uint32_t num_workers = options.m_num_workers;
+    if (num_workers == 0)
+    {
+        num_workers = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    num_workers = static_cast<uint32_t>(std::min<size_t>(num_workers, files.size()));
+
+    // Each capture is processed on a worker thread, and splits its own work over the shared
+    // ThreadPool (like RunAnalyzers(), since TraceStats::GatherTraceStats() blocks while its chunks
+    // run). The budget bounds how many captures are in memory at once.
+    MemoryBudget             memory_budget(options.m_memory_budget);
+    std::atomic<size_t>      next_file = 0;
+    std::vector<std::thread> workers;
+    for (uint32_t w = 0; w < num_workers; ++w)
+    {
+        workers.emplace_back([&]() {
+            for (size_t i = next_file++; i < files.size(); i = next_file++)
+            {
+                std::error_code error;
+                uint64_t        file_size = std::filesystem::file_size(files[i], error);
+                uint64_t        memory_size = error ? 0 : file_size * kMemoryPerFileByte;
+                if (!memory_budget.Acquire(context, memory_size))
+                {
+                    return;
+                }
+                CorpusCaptureStats capture_stats = GatherCaptureStats(context, files[i], options);
+                memory_budget.Release(memory_size);
+                if (context.Cancelled())
+                {
+                    return;
+                }
+                if (on_capture_done)
+                {
+                    on_capture_done(capture_stats);
+                }
+                corpus_stats.Add(std::move(capture_stats));
+            }
+        });
+    }
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    return !context.Cancelled();
+}
+
+}  // namespace Dive
@@ -0,0 +1,138 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "context.h"
+#include "trace_stats/trace_stats.h"
+
+namespace Dive
+{
+
+//--------------------------------------------------------------------------------------------------
+// Stats of a corpus of captures (e.g. all the captures of a test farm run), gathered capture by
+// capture so that only a small summary of each capture is kept in memory.
+struct CorpusStatsOptions
+{
+    // Number of captures processed at once. 0 for the number of hardware threads.
+    uint32_t m_num_workers = 0;
+
+    // Captures are only loaded while their estimated memory fits in this budget, in bytes. A
+    // capture over the budget is loaded alone.
+    uint64_t m_memory_budget = 4ull << 30;
+
+    // Whether the analysis sidecar of each capture and the shader disassembly store are used
+    // (see DataCore::SetAnalysisCacheEnabled())
+    bool m_use_analysis_cache = false;
+};
+
+// What is kept of each capture, small enough for hundreds of captures
+struct CorpusCaptureStats
+{
+    std::string m_file_name;
+    uint64_t    m_file_size = 0;
+    bool        m_success = false;
+    std::string m_error;
+    double      m_load_ms = 0;
+    uint64_t    m_num_events = 0;
+
+    std::array<uint64_t, Stats::kNumStats> m_stats = {};
+
+    // Number of shaders by GPR count
+    std::map<uint32_t, uint32_t> m_gpr_histogram;
+};
+
+// Distribution of a metric over the captures which were processed
+struct CorpusMetricDistribution
+{
+    const char *m_metric;
+    uint64_t    m_count;
+    double      m_min;
+    double      m_p10;
+    double      m_p50;
+    double      m_p90;
+    double      m_max;
+    double      m_mean;
+};
+
+struct CorpusGprCount
+{
+    uint32_t m_num_gprs;
+    uint64_t m_num_shaders;
+    uint64_t m_num_captures;  // Captures with at least one such shader
+};
+
+// Aggregate of the stats of the captures, added as they are processed
+class CorpusStats
+{
+public:
+    // The metrics whose distribution over the corpus is reported. A ratio metric is a fraction of
+    // the draws, the others are counts.
+    static uint32_t    GetNumMetrics();
+    static const char *GetMetricName(uint32_t metric);
+    static bool        IsRatioMetric(uint32_t metric);
+    static double      GetMetricValue(uint32_t metric, const CorpusCaptureStats &capture_stats);
+
+    // Thread-safe
+    void   Add(CorpusCaptureStats &&capture_stats);
+    void   Merge(CorpusStats &&other);
+    size_t GetNumCaptures() const;
+    size_t GetNumFailedCaptures() const;
+
+    // All the captures, including the failed ones, sorted by file name
+    std::vector<CorpusCaptureStats> GetCaptures() const;
+
+    // Count, min, p10, p50, p90, max and mean of each metric, over the captures which were
+    // processed. Metrics are in the order of GetMetricName(), and are omitted if no capture was.
+    std::vector<CorpusMetricDistribution> GetDistributions() const;
+
+    // Number of shaders, and of captures with such shaders, by GPR count
+    std::vector<CorpusGprCount> GetGprHistogram() const;
+
+private:
+    mutable std::mutex              m_mutex;
+    std::vector<CorpusCaptureStats> m_captures;
+};
+
+// The .rd and .dive captures of the given files and directories (searched recursively), sorted
+std::vector<std::filesystem::path> FindCaptureFiles(
+const std::vector<std::filesystem::path> &paths);
+
+// Load a capture and reduce it to its stats. A capture which can't be loaded or parsed is
+// returned with m_success false and the reason in m_error.
+CorpusCaptureStats GatherCaptureStats(const Context               &context,
+                                      const std::filesystem::path &file,
+                                      const CorpusStatsOptions    &options);
+
+// Load each capture and gather its stats into `corpus_stats`, several captures at once.
+// `on_capture_done` (optional) is called from the worker threads as each capture is done.
+// Returns false if cancelled.
+bool GatherCorpusStats(const Context                                         &context,
+                       const std::vector<std::filesystem::path>              &files,
+                       const CorpusStatsOptions                              &options,
+                       CorpusStats                                           &corpus_stats,
+                       const std::function<void(const CorpusCaptureStats &)> &on_capture_done);
+
+}  // namespace Dive
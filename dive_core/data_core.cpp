@@ -16,12 +16,40 @@
 */
 #include "data_core.h"
 #include <assert.h>
+#include <filesystem>
 #include <optional>
+#include <utility>
+#include "analysis_cache.h"
 #include "pm4_info.h"
+#include "shader_disassembly.h"
+#include "thread_pool.h"
 
 namespace Dive
 {
 
+// =================================================================================================
+// CaptureMetadata
+// =================================================================================================
+uint64_t CaptureMetadata::GetMemoryUsage() const
+{
+    uint64_t memory_usage = m_command_hierarchy.GetMemoryUsage() + m_event_state.RawBufferSize();
+    memory_usage += m_buffers.capacity() * sizeof(BufferInfo);
+    memory_usage += m_event_info.capacity() * sizeof(EventInfo);
+    for (const EventInfo &event_info : m_event_info)
+    {
+        memory_usage += event_info.m_shader_references.capacity() * sizeof(ShaderReference);
+        for (const std::vector<uint32_t> &buffer_indices : event_info.m_buffer_indices)
+        {
+            memory_usage += buffer_indices.capacity() * sizeof(uint32_t);
+        }
+    }
+    for (const Disassembly &shader : m_shaders)
+    {
+        memory_usage += sizeof(Disassembly) + shader.GetMemoryUsage();
+    }
+    return memory_usage;
+}
+
 // =================================================================================================
 // DataCore
 // =================================================================================================
@@ -32,6 +60,17 @@ DataCore::DataCore(ProgressTracker *progress_tracker) :
 {
 }
 
+//--------------------------------------------------------------------------------------------------
+void DataCore::SetAnalysisCacheEnabled(bool enabled)
+{
+    m_use_analysis_cache = enabled;
+    ShaderDisassemblyCache &shader_cache = ShaderDisassemblyCache::Get();
+    if (enabled && shader_cache.GetCacheDirectory().empty())
+    {
+        shader_cache.SetCacheDirectory(ShaderDisassemblyCache::GetDefaultCacheDirectory());
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 CaptureData::LoadResult DataCore::LoadDiveCaptureData(const std::string &file_name)
 {
@@ -46,7 +85,9 @@ CaptureData::LoadResult DataCore::LoadPm4CaptureData(const std::string &file_nam
 {
 
     m_pm4_capture_data = Pm4CaptureData(m_progress_tracker);  // Clear any previously loaded data
+    m_pm4_capture_data.SetHashContent(m_use_analysis_cache);
     m_capture_metadata = CaptureMetadata();
+    m_pm4_capture_file_name = file_name;
     return m_pm4_capture_data.LoadCaptureFile(file_name);
 }
 
@@ -83,7 +124,9 @@ bool DataCore::CreateDiveCommandHierarchy()
 }
 
 //--------------------------------------------------------------------------------------------------
-bool DataCore::CreatePm4CommandHierarchy()
+bool DataCore::CreatePm4CommandHierarchy(const Context     &context,
+                                         const SubmitRange &submit_range,
+                                         CaptureMetadata   &capture_metadata) const
 {
     std::unique_ptr<EmulateStateTracker> state_tracker(new EmulateStateTracker);
 
@@ -92,11 +135,13 @@ bool DataCore::CreatePm4CommandHierarchy()
     // field/register nodes. Overguessing means more memory used during creation. Underguessing
     // means more allocations. For big captures, this is easily in the multi-millions, so
     // pre-reserving the space is a signficiant performance win
-    uint64_t reserve_size = m_capture_metadata.m_num_pm4_packets * 10;
+    uint64_t reserve_size = capture_metadata.m_num_pm4_packets * 10;
 
     // Command hierarchy tree creation
-    CommandHierarchyCreator cmd_hier_creator(m_capture_metadata.m_command_hierarchy,
+    CommandHierarchyCreator cmd_hier_creator(capture_metadata.m_command_hierarchy,
                                              m_pm4_capture_data);
+    cmd_hier_creator.SetSubmitRange(submit_range);
+    cmd_hier_creator.SetContext(context);
     if (!cmd_hier_creator.CreateTrees(m_pm4_capture_data, true, reserve_size))
     {
         return false;
@@ -132,7 +177,25 @@ bool DataCore::CreateDiveMetaData()
 //--------------------------------------------------------------------------------------------------
 bool DataCore::CreatePm4MetaData()
 {
-    CaptureMetadataCreator metadata_creator(m_capture_metadata);
+    return CreatePm4MetaData(Context::Background(), m_submit_range, m_capture_metadata);
+}
+
+//--------------------------------------------------------------------------------------------------
+bool DataCore::CreatePm4MetaData(const Context     &context,
+                                 const SubmitRange &submit_range,
+                                 CaptureMetadata   &capture_metadata) const
+{
+    uint32_t num_submits = m_pm4_capture_data.GetNumSubmits();
+    if (submit_range.m_last < num_submits)
+    {
+        num_submits = submit_range.m_last + 1;
+    }
+    num_submits = num_submits > submit_range.m_first ? num_submits - submit_range.m_first : 0;
+
+    CaptureMetadataCreator metadata_creator(capture_metadata);
+    metadata_creator.SetSubmitRange(submit_range);
+    metadata_creator.SetContext(context);
+    metadata_creator.SetProgressTracker(m_progress_tracker, num_submits);
     if (!metadata_creator.ProcessSubmits(m_pm4_capture_data.GetSubmits(),
                                          m_pm4_capture_data.GetMemoryManager()))
     {
@@ -159,30 +222,116 @@ bool DataCore::ParseDiveCaptureData()
         return false;
     }
 
+    DisassembleShaders(Context::Background(), m_capture_metadata);
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool DataCore::ParsePm4CaptureData(const Context &context)
+{
+    CaptureMetadata capture_metadata;
+    if (!ParsePm4CaptureMetadata(context, m_submit_range, capture_metadata))
+    {
+        return false;
+    }
+    m_capture_metadata = std::move(capture_metadata);
     return true;
 }
 
 //--------------------------------------------------------------------------------------------------
-bool DataCore::ParsePm4CaptureData()
+bool DataCore::ParsePm4CaptureMetadata(const Context     &context,
+                                       const SubmitRange &submit_range,
+                                       CaptureMetadata   &capture_metadata) const
 {
+    std::string cache_file_name = AnalysisCache::GetCacheFileName(m_pm4_capture_file_name);
+    if (!submit_range.IsAll() && submit_range.m_first >= m_pm4_capture_data.GetNumSubmits())
+    {
+        std::string message = "Submit " + std::to_string(submit_range.m_first) +
+                              " not in the capture (" +
+                              std::to_string(m_pm4_capture_data.GetNumSubmits()) + " submits)";
+        if (m_progress_tracker)
+        {
+            m_progress_tracker->sendMessage(message);
+        }
+        else
+        {
+            DIVE_LOG("%s\n", message.c_str());
+        }
+        return false;
+    }
+
+    // The key was computed by the loader, from the content as it was read
+    AnalysisCache::CaptureKey capture_key;
+    bool use_analysis_cache = m_use_analysis_cache && !m_pm4_capture_file_name.empty() &&
+                              submit_range.IsAll() &&
+                              m_pm4_capture_data.GetContentHash(capture_key.m_content_size,
+                                                                capture_key.m_content_hash);
+    if (use_analysis_cache && std::filesystem::exists(cache_file_name))
+    {
+        if (m_progress_tracker)
+        {
+            m_progress_tracker->sendMessage("Loading cached analysis...");
+        }
+        if (AnalysisCache::Load(cache_file_name,
+                                capture_key,
+                                m_pm4_capture_data.GetMemoryManager(),
+                                capture_metadata))
+        {
+            DisassembleShaders(context, capture_metadata);
+            return !context.Cancelled();
+        }
+    }
+
     if (m_progress_tracker)
     {
         m_progress_tracker->sendMessage("Processing command buffers...");
     }
 
-    if (!CreatePm4MetaData())
+    if (!CreatePm4MetaData(context, submit_range, capture_metadata))
+    {
+        return false;
+    }
+
+    if (m_progress_tracker)
+    {
+        m_progress_tracker->sendMessage("Creating command hierarchy...");
+    }
+
+    if (!CreatePm4CommandHierarchy(context, submit_range, capture_metadata))
     {
         return false;
     }
 
-    if (!CreatePm4CommandHierarchy())
+    DisassembleShaders(context, capture_metadata);
+    if (context.Cancelled())
     {
         return false;
     }
 
+    // Failing to write the sidecar (e.g. read-only capture directory) only costs the next open
+    if (use_analysis_cache && !AnalysisCache::Save(cache_file_name, capture_key, capture_metadata))
+    {
+        std::string message = "Not able to write analysis cache: " + cache_file_name;
+        if (m_progress_tracker)
+        {
+            m_progress_tracker->sendMessage(message);
+        }
+        else
+        {
+            DIVE_LOG("%s\n", message.c_str());
+        }
+    }
+
     return true;
 }
 
+//--------------------------------------------------------------------------------------------------
+CaptureMetadata DataCore::SetCaptureMetadata(CaptureMetadata &&capture_metadata)
+{
+    return std::exchange(m_capture_metadata, std::move(capture_metadata));
+}
+
 //--------------------------------------------------------------------------------------------------
 bool DataCore::ParseGfxrCaptureData()
 {
@@ -199,6 +348,24 @@ bool DataCore::ParseGfxrCaptureData()
     return true;
 }
 
+//--------------------------------------------------------------------------------------------------
+void DataCore::DisassembleShaders(const Context         &context,
+                                  const CaptureMetadata &capture_metadata) const
+{
+    if (m_progress_tracker)
+    {
+        m_progress_tracker->sendMessage("Disassembling shaders...");
+    }
+
+    const std::deque<Disassembly> &shaders = capture_metadata.m_shaders;
+    ParallelFor(ThreadPool::Shared(),
+                context,
+                0,
+                shaders.size(),
+                1,
+                [&shaders](size_t i) { shaders[i].EagerEval(); });
+}
+
 //--------------------------------------------------------------------------------------------------
 const Pm4CaptureData &DataCore::GetPm4CaptureData() const
 {
@@ -255,7 +422,27 @@ void CaptureMetadataCreator::OnSubmitStart(uint32_t submit_index, const SubmitIn
 }
 
 //--------------------------------------------------------------------------------------------------
-void CaptureMetadataCreator::OnSubmitEnd(uint32_t submit_index, const SubmitInfo &submit_info) {}
+void CaptureMetadataCreator::SetProgressTracker(ProgressTracker *progress_tracker,
+                                                uint32_t         num_submits)
+{
+    m_progress_tracker = progress_tracker;
+    m_num_submits = num_submits;
+    m_num_submits_parsed = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+void CaptureMetadataCreator::OnSubmitEnd(uint32_t submit_index, const SubmitInfo &submit_info)
+{
+    if (m_progress_tracker)
+    {
+        LoadProgress progress;
+        progress.m_stage = LoadProgress::Stage::kParsingSubmits;
+        progress.m_submits_parsed = ++m_num_submits_parsed;
+        progress.m_total_submits = m_num_submits;
+        progress.m_num_events = m_capture_metadata.m_event_info.size();
+        m_progress_tracker->sendProgress(progress);
+    }
+}
 
 //--------------------------------------------------------------------------------------------------
 bool CaptureMetadataCreator::OnIbStart(uint32_t                  submit_index,
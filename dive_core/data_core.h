@@ -24,6 +24,7 @@
 #include "dive_capture_data.h"
 #include "capture_event_info.h"
 #include "command_hierarchy.h"
+#include "context.h"
 #include "event_state.h"
 #include "progress_tracker.h"
 #include "dive_command_hierarchy.h"
@@ -54,6 +55,9 @@ struct CaptureMetadata
 
     // Information about the submits in this capture
     uint64_t m_num_pm4_packets;
+
+    // Approximate heap memory used by the metadata, in bytes
+    uint64_t GetMemoryUsage() const;
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -75,13 +79,38 @@ public:
 
     // Parse the capture to generate info that describes the capture
     bool ParseDiveCaptureData();
-    bool ParsePm4CaptureData();
+    bool ParsePm4CaptureData(const Context &context = Context::Background());
     bool ParseGfxrCaptureData();
 
+    // Parse the submits of `submit_range` of the pm4 capture into `capture_metadata`, leaving the
+    // current metadata untouched. This only reads the capture data, so it can run on a worker
+    // thread while the current metadata is in use, e.g. to parse the whole capture while its first
+    // submits are shown. The analysis cache is used when `submit_range` covers all the submits.
+    // Returns false on error or if `context` is cancelled.
+    bool ParsePm4CaptureMetadata(const Context     &context,
+                                 const SubmitRange &submit_range,
+                                 CaptureMetadata   &capture_metadata) const;
+
+    // Replace the metadata of the capture, e.g. by one from ParsePm4CaptureMetadata(), and return
+    // the previous one (e.g. to put it back in a SubmitMetadataCache)
+    CaptureMetadata SetCaptureMetadata(CaptureMetadata &&capture_metadata);
+
     // Create meta data from the captured data
     bool CreateDiveMetaData();
     bool CreatePm4MetaData();
 
+    // Whether ParsePm4CaptureData() loads and saves the analysis sidecar of the capture
+    // (see AnalysisCache). Disabled by default. Must be set before LoadPm4CaptureData(), which
+    // hashes the capture for the cache while reading it.
+    // Enabling it also enables the on-disk store of the ShaderDisassemblyCache, at its default
+    // directory. That store is shared by the process, so disabling it here leaves it enabled.
+    void SetAnalysisCacheEnabled(bool enabled);
+
+    // Restrict ParsePm4CaptureData() to a range of submits, e.g. to focus on a render pass of a
+    // large capture. The command hierarchy and the metadata then only have the events of these
+    // submits, which keep their submit index. The analysis cache is not used for a partial parse.
+    void SetSubmitRange(const SubmitRange &submit_range) { m_submit_range = submit_range; }
+
     // Get the dive capture data
     const DiveCaptureData &GetDiveCaptureData() const;
 
@@ -102,12 +131,24 @@ public:
 private:
     // Create command hierarchy from the captured data
     bool CreateDiveCommandHierarchy();
-    bool CreatePm4CommandHierarchy();
+    bool CreatePm4CommandHierarchy(const Context     &context,
+                                   const SubmitRange &submit_range,
+                                   CaptureMetadata   &capture_metadata) const;
     bool CreateGfxrCommandHierarchy();
+    bool CreatePm4MetaData(const Context     &context,
+                           const SubmitRange &submit_range,
+                           CaptureMetadata   &capture_metadata) const;
+    // Disassemble all the shaders of the capture in parallel, so that the first access from the
+    // UI does not stall. Disassembly is shared through the ShaderDisassemblyCache.
+    void DisassembleShaders(const Context &context, const CaptureMetadata &capture_metadata) const;
     // The relatively raw captured dive data (memory & submit blocks)
     DiveCaptureData m_dive_capture_data;
     // The relatively raw captured pm4 data (memory & submit blocks)
     Pm4CaptureData m_pm4_capture_data;
+    // File m_pm4_capture_data was loaded from, used to locate its analysis sidecar
+    std::string m_pm4_capture_file_name;
+    bool        m_use_analysis_cache = false;
+    SubmitRange m_submit_range;
     // The relatively raw captured gfxr data
     GfxrCaptureData m_gfxr_capture_data;
 
@@ -155,6 +196,9 @@ public:
 
     const EmulateStateTracker &GetStateTracker() const { return m_state_tracker; }
 
+    // Report the progress of ProcessSubmits() after each submit, out of `num_submits` submits
+    void SetProgressTracker(ProgressTracker *progress_tracker, uint32_t num_submits);
+
     // Callbacks
     virtual bool OnIbStart(uint32_t                  submit_index,
                            uint32_t                  ib_index,
@@ -191,6 +235,9 @@ private:
 
     CaptureMetadata &m_capture_metadata;
     RenderModeType   m_current_render_mode = RenderModeType::kUnknown;
+    ProgressTracker *m_progress_tracker = nullptr;
+    uint32_t         m_num_submits = 0;
+    uint32_t         m_num_submits_parsed = 0;
 
 #if defined(ENABLE_CAPTURE_BUFFERS)
     // SRDCallbacks is a friend class, since it is essentially doing part of
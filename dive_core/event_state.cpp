@@ -341,6 +341,34 @@ typename EventStateInfo::Id::basic_type new_cap)
 #endif
 }
 
+template<>
+bool EventStateInfoT<EventStateInfo_CONFIG>::AssignRaw(typename EventStateInfo::Id::basic_type size,
+                                                       typename EventStateInfo::Id::basic_type cap,
+                                                       const void*    buffer,
+                                                       size_t         buffer_size,
+                                                       const uint8_t* is_set_buffer,
+                                                       size_t         is_set_buffer_size)
+{
+    if (size > cap || (cap & (kAlignment - 1)) != 0 || buffer_size != cap * kElemSize)
+        return false;
+    if (is_set_buffer_size != (cap * kNumFields) / 8 + 1)
+        return false;
+
+    // Start from empty storage, so that `Reserve` allocates exactly `cap` elements
+    m_size = 0;
+    m_cap = 0;
+    m_buffer.reset();
+    m_is_set_buffer.clear();
+    if (cap == 0)
+        return true;
+    Reserve(cap);
+
+    memcpy(m_buffer.get(), buffer, buffer_size);
+    memcpy(m_is_set_buffer.data(), is_set_buffer, is_set_buffer_size);
+    m_size = size;
+    return true;
+}
+
 template<> EventStateInfo::Iterator EventStateInfoT<EventStateInfo_CONFIG>::Add()
 {
     if (m_size >= m_cap)
@@ -8116,6 +8116,23 @@ public:
     // `Clear` resets size to 0, but keeps the allocated memory.
     inline void Clear() { m_size = 0; }
 
+    // Raw access to the storage of all the fields, e.g. to persist the whole
+    // container at once. All field types are trivially copyable, and the layout
+    // of the storage only depends on `capacity()`.
+    inline const void*                 RawBuffer() const { return m_buffer.get(); }
+    inline size_t                      RawBufferSize() const { return kElemSize * m_cap; }
+    inline const std::vector<uint8_t>& RawIsSetBuffer() const { return m_is_set_buffer; }
+
+    // `AssignRaw` replaces the contents with the raw storage of a container
+    // with the given size and capacity. Returns false if the storage does not
+    // match the layout of this container.
+    bool AssignRaw(typename Id::basic_type size,
+                   typename Id::basic_type cap,
+                   const void*             buffer,
+                   size_t                  buffer_size,
+                   const uint8_t*          is_set_buffer,
+                   size_t                  is_set_buffer_size);
+
 protected:
     template<typename CONFIG_> friend class EventStateInfoRefT;
     template<typename CONFIG_> friend class EventStateInfoConstRefT;
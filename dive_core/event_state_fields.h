@@ -0,0 +1,67 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#pragma once
+
+//--------------------------------------------------------------------------------------------------
+// The scalar fields of EventStateInfo, as an X-macro: DIVE_EVENT_STATE_SCALAR_FIELDS(X) expands to
+// X(field) for each field. The array fields (viewports, scissors, attachments, ...) and the stencil
+// op states are not listed. Used by the capture diff and the python bindings, so both see the
+// same fields.
+#define DIVE_EVENT_STATE_SCALAR_FIELDS(X)                                                          \
+    X(Topology)                                                                                    \
+    X(PrimRestartEnabled)                                                                          \
+    X(PatchControlPoints)                                                                          \
+    X(DepthClampEnabled)                                                                           \
+    X(RasterizerDiscardEnabled)                                                                    \
+    X(PolygonMode)                                                                                 \
+    X(CullMode)                                                                                    \
+    X(FrontFace)                                                                                   \
+    X(DepthBiasEnabled)                                                                            \
+    X(DepthBiasConstantFactor)                                                                     \
+    X(DepthBiasClamp)                                                                              \
+    X(DepthBiasSlopeFactor)                                                                        \
+    X(LineWidth)                                                                                   \
+    X(RasterizationSamples)                                                                        \
+    X(SampleShadingEnabled)                                                                        \
+    X(MinSampleShading)                                                                            \
+    X(SampleMask)                                                                                  \
+    X(AlphaToCoverageEnabled)                                                                      \
+    X(DepthTestEnabled)                                                                            \
+    X(DepthWriteEnabled)                                                                           \
+    X(DepthCompareOp)                                                                              \
+    X(DepthBoundsTestEnabled)                                                                      \
+    X(MinDepthBounds)                                                                              \
+    X(MaxDepthBounds)                                                                              \
+    X(StencilTestEnabled)                                                                          \
+    X(LRZEnabled)                                                                                  \
+    X(LRZWrite)                                                                                    \
+    X(LRZDirStatus)                                                                                \
+    X(LRZDirWrite)                                                                                 \
+    X(ZTestMode)                                                                                   \
+    X(BinW)                                                                                        \
+    X(BinH)                                                                                        \
+    X(WindowScissorTLX)                                                                            \
+    X(WindowScissorTLY)                                                                            \
+    X(WindowScissorBRX)                                                                            \
+    X(WindowScissorBRY)                                                                            \
+    X(RenderMode)                                                                                  \
+    X(BuffersLocation)                                                                             \
+    X(ThreadSize)                                                                                  \
+    X(EnableAllHelperLanes)                                                                        \
+    X(EnablePartialHelperLanes)                                                                    \
+    X(UBWCEnabledOnDS)                                                                             \
+    X(UBWCLosslessEnabledOnDS)
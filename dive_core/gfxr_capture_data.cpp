@@ -18,9 +18,8 @@
 
 #include <iostream>
 #include "dive_core/common/common.h"
-#include "generated/generated_vulkan_dive_consumer.h"
+#include "dive_core/gfxr_parallel_decoder.h"
 #include "gfxr_ext/decode/dive_file_processor.h"
-#include "third_party/gfxreconstruct/framework/generated/generated_vulkan_decoder.h"
 
 namespace Dive
 {
@@ -49,14 +48,21 @@ CaptureData::LoadResult GfxrCaptureData::LoadCaptureFile(const std::string& file
 
     file_processor.SetDiveBlockData(m_gfxr_capture_block_data);
 
-    gfxrecon::decode::VulkanExportDiveConsumer dive_consumer;
-    gfxrecon::decode::VulkanDecoder            decoder;
-    decoder.AddConsumer(&dive_consumer);
-    file_processor.AddDecoder(&decoder);
+    // The whole file is processed, so the frame index comes for free. It is only kept in memory,
+    // see WriteFrameIndex().
+    auto frame_index = std::make_shared<gfxrecon::decode::DiveFrameIndex>();
+    file_processor.SetFrameIndexBuilder(frame_index);
 
+    // The blocks are read on this thread and their function calls are decoded on the thread pool
     DiveAnnotationProcessor dive_annotation_processor;
+    GfxrParallelDecoder     decoder(dive_annotation_processor);
+    for (DiveAnnotationProcessor::FunctionObserver* observer : m_load_observers)
+    {
+        dive_annotation_processor.AddFunctionObserver(observer);
+    }
+    m_load_observers.clear();
+    file_processor.AddDecoder(&decoder);
     file_processor.SetAnnotationProcessor(&dive_annotation_processor);
-    dive_consumer.Initialize(&dive_annotation_processor);
 
     if (!file_processor.ProcessAllFrames())
     {
@@ -65,11 +71,13 @@ CaptureData::LoadResult GfxrCaptureData::LoadCaptureFile(const std::string& file
         std::cerr << file_processor.GetErrorState() << std::endl;
         return LoadResult::kFileIoError;
     }
+    decoder.Finish();
 
     m_gfxr_submits = dive_annotation_processor.TakeSubmits();
     DIVE_ASSERT(!m_gfxr_submits.empty());
     m_gfxr_command_buffers = dive_annotation_processor.TakeVkCommandsCache();
     m_gfxr_draw_call_counts = dive_annotation_processor.TakeDrawCallMap();
+    m_gfxr_arg_arena = dive_annotation_processor.GetArgArena();
 
     if (!m_gfxr_capture_block_data->FinalizeOriginalBlocksMapSizes())
     {
@@ -77,11 +85,23 @@ CaptureData::LoadResult GfxrCaptureData::LoadCaptureFile(const std::string& file
         return LoadResult::kFileIoError;
     }
 
+    m_frame_index = std::move(frame_index);
     m_cur_capture_file = file_name;
 
     return LoadResult::kSuccess;
 }
 
+//--------------------------------------------------------------------------------------------------
+bool GfxrCaptureData::WriteFrameIndex(const std::string& index_file_name) const
+{
+    if (m_cur_capture_file.empty() || m_frame_index == nullptr)
+    {
+        std::cerr << "Error: no loaded gfxr file" << std::endl;
+        return false;
+    }
+    return m_frame_index->Save(index_file_name, m_cur_capture_file);
+}
+
 //--------------------------------------------------------------------------------------------------
 bool GfxrCaptureData::WriteModifiedGfxrFile(const char* new_file_name)
 {
@@ -18,6 +18,7 @@
 #include "dive_core/capture_data.h"
 #include "gfxr_ext/decode/dive_annotation_processor.h"
 #include "gfxr_ext/decode/dive_block_data.h"
+#include "gfxr_ext/decode/dive_frame_index.h"
 
 namespace Dive
 {
@@ -36,10 +37,18 @@ public:
     const std::vector<DiveAnnotationProcessor::VulkanCommandInfo>           &GetGfxrCommandBuffers(
               uint64_t cmd_handle) const;
     const DiveAnnotationProcessor::DrawCallCounts &GetDrawCallCounts(uint64_t cmd_handle) const;
+    const std::shared_ptr<const DiveArgArena>     &GetArgArena() const { return m_gfxr_arg_arena; }
 
     // Sets m_cur_capture_file and m_gfxr_capture_block_data with info from the original GFXR file
     LoadResult LoadCaptureFile(const std::string &file_name) override;
 
+    // Adds an observer of the vulkan commands of the next LoadCaptureFile(), which sees them in
+    // capture order. The observer must outlive the load.
+    void AddLoadObserver(DiveAnnotationProcessor::FunctionObserver *observer)
+    {
+        m_load_observers.push_back(observer);
+    }
+
     // Get the gfxr data
     bool IsDiveBlockDataInitialized() const { return m_gfxr_capture_block_data != nullptr; }
     std::shared_ptr<gfxrecon::decode::DiveBlockData> GetMutableGfxrData()
@@ -51,6 +60,17 @@ public:
     // recorded in m_gfxr_capture_block_data
     bool WriteModifiedGfxrFile(const char *new_file_name);
 
+    // Positions of the frames of the loaded file, built while loading it
+    const std::shared_ptr<const gfxrecon::decode::DiveFrameIndex> &GetFrameIndex() const
+    {
+        return m_frame_index;
+    }
+
+    // Writes the frame index of the loaded file, e.g. to
+    // DiveFrameIndex::GetIndexFilePath(<capture>) to be pushed with the capture for the replay of a
+    // range of frames
+    bool WriteFrameIndex(const std::string &index_file_name) const;
+
 private:
     // Metadata for the original GFXR file m_cur_capture_file, as well as modifications
     std::shared_ptr<gfxrecon::decode::DiveBlockData> m_gfxr_capture_block_data = nullptr;
@@ -60,6 +80,13 @@ private:
     std::unordered_map<uint64_t, std::vector<DiveAnnotationProcessor::VulkanCommandInfo>>
                                                                           m_gfxr_command_buffers;
     std::unordered_map<uint64_t, DiveAnnotationProcessor::DrawCallCounts> m_gfxr_draw_call_counts;
+
+    // Arguments of all the vulkan commands above
+    std::shared_ptr<const DiveArgArena> m_gfxr_arg_arena = nullptr;
+
+    std::shared_ptr<const gfxrecon::decode::DiveFrameIndex> m_frame_index = nullptr;
+
+    std::vector<DiveAnnotationProcessor::FunctionObserver *> m_load_observers;
 };
 
 }  // namespace Dive
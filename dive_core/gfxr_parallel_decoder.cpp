@@ -0,0 +1,217 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "gfxr_parallel_decoder.h"
+
+#include <cstring>
+#include "dive_core/common/common.h"
+#include "generated/generated_vulkan_dive_consumer.h"
+#include "third_party/gfxreconstruct/framework/decode/decode_allocator.h"
+
+namespace Dive
+{
+
+//--------------------------------------------------------------------------------------------------
+// Keeps the functions of a batch in order, instead of processing them
+class GfxrParallelDecoder::Collector : public gfxrecon::decode::AnnotationHandler
+{
+public:
+    explicit Collector(std::vector<DecodedFunction> &functions) :
+        m_functions(functions)
+    {
+    }
+
+    void ProcessAnnotation(uint64_t                         block_index,
+                           gfxrecon::format::AnnotationType type,
+                           const std::string               &label,
+                           const std::string               &data) override
+    {
+    }
+
+    void WriteBlockEnd(const gfxrecon::util::DiveFunctionData &function_data) override
+    {
+        // The consumer only gives an index to the commands recorded in a command buffer
+        m_functions.push_back({ function_data.GetFunctionName(),
+                                function_data.GetCmdBufferIndex() != 0,
+                                function_data.GetBlockIndex(),
+                                function_data.GetArgs() });
+    }
+
+private:
+    std::vector<DecodedFunction> &m_functions;
+};
+
+// =================================================================================================
+// GfxrParallelDecoder
+// =================================================================================================
+GfxrParallelDecoder::GfxrParallelDecoder(DiveAnnotationProcessor &annotation_processor,
+                                         ThreadPool              &pool) :
+    m_annotation_processor(annotation_processor),
+    m_pool(pool),
+    m_task_group(pool),
+    m_max_in_flight_batches(kInFlightBatchesPerWorker * (pool.NumWorkers() + 1))
+{
+    // A worker which waits for the decoding tasks without helping could starve the pool
+    if (m_pool.NumWorkers() == 0 || m_pool.IsWorkerThread())
+    {
+        m_sequential_consumer = std::make_unique<gfxrecon::decode::VulkanExportDiveConsumer>();
+        m_sequential_consumer->Initialize(&m_annotation_processor);
+        AddConsumer(m_sequential_consumer.get());
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+GfxrParallelDecoder::~GfxrParallelDecoder()
+{
+    // The tasks reference the batches
+    m_task_group.Wait();
+}
+
+//--------------------------------------------------------------------------------------------------
+void GfxrParallelDecoder::DecodeFunctionCall(gfxrecon::format::ApiCallId           call_id,
+                                             const gfxrecon::decode::ApiCallInfo &call_info,
+                                             const uint8_t                        *parameter_buffer,
+                                             size_t                                buffer_size)
+{
+    if (m_sequential_consumer != nullptr)
+    {
+        VulkanDecoder::DecodeFunctionCall(call_id, call_info, parameter_buffer, buffer_size);
+        return;
+    }
+
+    if (m_current_batch == nullptr)
+    {
+        m_current_batch = std::make_unique<Batch>();
+        m_current_batch->m_parameters.reserve(kBatchParameterSize);
+    }
+
+    // The parameter buffer of the file processor is reused for the next block
+    std::vector<uint8_t> &parameters = m_current_batch->m_parameters;
+    size_t                offset = parameters.size();
+    parameters.resize(offset + buffer_size);
+    std::memcpy(parameters.data() + offset, parameter_buffer, buffer_size);
+    m_current_batch->m_calls.push_back({ call_id, call_info, offset, buffer_size });
+
+    if (parameters.size() >= kBatchParameterSize ||
+        m_current_batch->m_calls.size() >= kBatchCallCount)
+    {
+        SubmitBatch();
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+void GfxrParallelDecoder::Finish()
+{
+    if (m_current_batch != nullptr)
+    {
+        SubmitBatch();
+    }
+
+    // Unlike during the file processing, the calling thread can run decoding tasks from here
+    m_task_group.Wait();
+    MergeDecodedBatches(false);
+    DIVE_ASSERT(m_in_flight_batches.empty());
+}
+
+//--------------------------------------------------------------------------------------------------
+void GfxrParallelDecoder::DecodeBatch(Batch &batch)
+{
+    gfxrecon::decode::VulkanExportDiveConsumer consumer;
+    gfxrecon::decode::VulkanDecoder            decoder;
+    Collector                                  collector(batch.m_functions);
+    decoder.AddConsumer(&consumer);
+    consumer.Initialize(&collector);
+
+    batch.m_functions.reserve(batch.m_calls.size());
+    for (const FunctionCall &call : batch.m_calls)
+    {
+        gfxrecon::decode::DecodeAllocator::Begin();
+        decoder.SetCurrentApiCallId(call.m_call_id);
+        decoder.DecodeFunctionCall(call.m_call_id,
+                                   call.m_call_info,
+                                   batch.m_parameters.data() + call.m_parameter_offset,
+                                   call.m_parameter_size);
+        gfxrecon::decode::DecodeAllocator::End();
+    }
+
+    // The parameters are not needed anymore, and the allocator of this thread is only used again
+    // by the next batch
+    batch.m_parameters = {};
+    batch.m_calls = {};
+    gfxrecon::decode::DecodeAllocator::DestroyInstance();
+}
+
+//--------------------------------------------------------------------------------------------------
+void GfxrParallelDecoder::SubmitBatch()
+{
+    Batch *batch = m_current_batch.get();
+    m_in_flight_batches.push_back(std::move(m_current_batch));
+
+    m_task_group.Run([this, batch]() {
+        DecodeBatch(*batch);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        batch->m_decoded = true;
+        m_decoded_condition_variable.notify_all();
+    });
+
+    // Merge as the decoding progresses, so that the json of the decoded batches does not pile up
+    MergeDecodedBatches(m_in_flight_batches.size() >= m_max_in_flight_batches);
+}
+
+//--------------------------------------------------------------------------------------------------
+void GfxrParallelDecoder::MergeBatch(Batch &batch)
+{
+    for (const DecodedFunction &function : batch.m_functions)
+    {
+        uint32_t cmd_buffer_index = 0;
+        if (function.m_is_recorded_command)
+        {
+            uint64_t cmd_handle = function.m_args.value("commandBuffer", uint64_t(0));
+            cmd_buffer_index = ++m_cmd_buffer_indices[cmd_handle];
+        }
+        m_annotation_processor.ProcessFunction(function.m_name,
+                                               cmd_buffer_index,
+                                               function.m_block_index,
+                                               function.m_args);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+void GfxrParallelDecoder::MergeDecodedBatches(bool wait)
+{
+    while (!m_in_flight_batches.empty())
+    {
+        Batch &batch = *m_in_flight_batches.front();
+        {
+            // Do not help with the tasks while waiting: the calling thread is in the middle of
+            // decoding a block, and the decoding tasks use the decode allocator of their thread
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (wait)
+            {
+                m_decoded_condition_variable.wait(lock, [&batch]() { return batch.m_decoded; });
+            }
+            else if (!batch.m_decoded)
+            {
+                return;
+            }
+        }
+        MergeBatch(batch);
+        m_in_flight_batches.pop_front();
+        wait = false;
+    }
+}
+
+}  // namespace Dive
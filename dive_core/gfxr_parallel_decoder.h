@@ -0,0 +1,141 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dive_core/thread_pool.h"
+#include "gfxr_ext/decode/dive_annotation_processor.h"
+#include "third_party/gfxreconstruct/framework/generated/generated_vulkan_decoder.h"
+
+namespace gfxrecon::decode
+{
+class VulkanExportDiveConsumer;
+}
+
+namespace Dive
+{
+
+//--------------------------------------------------------------------------------------------------
+// Vulkan decoder which converts the function calls of a gfxr capture to json on a thread pool.
+//
+// The file processor reads the blocks of the capture in order, on the calling thread, and hands
+// the parameters of each function call to DecodeFunctionCall(). The parameters are copied into a
+// batch, and full batches are decoded by a VulkanExportDiveConsumer on the pool. Decoded batches
+// are merged in capture order on the calling thread, which feeds the commands to the
+// DiveAnnotationProcessor, so the result is the same as decoding the whole capture sequentially.
+//
+// The index of a command within its command buffer is tracked by the consumer, so it is
+// recomputed during the merge: each batch is decoded by a fresh consumer which only sees part of
+// the capture.
+//
+// Without pool workers, or when created on a worker of the pool, the function calls are decoded
+// sequentially as they are read.
+//
+// Usage:
+//     GfxrParallelDecoder decoder(annotation_processor);
+//     file_processor.AddDecoder(&decoder);
+//     file_processor.ProcessAllFrames();
+//     decoder.Finish();
+class GfxrParallelDecoder : public gfxrecon::decode::VulkanDecoder
+{
+public:
+    explicit GfxrParallelDecoder(DiveAnnotationProcessor &annotation_processor,
+                                 ThreadPool              &pool = ThreadPool::Shared());
+    ~GfxrParallelDecoder() override;
+
+    GfxrParallelDecoder(const GfxrParallelDecoder &) = delete;
+    GfxrParallelDecoder &operator=(const GfxrParallelDecoder &) = delete;
+
+    void DecodeFunctionCall(gfxrecon::format::ApiCallId           call_id,
+                            const gfxrecon::decode::ApiCallInfo &call_info,
+                            const uint8_t                        *parameter_buffer,
+                            size_t                                buffer_size) override;
+
+    // Decode the pending function calls and merge them. Must be called once the file processor is
+    // done, before using the annotation processor.
+    void Finish();
+
+private:
+    // Batches are flushed once they reach either limit. Large enough to amortize the scheduling
+    // and the creation of the consumer, small enough to keep all the workers busy.
+    static constexpr size_t kBatchParameterSize = 1024 * 1024;
+    static constexpr size_t kBatchCallCount = 4096;
+
+    // Bounds the memory used by the parameters and the json of the batches in flight
+    static constexpr size_t kInFlightBatchesPerWorker = 4;
+
+    struct FunctionCall
+    {
+        gfxrecon::format::ApiCallId   m_call_id;
+        gfxrecon::decode::ApiCallInfo m_call_info;
+        size_t                        m_parameter_offset;
+        size_t                        m_parameter_size;
+    };
+
+    struct DecodedFunction
+    {
+        std::string            m_name;
+        bool                   m_is_recorded_command;
+        uint64_t               m_block_index;
+        nlohmann::ordered_json m_args;
+    };
+
+    struct Batch
+    {
+        std::vector<uint8_t>         m_parameters;
+        std::vector<FunctionCall>    m_calls;
+        std::vector<DecodedFunction> m_functions;
+        bool                         m_decoded = false;
+    };
+
+    class Collector;
+
+    static void DecodeBatch(Batch &batch);
+
+    void SubmitBatch();
+    void MergeBatch(Batch &batch);
+
+    // Merge the batches that are decoded, in order, until the first one which is not. With
+    // `wait`, waits for the oldest batch to be decoded first.
+    void MergeDecodedBatches(bool wait);
+
+    DiveAnnotationProcessor &m_annotation_processor;
+    ThreadPool              &m_pool;
+    TaskGroup                m_task_group;
+    size_t                   m_max_in_flight_batches;
+
+    std::unique_ptr<Batch>             m_current_batch;
+    std::deque<std::unique_ptr<Batch>> m_in_flight_batches;
+    std::mutex                         m_mutex;
+    std::condition_variable            m_decoded_condition_variable;
+
+    // Index of the last recorded command of each command buffer
+    std::unordered_map<uint64_t, uint32_t> m_cmd_buffer_indices;
+
+    // Consumer of the sequential decoding
+    std::unique_ptr<gfxrecon::decode::VulkanExportDiveConsumer> m_sequential_consumer;
+};
+
+}  // namespace Dive
@@ -24,7 +24,14 @@ GfxrVulkanCommandHierarchyCreator::GfxrVulkanCommandHierarchyCreator(
 CommandHierarchy      &command_hierarchy,
 const GfxrCaptureData &capture_data) :
     m_command_hierarchy(command_hierarchy),
-    m_capture_data(capture_data)
+    m_capture_data(&capture_data)
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+GfxrVulkanCommandHierarchyCreator::GfxrVulkanCommandHierarchyCreator(
+CommandHierarchy &command_hierarchy) :
+    m_command_hierarchy(command_hierarchy)
 {
 }
 
@@ -53,17 +60,18 @@ const DiveAnnotationProcessor::VulkanCommandInfo &vk_cmd_info,
 uint64_t                                          draw_call_count,
 std::vector<uint64_t>                            &render_pass_draw_call_counts)
 {
-    const std::string            &vulkan_cmd_name = vk_cmd_info.name;
-    const nlohmann::ordered_json &vulkan_cmd_args = vk_cmd_info.args;
-    std::ostringstream            vk_cmd_string_stream;
+    const std::string        &vulkan_cmd_name = vk_cmd_info.name;
+    CommandHierarchy::AuxInfo args_info = CommandHierarchy::AuxInfo::GfxrCommandNode(
+    vk_cmd_info.args_offset);
+    std::ostringstream        vk_cmd_string_stream;
     vk_cmd_string_stream << vulkan_cmd_name;
     if (vulkan_cmd_name == "vkBeginCommandBuffer")
     {
         vk_cmd_string_stream << ", Draw Call Count: " << draw_call_count;
         uint64_t cmd_buffer_index = AddNode(NodeType::kGfxrVulkanBeginCommandBufferNode,
-                                            vk_cmd_string_stream.str());
+                                            vk_cmd_string_stream.str(),
+                                            args_info);
         m_cur_command_buffer_node_index = cmd_buffer_index;
-        GetArgs(vulkan_cmd_args, m_cur_command_buffer_node_index, "");
         AddChild(CommandHierarchy::TopologyType::kAllEventTopology,
                  m_cur_submit_node_index,
                  cmd_buffer_index);
@@ -71,21 +79,20 @@ std::vector<uint64_t>                            &render_pass_draw_call_counts)
     else if (vulkan_cmd_name == "vkEndCommandBuffer")
     {
         uint64_t cmd_buffer_index = AddNode(NodeType::kGfxrVulkanEndCommandBufferNode,
-                                            vk_cmd_string_stream.str());
-
-        GetArgs(vulkan_cmd_args, cmd_buffer_index, "");
+                                            vk_cmd_string_stream.str(),
+                                            args_info);
         AddChild(CommandHierarchy::TopologyType::kAllEventTopology,
                  m_cur_command_buffer_node_index,
                  cmd_buffer_index);
     }
     else if (vulkan_cmd_name.find("BeginDebugUtilsLabelEXT") != std::string::npos)
     {
-        std::string label_name = vulkan_cmd_args["pLabelInfo"]["pLabelName"];
+        std::string label_name = vk_cmd_info.GetArgs()["pLabelInfo"]["pLabelName"];
 
         uint64_t
         begin_debug_utils_label_cmd_index = AddNode(NodeType::kGfxrBeginDebugUtilsLabelCommandNode,
-                                                    label_name.c_str());
-        GetArgs(vulkan_cmd_args, begin_debug_utils_label_cmd_index, "");
+                                                    label_name.c_str(),
+                                                    args_info);
         ConditionallyAddChild(begin_debug_utils_label_cmd_index);
         m_cur_parent_node_index_stack.push(begin_debug_utils_label_cmd_index);
     }
@@ -103,8 +110,8 @@ std::vector<uint64_t>                            &render_pass_draw_call_counts)
              vulkan_cmd_name.find("vkCmdDispatch") != std::string::npos)
     {
         uint64_t vk_cmd_index = AddNode(NodeType::kGfxrVulkanDrawCommandNode,
-                                        vk_cmd_string_stream.str());
-        GetArgs(vulkan_cmd_args, vk_cmd_index, "");
+                                        vk_cmd_string_stream.str(),
+                                        args_info);
         ConditionallyAddChild(vk_cmd_index);
     }
     else if (vulkan_cmd_name.find("vkCmdBeginRenderPass") != std::string::npos)
@@ -116,16 +123,16 @@ std::vector<uint64_t>                            &render_pass_draw_call_counts)
         }
         vk_cmd_string_stream << ", Draw Call Count: " << draw_call_count;
         uint64_t vk_cmd_index = AddNode(NodeType::kGfxrVulkanBeginRenderPassCommandNode,
-                                        vk_cmd_string_stream.str());
-        GetArgs(vulkan_cmd_args, vk_cmd_index, "");
+                                        vk_cmd_string_stream.str(),
+                                        args_info);
         ConditionallyAddChild(vk_cmd_index);
         m_cur_parent_node_index_stack.push(vk_cmd_index);
     }
     else if (vulkan_cmd_name.find("vkCmdEndRenderPass") != std::string::npos)
     {
         uint64_t vk_cmd_index = AddNode(NodeType::kGfxrVulkanEndRenderPassCommandNode,
-                                        vk_cmd_string_stream.str());
-        GetArgs(vulkan_cmd_args, vk_cmd_index, "");
+                                        vk_cmd_string_stream.str(),
+                                        args_info);
         ConditionallyAddChild(vk_cmd_index);
         if (!m_cur_parent_node_index_stack.empty())
         {
@@ -136,8 +143,8 @@ std::vector<uint64_t>                            &render_pass_draw_call_counts)
     else
     {
         uint64_t vk_cmd_index = AddNode(NodeType::kGfxrVulkanCommandNode,
-                                        vk_cmd_string_stream.str());
-        GetArgs(vulkan_cmd_args, vk_cmd_index, "");
+                                        vk_cmd_string_stream.str(),
+                                        args_info);
         ConditionallyAddChild(vk_cmd_index);
     }
 }
@@ -152,8 +159,7 @@ const std::vector<uint64_t>                                   &render_pass_draw_
 
     for (uint32_t i = 0; i < vkCmds.size(); ++i)
     {
-        DiveAnnotationProcessor::VulkanCommandInfo vk_cmd_info = vkCmds[i];
-        OnCommand(vk_cmd_info, draw_call_count, mutable_render_pass_draw_call_counts);
+        OnCommand(vkCmds[i], draw_call_count, mutable_render_pass_draw_call_counts);
     }
 
     // Ensure the parent node index stack is cleared
@@ -172,6 +178,9 @@ bool GfxrVulkanCommandHierarchyCreator::ProcessGfxrSubmits(const GfxrCaptureData
     uint64_t frame_root_node_index = AddNode(NodeType::kGfxrRootFrameNode, "Frame");
     AddChild(CommandHierarchy::kAllEventTopology, Topology::kRootNodeIndex, frame_root_node_index);
 
+    // The argument nodes are created on demand from the arguments of the capture
+    m_command_hierarchy.m_gfxr_arg_arena = capture_data.GetArgArena();
+
     const auto &submits = capture_data.GetGfxrSubmits();
     for (uint32_t submit_index = 0; submit_index < submits.size(); ++submit_index)
     {
@@ -214,7 +223,7 @@ bool GfxrVulkanCommandHierarchyCreator::CreateTrees(bool used_in_mixed_command_h
         uint64_t root_node_index = AddNode(NodeType::kRootNode, "");
         DIVE_VERIFY(root_node_index == Topology::kRootNodeIndex);
 
-        if (!ProcessGfxrSubmits(m_capture_data))
+        if (!ProcessGfxrSubmits(*m_capture_data))
         {
             return false;
         }
@@ -227,9 +236,43 @@ bool GfxrVulkanCommandHierarchyCreator::CreateTrees(bool used_in_mixed_command_h
 }
 
 //--------------------------------------------------------------------------------------------------
-uint64_t GfxrVulkanCommandHierarchyCreator::AddNode(NodeType type, std::string &&desc)
+bool GfxrVulkanCommandHierarchyCreator::CreateArgTrees(const CommandHierarchy &command_hierarchy,
+                                                       uint64_t                command_node_index)
+{
+    if (!command_hierarchy.HasGfxrCommandArgs(command_node_index))
+    {
+        return false;
+    }
+
+    m_used_in_mixed_command_hierarchy = false;
+    ClearCreatedDiveIndices();
+    for (uint32_t topology = 0; topology < CommandHierarchy::kTopologyTypeCount; ++topology)
+    {
+        m_node_children[topology].clear();
+        m_node_root_node_indices[topology].clear();
+    }
+    m_command_hierarchy = CommandHierarchy();
+
+    uint64_t root_node_index = AddNode(NodeType::kRootNode, "");
+    DIVE_VERIFY(root_node_index == Topology::kRootNodeIndex);
+
+    uint64_t vk_cmd_index = AddNode(command_hierarchy.GetNodeType(command_node_index),
+                                    command_hierarchy.GetNodeDesc(command_node_index));
+    AddChild(CommandHierarchy::kAllEventTopology, root_node_index, vk_cmd_index);
+
+    uint64_t args_offset = command_hierarchy.GetGfxrCommandNodeArgsOffset(command_node_index);
+    GetArgs(command_hierarchy.m_gfxr_arg_arena->Get(args_offset), vk_cmd_index, "");
+
+    CreateTopologies();
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t GfxrVulkanCommandHierarchyCreator::AddNode(NodeType                  type,
+                                                    std::string             &&desc,
+                                                    CommandHierarchy::AuxInfo aux_info)
 {
-    uint64_t node_index = m_command_hierarchy.AddGfxrNode(type, std::move(desc));
+    uint64_t node_index = m_command_hierarchy.AddGfxrNode(type, std::move(desc), aux_info);
 
     if (m_used_in_mixed_command_hierarchy)
     {
@@ -29,8 +29,15 @@ class GfxrVulkanCommandHierarchyCreator
 public:
     GfxrVulkanCommandHierarchyCreator(CommandHierarchy      &command_hierarchy,
                                       const GfxrCaptureData &capture_data);
+    // Only for CreateArgTrees()
+    explicit GfxrVulkanCommandHierarchyCreator(CommandHierarchy &command_hierarchy);
 
     bool CreateTrees(bool used_in_mixed_command_hierarchy = false);
+
+    // Create a hierarchy made of a copy of the vulkan command node `command_node_index` of
+    // `command_hierarchy`, with its arguments as kGfxrVulkanCommandArgNode children. Returns false
+    // if the node has no arguments.
+    bool CreateArgTrees(const CommandHierarchy &command_hierarchy, uint64_t command_node_index);
     bool ProcessGfxrSubmits(const GfxrCaptureData &capture_date);
 
     void OnGfxrSubmit(uint32_t                                   submit_index,
@@ -60,7 +67,7 @@ private:
                      uint64_t                      curr_index,
                      const std::string            &current_path = "");
     void     CreateTopologies();
-    uint64_t AddNode(NodeType type, std::string &&desc);
+    uint64_t AddNode(NodeType type, std::string &&desc, CommandHierarchy::AuxInfo aux_info = 0);
     void     AddChild(CommandHierarchy::TopologyType type,
                       uint64_t                       node_index,
                       uint64_t                       child_node_index);
@@ -70,7 +77,7 @@ private:
     uint64_t               m_cur_command_buffer_node_index = 0;
     std::stack<uint64_t>   m_cur_parent_node_index_stack;
     CommandHierarchy      &m_command_hierarchy;
-    const GfxrCaptureData &m_capture_data;
+    const GfxrCaptureData *m_capture_data = nullptr;
     // This is a list of child indices per node, ie. topology info
     // Once parsing is complete, we will create a topology from this
     DiveVector<DiveVector<uint64_t>> m_node_children[CommandHierarchy::kTopologyTypeCount];
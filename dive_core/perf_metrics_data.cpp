@@ -422,9 +422,6 @@ HashMap<NodeIndex, DrawIndex>&  out_node_to_draw)
         alias_draws.clear();
     };
 
-    auto& alias_marker = command_hierarchy.GetFilterExcludeIndices(
-    Dive::CommandHierarchy::kBinningPassOnly);
-
     for (size_t i = 0; i < command_hierarchy.size(); ++i)
     {
         auto node_type = command_hierarchy.GetNodeType(i);
@@ -435,7 +432,7 @@ HashMap<NodeIndex, DrawIndex>&  out_node_to_draw)
         if (node_type == Dive::NodeType::kRenderMarkerNode)
         {
             dedupe();
-            if (alias_marker.find(i) != alias_marker.end())
+            if (command_hierarchy.IsFilterExcluded(i, Dive::CommandHierarchy::kBinningPassOnly))
             {
                 draws = &alias_draws;
             }
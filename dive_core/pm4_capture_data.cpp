@@ -39,11 +39,12 @@ namespace
 constexpr const uint64_t
 kMaxNumMemAlloc = (uint64_t(24) << 30) /
                   (4 * 1024);  // Number of allocation in 4k chunks for 16+8 GiB memory
-constexpr const uint32_t kMaxMemAllocSize = 1 << 30;      // 1 GiB
-constexpr const uint32_t kMaxStrLen = 100 << 20;          // 100 MiB
-constexpr const uint32_t kMaxNumWavesPerBlock = 1 << 20;  // 1 MiB
-constexpr const uint32_t kMaxNumSGPRPerWave = 1 << 20;    // 1 MiB
-constexpr const uint32_t kMaxNumVGPRPerWave = 1 << 20;    // 1 MiB
+constexpr const uint32_t kMaxMemAllocSize = 1 << 30;         // 1 GiB
+constexpr const uint32_t kMaxStrLen = 100 << 20;             // 100 MiB
+constexpr const uint32_t kMaxNumWavesPerBlock = 1 << 20;     // 1 MiB
+constexpr const uint32_t kMaxNumSGPRPerWave = 1 << 20;       // 1 MiB
+constexpr const uint32_t kMaxNumVGPRPerWave = 1 << 20;       // 1 MiB
+constexpr const uint64_t kProgressIntervalBytes = 16 << 20;  // 16 MiB
 }  // namespace
 
 //--------------------------------------------------------------------------------------------------
@@ -93,6 +94,13 @@ int FileReader::Open()
         return ret;
     }
 
+    std::error_code ec;
+    m_file_size = std::filesystem::file_size(m_file_name, ec);
+    if (ec)
+    {
+        m_file_size = 0;
+    }
+
     ret = archive_read_open_filename(m_handle.get(), m_file_name.c_str(), 10240);
     if (ret != ARCHIVE_OK)
     {
@@ -128,9 +136,32 @@ int64_t FileReader::Read(char *buf, int64_t nbytes)
         nbytes -= n;
         ret += n;
     }
+    if (m_content_hasher)
+    {
+        m_content_hasher->Update(buf, static_cast<size_t>(ret));
+        m_content_size += static_cast<uint64_t>(ret);
+    }
     return ret;
 }
 
+//--------------------------------------------------------------------------------------------------
+bool FileReader::GetContentHash(uint64_t &content_size, uint64_t &content_hash) const
+{
+    if (!m_content_hasher)
+        return false;
+    content_size = m_content_size;
+    content_hash = m_content_hasher->Finalize();
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t FileReader::GetBytesRead() const
+{
+    // -1 is the last filter of the chain, which reads the file itself
+    int64_t bytes_read = archive_filter_bytes(m_handle.get(), -1);
+    return bytes_read > 0 ? static_cast<uint64_t>(bytes_read) : 0;
+}
+
 //--------------------------------------------------------------------------------------------------
 int FileReader::Close()
 {
@@ -194,6 +225,12 @@ void MemoryAllocationInfo::AddMemoryAllocations(uint32_t
 // =================================================================================================
 // MemoryManager
 // =================================================================================================
+MemoryManager::MemoryManager(MemoryManager &&other)
+{
+    *this = std::move(other);
+}
+
+//--------------------------------------------------------------------------------------------------
 MemoryManager::~MemoryManager()
 {
     for (uint32_t i = 0; i < m_memory_blocks.size(); ++i)
@@ -202,6 +239,26 @@ MemoryManager::~MemoryManager()
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+MemoryManager &MemoryManager::operator=(MemoryManager &&other)
+{
+    if (this != &other)
+    {
+        for (uint32_t i = 0; i < m_memory_blocks.size(); ++i)
+        {
+            delete[] m_memory_blocks[i].m_data_ptr;
+        }
+        // The blocks own their data, which `other` no longer frees
+        m_memory_blocks = std::move(other.m_memory_blocks);
+        other.m_memory_blocks.clear();
+        m_memory_allocations = std::move(other.m_memory_allocations);
+        m_same_submit_only = other.m_same_submit_only;
+        m_last_used_block_ptr = nullptr;
+        other.m_last_used_block_ptr = nullptr;
+    }
+    return *this;
+}
+
 //--------------------------------------------------------------------------------------------------
 void MemoryManager::AddMemoryBlock(uint32_t submit_index, uint64_t va_addr, MemoryData &&data)
 {
@@ -354,9 +411,10 @@ bool MemoryManager::RetrieveMemoryData(void    *buffer_ptr,
                                        uint64_t size) const
 {
     // Check the last-used block first, because this is the desired block most of the time
-    if (m_last_used_block_ptr != nullptr)
+    const MemoryBlock *last_used_block_ptr = m_last_used_block_ptr.load(std::memory_order_relaxed);
+    if (last_used_block_ptr != nullptr)
     {
-        const MemoryBlock &mem_block = *m_last_used_block_ptr;
+        const MemoryBlock &mem_block = *last_used_block_ptr;
         uint64_t           mem_block_end_addr = mem_block.m_va_addr + mem_block.m_data_size;
         uint64_t           end_addr = va_addr + size;
 
@@ -391,7 +449,7 @@ bool MemoryManager::RetrieveMemoryData(void    *buffer_ptr,
         bool overlaps = (va_addr < mem_block_end_addr) && (mem_block.m_va_addr < end_addr);
         if (valid_submit && overlaps)
         {
-            m_last_used_block_ptr = &mem_block;
+            m_last_used_block_ptr.store(&mem_block, std::memory_order_relaxed);
             uint64_t max_start_addr = std::max(va_addr, mem_block.m_va_addr);
             uint64_t min_end_addr = std::min(mem_block_end_addr, end_addr);
             uint64_t src_offset = max_start_addr - mem_block.m_va_addr;
@@ -909,6 +967,10 @@ CaptureData::LoadResult Pm4CaptureData::LoadAdrenoRdFile(const std::string &file
         std::cerr << "Not able to open: " << file_name << std::endl;
         return LoadResult::kFileIoError;
     }
+    if (m_hash_content)
+    {
+        reader.EnableContentHash();
+    }
     auto result = LoadAdrenoRdFile(reader);
     if (result != LoadResult::kSuccess)
     {
@@ -917,6 +979,7 @@ CaptureData::LoadResult Pm4CaptureData::LoadAdrenoRdFile(const std::string &file
     else
     {
         m_cur_capture_file = std::string(file_name);
+        m_has_content_hash = reader.GetContentHash(m_content_size, m_content_hash);
     }
 
     return result;
@@ -1017,8 +1080,22 @@ CaptureData::LoadResult Pm4CaptureData::LoadAdrenoRdFile(FileReader &capture_fil
     uint32_t  cur_size = UINT32_MAX;
     bool      is_new_submit = false;
     bool      skip_commands = false;
+
+    LoadProgress progress;
+    progress.m_total_bytes = capture_file.GetFileSize();
+    uint64_t next_progress_bytes = 0;
     while (capture_file.Read((char *)&block_info, sizeof(block_info)) > 0)
     {
+        if (m_progress_tracker)
+        {
+            progress.m_bytes_read = capture_file.GetBytesRead();
+            if (progress.m_bytes_read >= next_progress_bytes)
+            {
+                m_progress_tracker->sendProgress(progress);
+                next_progress_bytes = progress.m_bytes_read + kProgressIntervalBytes;
+            }
+        }
+
         // Read and discard any trailing 0xffffffff padding from previous block
         while (block_info.m_block_type == 0xffffffff && block_info.m_data_size == 0xffffffff)
         {
@@ -1114,6 +1191,16 @@ CaptureData::LoadResult Pm4CaptureData::LoadAdrenoRdFile(FileReader &capture_fil
     return LoadResult::kSuccess;
 }
 
+//--------------------------------------------------------------------------------------------------
+bool Pm4CaptureData::GetContentHash(uint64_t &content_size, uint64_t &content_hash) const
+{
+    if (!m_has_content_hash)
+        return false;
+    content_size = m_content_size;
+    content_hash = m_content_hash;
+    return true;
+}
+
 //--------------------------------------------------------------------------------------------------
 CaptureDataHeader::CaptureType Pm4CaptureData::GetCaptureType() const
 {
@@ -15,13 +15,16 @@
 */
 
 #pragma once
+#include <atomic>
 #include <fstream>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include "third_party/libarchive/libarchive/archive.h"
 #include "common.h"
 #include "dive_core/common/dive_capture_format.h"
+#include "dive_core/common/hash_utils.h"
 #include "dive_core/common/memory_manager_base.h"
 #include "log.h"
 #include "progress_tracker.h"
@@ -85,8 +88,14 @@ struct MemoryData
 class MemoryManager : public IMemoryManager
 {
 public:
+    MemoryManager() = default;
+    MemoryManager(const MemoryManager &) = delete;
+    MemoryManager(MemoryManager &&other);
     virtual ~MemoryManager();
 
+    MemoryManager &operator=(const MemoryManager &) = delete;
+    MemoryManager &operator=(MemoryManager &&other);
+
     // Use an r-value reference instead of normal reference to prevent an extra copy
     // Given the amount of memory potentially in a capture, this can be significant
     void AddMemoryBlock(uint32_t submit_index, uint64_t va_addr, MemoryData &&data);
@@ -131,8 +140,9 @@ private:
         uint8_t *m_data_ptr;
     };
 
-    // mutable variable for caching reasons
-    mutable const MemoryBlock *m_last_used_block_ptr = nullptr;
+    // mutable variable for caching reasons. Atomic, since the lookups are const and done from
+    // several threads at once (e.g. the full parse of a capture while its preview is shown).
+    mutable std::atomic<const MemoryBlock *> m_last_used_block_ptr = nullptr;
 
     // Memory blocks containing all the captured memory data
     DiveVector<MemoryBlock> m_memory_blocks;
@@ -320,9 +330,23 @@ public:
     int64_t Read(char *buf, int64_t size);
     int     Close();
 
+    // Size of the file on disk, and how much of it was read so far (compressed bytes for a
+    // compressed file), for progress reporting
+    uint64_t GetFileSize() const { return m_file_size; }
+    uint64_t GetBytesRead() const;
+
+    // Hash the content (decompressed bytes) as it is read. Must be called before the first Read.
+    void EnableContentHash() { m_content_hasher.emplace(); }
+
+    // Size and hash of the content read so far. Returns false if EnableContentHash was not called.
+    bool GetContentHash(uint64_t &content_size, uint64_t &content_hash) const;
+
 private:
     std::string                                                   m_file_name;
+    uint64_t                                                      m_file_size = 0;
     std::unique_ptr<struct archive, decltype(&archive_read_free)> m_handle;
+    std::optional<HashUtils::ContentHasher>                       m_content_hasher;
+    uint64_t                                                      m_content_size = 0;
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -335,6 +359,14 @@ public:
 
     LoadResult LoadCaptureFile(const std::string &file_name);
 
+    // Hash the content of the capture file while it is loaded (see AnalysisCache::CaptureKey), so
+    // that it is not read a second time. Must be called before LoadCaptureFile. Only .rd files are
+    // hashed.
+    void SetHashContent(bool hash_content) { m_hash_content = hash_content; }
+
+    // Size and hash of the content of the loaded capture file. Returns false if it was not hashed.
+    bool GetContentHash(uint64_t &content_size, uint64_t &content_hash) const;
+
     CaptureDataHeader::CaptureType GetCaptureType() const;
     const MemoryManager           &GetMemoryManager() const;
     uint32_t                       GetNumSubmits() const;
@@ -394,6 +426,10 @@ private:
     ProgressTracker               *m_progress_tracker;
     std::string                    m_cur_capture_file;
     CaptureDataHeader              m_data_header;
+    bool                           m_hash_content = false;
+    bool                           m_has_content_hash = false;
+    uint64_t                       m_content_size = 0;
+    uint64_t                       m_content_hash = 0;
 };
 
 }  // namespace Dive
@@ -14,6 +14,7 @@
  limitations under the License.
 */
 
+#include <cstdint>
 #include <string>
 
 #pragma once
@@ -21,10 +22,30 @@
 namespace Dive
 {
 
+// Progress of the loading of a capture. Counts that are not known yet are 0.
+struct LoadProgress
+{
+    enum class Stage
+    {
+        kReadingFile,     // Reading the memory blocks and command buffers of the file
+        kParsingSubmits,  // Emulating the submits to create the events and their state
+    };
+
+    Stage    m_stage = Stage::kReadingFile;
+    uint64_t m_bytes_read = 0;
+    uint64_t m_total_bytes = 0;
+    uint32_t m_submits_parsed = 0;
+    uint32_t m_total_submits = 0;
+    uint64_t m_num_events = 0;
+};
+
 class ProgressTracker
 {
 public:
     virtual void sendMessage(std::string message) = 0;
+
+    // Called periodically while a capture loads, from the loading thread
+    virtual void sendProgress(const LoadProgress &progress) {}
 };
 
 }  // namespace Dive
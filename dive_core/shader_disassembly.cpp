@@ -16,9 +16,17 @@
 
 #include "shader_disassembly.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
 #include <mutex>
+#include <sstream>
 #include <string_view>
+#include <thread>
 
+#include "dive_core/common/cache_utils.h"
+#include "dive_core/common/hash_utils.h"
 #include "dive_core/common/memory_manager_base.h"
 #include "pm4_info.h"
 
@@ -37,6 +45,60 @@ extern "C"
 namespace Dive
 {
 
+// Bump when the disassembler or the cached data layout changes, to invalidate on-disk entries
+constexpr uint32_t kShaderCacheFormatVersion = 2;
+
+namespace
+{
+
+//--------------------------------------------------------------------------------------------------
+// Size of the shader at `data`, up to the instruction where the disassembler stops (see
+// disasm_field_cb() in disasm-a3xx.c): a "chsh", or the 4th "nop" in a row after an "end". This
+// is the actual extent of the shader, unlike `max_size` which spans whatever memory follows it.
+uint64_t GetShaderBinarySize(const uint8_t* data, uint64_t max_size)
+{
+    // Category 0 instructions: bits 61-63 are the category, bit 49 is the low bit of the opcode
+    // high bits, and bits 55-58 are the opcode (see ir3-cat0.xml)
+    constexpr uint32_t kOpcNop = 0x0;
+    constexpr uint32_t kOpcEnd = 0x6;
+    constexpr uint32_t kOpcChsh = 0xa;
+    constexpr uint32_t kMaxNopsAfterEnd = 3;
+
+    bool     has_end = false;
+    uint32_t nop_count = 0;
+    uint64_t num_instructions = max_size / sizeof(uint64_t);
+    for (uint64_t i = 0; i < num_instructions; ++i)
+    {
+        uint64_t instruction;
+        memcpy(&instruction, data + i * sizeof(uint64_t), sizeof(instruction));
+        uint32_t category = static_cast<uint32_t>(instruction >> 61);
+        uint32_t opc_hi = static_cast<uint32_t>((instruction >> 49) & 0x1);
+        uint32_t opc = static_cast<uint32_t>((instruction >> 55) & 0xf);
+        bool     is_cat0 = category == 0 && opc_hi == 0;
+
+        if (is_cat0 && opc == kOpcNop)
+        {
+            if (has_end && ++nop_count > kMaxNopsAfterEnd)
+            {
+                return (i + 1) * sizeof(uint64_t);
+            }
+            continue;
+        }
+        nop_count = 0;
+        if (is_cat0 && opc == kOpcEnd)
+        {
+            has_end = true;
+        }
+        else if (is_cat0 && opc == kOpcChsh)
+        {
+            return (i + 1) * sizeof(uint64_t);
+        }
+    }
+    return num_instructions * sizeof(uint64_t);
+}
+
+}  // namespace
+
 //--------------------------------------------------------------------------------------------------
 bool Disassemble(const uint8_t*                             shader_memory,
                  uint64_t                                   shader_address,
@@ -113,12 +175,26 @@ Disassembly::Disassembly(const IMemoryManager& mem_manager,
     ((void)(m_log));  // avoid unused variable
 }
 
+//--------------------------------------------------------------------------------------------------
+uint64_t Disassembly::GetMemoryUsage() const
+{
+    const DisassembledData& data = GetData();
+    uint64_t                memory_usage = sizeof(DisassembledData) + data.m_listing.capacity();
+    memory_usage += data.m_binary.capacity();
+    memory_usage += data.m_instructions_text.capacity() * sizeof(std::string);
+    memory_usage += data.m_instructions_raw.capacity() * sizeof(uint64_t);
+    for (const std::string& text : data.m_instructions_text)
+    {
+        memory_usage += text.capacity();
+    }
+    return memory_usage;
+}
+
 //--------------------------------------------------------------------------------------------------
 void Disassembly::Disassemble() const
 {
     std::call_once(m_disassembled_flag, [&]() {
-        DisassembledData disassembled_data;
-        uint64_t         max_size = m_mem_manager.GetMaxContiguousSize(m_submit_index, m_address);
+        uint64_t max_size = m_mem_manager.GetMaxContiguousSize(m_submit_index, m_address);
 
         // The disassembler does not early-out when it encounters an "end" instruction (at least not
         // in its "prepass"), so passing it a too-big max_size can make the disassembly very slow!
@@ -128,9 +204,30 @@ void Disassembly::Disassemble() const
         if (max_size > kMaxSizeLimit)
             max_size = kMaxSizeLimit;
 
-        uint8_t* data_ptr = new uint8_t[max_size];
+        std::vector<uint8_t> data(max_size);
         DIVE_VERIFY(
-        m_mem_manager.RetrieveMemoryData(data_ptr, m_submit_index, m_address, max_size));
+        m_mem_manager.RetrieveMemoryData(data.data(), m_submit_index, m_address, max_size));
+        uint8_t* data_ptr = data.data();
+
+        // The disassembly only depends on the binary and the GPU it targets. What follows the
+        // shader in memory is left out, so that identical shaders share their disassembly.
+        max_size = GetShaderBinarySize(data_ptr, max_size);
+        uint64_t content_hash = HashUtils::ContentHasher(kShaderCacheFormatVersion)
+                                .UpdateValue(GetGPUID())
+                                .Update(data_ptr, max_size)
+                                .Finalize();
+        ShaderDisassemblyCache& cache = ShaderDisassemblyCache::Get();
+        if (std::shared_ptr<const DisassembledData> cached = cache.Find(content_hash,
+                                                                        data_ptr,
+                                                                        max_size))
+        {
+            m_disassembled_data = std::move(cached);
+            return;
+        }
+
+        auto disassembled_data = std::make_shared<DisassembledData>();
+        disassembled_data->m_content_hash = content_hash;
+        disassembled_data->m_binary.assign(data_ptr, data_ptr + max_size);
 
         struct shader_stats stats;
         std::string         disasm = DisassembleA3XX(data_ptr, max_size, &stats, PRINT_RAW);
@@ -164,25 +261,286 @@ void Disassembly::Disassemble() const
 #endif
             DIVE_ASSERT(0 <= prefix_len && prefix_len <= line.length());
             std::string_view instr = std::string_view(line).substr(prefix_len);
-            if (n >= disassembled_data.m_instructions_text.size())
+            if (n >= disassembled_data->m_instructions_text.size())
             {
-                disassembled_data.m_instructions_text.resize(n + 1);
-                disassembled_data.m_instructions_raw.resize(n + 1);
+                disassembled_data->m_instructions_text.resize(n + 1);
+                disassembled_data->m_instructions_raw.resize(n + 1);
             }
-            if (disassembled_data.m_instructions_text[n].size() > 0)
+            if (disassembled_data->m_instructions_text[n].size() > 0)
             {
-                disassembled_data.m_instructions_text[n] += "\n";
+                disassembled_data->m_instructions_text[n] += "\n";
             }
-            disassembled_data.m_instructions_text[n] += instr;
+            disassembled_data->m_instructions_text[n] += instr;
+
+            disassembled_data->m_instructions_raw[n] = (static_cast<uint64_t>(dword1) << 32) |
+                                                       dword0;
+        }
+        disassembled_data->m_gpr_count = (stats.fullreg + 3) / 4;
+        disassembled_data->m_listing = DisassembleA3XX(data_ptr, max_size, &stats, PRINT_STATS);
+        m_disassembled_data = cache.Add(std::move(disassembled_data));
+    });
+}
+
+// =================================================================================================
+// ShaderDisassemblyCache
+// =================================================================================================
+namespace
+{
+
+constexpr uint32_t kShaderCacheFileMagic = 0x48535644;  // "DVSH"
+constexpr char     kShaderCacheFileExtension[] = ".disasm";
+
+// Size of the on-disk store, beyond which the least recently used entries are deleted
+constexpr uint64_t kMaxShaderCacheStoreSize = 256ull << 20;
+
+// Minimum size of ShaderDisassemblyCache::m_entries before its expired entries are erased
+constexpr size_t kMinPruneEntriesSize = 1024;
+
+template<typename T> void WriteValue(std::ostream& stream, const T& value)
+{
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template<typename T> bool ReadValue(std::istream& stream, T& value)
+{
+    return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+void WriteString(std::ostream& stream, const std::string& str)
+{
+    WriteValue(stream, static_cast<uint64_t>(str.size()));
+    stream.write(str.data(), str.size());
+}
+
+bool ReadString(std::istream& stream, std::string& str, uint64_t max_size)
+{
+    uint64_t size = 0;
+    if (!ReadValue(stream, size) || size > max_size)
+        return false;
+    str.resize(size);
+    return static_cast<bool>(stream.read(str.data(), size));
+}
+
+}  // namespace
+
+//--------------------------------------------------------------------------------------------------
+ShaderDisassemblyCache& ShaderDisassemblyCache::Get()
+{
+    static ShaderDisassemblyCache cache;
+    return cache;
+}
+
+//--------------------------------------------------------------------------------------------------
+ShaderDisassemblyCache::ShaderDisassemblyCache() :
+    m_prune_entries_size(kMinPruneEntriesSize)
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+std::filesystem::path ShaderDisassemblyCache::GetDefaultCacheDirectory()
+{
+    std::filesystem::path user_cache_directory = CacheUtils::GetUserCacheDirectory();
+    if (user_cache_directory.empty())
+    {
+        return std::filesystem::path();
+    }
+    return user_cache_directory / "shader_cache";
+}
+
+//--------------------------------------------------------------------------------------------------
+void ShaderDisassemblyCache::SetCacheDirectory(const std::filesystem::path& path)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cache_directory = path;
+}
+
+//--------------------------------------------------------------------------------------------------
+std::filesystem::path ShaderDisassemblyCache::GetCacheDirectory() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_cache_directory;
+}
+
+//--------------------------------------------------------------------------------------------------
+std::filesystem::path ShaderDisassemblyCache::GetEntryPath(uint64_t content_hash) const
+{
+    return m_cache_directory / (HashUtils::HashToString(content_hash) + kShaderCacheFileExtension);
+}
+
+//--------------------------------------------------------------------------------------------------
+std::shared_ptr<const ShaderDisassemblyCache::DisassembledData> ShaderDisassemblyCache::Find(
+uint64_t       content_hash,
+const uint8_t* binary,
+size_t         binary_size)
+{
+    auto is_same_binary = [binary, binary_size](const DisassembledData& data) {
+        return data.m_binary.size() == binary_size &&
+               std::equal(data.m_binary.begin(), data.m_binary.end(), binary);
+    };
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto                        it = m_entries.find(content_hash);
+        if (it != m_entries.end())
+        {
+            if (std::shared_ptr<const DisassembledData> data = it->second.lock())
+                return is_same_binary(*data) ? data : nullptr;
+        }
+    }
+
+    std::shared_ptr<const DisassembledData> data = Load(content_hash, binary, binary_size);
+    if (!data)
+        return nullptr;
+    return Add(std::move(data));
+}
+
+//--------------------------------------------------------------------------------------------------
+std::shared_ptr<const ShaderDisassemblyCache::DisassembledData> ShaderDisassemblyCache::Add(
+std::shared_ptr<const DisassembledData> data)
+{
+    std::filesystem::path entry_path;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::weak_ptr<const DisassembledData>& entry = m_entries[data->m_content_hash];
+        if (std::shared_ptr<const DisassembledData> existing = entry.lock())
+        {
+            // A different binary with the same hash is not cached
+            return existing->m_binary == data->m_binary ? existing : data;
+        }
+        entry = data;
 
-            disassembled_data.m_instructions_raw[n] = (static_cast<uint64_t>(dword1) << 32) |
-                                                      dword0;
+        if (m_entries.size() >= m_prune_entries_size)
+        {
+            std::erase_if(m_entries, [](const auto& item) { return item.second.expired(); });
+            m_prune_entries_size = std::max(kMinPruneEntriesSize, 2 * m_entries.size());
         }
-        disassembled_data.m_gpr_count = (stats.fullreg + 3) / 4;
-        disassembled_data.m_listing = DisassembleA3XX(data_ptr, max_size, &stats, PRINT_STATS);
-        delete[] data_ptr;
-        m_disassembled_data = disassembled_data;
+        if (!m_cache_directory.empty())
+            entry_path = GetEntryPath(data->m_content_hash);
+    }
+
+    // Mark an entry loaded from disk as recently used, or store a new one
+    std::error_code ec;
+    if (!entry_path.empty() && std::filesystem::exists(entry_path, ec))
+        CacheUtils::TouchFile(entry_path);
+    else
+        Store(*data);
+    return data;
+}
+
+//--------------------------------------------------------------------------------------------------
+std::shared_ptr<const ShaderDisassemblyCache::DisassembledData> ShaderDisassemblyCache::Load(
+uint64_t       content_hash,
+const uint8_t* binary,
+size_t         binary_size) const
+{
+    std::filesystem::path path;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_cache_directory.empty())
+            return nullptr;
+        path = GetEntryPath(content_hash);
+    }
+
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream.is_open())
+        return nullptr;
+
+    // Guard against truncated or corrupted entries: anything unexpected is a miss
+    constexpr uint64_t kMaxStringSize = 64 * 1024 * 1024;
+    auto               data = std::make_shared<DisassembledData>();
+    uint32_t           magic = 0, version = 0;
+    uint64_t           num_instructions = 0;
+    if (!ReadValue(stream, magic) || magic != kShaderCacheFileMagic)
+        return nullptr;
+    if (!ReadValue(stream, version) || version != kShaderCacheFormatVersion)
+        return nullptr;
+    if (!ReadValue(stream, data->m_content_hash) || data->m_content_hash != content_hash)
+        return nullptr;
+    uint64_t stored_binary_size = 0;
+    if (!ReadValue(stream, stored_binary_size) || stored_binary_size != binary_size)
+        return nullptr;
+    data->m_binary.resize(binary_size);
+    if (!stream.read(reinterpret_cast<char*>(data->m_binary.data()), binary_size) ||
+        !std::equal(data->m_binary.begin(), data->m_binary.end(), binary))
+        return nullptr;
+    if (!ReadValue(stream, data->m_gpr_count) ||
+        !ReadString(stream, data->m_listing, kMaxStringSize))
+        return nullptr;
+    if (!ReadValue(stream, num_instructions) || num_instructions > kMaxStringSize)
+        return nullptr;
+
+    data->m_instructions_raw.resize(num_instructions);
+    data->m_instructions_text.resize(num_instructions);
+    if (!stream.read(reinterpret_cast<char*>(data->m_instructions_raw.data()),
+                     num_instructions * sizeof(uint64_t)))
+        return nullptr;
+    for (std::string& text : data->m_instructions_text)
+    {
+        if (!ReadString(stream, text, kMaxStringSize))
+            return nullptr;
+    }
+    return data;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool ShaderDisassemblyCache::Store(const DisassembledData& data)
+{
+    std::filesystem::path path;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_cache_directory.empty())
+            return false;
+        path = GetEntryPath(data.m_content_hash);
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+    if (ec)
+        return false;
+    std::call_once(m_prune_store_flag, [&path]() {
+        CacheUtils::PruneDirectory(path.parent_path(),
+                                   kShaderCacheFileExtension,
+                                   kMaxShaderCacheStoreSize);
     });
+
+    // Write to a unique temporary file and rename it, so that concurrent writers (threads or
+    // other Dive instances) never expose a partially written entry
+    std::ostringstream temp_name;
+    temp_name << path.filename().string() << "." << std::this_thread::get_id() << "."
+              << std::chrono::steady_clock::now().time_since_epoch().count() << ".tmp";
+    std::filesystem::path temp_path = path.parent_path() / temp_name.str();
+    {
+        std::ofstream stream(temp_path, std::ios::binary | std::ios::trunc);
+        if (!stream.is_open())
+            return false;
+
+        WriteValue(stream, kShaderCacheFileMagic);
+        WriteValue(stream, kShaderCacheFormatVersion);
+        WriteValue(stream, data.m_content_hash);
+        WriteValue(stream, static_cast<uint64_t>(data.m_binary.size()));
+        stream.write(reinterpret_cast<const char*>(data.m_binary.data()), data.m_binary.size());
+        WriteValue(stream, data.m_gpr_count);
+        WriteString(stream, data.m_listing);
+        WriteValue(stream, static_cast<uint64_t>(data.m_instructions_raw.size()));
+        stream.write(reinterpret_cast<const char*>(data.m_instructions_raw.data()),
+                     data.m_instructions_raw.size() * sizeof(uint64_t));
+        for (const std::string& text : data.m_instructions_text)
+        {
+            WriteString(stream, text);
+        }
+        if (!stream)
+        {
+            stream.close();
+            std::filesystem::remove(temp_path, ec);
+            return false;
+        }
+    }
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec)
+    {
+        std::filesystem::remove(temp_path, ec);
+        return false;
+    }
+    return true;
 }
 
 }  // namespace Dive
@@ -16,7 +16,10 @@
 
 #pragma once
 
+#include <filesystem>
 #include <functional>
+#include <map>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -66,6 +69,7 @@ public:
 
     std::string        GetListing() const { return GetData().m_listing; }
     uint64_t           GetShaderAddr() const { return m_address; }
+    uint32_t           GetSubmitIndex() const { return m_submit_index; }
     size_t             GetNumInstructions() const { return GetData().m_instructions_text.size(); }
     const std::string& GetInstructionText(uint32_t index) const
     {
@@ -80,21 +84,33 @@ public:
 
     void EagerEval() const { Disassemble(); }
 
-private:
+    // Content hash of the shader binary, up to the instruction where the disassembler stops, which
+    // identifies its disassembly in the ShaderDisassemblyCache. Only valid once the shader has
+    // been disassembled.
+    uint64_t GetContentHash() const { return GetData().m_content_hash; }
+
+    // Approximate heap memory used by the disassembly, in bytes. The disassembled data is shared
+    // by the shaders with the same binary, and is counted for each of them.
+    uint64_t GetMemoryUsage() const;
+
     struct DisassembledData
     {
+        uint64_t                 m_content_hash = 0;
+        // Compared on a cache hit, so that a hash collision is a miss
+        std::vector<uint8_t>     m_binary;
         std::string              m_listing;
         std::vector<std::string> m_instructions_text;
         std::vector<uint64_t>    m_instructions_raw;
-        uint32_t                 m_gpr_count;
+        uint32_t                 m_gpr_count = 0;
     };
 
+private:
     void Disassemble() const;
 
     const DisassembledData& GetData() const
     {
         Disassemble();
-        return m_disassembled_data;
+        return *m_disassembled_data;
     }
 
     const IMemoryManager& m_mem_manager;
@@ -102,8 +118,59 @@ private:
     uint64_t              m_address;
     ILog*                 m_log;
 
-    mutable std::once_flag   m_disassembled_flag;
-    mutable DisassembledData m_disassembled_data;
+    // Shared between all Disassembly objects with the same shader binary
+    mutable std::once_flag                          m_disassembled_flag;
+    mutable std::shared_ptr<const DisassembledData> m_disassembled_data;
+};
+
+//--------------------------------------------------------------------------------------------------
+// Cache of shader disassembly keyed by the content hash of the shader binary.
+// The same binary uploaded at different addresses, in different submits, or in another capture
+// (e.g. of the same title) is only disassembled once. Results can also be persisted to an on-disk
+// store, one file per hash, so reopening a capture skips disassembly entirely. Entries are only
+// used if their binary matches, and the store is pruned of its least recently used entries.
+// The store is disabled until a directory is set, e.g. by DataCore::SetAnalysisCacheEnabled().
+class ShaderDisassemblyCache
+{
+public:
+    using DisassembledData = Disassembly::DisassembledData;
+
+    static ShaderDisassemblyCache& Get();
+
+    // Directory of the on-disk store. An empty path, the default, disables persistence.
+    void                  SetCacheDirectory(const std::filesystem::path& path);
+    std::filesystem::path GetCacheDirectory() const;
+
+    // "shader_cache" under CacheUtils::GetUserCacheDirectory(), or an empty path if there is none
+    static std::filesystem::path GetDefaultCacheDirectory();
+
+    // Look up the disassembly of the given binary, from memory first and then from disk.
+    // Returns nullptr on a miss.
+    std::shared_ptr<const DisassembledData> Find(uint64_t       content_hash,
+                                                 const uint8_t* binary,
+                                                 size_t         binary_size);
+
+    // Add a newly disassembled shader, and persist it if the on-disk store is enabled.
+    // Returns the cached entry, which may be a concurrently added one for the same hash.
+    std::shared_ptr<const DisassembledData> Add(std::shared_ptr<const DisassembledData> data);
+
+private:
+    ShaderDisassemblyCache();
+
+    std::shared_ptr<const DisassembledData> Load(uint64_t       content_hash,
+                                                 const uint8_t* binary,
+                                                 size_t         binary_size) const;
+    bool                                    Store(const DisassembledData& data);
+    std::filesystem::path                   GetEntryPath(uint64_t content_hash) const;
+
+    mutable std::mutex    m_mutex;
+    std::filesystem::path m_cache_directory;
+    // Entries are only kept alive by the captures referencing them; the disk store is the
+    // long-lived cache. The expired entries are erased once the map doubles in size.
+    std::map<uint64_t, std::weak_ptr<const DisassembledData>> m_entries;
+    size_t                                                    m_prune_entries_size;
+    // The on-disk store is pruned once per process, when the first entry is stored
+    std::once_flag m_prune_store_flag;
 };
 
 bool Disassemble(const uint8_t*                             shader_memory,
@@ -0,0 +1,110 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "submit_metadata_cache.h"
+
+#include <iterator>
+#include <utility>
+
+namespace Dive
+{
+
+//--------------------------------------------------------------------------------------------------
+SubmitMetadataCache::SubmitMetadataCache(const DataCore &data_core, uint64_t memory_budget) :
+    m_data_core(data_core),
+    m_memory_budget(memory_budget)
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+bool SubmitMetadataCache::Take(const Context   &context,
+                               uint32_t         submit_index,
+                               CaptureMetadata &capture_metadata)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto                        it = m_entry_by_submit.find(submit_index);
+        if (it != m_entry_by_submit.end())
+        {
+            capture_metadata = std::move(it->second->m_capture_metadata);
+            m_memory_usage -= it->second->m_memory_usage;
+            m_entries.erase(it->second);
+            m_entry_by_submit.erase(it);
+            return true;
+        }
+    }
+
+    // Parsed without the lock, so that the cached submits stay available meanwhile
+    SubmitRange submit_range;
+    submit_range.m_first = submit_index;
+    submit_range.m_last = submit_index;
+    return m_data_core.ParsePm4CaptureMetadata(context, submit_range, capture_metadata);
+}
+
+//--------------------------------------------------------------------------------------------------
+void SubmitMetadataCache::Put(uint32_t submit_index, CaptureMetadata &&capture_metadata)
+{
+    uint64_t memory_usage = capture_metadata.GetMemoryUsage();
+
+    // The evicted submits are freed once the lock is released
+    std::list<Entry>            evicted;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (auto it = m_entry_by_submit.find(submit_index); it != m_entry_by_submit.end())
+    {
+        // Parsed again while it was cached
+        m_memory_usage -= it->second->m_memory_usage;
+        evicted.splice(evicted.end(), m_entries, it->second);
+        m_entry_by_submit.erase(it);
+    }
+    if (memory_usage > m_memory_budget)
+    {
+        return;
+    }
+
+    m_entries.push_front(Entry{ submit_index, memory_usage, std::move(capture_metadata) });
+    m_entry_by_submit[submit_index] = m_entries.begin();
+    m_memory_usage += memory_usage;
+    while (m_memory_usage > m_memory_budget)
+    {
+        auto lru = std::prev(m_entries.end());
+        m_memory_usage -= lru->m_memory_usage;
+        m_entry_by_submit.erase(lru->m_submit_index);
+        evicted.splice(evicted.end(), m_entries, lru);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+bool SubmitMetadataCache::Contains(uint32_t submit_index) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entry_by_submit.find(submit_index) != m_entry_by_submit.end();
+}
+
+//--------------------------------------------------------------------------------------------------
+size_t SubmitMetadataCache::GetNumSubmits() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t SubmitMetadataCache::GetMemoryUsage() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_memory_usage;
+}
+
+}  // namespace Dive
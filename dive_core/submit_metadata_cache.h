@@ -0,0 +1,77 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "context.h"
+#include "data_core.h"
+
+namespace Dive
+{
+
+//--------------------------------------------------------------------------------------------------
+// LRU cache of the metadata of single submits of a pm4 capture: their command hierarchy, event
+// info and state, and shaders. It bounds the memory used to browse a large capture one submit at a
+// time. The submits that do not fit in the memory budget are evicted, and parsed again from the
+// capture data when they are needed.
+//
+// The metadata of a submit is taken out of the cache while it is in use (e.g. shown by
+// DataCore::SetCaptureMetadata()), and put back once done. The budget only applies to the submits
+// in the cache. Thread-safe.
+class SubmitMetadataCache
+{
+public:
+    // `data_core` has the pm4 capture loaded, and outlives the cache
+    SubmitMetadataCache(const DataCore &data_core, uint64_t memory_budget);
+
+    // Move the metadata of a submit out of the cache, or parse it if it is not cached.
+    // Returns false if the submit cannot be parsed or if `context` is cancelled.
+    bool Take(const Context &context, uint32_t submit_index, CaptureMetadata &capture_metadata);
+
+    // Put back the metadata of a submit, as the most recently used one, and evict the least
+    // recently used submits that do not fit in the budget anymore. The metadata is dropped if it
+    // does not fit by itself.
+    void Put(uint32_t submit_index, CaptureMetadata &&capture_metadata);
+
+    bool     Contains(uint32_t submit_index) const;
+    size_t   GetNumSubmits() const;
+    uint64_t GetMemoryUsage() const;
+    uint64_t GetMemoryBudget() const { return m_memory_budget; }
+
+private:
+    struct Entry
+    {
+        uint32_t        m_submit_index;
+        uint64_t        m_memory_usage;
+        CaptureMetadata m_capture_metadata;
+    };
+
+    const DataCore &m_data_core;
+    const uint64_t  m_memory_budget;
+
+    mutable std::mutex m_mutex;
+    // Most recently used first
+    std::list<Entry>                                         m_entries;
+    std::unordered_map<uint32_t, std::list<Entry>::iterator> m_entry_by_submit;
+    uint64_t                                                 m_memory_usage = 0;
+};
+
+}  // namespace Dive
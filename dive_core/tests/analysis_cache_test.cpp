@@ -0,0 +1,183 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/analysis_cache.h"
+#include "dive_core/data_core.h"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace Dive
+{
+namespace
+{
+
+std::string GetTempFileName(const char *name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+void CreateMetadata(CaptureMetadata &metadata)
+{
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        EventInfo event_info;
+        event_info.m_num_indices = 100 * i;
+        event_info.m_submit_index = i;
+        event_info.m_type = EventInfo::EventType::kDraw;
+        event_info.m_render_mode = RenderModeType::kBinningDirect;
+        event_info.m_str = "Draw " + std::to_string(i);
+        event_info.m_buffer_indices[(uint32_t)ShaderStage::kShaderStagePs].assign(i, 7);
+        ShaderReference reference;
+        reference.m_shader_index = i;
+        reference.m_stage = ShaderStage::kShaderStageVs;
+        reference.m_enable_mask = 0x1;
+        event_info.m_shader_references.push_back(reference);
+        metadata.m_event_info.push_back(std::move(event_info));
+
+        auto event_state_it = metadata.m_event_state.Add();
+        event_state_it->SetLineWidth(1.0f + i);
+    }
+    BufferInfo buffer_info = {};
+    buffer_info.m_addr = 0x1000;
+    buffer_info.m_size = 256;
+    metadata.m_buffers.push_back(buffer_info);
+    metadata.m_num_pm4_packets = 42;
+}
+
+const AnalysisCache::CaptureKey kCaptureKey = { 1234, 0xabcdef };
+
+TEST(AnalysisCacheTest, RoundTrip)
+{
+    std::string     cache_file_name = GetTempFileName("analysis_cache_round_trip.divecache");
+    CaptureMetadata metadata;
+    CreateMetadata(metadata);
+    ASSERT_TRUE(AnalysisCache::Save(cache_file_name, kCaptureKey, metadata));
+
+    MemoryManager   mem_manager;
+    CaptureMetadata loaded;
+    ASSERT_TRUE(AnalysisCache::Load(cache_file_name, kCaptureKey, mem_manager, loaded));
+    std::filesystem::remove(cache_file_name);
+
+    EXPECT_EQ(loaded.m_num_pm4_packets, 42u);
+    EXPECT_EQ(loaded.m_command_hierarchy.size(), metadata.m_command_hierarchy.size());
+    ASSERT_EQ(loaded.m_buffers.size(), 1u);
+    EXPECT_EQ(loaded.m_buffers[0].m_addr, 0x1000u);
+    EXPECT_EQ(loaded.m_buffers[0].m_size, 256u);
+
+    ASSERT_EQ(loaded.m_event_info.size(), metadata.m_event_info.size());
+    for (size_t i = 0; i < loaded.m_event_info.size(); ++i)
+    {
+        const EventInfo &expected = metadata.m_event_info[i];
+        const EventInfo &actual = loaded.m_event_info[i];
+        EXPECT_EQ(actual.m_num_indices, expected.m_num_indices);
+        EXPECT_EQ(actual.m_submit_index, expected.m_submit_index);
+        EXPECT_EQ(actual.m_type, expected.m_type);
+        EXPECT_EQ(actual.m_render_mode, expected.m_render_mode);
+        EXPECT_EQ(actual.m_str, expected.m_str);
+        for (uint32_t stage = 0; stage < kShaderStageCount; ++stage)
+        {
+            EXPECT_EQ(actual.m_buffer_indices[stage], expected.m_buffer_indices[stage]);
+        }
+        ASSERT_EQ(actual.m_shader_references.size(), 1u);
+        EXPECT_EQ(actual.m_shader_references[0].m_shader_index, i);
+    }
+
+    ASSERT_EQ(loaded.m_event_state.size(), metadata.m_event_state.size());
+    for (uint32_t i = 0; i < loaded.m_event_state.size(); ++i)
+    {
+        auto event_state_it = loaded.m_event_state.find(static_cast<EventStateId>(i));
+        EXPECT_TRUE(event_state_it->IsLineWidthSet());
+        EXPECT_FALSE(event_state_it->IsTopologySet());
+        EXPECT_EQ(event_state_it->LineWidth(), 1.0f + i);
+    }
+}
+
+TEST(AnalysisCacheTest, RejectsOtherCapture)
+{
+    std::string     cache_file_name = GetTempFileName("analysis_cache_other_capture.divecache");
+    CaptureMetadata metadata;
+    CreateMetadata(metadata);
+    ASSERT_TRUE(AnalysisCache::Save(cache_file_name, kCaptureKey, metadata));
+
+    AnalysisCache::CaptureKey other_key = kCaptureKey;
+    other_key.m_content_hash++;
+    MemoryManager   mem_manager;
+    CaptureMetadata loaded;
+    EXPECT_FALSE(AnalysisCache::Load(cache_file_name, other_key, mem_manager, loaded));
+    EXPECT_TRUE(loaded.m_event_info.empty());
+    std::filesystem::remove(cache_file_name);
+}
+
+TEST(AnalysisCacheTest, RejectsTruncatedFile)
+{
+    std::string     cache_file_name = GetTempFileName("analysis_cache_truncated.divecache");
+    CaptureMetadata metadata;
+    CreateMetadata(metadata);
+    ASSERT_TRUE(AnalysisCache::Save(cache_file_name, kCaptureKey, metadata));
+    std::filesystem::resize_file(cache_file_name,
+                                 std::filesystem::file_size(cache_file_name) / 2);
+
+    MemoryManager   mem_manager;
+    CaptureMetadata loaded;
+    EXPECT_FALSE(AnalysisCache::Load(cache_file_name, kCaptureKey, mem_manager, loaded));
+    std::filesystem::remove(cache_file_name);
+}
+
+// A .rd capture made of a single RD_TEST block (ascii text), skipped by the loader
+void WriteRdCapture(const std::string &file_name, const std::string &text)
+{
+    const uint32_t block_info[2] = { 1, static_cast<uint32_t>(text.size()) };
+    std::ofstream  stream(file_name, std::ios::binary);
+    stream.write(reinterpret_cast<const char *>(block_info), sizeof(block_info));
+    stream.write(text.data(), text.size());
+}
+
+bool LoadCaptureKey(const std::string &file_name, AnalysisCache::CaptureKey &key)
+{
+    Pm4CaptureData capture_data;
+    capture_data.SetHashContent(true);
+    if (capture_data.LoadCaptureFile(file_name) != CaptureData::LoadResult::kSuccess)
+        return false;
+    return capture_data.GetContentHash(key.m_content_size, key.m_content_hash);
+}
+
+TEST(AnalysisCacheTest, LoaderHashesContent)
+{
+    std::string capture_file_name = GetTempFileName("analysis_cache_capture.rd");
+    AnalysisCache::CaptureKey key, same_key, other_key;
+    WriteRdCapture(capture_file_name, "capture contents");
+    ASSERT_TRUE(LoadCaptureKey(capture_file_name, key));
+    ASSERT_TRUE(LoadCaptureKey(capture_file_name, same_key));
+    WriteRdCapture(capture_file_name, "capture_contents");
+    ASSERT_TRUE(LoadCaptureKey(capture_file_name, other_key));
+
+    // Not hashed unless requested
+    Pm4CaptureData capture_data;
+    ASSERT_EQ(capture_data.LoadCaptureFile(capture_file_name), CaptureData::LoadResult::kSuccess);
+    uint64_t content_size, content_hash;
+    EXPECT_FALSE(capture_data.GetContentHash(content_size, content_hash));
+    std::filesystem::remove(capture_file_name);
+
+    EXPECT_EQ(key.m_content_size, 24u);
+    EXPECT_EQ(key.m_content_hash, same_key.m_content_hash);
+    EXPECT_EQ(other_key.m_content_size, 24u);
+    EXPECT_NE(key.m_content_hash, other_key.m_content_hash);
+}
+
+}  // namespace
+}  // namespace Dive
@@ -0,0 +1,76 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+
+#include "dive_core/common/cache_utils.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <fstream>
+#include <string>
+
+namespace Dive
+{
+namespace CacheUtils
+{
+namespace
+{
+
+void WriteFile(const std::filesystem::path &path, size_t size)
+{
+    std::ofstream stream(path, std::ios::binary);
+    stream << std::string(size, 'x');
+}
+
+TEST(CacheUtils, PruneDirectoryDeletesLeastRecentlyUsed)
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() /
+                                      "dive_cache_utils_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    // From the oldest to the newest
+    const char *kNames[] = { "a.entry", "b.entry", "c.entry" };
+    auto        time = std::filesystem::file_time_type::clock::now() - std::chrono::hours(3);
+    for (const char *name : kNames)
+    {
+        WriteFile(directory / name, 100);
+        std::filesystem::last_write_time(directory / name, time);
+        time += std::chrono::hours(1);
+    }
+    WriteFile(directory / "other.txt", 1000);
+    // "a" is used again, so "b" is now the least recently used
+    TouchFile(directory / "a.entry");
+
+    PruneDirectory(directory, ".entry", 250);
+    EXPECT_TRUE(std::filesystem::exists(directory / "a.entry"));
+    EXPECT_FALSE(std::filesystem::exists(directory / "b.entry"));
+    EXPECT_TRUE(std::filesystem::exists(directory / "c.entry"));
+    EXPECT_TRUE(std::filesystem::exists(directory / "other.txt"));
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(CacheUtils, PruneMissingDirectory)
+{
+    PruneDirectory(std::filesystem::temp_directory_path() / "dive_cache_utils_test_missing",
+                   ".entry",
+                   0);
+}
+
+}  // namespace
+}  // namespace CacheUtils
+}  // namespace Dive
@@ -0,0 +1,212 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/capture_diff.h"
+#include "dive_core/data_core.h"
+#include "gtest/gtest.h"
+
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace Dive
+{
+namespace
+{
+
+using EventType = EventInfo::EventType;
+
+void AddEvent(CaptureMetadata &metadata, EventType type, float line_width = 1.0f)
+{
+    EventInfo event_info = {};
+    event_info.m_type = type;
+    event_info.m_num_indices = type == EventType::kDraw ? 3 : 0;
+    metadata.m_event_info.push_back(std::move(event_info));
+    metadata.m_event_state.Add()->SetLineWidth(line_width);
+}
+
+void CreateMetadata(CaptureMetadata &metadata, const std::vector<EventType> &types)
+{
+    for (EventType type : types)
+    {
+        AddEvent(metadata, type);
+    }
+}
+
+CaptureDiff Diff(const CaptureMetadata    &a,
+                 const CaptureMetadata    &b,
+                 const CaptureDiffOptions &options = {})
+{
+    CaptureDiff diff;
+    EXPECT_TRUE(DiffCaptures(Context::Background(), a, b, options, diff));
+    return diff;
+}
+
+TEST(CaptureDiffTest, SameCapture)
+{
+    CaptureMetadata a, b;
+    CreateMetadata(a, { EventType::kDraw, EventType::kColorGmemToSysMemResolve, EventType::kDraw });
+    CreateMetadata(b, { EventType::kDraw, EventType::kColorGmemToSysMemResolve, EventType::kDraw });
+
+    CaptureDiff diff = Diff(a, b);
+    EXPECT_FALSE(diff.HasDifferences());
+    EXPECT_EQ(diff.m_num_aligned_events, 3u);
+    EXPECT_TRUE(diff.m_type_count_changes.empty());
+}
+
+TEST(CaptureDiffTest, StateChange)
+{
+    CaptureMetadata a, b;
+    CreateMetadata(a, { EventType::kDraw, EventType::kDraw });
+    AddEvent(b, EventType::kDraw);
+    AddEvent(b, EventType::kDraw, 2.0f);
+    b.m_event_state.SetDepthTestEnabled(EventStateId(1), true);
+
+    CaptureDiff diff = Diff(a, b);
+    EXPECT_EQ(diff.m_num_aligned_events, 2u);
+    EXPECT_TRUE(diff.m_added_events.empty());
+    EXPECT_TRUE(diff.m_removed_events.empty());
+    ASSERT_EQ(diff.m_changed_events.size(), 1u);
+
+    const EventDiff &event_diff = diff.m_changed_events[0];
+    EXPECT_EQ(event_diff.m_event_a, 1u);
+    EXPECT_EQ(event_diff.m_event_b, 1u);
+    EXPECT_TRUE(event_diff.m_shader_changes.empty());
+    ASSERT_EQ(event_diff.m_state_changes.size(), 2u);
+    EXPECT_STREQ(event_diff.m_state_changes[0].m_field, "LineWidth");
+    EXPECT_EQ(event_diff.m_state_changes[0].m_value_a, 1.0);
+    EXPECT_EQ(event_diff.m_state_changes[0].m_value_b, 2.0);
+    EXPECT_STREQ(event_diff.m_state_changes[1].m_field, "DepthTestEnabled");
+    EXPECT_FALSE(event_diff.m_state_changes[1].m_is_set_a);
+    EXPECT_TRUE(event_diff.m_state_changes[1].m_is_set_b);
+    EXPECT_EQ(event_diff.m_state_changes[1].m_value_b, 1.0);
+}
+
+TEST(CaptureDiffTest, AddedAndRemovedEvents)
+{
+    CaptureMetadata a, b;
+    CreateMetadata(a, { EventType::kDispatch, EventType::kBlit, EventType::kDraw });
+    AddEvent(a, EventType::kDispatch);
+    CreateMetadata(b, { EventType::kBlit, EventType::kDraw, EventType::kDispatch });
+    AddEvent(b, EventType::kBlit);
+
+    CaptureDiff diff = Diff(a, b);
+    EXPECT_EQ(diff.m_num_aligned_events, 3u);
+    EXPECT_TRUE(diff.m_changed_events.empty());
+    EXPECT_EQ(diff.m_removed_events, std::vector<uint32_t>({ 0 }));
+    EXPECT_EQ(diff.m_added_events, std::vector<uint32_t>({ 3 }));
+}
+
+TEST(CaptureDiffTest, ChangedResolve)
+{
+    CaptureMetadata a, b;
+    CreateMetadata(a, { EventType::kDraw, EventType::kColorGmemToSysMemResolve });
+    CreateMetadata(b, { EventType::kDraw, EventType::kColorGmemToSysMemResolveAndClear });
+
+    CaptureDiff diff = Diff(a, b);
+    EXPECT_EQ(diff.m_num_aligned_events, 2u);
+    ASSERT_EQ(diff.m_changed_events.size(), 1u);
+    EXPECT_EQ(diff.m_changed_events[0].m_type_a, EventType::kColorGmemToSysMemResolve);
+    EXPECT_EQ(diff.m_changed_events[0].m_type_b, EventType::kColorGmemToSysMemResolveAndClear);
+    EXPECT_TRUE(diff.m_changed_events[0].m_state_changes.empty());
+
+    ASSERT_EQ(diff.m_type_count_changes.size(), 2u);
+    EXPECT_EQ(diff.m_type_count_changes[0].m_type, EventType::kColorGmemToSysMemResolve);
+    EXPECT_EQ(diff.m_type_count_changes[0].m_count_a, 1u);
+    EXPECT_EQ(diff.m_type_count_changes[0].m_count_b, 0u);
+    EXPECT_EQ(diff.m_type_count_changes[1].m_type, EventType::kColorGmemToSysMemResolveAndClear);
+    EXPECT_EQ(diff.m_type_count_changes[1].m_count_a, 0u);
+    EXPECT_EQ(diff.m_type_count_changes[1].m_count_b, 1u);
+}
+
+TEST(CaptureDiffTest, AlignsByMarkerPath)
+{
+    CaptureMetadata a, b;
+    CreateMetadata(a, { EventType::kDraw, EventType::kDraw, EventType::kDispatch });
+    CreateMetadata(b, { EventType::kDispatch, EventType::kDraw, EventType::kDraw });
+    AddEvent(b, EventType::kDraw, 2.0f);
+
+    CaptureDiff diff;
+    ASSERT_TRUE(DiffCaptures(Context::Background(),
+                             a,
+                             { "Frame/Shadows", "Frame/Main", "Frame/Post" },
+                             b,
+                             { "Frame/Post", "Frame/Main", "Frame/Shadows", "Frame/Shadows" },
+                             CaptureDiffOptions(),
+                             diff));
+    EXPECT_EQ(diff.m_num_aligned_events, 3u);
+    EXPECT_TRUE(diff.m_changed_events.empty());
+    EXPECT_TRUE(diff.m_removed_events.empty());
+    EXPECT_EQ(diff.m_added_events, std::vector<uint32_t>({ 3 }));
+}
+
+TEST(CaptureDiffTest, PairsByKindOverMaxEditDistance)
+{
+    CaptureMetadata a, b;
+    CreateMetadata(a, { EventType::kDraw, EventType::kDispatch, EventType::kDraw });
+    CreateMetadata(b, { EventType::kDispatch, EventType::kDraw, EventType::kDraw });
+
+    CaptureDiffOptions options;
+    options.m_max_edit_distance = 0;
+    CaptureDiff diff = Diff(a, b, options);
+    EXPECT_EQ(diff.m_num_aligned_events, 2u);
+    EXPECT_EQ(diff.m_removed_events, std::vector<uint32_t>({ 1 }));
+    EXPECT_EQ(diff.m_added_events, std::vector<uint32_t>({ 0 }));
+}
+
+TEST(CaptureDiffTest, LargeCapture)
+{
+    const EventType kTypes[] = { EventType::kDraw,
+                                 EventType::kDraw,
+                                 EventType::kDispatch,
+                                 EventType::kColorClearGmem,
+                                 EventType::kDraw,
+                                 EventType::kColorGmemToSysMemResolve,
+                                 EventType::kWaitForIdle };
+    const uint32_t  kNumEvents = 100000;
+
+    CaptureMetadata a, b;
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+    {
+        AddEvent(a, kTypes[i % std::size(kTypes)]);
+    }
+    // Remove some events, add blits, and change the state of others
+    for (uint32_t i = 0; i < kNumEvents; ++i)
+    {
+        if (i % 10000 == 5000)
+        {
+            continue;
+        }
+        if (i % 20000 == 100)
+        {
+            AddEvent(b, EventType::kBlit);
+        }
+        AddEvent(b, kTypes[i % std::size(kTypes)], i % 25000 == 12500 ? 4.0f : 1.0f);
+    }
+
+    CaptureDiff diff = Diff(a, b);
+    EXPECT_EQ(diff.m_removed_events.size(), 10u);
+    EXPECT_EQ(diff.m_added_events.size(), 5u);
+    EXPECT_EQ(diff.m_num_aligned_events, kNumEvents - 10);
+    EXPECT_EQ(diff.m_changed_events.size(), 4u);
+    for (uint32_t event_b : diff.m_added_events)
+    {
+        EXPECT_EQ(b.m_event_info[event_b].m_type, EventType::kBlit);
+    }
+}
+
+}  // namespace
+}  // namespace Dive
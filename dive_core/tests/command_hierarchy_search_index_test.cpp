@@ -0,0 +1,261 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/command_hierarchy_search_index.h"
+#include "dive_core/command_hierarchy.h"
+#include "dive_core/pm4_capture_data.h"
+#include "gtest/gtest.h"
+#include "pm4_info.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+namespace Dive
+{
+namespace
+{
+
+uint32_t OddParity(uint32_t val)
+{
+    val ^= val >> 16;
+    val ^= val >> 8;
+    val ^= val >> 4;
+    val &= 0xf;
+    return (~0x6996 >> val) & 1;
+}
+
+void AddType7Packet(std::vector<uint32_t> &dwords, uint32_t opcode, std::vector<uint32_t> payload)
+{
+    Pm4Header header;
+    header.u32All = 0;
+    header.type7.type = 7;
+    header.type7.opcode = opcode;
+    header.type7.opcode_parity = OddParity(opcode);
+    header.type7.count = static_cast<uint32_t>(payload.size());
+    header.type7.count_parity = OddParity(header.type7.count);
+    dwords.push_back(header.u32All);
+    dwords.insert(dwords.end(), payload.begin(), payload.end());
+}
+
+// Creates the hierarchies from PM4 streams with the CommandHierarchyCreator, without a capture
+class CommandHierarchySearchIndexTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // Can only be called once per process
+        static bool s_pm4_info_initialized = false;
+        if (!s_pm4_info_initialized)
+        {
+            Pm4InfoInit();
+            s_pm4_info_initialized = true;
+        }
+
+        // Packets at 0x0 (CP_SET_MARKER), 0x8 and 0x28 (CP_DRAW_INDX_OFFSET)
+        CreateHierarchy({ 36, 6 });
+    }
+
+    // A CP_SET_MARKER, then a CP_DRAW_INDX_OFFSET of each number of indices
+    void CreateHierarchy(const std::vector<uint32_t> &num_indices)
+    {
+        std::vector<uint32_t> dwords;
+        AddType7Packet(dwords, CP_SET_MARKER, { 0 });
+        for (uint32_t num : num_indices)
+        {
+            AddType7Packet(dwords, CP_DRAW_INDX_OFFSET, { 0, 1, num, 0, 0, 0, 0 });
+        }
+
+        Pm4CaptureData          capture_data;
+        CommandHierarchyCreator creator(m_command_hierarchy, capture_data);
+        ASSERT_TRUE(creator.CreateTrees(EngineType::kUniversal,
+                                        QueueType::kUniversal,
+                                        dwords,
+                                        static_cast<uint32_t>(dwords.size())));
+    }
+
+    std::vector<uint64_t> Search(const CommandHierarchySearchQuery &query)
+    {
+        std::vector<uint64_t> node_indices;
+        EXPECT_TRUE(m_index.Search(query, node_indices));
+        return node_indices;
+    }
+
+    std::vector<uint64_t> SearchText(const std::string &text, bool case_sensitive = false)
+    {
+        CommandHierarchySearchQuery query;
+        query.m_text = text;
+        query.m_case_sensitive = case_sensitive;
+        return Search(query);
+    }
+
+    // What SearchText() is expected to return, found without the index
+    std::vector<uint64_t> LinearSearchText(std::string text, bool case_sensitive = false)
+    {
+        auto to_lower = [](std::string &str) {
+            for (char &c : str)
+            {
+                c = static_cast<char>(tolower(c));
+            }
+        };
+        if (!case_sensitive)
+        {
+            to_lower(text);
+        }
+        std::vector<uint64_t> node_indices;
+        for (uint64_t i = 0; i < m_command_hierarchy.size(); ++i)
+        {
+            std::string desc = m_command_hierarchy.GetNodeDesc(i);
+            if (!case_sensitive)
+            {
+                to_lower(desc);
+            }
+            if (desc.find(text) != std::string::npos)
+            {
+                node_indices.push_back(i);
+            }
+        }
+        return node_indices;
+    }
+
+    // The packet nodes, in node order
+    std::vector<uint64_t> GetPacketNodes()
+    {
+        std::vector<uint64_t> node_indices;
+        for (uint64_t i = 0; i < m_command_hierarchy.size(); ++i)
+        {
+            if (m_command_hierarchy.GetNodeType(i) == NodeType::kPacketNode)
+            {
+                node_indices.push_back(i);
+            }
+        }
+        return node_indices;
+    }
+
+    CommandHierarchy            m_command_hierarchy;
+    CommandHierarchySearchIndex m_index;
+};
+
+TEST_F(CommandHierarchySearchIndexTest, InternsDescriptions)
+{
+    ASSERT_TRUE(m_index.Build(m_command_hierarchy));
+    EXPECT_TRUE(m_index.IsBuilt());
+    EXPECT_EQ(m_index.GetNumNodes(), m_command_hierarchy.size());
+
+    // The fields of the two draws mostly have the same descriptions
+    std::set<std::string> descs;
+    for (uint64_t i = 0; i < m_command_hierarchy.size(); ++i)
+    {
+        descs.insert(m_command_hierarchy.GetNodeDesc(i));
+    }
+    EXPECT_EQ(m_index.GetNumDistinctStrings(), descs.size());
+    EXPECT_LT(m_index.GetNumDistinctStrings(), m_index.GetNumNodes());
+}
+
+TEST_F(CommandHierarchySearchIndexTest, FindsText)
+{
+    ASSERT_TRUE(m_index.Build(m_command_hierarchy));
+    std::vector<uint64_t> packet_nodes = GetPacketNodes();
+    ASSERT_EQ(packet_nodes.size(), 3u);
+    EXPECT_EQ(SearchText("DRAW_INDX"),
+              (std::vector<uint64_t>{ packet_nodes[1], packet_nodes[2] }));
+
+    std::vector<uint64_t> draw_nodes = SearchText("DrawIndexOffset", /*case_sensitive=*/true);
+    ASSERT_EQ(draw_nodes.size(), 2u);
+    EXPECT_EQ(m_command_hierarchy.GetNodeType(draw_nodes[0]), NodeType::kDrawDispatchNode);
+    EXPECT_EQ(SearchText("draw"), LinearSearchText("draw"));
+    EXPECT_EQ(SearchText("Draw", /*case_sensitive=*/true), draw_nodes);
+    EXPECT_EQ(SearchText("NumIndices:36"), (std::vector<uint64_t>{ draw_nodes[0] }));
+
+    std::vector<uint64_t> num_indices_nodes = SearchText("indices: 36");
+    ASSERT_EQ(num_indices_nodes.size(), 1u);
+    EXPECT_STREQ(m_command_hierarchy.GetNodeDesc(num_indices_nodes[0]), "NUM_INDICES: 36");
+
+    // All the trigrams of the text are present, but not the text itself
+    EXPECT_TRUE(SearchText("indx_indx").empty());
+    EXPECT_TRUE(SearchText("not there").empty());
+    // Shorter than a trigram
+    EXPECT_EQ(SearchText("36"), LinearSearchText("36"));
+    EXPECT_EQ(SearchText("").size(), m_command_hierarchy.size());
+}
+
+TEST_F(CommandHierarchySearchIndexTest, FindsRegex)
+{
+    ASSERT_TRUE(m_index.Build(m_command_hierarchy));
+    CommandHierarchySearchQuery query;
+    query.m_is_regex = true;
+    query.m_text = "num_indices: [0-9]$";
+    std::vector<uint64_t> node_indices = Search(query);
+    ASSERT_EQ(node_indices.size(), 1u);
+    EXPECT_STREQ(m_command_hierarchy.GetNodeDesc(node_indices[0]), "NUM_INDICES: 6");
+
+    query.m_case_sensitive = true;
+    EXPECT_TRUE(Search(query).empty());
+
+    query.m_text = "(unbalanced";
+    EXPECT_FALSE(m_index.Search(query, node_indices));
+}
+
+TEST_F(CommandHierarchySearchIndexTest, FiltersPackets)
+{
+    ASSERT_TRUE(m_index.Build(m_command_hierarchy));
+    std::vector<uint64_t> packet_nodes = GetPacketNodes();
+    ASSERT_EQ(packet_nodes.size(), 3u);
+    EXPECT_EQ(m_command_hierarchy.GetPacketNodeAddr(packet_nodes[1]), 0x8u);
+
+    CommandHierarchySearchQuery query;
+    query.m_min_address = 0x0;
+    query.m_max_address = 0x1f;
+    EXPECT_EQ(Search(query), (std::vector<uint64_t>{ packet_nodes[0], packet_nodes[1] }));
+
+    query.m_opcode = CP_DRAW_INDX_OFFSET;
+    EXPECT_EQ(Search(query), (std::vector<uint64_t>{ packet_nodes[1] }));
+
+    query = {};
+    query.m_text = "draw";
+    query.m_opcode = CP_DRAW_INDX_OFFSET;
+    EXPECT_EQ(Search(query), (std::vector<uint64_t>{ packet_nodes[1], packet_nodes[2] }));
+}
+
+TEST_F(CommandHierarchySearchIndexTest, MatchesLinearSearchOnManyStrings)
+{
+    std::vector<uint32_t> num_indices;
+    for (uint32_t i = 0; i < 2000; ++i)
+    {
+        num_indices.push_back(i * 7 % 1500);
+    }
+    CreateHierarchy(num_indices);
+    ASSERT_TRUE(m_index.Build(m_command_hierarchy));
+
+    for (const char *text : { "num_indices: 12", "ces:1", "first_indx: 0x", "7" })
+    {
+        EXPECT_EQ(SearchText(text), LinearSearchText(text)) << text;
+    }
+}
+
+TEST_F(CommandHierarchySearchIndexTest, CancelledBuildLeavesIndexEmpty)
+{
+    SimpleContext context = SimpleContext::Create();
+    context->Cancel();
+    EXPECT_FALSE(m_index.Build(m_command_hierarchy, context));
+    EXPECT_FALSE(m_index.IsBuilt());
+
+    std::vector<uint64_t> node_indices;
+    EXPECT_FALSE(m_index.Search(CommandHierarchySearchQuery(), node_indices));
+}
+
+}  // namespace
+}  // namespace Dive
@@ -0,0 +1,188 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/corpus_stats.h"
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace Dive
+{
+namespace
+{
+
+CorpusCaptureStats MakeCaptureStats(const std::string                  &file_name,
+                                    uint64_t                            num_direct_draws,
+                                    uint64_t                            num_lrz_enabled,
+                                    const std::map<uint32_t, uint32_t> &gpr_histogram = {})
+{
+    CorpusCaptureStats capture_stats;
+    capture_stats.m_file_name = file_name;
+    capture_stats.m_success = true;
+    capture_stats.m_num_events = num_direct_draws;
+    capture_stats.m_stats[Stats::kDirectDraws] = num_direct_draws;
+    capture_stats.m_stats[Stats::kLrzEnabled] = num_lrz_enabled;
+    capture_stats.m_gpr_histogram = gpr_histogram;
+    return capture_stats;
+}
+
+CorpusCaptureStats MakeFailedCaptureStats(const std::string &file_name)
+{
+    CorpusCaptureStats capture_stats;
+    capture_stats.m_file_name = file_name;
+    capture_stats.m_error = "Can't load";
+    return capture_stats;
+}
+
+const CorpusMetricDistribution *FindDistribution(
+const std::vector<CorpusMetricDistribution> &distributions,
+const char                                  *metric)
+{
+    for (const CorpusMetricDistribution &distribution : distributions)
+    {
+        if (strcmp(distribution.m_metric, metric) == 0)
+        {
+            return &distribution;
+        }
+    }
+    return nullptr;
+}
+
+TEST(CorpusStatsTest, EmptyCorpus)
+{
+    CorpusStats corpus_stats;
+    EXPECT_EQ(corpus_stats.GetNumCaptures(), 0u);
+    EXPECT_EQ(corpus_stats.GetNumFailedCaptures(), 0u);
+    EXPECT_TRUE(corpus_stats.GetCaptures().empty());
+    EXPECT_TRUE(corpus_stats.GetDistributions().empty());
+    EXPECT_TRUE(corpus_stats.GetGprHistogram().empty());
+}
+
+TEST(CorpusStatsTest, Distributions)
+{
+    CorpusStats corpus_stats;
+    for (uint64_t i = 1; i <= 11; ++i)
+    {
+        corpus_stats.Add(MakeCaptureStats("capture" + std::to_string(i), i * 10, i));
+    }
+
+    std::vector<CorpusMetricDistribution> distributions = corpus_stats.GetDistributions();
+    EXPECT_EQ(distributions.size(), CorpusStats::GetNumMetrics());
+
+    const CorpusMetricDistribution *draws = FindDistribution(distributions, "draws");
+    ASSERT_NE(draws, nullptr);
+    EXPECT_EQ(draws->m_count, 11u);
+    EXPECT_EQ(draws->m_min, 10.0);
+    EXPECT_EQ(draws->m_p10, 20.0);
+    EXPECT_EQ(draws->m_p50, 60.0);
+    EXPECT_EQ(draws->m_p90, 100.0);
+    EXPECT_EQ(draws->m_max, 110.0);
+    EXPECT_EQ(draws->m_mean, 60.0);
+
+    // 1 LRZ draw out of 10 in every capture
+    const CorpusMetricDistribution *lrz = FindDistribution(distributions, "lrz_enabled_ratio");
+    ASSERT_NE(lrz, nullptr);
+    EXPECT_DOUBLE_EQ(lrz->m_min, 0.1);
+    EXPECT_DOUBLE_EQ(lrz->m_max, 0.1);
+}
+
+TEST(CorpusStatsTest, FailedCaptures)
+{
+    CorpusStats corpus_stats;
+    corpus_stats.Add(MakeFailedCaptureStats("c"));
+    corpus_stats.Add(MakeCaptureStats("b", 10, 0));
+    corpus_stats.Add(MakeFailedCaptureStats("a"));
+
+    EXPECT_EQ(corpus_stats.GetNumCaptures(), 3u);
+    EXPECT_EQ(corpus_stats.GetNumFailedCaptures(), 2u);
+
+    // Listed, sorted by file name
+    std::vector<CorpusCaptureStats> captures = corpus_stats.GetCaptures();
+    ASSERT_EQ(captures.size(), 3u);
+    EXPECT_EQ(captures[0].m_file_name, "a");
+    EXPECT_FALSE(captures[0].m_success);
+    EXPECT_EQ(captures[0].m_error, "Can't load");
+    EXPECT_EQ(captures[1].m_file_name, "b");
+    EXPECT_TRUE(captures[1].m_success);
+
+    // But not in the distributions
+    const CorpusMetricDistribution *draws = FindDistribution(corpus_stats.GetDistributions(),
+                                                             "draws");
+    ASSERT_NE(draws, nullptr);
+    EXPECT_EQ(draws->m_count, 1u);
+    EXPECT_EQ(draws->m_min, 10.0);
+    EXPECT_EQ(draws->m_max, 10.0);
+}
+
+TEST(CorpusStatsTest, OnlyFailedCaptures)
+{
+    CorpusStats corpus_stats;
+    corpus_stats.Add(MakeFailedCaptureStats("a"));
+    EXPECT_EQ(corpus_stats.GetCaptures().size(), 1u);
+    EXPECT_TRUE(corpus_stats.GetDistributions().empty());
+    EXPECT_TRUE(corpus_stats.GetGprHistogram().empty());
+}
+
+TEST(CorpusStatsTest, MergeGprHistograms)
+{
+    CorpusStats corpus_stats, other;
+    corpus_stats.Add(MakeCaptureStats("a", 1, 0, { { 8, 2 }, { 16, 1 } }));
+    other.Add(MakeCaptureStats("b", 1, 0, { { 16, 3 }, { 32, 1 } }));
+    other.Add(MakeFailedCaptureStats("c"));
+
+    corpus_stats.Merge(std::move(other));
+    EXPECT_EQ(corpus_stats.GetNumCaptures(), 3u);
+    EXPECT_EQ(corpus_stats.GetNumFailedCaptures(), 1u);
+    EXPECT_EQ(other.GetNumCaptures(), 0u);
+
+    std::vector<CorpusGprCount> gpr_histogram = corpus_stats.GetGprHistogram();
+    ASSERT_EQ(gpr_histogram.size(), 3u);
+    EXPECT_EQ(gpr_histogram[0].m_num_gprs, 8u);
+    EXPECT_EQ(gpr_histogram[0].m_num_shaders, 2u);
+    EXPECT_EQ(gpr_histogram[0].m_num_captures, 1u);
+    EXPECT_EQ(gpr_histogram[1].m_num_gprs, 16u);
+    EXPECT_EQ(gpr_histogram[1].m_num_shaders, 4u);
+    EXPECT_EQ(gpr_histogram[1].m_num_captures, 2u);
+    EXPECT_EQ(gpr_histogram[2].m_num_gprs, 32u);
+    EXPECT_EQ(gpr_histogram[2].m_num_shaders, 1u);
+    EXPECT_EQ(gpr_histogram[2].m_num_captures, 1u);
+}
+
+TEST(CorpusStatsTest, GatherMissingCapture)
+{
+    std::vector<std::filesystem::path> files = { "missing_capture.rd" };
+    CorpusStatsOptions                 options;
+    options.m_num_workers = 2;
+
+    CorpusStats corpus_stats;
+    size_t      num_done = 0;
+    EXPECT_TRUE(GatherCorpusStats(Context::Background(),
+                                  files,
+                                  options,
+                                  corpus_stats,
+                                  [&](const CorpusCaptureStats &) { ++num_done; }));
+    EXPECT_EQ(num_done, 1u);
+    std::vector<CorpusCaptureStats> captures = corpus_stats.GetCaptures();
+    ASSERT_EQ(captures.size(), 1u);
+    EXPECT_FALSE(captures[0].m_success);
+    EXPECT_FALSE(captures[0].m_error.empty());
+    EXPECT_TRUE(corpus_stats.GetDistributions().empty());
+}
+
+}  // namespace
+}  // namespace Dive
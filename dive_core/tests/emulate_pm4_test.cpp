@@ -0,0 +1,113 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/common/emulate_pm4.h"
+#include "dive_core/pm4_capture_data.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+namespace Dive
+{
+namespace
+{
+
+// Records the submits it is called back for
+class SubmitRecorder : public EmulateCallbacksBase
+{
+public:
+    void OnSubmitStart(uint32_t submit_index, const SubmitInfo &submit_info) override
+    {
+        m_started.push_back(submit_index);
+    }
+    void OnSubmitEnd(uint32_t submit_index, const SubmitInfo &submit_info) override
+    {
+        m_ended.push_back(submit_index);
+    }
+
+    std::vector<uint32_t> m_started;
+    std::vector<uint32_t> m_ended;
+};
+
+DiveVector<SubmitInfo> CreateDummySubmits(uint32_t num_submits)
+{
+    DiveVector<SubmitInfo> submits;
+    for (uint32_t i = 0; i < num_submits; ++i)
+    {
+        submits.push_back(SubmitInfo(EngineType::kUniversal,
+                                     QueueType::kUniversal,
+                                     0,
+                                     true,
+                                     DiveVector<IndirectBufferInfo>()));
+    }
+    return submits;
+}
+
+std::vector<uint32_t> ProcessSubmits(uint32_t num_submits, const SubmitRange *submit_range)
+{
+    Pm4CaptureData capture_data;
+    SubmitRecorder recorder;
+    if (submit_range != nullptr)
+    {
+        recorder.SetSubmitRange(*submit_range);
+    }
+    EXPECT_TRUE(recorder.ProcessSubmits(CreateDummySubmits(num_submits),
+                                        capture_data.GetMemoryManager()));
+    EXPECT_EQ(recorder.m_started, recorder.m_ended);
+    return recorder.m_started;
+}
+
+TEST(EmulatePm4Test, AllSubmits)
+{
+    EXPECT_TRUE(SubmitRange().IsAll());
+    EXPECT_EQ(ProcessSubmits(4, nullptr), std::vector<uint32_t>({ 0, 1, 2, 3 }));
+}
+
+TEST(EmulatePm4Test, SubmitRange)
+{
+    SubmitRange submit_range;
+    submit_range.m_first = 1;
+    submit_range.m_last = 2;
+    EXPECT_FALSE(submit_range.IsAll());
+    EXPECT_FALSE(submit_range.Contains(0));
+    EXPECT_TRUE(submit_range.Contains(2));
+    EXPECT_EQ(ProcessSubmits(4, &submit_range), std::vector<uint32_t>({ 1, 2 }));
+}
+
+TEST(EmulatePm4Test, SubmitRangePastTheEnd)
+{
+    SubmitRange submit_range;
+    submit_range.m_first = 2;
+    submit_range.m_last = 10;
+    EXPECT_EQ(ProcessSubmits(4, &submit_range), std::vector<uint32_t>({ 2, 3 }));
+
+    submit_range.m_first = 5;
+    EXPECT_TRUE(ProcessSubmits(4, &submit_range).empty());
+}
+
+TEST(EmulatePm4Test, Cancelled)
+{
+    Pm4CaptureData capture_data;
+    SubmitRecorder recorder;
+    SimpleContext  context = SimpleContext::Create();
+    recorder.SetContext(context);
+    context->Cancel();
+    EXPECT_FALSE(recorder.ProcessSubmits(CreateDummySubmits(4), capture_data.GetMemoryManager()));
+    EXPECT_TRUE(recorder.m_started.empty());
+}
+
+}  // namespace
+}  // namespace Dive
@@ -0,0 +1,65 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/common/hash_utils.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+namespace Dive
+{
+namespace HashUtils
+{
+
+TEST(HashUtils, StreamingMatchesSingleUpdate)
+{
+    std::vector<uint8_t> data(1000);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+    uint64_t expected = HashContent(data.data(), data.size());
+
+    // Split at sizes that straddle the internal block boundaries
+    for (size_t split : { 1, 7, 31, 32, 33, 500, 999 })
+    {
+        ContentHasher hasher;
+        hasher.Update(data.data(), split);
+        hasher.Update(data.data() + split, data.size() - split);
+        EXPECT_EQ(hasher.Finalize(), expected);
+    }
+}
+
+TEST(HashUtils, DifferentContentDifferentHash)
+{
+    std::vector<uint8_t> a(64, 0);
+    std::vector<uint8_t> b(64, 0);
+    b[63] = 1;
+    EXPECT_NE(HashContent(a.data(), a.size()), HashContent(b.data(), b.size()));
+
+    // Trailing zeros must not collide with the shorter buffer
+    EXPECT_NE(HashContent(a.data(), 63), HashContent(a.data(), 64));
+    EXPECT_NE(HashContent(a.data(), a.size(), 1), HashContent(a.data(), a.size(), 2));
+}
+
+TEST(HashUtils, HashToString)
+{
+    EXPECT_EQ(HashToString(0), "0000000000000000");
+    EXPECT_EQ(HashToString(0x0123456789abcdefull), "0123456789abcdef");
+}
+
+}  // namespace HashUtils
+}  // namespace Dive
@@ -0,0 +1,87 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+
+#include "dive_core/shader_disassembly.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+namespace Dive
+{
+namespace
+{
+
+using DisassembledData = ShaderDisassemblyCache::DisassembledData;
+
+std::shared_ptr<const DisassembledData> CreateData(uint64_t                    content_hash,
+                                                   const std::vector<uint8_t> &binary)
+{
+    auto data = std::make_shared<DisassembledData>();
+    data->m_content_hash = content_hash;
+    data->m_binary = binary;
+    data->m_listing = "listing";
+    data->m_instructions_text = { "nop", "end" };
+    data->m_instructions_raw = { 0, 1 };
+    data->m_gpr_count = 4;
+    return data;
+}
+
+class ShaderDisassemblyCacheTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_directory = std::filesystem::temp_directory_path() / "dive_shader_disassembly_test";
+        std::filesystem::remove_all(m_directory);
+        m_previous_directory = ShaderDisassemblyCache::Get().GetCacheDirectory();
+        ShaderDisassemblyCache::Get().SetCacheDirectory(m_directory);
+    }
+
+    void TearDown() override
+    {
+        ShaderDisassemblyCache::Get().SetCacheDirectory(m_previous_directory);
+        std::filesystem::remove_all(m_directory);
+    }
+
+    std::filesystem::path m_directory;
+    std::filesystem::path m_previous_directory;
+};
+
+TEST_F(ShaderDisassemblyCacheTest, HashCollisionIsAMiss)
+{
+    ShaderDisassemblyCache &cache = ShaderDisassemblyCache::Get();
+    std::vector<uint8_t>    binary = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    std::vector<uint8_t>    other_binary = { 8, 7, 6, 5, 4, 3, 2, 1 };
+
+    auto data = cache.Add(CreateData(0x1234, binary));
+    EXPECT_EQ(cache.Find(0x1234, binary.data(), binary.size()), data);
+    EXPECT_EQ(cache.Find(0x1234, other_binary.data(), other_binary.size()), nullptr);
+
+    // Once no capture references it, the entry is loaded back from disk
+    data = nullptr;
+    auto loaded = cache.Find(0x1234, binary.data(), binary.size());
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_EQ(loaded->m_binary, binary);
+    EXPECT_EQ(loaded->m_listing, "listing");
+    EXPECT_EQ(loaded->m_instructions_text.size(), 2u);
+    EXPECT_EQ(loaded->m_gpr_count, 4u);
+    loaded = nullptr;
+    EXPECT_EQ(cache.Find(0x1234, other_binary.data(), other_binary.size()), nullptr);
+}
+
+}  // namespace
+}  // namespace Dive
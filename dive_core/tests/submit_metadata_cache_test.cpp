@@ -0,0 +1,88 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/submit_metadata_cache.h"
+#include "gtest/gtest.h"
+
+namespace Dive
+{
+namespace
+{
+
+// Metadata of a submit with `num_events` draws
+CaptureMetadata CreateMetadata(uint32_t num_events)
+{
+    CaptureMetadata metadata;
+    for (uint32_t i = 0; i < num_events; ++i)
+    {
+        EventInfo event_info = {};
+        event_info.m_type = EventInfo::EventType::kDraw;
+        metadata.m_event_info.push_back(std::move(event_info));
+        metadata.m_event_state.Add();
+    }
+    return metadata;
+}
+
+TEST(SubmitMetadataCacheTest, TakeCachedSubmit)
+{
+    DataCore            data_core;
+    SubmitMetadataCache cache(data_core, UINT64_MAX);
+    cache.Put(3, CreateMetadata(2));
+    EXPECT_TRUE(cache.Contains(3));
+    EXPECT_GT(cache.GetMemoryUsage(), 0u);
+
+    CaptureMetadata metadata;
+    ASSERT_TRUE(cache.Take(Context::Background(), 3, metadata));
+    EXPECT_EQ(metadata.m_event_info.size(), 2u);
+    EXPECT_EQ(metadata.m_event_state.size(), 2u);
+    EXPECT_FALSE(cache.Contains(3));
+    EXPECT_EQ(cache.GetNumSubmits(), 0u);
+    EXPECT_EQ(cache.GetMemoryUsage(), 0u);
+}
+
+TEST(SubmitMetadataCacheTest, EvictsLeastRecentlyUsed)
+{
+    const uint64_t kSubmitMemoryUsage = CreateMetadata(100).GetMemoryUsage();
+
+    DataCore            data_core;
+    SubmitMetadataCache cache(data_core, 2 * kSubmitMemoryUsage);
+    cache.Put(0, CreateMetadata(100));
+    cache.Put(1, CreateMetadata(100));
+    EXPECT_EQ(cache.GetNumSubmits(), 2u);
+
+    // Submit 0 is used again, so submit 1 is the least recently used
+    CaptureMetadata metadata;
+    ASSERT_TRUE(cache.Take(Context::Background(), 0, metadata));
+    cache.Put(0, std::move(metadata));
+    cache.Put(2, CreateMetadata(100));
+    EXPECT_TRUE(cache.Contains(0));
+    EXPECT_FALSE(cache.Contains(1));
+    EXPECT_TRUE(cache.Contains(2));
+    EXPECT_LE(cache.GetMemoryUsage(), cache.GetMemoryBudget());
+}
+
+TEST(SubmitMetadataCacheTest, SubmitOverBudget)
+{
+    DataCore            data_core;
+    SubmitMetadataCache cache(data_core, CreateMetadata(10).GetMemoryUsage());
+    cache.Put(0, CreateMetadata(10));
+    cache.Put(1, CreateMetadata(1000));
+    EXPECT_TRUE(cache.Contains(0));
+    EXPECT_FALSE(cache.Contains(1));
+}
+
+}  // namespace
+}  // namespace Dive
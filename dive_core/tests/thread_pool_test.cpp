@@ -0,0 +1,150 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_core/thread_pool.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace Dive
+{
+namespace
+{
+
+TEST(ThreadPoolTest, TaskGroupRunsAllTasks)
+{
+    ThreadPool       pool(4);
+    std::atomic<int> count = 0;
+    TaskGroup        group(pool);
+    for (int i = 0; i < 1000; ++i)
+    {
+        group.Run([&count]() { ++count; });
+    }
+    EXPECT_TRUE(group.Wait());
+    EXPECT_EQ(count.load(), 1000);
+}
+
+TEST(ThreadPoolTest, NestedTaskGroupsDoNotDeadlock)
+{
+    // A single worker forces the waiting task to help run its own nested tasks
+    ThreadPool       pool(1);
+    std::atomic<int> count = 0;
+    TaskGroup        group(pool);
+    for (int i = 0; i < 16; ++i)
+    {
+        group.Run([&pool, &count]() {
+            TaskGroup nested_group(pool);
+            for (int j = 0; j < 16; ++j)
+            {
+                nested_group.Run([&count]() { ++count; });
+            }
+            nested_group.Wait();
+        });
+    }
+    EXPECT_TRUE(group.Wait());
+    EXPECT_EQ(count.load(), 16 * 16);
+}
+
+TEST(ThreadPoolTest, WaitOnlyRunsTasksOfItsGroup)
+{
+    ThreadPool        pool(1);
+    std::atomic<bool> started = false;
+    std::atomic<bool> release = false;
+    TaskGroup         blocking_group(pool);
+    blocking_group.Run([&started, &release]() {
+        started = true;
+        while (!release)
+        {
+            std::this_thread::yield();
+        }
+    });
+    while (!started)
+    {
+        std::this_thread::yield();
+    }
+
+    // Queued behind the blocked worker
+    std::atomic<int> other_count = 0;
+    TaskGroup        other_group(pool);
+    other_group.Run([&other_count]() { ++other_count; });
+
+    std::atomic<int> count = 0;
+    TaskGroup        group(pool);
+    group.Run([&count]() { ++count; });
+    EXPECT_TRUE(group.Wait());
+    EXPECT_EQ(count.load(), 1);
+    EXPECT_EQ(other_count.load(), 0);
+
+    release = true;
+    EXPECT_TRUE(other_group.Wait());
+    EXPECT_EQ(other_count.load(), 1);
+}
+
+TEST(ThreadPoolTest, CancelledTaskGroupSkipsTasks)
+{
+    ThreadPool       pool(2);
+    SimpleContext    context = SimpleContext::Create();
+    std::atomic<int> count = 0;
+    context->Cancel();
+
+    TaskGroup group(pool, context);
+    for (int i = 0; i < 100; ++i)
+    {
+        group.Run([&count]() { ++count; });
+    }
+    EXPECT_FALSE(group.Wait());
+    EXPECT_EQ(count.load(), 0);
+}
+
+TEST(ThreadPoolTest, ParallelForVisitsEachIndexOnce)
+{
+    ThreadPool       pool(4);
+    std::vector<int> visits(10000, 0);
+    EXPECT_TRUE(ParallelFor(pool, Context::Background(), 0, visits.size(), 64, [&](size_t i) {
+        visits[i]++;
+    }));
+    EXPECT_EQ(std::accumulate(visits.begin(), visits.end(), 0), 10000);
+    EXPECT_EQ(*std::min_element(visits.begin(), visits.end()), 1);
+}
+
+TEST(ThreadPoolTest, ParallelForChunksCoversRangeInOrder)
+{
+    ThreadPool pool(3);
+    size_t     num_chunks = ParallelForNumChunks(pool, 1000, 10);
+    std::vector<std::pair<size_t, size_t>> ranges(num_chunks);
+    EXPECT_TRUE(ParallelForChunks(pool,
+                                  Context::Background(),
+                                  5,
+                                  1005,
+                                  10,
+                                  [&](size_t chunk_index, size_t begin, size_t end) {
+                                      ranges[chunk_index] = { begin, end };
+                                  }));
+    size_t expected_begin = 5;
+    for (const auto &[begin, end] : ranges)
+    {
+        EXPECT_EQ(begin, expected_begin);
+        EXPECT_LE(begin, end);
+        expected_begin = end;
+    }
+    EXPECT_EQ(expected_begin, 1005u);
+}
+
+}  // namespace
+}  // namespace Dive
@@ -0,0 +1,285 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "thread_pool.h"
+
+
+namespace Dive
+{
+namespace
+{
+
+// Identifies the pool and the worker running on the current thread, if any
+struct WorkerIdentity
+{
+    const ThreadPool *m_pool = nullptr;
+    uint32_t          m_index = UINT32_MAX;
+};
+
+thread_local WorkerIdentity t_worker_identity;
+
+}  // namespace
+
+// =================================================================================================
+// ThreadPool
+// =================================================================================================
+ThreadPool::ThreadPool(uint32_t num_workers)
+{
+    num_workers = (num_workers > 0 ? num_workers : DefaultNumWorkers());
+
+    // Extra queue at the end is the injection queue
+    for (uint32_t i = 0; i < num_workers + 1; ++i)
+    {
+        m_queues.push_back(std::make_unique<TaskQueue>());
+    }
+    m_workers.reserve(num_workers);
+    for (uint32_t i = 0; i < num_workers; ++i)
+    {
+        m_workers.emplace_back([this, i]() { this->WorkerImpl(i); });
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        m_running = false;
+    }
+    m_sleep_condition_variable.notify_all();
+    for (std::thread &worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+ThreadPool &ThreadPool::Shared()
+{
+    static ThreadPool shared_pool;
+    return shared_pool;
+}
+
+//--------------------------------------------------------------------------------------------------
+uint32_t ThreadPool::DefaultNumWorkers()
+{
+    unsigned int count = std::thread::hardware_concurrency();
+    return (count > 1 ? count - 1 : 1);
+}
+
+//--------------------------------------------------------------------------------------------------
+void ThreadPool::Run(Task &&task)
+{
+    // Count the task before publishing it, so the count never drops below the number of queued
+    // tasks when it is popped right away
+    {
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        ++m_pending_tasks;
+    }
+    uint32_t queue_index = IsWorkerThread() ? t_worker_identity.m_index : NumWorkers();
+    {
+        TaskQueue                  &queue = *m_queues[queue_index];
+        std::lock_guard<std::mutex> lock(queue.m_mutex);
+        queue.m_tasks.push_back(std::move(task));
+    }
+    m_sleep_condition_variable.notify_one();
+}
+
+//--------------------------------------------------------------------------------------------------
+bool ThreadPool::IsWorkerThread() const
+{
+    return t_worker_identity.m_pool == this;
+}
+
+//--------------------------------------------------------------------------------------------------
+bool ThreadPool::PopTask(uint32_t worker_index, Task &task)
+{
+    if (m_pending_tasks.load() == 0)
+    {
+        return false;
+    }
+
+    // Own queue first, newest task first
+    if (worker_index < NumWorkers())
+    {
+        TaskQueue                  &queue = *m_queues[worker_index];
+        std::lock_guard<std::mutex> lock(queue.m_mutex);
+        if (!queue.m_tasks.empty())
+        {
+            task = std::move(queue.m_tasks.back());
+            queue.m_tasks.pop_back();
+            --m_pending_tasks;
+            return true;
+        }
+    }
+    return StealTask(worker_index, task);
+}
+
+//--------------------------------------------------------------------------------------------------
+bool ThreadPool::StealTask(uint32_t worker_index, Task &task)
+{
+    // Start from the injection queue, then visit the other workers round-robin so that thieves
+    // do not all contend on the same victim
+    uint32_t num_queues = static_cast<uint32_t>(m_queues.size());
+    uint32_t start = num_queues - 1;
+    for (uint32_t i = 0; i < num_queues; ++i)
+    {
+        uint32_t victim = (start + i + (worker_index < NumWorkers() ? worker_index : 0)) %
+                          num_queues;
+        if (victim == worker_index)
+        {
+            continue;
+        }
+        TaskQueue                  &queue = *m_queues[victim];
+        std::lock_guard<std::mutex> lock(queue.m_mutex);
+        if (!queue.m_tasks.empty())
+        {
+            task = std::move(queue.m_tasks.front());
+            queue.m_tasks.pop_front();
+            --m_pending_tasks;
+            return true;
+        }
+    }
+    return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+void ThreadPool::WorkerImpl(uint32_t worker_index)
+{
+    t_worker_identity.m_pool = this;
+    t_worker_identity.m_index = worker_index;
+
+    while (true)
+    {
+        Task task;
+        if (PopTask(worker_index, task))
+        {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleep_mutex);
+        m_sleep_condition_variable.wait(lock, [this] {
+            return !m_running || m_pending_tasks.load() > 0;
+        });
+        // Drain the remaining tasks before exiting
+        if (!m_running && m_pending_tasks.load() == 0)
+        {
+            break;
+        }
+    }
+
+    t_worker_identity = WorkerIdentity();
+}
+
+// =================================================================================================
+// TaskGroup
+// =================================================================================================
+struct TaskGroup::State
+{
+    explicit State(const Context &context) :
+        m_context(context)
+    {
+    }
+
+    // Run the oldest task not started yet, if any. Returns false if there was none.
+    bool RunTask()
+    {
+        ThreadPool::Task task;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_tasks.empty())
+            {
+                return false;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        if (!m_context.Cancelled())
+        {
+            task();
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_outstanding_tasks == 0)
+        {
+            m_condition_variable.notify_all();
+        }
+        return true;
+    }
+
+    Context                      m_context;
+    std::mutex                   m_mutex;
+    std::condition_variable      m_condition_variable;
+    std::deque<ThreadPool::Task> m_tasks;  // Not started yet
+    size_t                       m_outstanding_tasks = 0;  // Not started yet, or running
+};
+
+//--------------------------------------------------------------------------------------------------
+TaskGroup::TaskGroup(ThreadPool &pool, const Context &context) :
+    m_pool(pool),
+    m_context(context),
+    m_state(std::make_shared<State>(context))
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+TaskGroup::~TaskGroup()
+{
+    // Tasks may reference state owned by the caller of the group
+    Wait();
+}
+
+//--------------------------------------------------------------------------------------------------
+void TaskGroup::Run(ThreadPool::Task &&task)
+{
+    if (m_context.Cancelled())
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_state->m_mutex);
+        m_state->m_tasks.push_back(std::move(task));
+        ++m_state->m_outstanding_tasks;
+    }
+    // Wake up Wait() to run it, in case the workers are busy
+    m_state->m_condition_variable.notify_all();
+    m_pool.Run([state = m_state]() { state->RunTask(); });
+}
+
+//--------------------------------------------------------------------------------------------------
+bool TaskGroup::Wait()
+{
+    while (true)
+    {
+        if (m_state->RunTask())
+        {
+            continue;
+        }
+        // The remaining tasks are running on other threads. They may add tasks to the group,
+        // which wake up this thread to help with them.
+        std::unique_lock<std::mutex> lock(m_state->m_mutex);
+        m_state->m_condition_variable.wait(lock, [this] {
+            return m_state->m_outstanding_tasks == 0 || !m_state->m_tasks.empty();
+        });
+        if (m_state->m_outstanding_tasks == 0)
+        {
+            break;
+        }
+    }
+    return !m_context.Cancelled();
+}
+
+}  // namespace Dive
@@ -0,0 +1,200 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "dive_core/context.h"
+
+namespace Dive
+{
+
+// Work-stealing thread pool.
+//
+// Each worker owns a deque of tasks. Tasks scheduled from a worker go to the back of its own
+// deque and are popped LIFO by that worker, which keeps recursively split work cache-local. Tasks
+// scheduled from other threads go to a shared injection queue. Idle workers first drain the
+// injection queue and then steal from the front of the other workers' deques.
+//
+// Usage:
+//     Dive::TaskGroup group(Dive::ThreadPool::Shared(), context);
+//     for (...)
+//         group.Run([&]() { ... });
+//     if (!group.Wait())
+//         return;  // Cancelled
+class ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    // num_workers == 0 uses DefaultNumWorkers()
+    explicit ThreadPool(uint32_t num_workers = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // Process-wide pool shared by parsing, disassembly, stats and correlation so that they do
+    // not oversubscribe the cores
+    static ThreadPool &Shared();
+
+    // One worker per hardware thread, leaving one for the calling (UI/main) thread
+    static uint32_t DefaultNumWorkers();
+
+    uint32_t NumWorkers() const { return static_cast<uint32_t>(m_workers.size()); }
+
+    // Schedule a task. Prefer TaskGroup, which allows waiting on and cancelling a set of tasks.
+    void Run(Task &&task);
+
+    // Whether the calling thread is one of this pool's workers
+    bool IsWorkerThread() const;
+
+private:
+    struct TaskQueue
+    {
+        std::mutex       m_mutex;
+        std::deque<Task> m_tasks;
+    };
+
+    bool PopTask(uint32_t worker_index, Task &task);
+    bool StealTask(uint32_t worker_index, Task &task);
+    void WorkerImpl(uint32_t worker_index);
+
+    // One queue per worker, followed by the injection queue for external threads
+    std::vector<std::unique_ptr<TaskQueue>> m_queues;
+    std::vector<std::thread>                m_workers;
+
+    std::mutex              m_sleep_mutex;
+    std::condition_variable m_sleep_condition_variable;
+    std::atomic<size_t>     m_pending_tasks = 0;
+    bool                    m_running = true;
+};
+
+// A set of tasks which can be waited on and cancelled together through a Context.
+// Tasks scheduled after the context is cancelled are dropped without being run.
+//
+// The tasks are queued in the group, and each of them is claimed by whichever comes first: a pool
+// worker, or the thread waiting on the group. So a waiting thread only ever runs tasks of its own
+// group, and the pool tasks left over once the group is done are no-ops.
+class TaskGroup
+{
+public:
+    explicit TaskGroup(ThreadPool &pool, const Context &context = Context::Background());
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    void Run(ThreadPool::Task &&task);
+
+    // Block until all the tasks of the group are complete. The calling thread runs the tasks of
+    // the group which have not started yet, and sleeps while the others run on other threads, so
+    // it is safe to wait from within a worker.
+    // Returns false if the context was cancelled.
+    bool Wait();
+
+    bool           Cancelled() const { return m_context.Cancelled(); }
+    const Context &GetContext() const { return m_context; }
+    ThreadPool    &GetPool() const { return m_pool; }
+
+private:
+    // Shared with the pool tasks, which may outlive the group
+    struct State;
+
+    ThreadPool            &m_pool;
+    Context                m_context;
+    std::shared_ptr<State> m_state;
+};
+
+// Number of chunks ParallelFor() splits [0, count) into
+inline size_t ParallelForNumChunks(const ThreadPool &pool, size_t count, size_t min_chunk_size)
+{
+    // A few chunks per worker balances the load when the cost per item is uneven
+    constexpr size_t kChunksPerWorker = 4;
+    min_chunk_size = std::max<size_t>(min_chunk_size, 1);
+    size_t num_chunks = std::min<size_t>((size_t)(pool.NumWorkers() + 1) * kChunksPerWorker,
+                                         (count + min_chunk_size - 1) / min_chunk_size);
+    return std::max<size_t>(num_chunks, 1);
+}
+
+// Call func(chunk_index, begin, end) over [begin, end) split into contiguous chunks of at least
+// min_chunk_size items. Chunk indices are in increasing order of the ranges, which allows callers
+// to reduce per-chunk partial results deterministically.
+// Returns false if the context was cancelled.
+template<typename Func>
+bool ParallelForChunks(ThreadPool    &pool,
+                       const Context &context,
+                       size_t         begin,
+                       size_t         end,
+                       size_t         min_chunk_size,
+                       Func         &&func)
+{
+    if (end <= begin)
+    {
+        return !context.Cancelled();
+    }
+    size_t count = end - begin;
+    size_t num_chunks = ParallelForNumChunks(pool, count, min_chunk_size);
+    size_t chunk_size = (count + num_chunks - 1) / num_chunks;
+
+    TaskGroup group(pool, context);
+    for (size_t c = 0; c < num_chunks; ++c)
+    {
+        size_t chunk_begin = begin + std::min(c * chunk_size, count);
+        size_t chunk_end = begin + std::min((c + 1) * chunk_size, count);
+        group.Run([&func, c, chunk_begin, chunk_end]() { func(c, chunk_begin, chunk_end); });
+    }
+    return group.Wait();
+}
+
+// Call func(index) for each index in [begin, end)
+template<typename Func>
+bool ParallelFor(ThreadPool    &pool,
+                 const Context &context,
+                 size_t         begin,
+                 size_t         end,
+                 size_t         min_chunk_size,
+                 Func         &&func)
+{
+    return ParallelForChunks(pool,
+                             context,
+                             begin,
+                             end,
+                             min_chunk_size,
+                             [&func, &context](size_t, size_t chunk_begin, size_t chunk_end) {
+                                 for (size_t i = chunk_begin; i < chunk_end; ++i)
+                                 {
+                                     if (context.Cancelled())
+                                     {
+                                         return;
+                                     }
+                                     func(i);
+                                 }
+                             });
+}
+
+}  // namespace Dive
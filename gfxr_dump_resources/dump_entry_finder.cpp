@@ -0,0 +1,149 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+
+#include "dump_entry_finder.h"
+
+#include "third_party/gfxreconstruct/framework/util/logging.h"
+
+namespace Dive::gfxr
+{
+
+DumpEntryFinder::DumpEntryFinder(std::function<void(DumpEntry)> dump_found_callback) :
+    dump_found_callback_(std::move(dump_found_callback))
+{
+}
+
+void DumpEntryFinder::OnFunction(const std::string&            function_name,
+                                 uint64_t                      block_index,
+                                 const nlohmann::ordered_json& args)
+{
+    if (function_name == "vkQueueSubmit")
+    {
+        OnQueueSubmit(block_index, args);
+        return;
+    }
+
+    auto command_buffer_it = args.find("commandBuffer");
+    if (command_buffer_it == args.end())
+    {
+        return;
+    }
+    uint64_t command_buffer = command_buffer_it->get<uint64_t>();
+
+    if (function_name == "vkBeginCommandBuffer")
+    {
+        GFXRECON_LOG_DEBUG("vkBeginCommandBuffer: commandBuffer=%lu", command_buffer);
+        CommandBufferState state;
+        state.dump_entry.begin_command_buffer_block_index = block_index;
+        auto [it, inserted] = incomplete_dumps_.insert_or_assign(command_buffer, std::move(state));
+        if (!inserted)
+        {
+            GFXRECON_LOG_DEBUG("Command buffer %lu never submitted! Discarding previous state...",
+                               command_buffer);
+        }
+        return;
+    }
+
+    auto it = incomplete_dumps_.find(command_buffer);
+    if (it == incomplete_dumps_.end())
+    {
+        return;
+    }
+    CommandBufferState& state = it->second;
+
+    switch (state.state)
+    {
+    case State::kLookingForBeginRenderPass:
+        if (function_name == "vkCmdBeginRenderPass" || function_name == "vkCmdBeginRenderPass2KHR")
+        {
+            state.dump_entry.render_passes.push_back(DumpRenderPass{ block_index });
+            state.state = State::kLookingForDraw;
+        }
+        break;
+    case State::kLookingForDraw:
+        // TODO: Subpass
+        // TODO: Other draws
+        if (function_name == "vkCmdDraw" || function_name == "vkCmdDrawIndexed")
+        {
+            // Stay in this state and keep accumulating any subsequent draws.
+            state.dump_entry.draws.push_back(block_index);
+        }
+        else if (function_name == "vkCmdEndRenderPass" ||
+                 function_name == "vkCmdEndRenderPass2KHR")
+        {
+            state.dump_entry.render_passes.back().end_block_index = block_index;
+            state.state = State::kLookingForBeginRenderPass;
+        }
+        break;
+    }
+}
+
+void DumpEntryFinder::OnQueueSubmit(uint64_t block_index, const nlohmann::ordered_json& args)
+{
+    GFXRECON_LOG_DEBUG("vkQueueSubmit");
+    auto submits_it = args.find("pSubmits");
+    if (submits_it == args.end() || !submits_it->is_array())
+    {
+        return;
+    }
+
+    for (const nlohmann::ordered_json& submit : *submits_it)
+    {
+        auto command_buffers_it = submit.find("pCommandBuffers");
+        if (command_buffers_it == submit.end() || !command_buffers_it->is_array())
+        {
+            continue;
+        }
+        for (const nlohmann::ordered_json& command_buffer_json : *command_buffers_it)
+        {
+            uint64_t command_buffer = command_buffer_json.get<uint64_t>();
+            GFXRECON_LOG_DEBUG("... for commandBuffer=%lu", command_buffer);
+            auto it = incomplete_dumps_.find(command_buffer);
+            if (it == incomplete_dumps_.end())
+            {
+                GFXRECON_LOG_DEBUG("Command buffer %lu never started! Ignoring...",
+                                   command_buffer);
+                continue;
+            }
+            if (it->second.state != State::kLookingForBeginRenderPass)
+            {
+                continue;
+            }
+            it->second.dump_entry.queue_submit_block_index = block_index;
+            // Could be accept or reject depending on what's been accumulated so far...
+            Done(command_buffer);
+        }
+    }
+}
+
+void DumpEntryFinder::Done(uint64_t command_buffer)
+{
+    auto       it = incomplete_dumps_.find(command_buffer);
+    DumpEntry& dump_entry = it->second.dump_entry;
+    if (dump_entry.IsComplete())
+    {
+        GFXRECON_LOG_DEBUG("Accept! ID=%lu", command_buffer);
+        dump_found_callback_(std::move(dump_entry));
+    }
+    else
+    {
+        GFXRECON_LOG_DEBUG("Reject! ID=%lu", command_buffer);
+    }
+    incomplete_dumps_.erase(it);
+}
+
+}  // namespace Dive::gfxr
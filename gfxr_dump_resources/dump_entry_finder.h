@@ -0,0 +1,90 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+#include "dump_entry.h"
+
+#include "gfxr_ext/decode/dive_annotation_processor.h"
+
+namespace Dive::gfxr
+{
+
+// Processes the Vulkan commands of a .gfxr in capture order, looking for candidates for
+// `--dump-resources`. The commands are the ones exported by VulkanExportDiveConsumer, so the
+// finder can observe the regular load of a capture by Dive (see
+// DiveAnnotationProcessor::AddFunctionObserver) instead of decoding the capture again.
+//
+// Each command buffer has its own state, to avoid problems that could arise if two command buffers
+// are interleaved in the capture. The commands of a command buffer are expected in a certain order
+// with certain constraints:
+//
+// - LookingForBeginRenderPass:
+//   - Start here when vkBeginCommandBuffer is found. If the command buffer already has state
+//   (likely vkQueueSubmit was not called), then the state is reset.
+//   - When vkCmdBeginRenderPass is found, record the block index and transition to LookingForDraw.
+//   - When vkQueueSubmit is found, record the block index. Then, either accept or reject depending
+//   on whether the dumpable is complete.
+//
+// - LookingForDraw:
+//   - When a vkCmdDraw* call is found, record the block index. Stay in this state to accumulate
+//   more draw calls.
+//   - When vkCmdEndRenderPass is found, record the block index and transition to
+//   LookingForBeginRenderPass.
+//
+// Accepted dumpables are complete and passed to the callback. Rejected ones are discarded.
+class DumpEntryFinder : public DiveAnnotationProcessor::FunctionObserver
+{
+public:
+    // `dump_found_callback` is run when a complete DumpEntry is found which is suitable for being
+    // used with `--dump-resources`.
+    explicit DumpEntryFinder(std::function<void(DumpEntry)> dump_found_callback);
+
+    void OnFunction(const std::string&            function_name,
+                    uint64_t                      block_index,
+                    const nlohmann::ordered_json& args) override;
+
+private:
+    enum class State
+    {
+        kLookingForBeginRenderPass,
+        kLookingForDraw,
+    };
+
+    struct CommandBufferState
+    {
+        State     state = State::kLookingForBeginRenderPass;
+        DumpEntry dump_entry;
+    };
+
+    void OnQueueSubmit(uint64_t block_index, const nlohmann::ordered_json& args);
+
+    // Accept or reject the dumpable of the command buffer, which is submitted
+    void Done(uint64_t command_buffer);
+
+    std::function<void(DumpEntry)> dump_found_callback_;
+
+    // State of the command buffers which have begun and are not submitted yet
+    std::unordered_map<uint64_t, CommandBufferState> incomplete_dumps_;
+};
+
+}  // namespace Dive::gfxr
@@ -16,20 +16,102 @@
 
 #include "gfxr_dump_resources.h"
 
+#include <charconv>
 #include <fstream>
 #include <iostream>
 #include <optional>
 #include <vector>
 
 #include "dump_entry.h"
-#include "dump_resources_builder_consumer.h"
+#include "dump_entry_finder.h"
 
+#include "gfxr_ext/decode/dive_filtered_vulkan_decoder.h"
 #include "third_party/gfxreconstruct/framework/decode/file_processor.h"
-#include "third_party/gfxreconstruct/framework/generated/generated_vulkan_decoder.h"
+#include "third_party/gfxreconstruct/framework/generated/generated_vulkan_dive_consumer.h"
 
 namespace Dive::gfxr
 {
 
+namespace
+{
+
+// Forwards the commands exported by VulkanExportDiveConsumer to a DumpEntryFinder
+class DumpEntryFinderHandler : public gfxrecon::decode::AnnotationHandler
+{
+public:
+    explicit DumpEntryFinderHandler(DumpEntryFinder& finder) :
+        finder_(finder)
+    {
+    }
+
+    void ProcessAnnotation(uint64_t                         block_index,
+                           gfxrecon::format::AnnotationType type,
+                           const std::string&               label,
+                           const std::string&               data) override
+    {
+    }
+
+    void WriteBlockEnd(const gfxrecon::util::DiveFunctionData& function_data) override
+    {
+        finder_.OnFunction(function_data.GetFunctionName(),
+                           function_data.GetBlockIndex(),
+                           function_data.GetArgs());
+    }
+
+private:
+    DumpEntryFinder& finder_;
+};
+
+// Index of the draws of `dump_entry` to keep for `plan`
+std::vector<size_t> SelectDraws(const DumpEntry& dump_entry, const DumpPlan& plan)
+{
+    const std::vector<uint64_t>& draws = dump_entry.draws;
+    std::vector<size_t>          selected;
+    switch (plan.kind)
+    {
+    case DumpPlan::Kind::kAllDraws:
+        for (size_t i = 0; i < draws.size(); ++i)
+        {
+            selected.push_back(i);
+        }
+        break;
+    case DumpPlan::Kind::kLastDraw:
+        selected.push_back(draws.size() - 1);
+        break;
+    case DumpPlan::Kind::kLastDrawPerRenderPass:
+    {
+        // Draws are only recorded within a render pass, and both are in block order
+        size_t draw = 0;
+        for (const DumpRenderPass& render_pass : dump_entry.render_passes)
+        {
+            std::optional<size_t> last_draw;
+            for (; draw < draws.size() && draws[draw] < render_pass.end_block_index; ++draw)
+            {
+                last_draw = draw;
+            }
+            if (last_draw.has_value())
+            {
+                selected.push_back(*last_draw);
+            }
+        }
+        break;
+    }
+    case DumpPlan::Kind::kEveryNDraws:
+        for (size_t i = plan.draw_interval - 1; i < draws.size(); i += plan.draw_interval)
+        {
+            selected.push_back(i);
+        }
+        if (selected.empty() || selected.back() != draws.size() - 1)
+        {
+            selected.push_back(draws.size() - 1);
+        }
+        break;
+    }
+    return selected;
+}
+
+}  // namespace
+
 std::optional<std::vector<DumpEntry>> FindDumpableResources(const char* filename)
 {
     gfxrecon::decode::FileProcessor file_processor;
@@ -38,13 +120,29 @@ std::optional<std::vector<DumpEntry>> FindDumpableResources(const char* filename
         std::cerr << "Failed to open input:" << filename << '\n';
         return std::nullopt;
     }
+    // The parameters of the commands that are not decoded are not even read
+    file_processor.SetSkipUnsupportedFunctionCalls(true);
 
     std::vector<DumpEntry> complete_dump_entries;
 
-    gfxrecon::decode::VulkanDecoder vulkan_decoder;
-    DumpResourcesBuilderConsumer    consumer([&complete_dump_entries](DumpEntry dump_entry) {
+    DumpEntryFinder finder([&complete_dump_entries](DumpEntry dump_entry) {
         complete_dump_entries.push_back(std::move(dump_entry));
     });
+    DumpEntryFinderHandler                     handler(finder);
+    gfxrecon::decode::VulkanExportDiveConsumer consumer;
+
+    // Only decode the commands that DumpEntryFinder looks for. Exporting the other commands would
+    // be wasted work.
+    gfxrecon::decode::DiveFilteredVulkanDecoder vulkan_decoder(
+    { gfxrecon::format::ApiCallId::ApiCall_vkBeginCommandBuffer,
+      gfxrecon::format::ApiCallId::ApiCall_vkCmdBeginRenderPass,
+      gfxrecon::format::ApiCallId::ApiCall_vkCmdBeginRenderPass2KHR,
+      gfxrecon::format::ApiCallId::ApiCall_vkCmdDraw,
+      gfxrecon::format::ApiCallId::ApiCall_vkCmdDrawIndexed,
+      gfxrecon::format::ApiCallId::ApiCall_vkCmdEndRenderPass,
+      gfxrecon::format::ApiCallId::ApiCall_vkCmdEndRenderPass2KHR,
+      gfxrecon::format::ApiCallId::ApiCall_vkQueueSubmit });
+    consumer.Initialize(&handler);
     vulkan_decoder.AddConsumer(&consumer);
     file_processor.AddDecoder(&vulkan_decoder);
 
@@ -53,6 +151,74 @@ std::optional<std::vector<DumpEntry>> FindDumpableResources(const char* filename
     return complete_dump_entries;
 }
 
+std::optional<DumpPlan> ParseDumpPlan(std::string_view plan)
+{
+    size_t separator = plan.find('=');
+    if (separator == std::string_view::npos || separator + 1 == plan.size())
+    {
+        return std::nullopt;
+    }
+
+    DumpPlan         dump_plan;
+    std::string_view kind = plan.substr(0, separator);
+    dump_plan.output_path = std::string(plan.substr(separator + 1));
+    if (kind == "all")
+    {
+        dump_plan.kind = DumpPlan::Kind::kAllDraws;
+        return dump_plan;
+    }
+    if (kind == "last_draw")
+    {
+        dump_plan.kind = DumpPlan::Kind::kLastDraw;
+        return dump_plan;
+    }
+    if (kind == "last_draw_per_render_pass")
+    {
+        dump_plan.kind = DumpPlan::Kind::kLastDrawPerRenderPass;
+        return dump_plan;
+    }
+
+    constexpr std::string_view kEveryPrefix = "every_";
+    constexpr std::string_view kDrawsSuffix = "_draws";
+    if (kind.size() <= kEveryPrefix.size() + kDrawsSuffix.size() ||
+        kind.substr(0, kEveryPrefix.size()) != kEveryPrefix ||
+        kind.substr(kind.size() - kDrawsSuffix.size()) != kDrawsSuffix)
+    {
+        return std::nullopt;
+    }
+    std::string_view interval = kind.substr(kEveryPrefix.size(),
+                                            kind.size() - kEveryPrefix.size() -
+                                            kDrawsSuffix.size());
+    auto [end, error] = std::from_chars(interval.data(),
+                                        interval.data() + interval.size(),
+                                        dump_plan.draw_interval);
+    if (error != std::errc() || end != interval.data() + interval.size() ||
+        dump_plan.draw_interval == 0)
+    {
+        return std::nullopt;
+    }
+    dump_plan.kind = DumpPlan::Kind::kEveryNDraws;
+    return dump_plan;
+}
+
+std::vector<DumpEntry> ApplyDumpPlan(const std::vector<DumpEntry>& dumpables, const DumpPlan& plan)
+{
+    std::vector<DumpEntry> planned;
+    planned.reserve(dumpables.size());
+    for (const DumpEntry& dumpable : dumpables)
+    {
+        // Complete dump entries have at least one draw
+        DumpEntry planned_entry = dumpable;
+        planned_entry.draws.clear();
+        for (size_t draw : SelectDraws(dumpable, plan))
+        {
+            planned_entry.draws.push_back(dumpable.draws[draw]);
+        }
+        planned.push_back(std::move(planned_entry));
+    }
+    return planned;
+}
+
 bool SaveAsJsonFile(const std::vector<DumpEntry>& dumpables, const char* filename)
 {
     std::ofstream out(filename);
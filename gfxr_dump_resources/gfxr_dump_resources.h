@@ -16,7 +16,10 @@
 
 #pragma once
 
+#include <cstdint>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include "dump_entry.h"
@@ -26,9 +29,43 @@ namespace Dive::gfxr
 
 // From a GFXR file, produce block indices that can be used with GXR --dump-resources.
 //
+// Only the commands which can be part of a DumpEntry are decoded. To find the dump entries while
+// Dive loads a capture instead, attach a DumpEntryFinder to the load.
+//
 // Returns std::nullopt on error.
 std::optional<std::vector<DumpEntry>> FindDumpableResources(const char* filename);
 
+// Selects the draws to dump from the dump entries of a capture. Dumping a draw is slow (each draw
+// call can take 2-3 seconds), so plans trade coverage for speed. Since the dump entries only need
+// to be found once, several plans can be generated from a single pass over the capture.
+struct DumpPlan
+{
+    enum class Kind
+    {
+        // All the draws
+        kAllDraws,
+        // The final draw of each entry. This should represent the image presented to the user.
+        kLastDraw,
+        // The final draw of each render pass
+        kLastDrawPerRenderPass,
+        // Every `draw_interval`-th draw of each entry, and its final draw
+        kEveryNDraws,
+    };
+
+    Kind        kind = Kind::kAllDraws;
+    uint32_t    draw_interval = 1;
+    std::string output_path;
+};
+
+// Parse a plan given as PLAN=OUTPUT.JSON, where PLAN is one of "all", "last_draw",
+// "last_draw_per_render_pass" or "every_N_draws" (for example "every_10_draws").
+//
+// Returns std::nullopt on error.
+std::optional<DumpPlan> ParseDumpPlan(std::string_view plan);
+
+// Keep the draws of the dump entries selected by the plan.
+std::vector<DumpEntry> ApplyDumpPlan(const std::vector<DumpEntry>& dumpables, const DumpPlan& plan);
+
 // Serialize a list of complete dumpable to a JSON file.
 //
 // Returns false on error.
@@ -16,6 +16,7 @@
 
 #include <iostream>
 #include <optional>
+#include <string>
 #include <vector>
 
 #include "dump_entry.h"
@@ -31,12 +32,21 @@ ABSL_FLAG(bool,
           false,
           "If specified, only dump the final draw call for a render pass. This should speed up "
           "dumping while still providing a useful result.");
+ABSL_FLAG(std::vector<std::string>,
+          plans,
+          {},
+          "Additional dump plans to generate in the same run, as a comma-separated list of "
+          "PLAN=OUTPUT.JSON. PLAN is one of all, last_draw, last_draw_per_render_pass or "
+          "every_N_draws (for example every_10_draws).");
 
 namespace
 {
 
+using Dive::gfxr::ApplyDumpPlan;
 using Dive::gfxr::DumpEntry;
+using Dive::gfxr::DumpPlan;
 using Dive::gfxr::FindDumpableResources;
+using Dive::gfxr::ParseDumpPlan;
 using Dive::gfxr::SaveAsJsonFile;
 using gfxrecon::util::Log;
 
@@ -55,6 +65,25 @@ int main(int argc, char** argv)
     const char* input_filename = positional_args[1];
     const char* output_filename = positional_args[2];
 
+    std::vector<DumpPlan> plans;
+    DumpPlan              main_plan;
+    if (absl::GetFlag(FLAGS_last_draw_only))
+    {
+        main_plan.kind = DumpPlan::Kind::kLastDraw;
+    }
+    main_plan.output_path = output_filename;
+    plans.push_back(std::move(main_plan));
+    for (const std::string& plan_flag : absl::GetFlag(FLAGS_plans))
+    {
+        std::optional<DumpPlan> plan = ParseDumpPlan(plan_flag);
+        if (!plan.has_value())
+        {
+            std::cerr << "Invalid dump plan: " << plan_flag << '\n';
+            return 1;
+        }
+        plans.push_back(*std::move(plan));
+    }
+
 #ifdef NDEBUG
     Log::Init(Log::kInfoSeverity);
 #else
@@ -68,27 +97,15 @@ int main(int argc, char** argv)
         return 1;
     }
 
-    if (absl::GetFlag(FLAGS_last_draw_only))
+    // The dump entries are found once for all the plans
+    for (const DumpPlan& plan : plans)
     {
-        // Only keep the final draw call. This should represent the image presented to the user.
-        // For validation purposes, this is typically fine and saves a lot of time (since each draw
-        // call can take 2-3 seconds to dump).
-        for (DumpEntry& dumpable : *dumpables)
+        if (!SaveAsJsonFile(ApplyDumpPlan(*dumpables, plan), plan.output_path.c_str()))
         {
-            std::vector<uint64_t>& draws = dumpable.draws;
-            if (draws.size() == 1)
-            {
-                continue;
-            }
-            draws.erase(draws.begin(), draws.end() - 1);
+            std::cerr << "Failed to serialize to " << plan.output_path << '\n';
+            return 1;
         }
     }
 
-    if (!SaveAsJsonFile(*dumpables, output_filename))
-    {
-        std::cerr << "Failed to serialize to " << output_filename << '\n';
-        return 1;
-    }
-
     return 0;
 }
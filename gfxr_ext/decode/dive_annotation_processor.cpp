@@ -23,8 +23,21 @@
 
 void DiveAnnotationProcessor::WriteBlockEnd(const gfxrecon::util::DiveFunctionData& function_data)
 {
-    std::string function_name = function_data.GetFunctionName();
-    const auto& args = function_data.GetArgs();
+    ProcessFunction(function_data.GetFunctionName(),
+                    function_data.GetCmdBufferIndex(),
+                    function_data.GetBlockIndex(),
+                    function_data.GetArgs());
+}
+
+void DiveAnnotationProcessor::ProcessFunction(const std::string&            function_name,
+                                              uint32_t                      cmd_buffer_index,
+                                              uint64_t                      block_index,
+                                              const nlohmann::ordered_json& args)
+{
+    for (FunctionObserver* observer : m_function_observers)
+    {
+        observer->OnFunction(function_name, block_index, args);
+    }
 
     if (function_name == "vkQueueSubmit" || function_name == "vkQueueSubmit2")
     {
@@ -50,7 +63,7 @@ void DiveAnnotationProcessor::WriteBlockEnd(const gfxrecon::util::DiveFunctionDa
     }
     else
     {
-        VulkanCommandInfo vkCmd(function_data);
+        VulkanCommandInfo vkCmd(function_name, cmd_buffer_index, args, *m_arg_arena);
         if (args.count("commandBuffer") != 0)
         {
             uint64_t cmd_handle = args["commandBuffer"];
@@ -65,9 +78,9 @@ void DiveAnnotationProcessor::WriteBlockEnd(const gfxrecon::util::DiveFunctionDa
                 m_draw_call_counts_map[cmd_handle].render_pass_draw_call_counts.push_back(0);
             }
 
-            m_cmd_vk_commands_cache[cmd_handle].push_back(vkCmd);
+            m_cmd_vk_commands_cache[cmd_handle].push_back(std::move(vkCmd));
 
-            if (vkCmd.name.find("vkCmdDraw") != std::string::npos)
+            if (function_name.find("vkCmdDraw") != std::string::npos)
             {
                 m_draw_call_counts_map[cmd_handle].begin_command_buffer_draw_call_count++;
                 if (!m_draw_call_counts_map[cmd_handle].render_pass_draw_call_counts.empty())
@@ -78,7 +91,7 @@ void DiveAnnotationProcessor::WriteBlockEnd(const gfxrecon::util::DiveFunctionDa
         }
         else
         {
-            m_none_cmd_vk_commands_per_submit_cache.push_back(vkCmd);
+            m_none_cmd_vk_commands_per_submit_cache.push_back(std::move(vkCmd));
         }
     }
 }
@@ -14,9 +14,11 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include "decode/annotation_handler.h"
+#include "dive_arg_arena.h"
 #include "util/defines.h"
 #include "util/platform.h"
 
@@ -26,22 +28,32 @@ struct ApiCallInfo;
 // made when processing the vulkan commands. WriteBlockEnd is called passing the function data
 // (name, command buffer index, args) and then DiveAnnotationProcessor converts the data to
 // SubmitInfo for vkQueueSubmits or VulkanCommandInfo for vulkan commands. These structs are then
-// used to construct the command hierarchy displayed in the Dive UI.
+// used to construct the command hierarchy displayed in the Dive UI. The arguments of the vulkan
+// commands are encoded in a DiveArgArena shared by all the commands of the capture.
 class DiveAnnotationProcessor : public gfxrecon::decode::AnnotationHandler
 {
 public:
     struct VulkanCommandInfo
     {
-        explicit VulkanCommandInfo(const gfxrecon::util::DiveFunctionData& data) :
-            args(data.GetArgs()),
-            name(data.GetFunctionName()),
-            index(data.GetCmdBufferIndex())
+        VulkanCommandInfo(const std::string&            function_name,
+                          uint32_t                      cmd_buffer_index,
+                          const nlohmann::ordered_json& function_args,
+                          DiveArgArena&                 arena) :
+            name(function_name),
+            index(cmd_buffer_index),
+            arg_arena(&arena),
+            args_offset(arena.Add(function_args))
         {
         }
 
-        nlohmann::ordered_json args = {};
-        std::string            name = "";
-        uint32_t               index = 0;
+        // Decode the arguments of the command. This allocates a json tree, so only do it for the
+        // commands that are actually inspected.
+        nlohmann::ordered_json GetArgs() const { return arg_arena->Get(args_offset); }
+
+        std::string          name = "";
+        uint32_t             index = 0;
+        const DiveArgArena*  arg_arena = nullptr;
+        DiveArgArena::Offset args_offset = 0;
     };
 
     struct SubmitInfo
@@ -67,12 +79,41 @@ public:
         std::vector<uint64_t> render_pass_draw_call_counts = {};
     };
 
-    DiveAnnotationProcessor() {}
+    // Observes the vulkan commands in capture order, as they are processed. This lets tools which
+    // scan the commands of a capture do it during the load of the capture, instead of decoding the
+    // capture again.
+    class FunctionObserver
+    {
+    public:
+        virtual ~FunctionObserver() = default;
+        virtual void OnFunction(const std::string&            function_name,
+                                uint64_t                      block_index,
+                                const nlohmann::ordered_json& args) = 0;
+    };
+
+    DiveAnnotationProcessor() :
+        m_arg_arena(std::make_shared<DiveArgArena>())
+    {
+    }
     ~DiveAnnotationProcessor() {}
 
     // Finalize the current block and stream it out.
     void WriteBlockEnd(const gfxrecon::util::DiveFunctionData& function_data) override;
 
+    // Process a vulkan command. Commands must be processed in capture order. This is what
+    // WriteBlockEnd does, and is also called directly by decoders which convert the commands to
+    // json out of order and then merge them back in order.
+    void ProcessFunction(const std::string&            function_name,
+                         uint32_t                      cmd_buffer_index,
+                         uint64_t                      block_index,
+                         const nlohmann::ordered_json& args);
+
+    // The observer must outlive the processing of the commands
+    void AddFunctionObserver(FunctionObserver* observer)
+    {
+        m_function_observers.push_back(observer);
+    }
+
     // @brief Convert annotations, which are simple {type:enum, key:string, value:string} objects.
     virtual void ProcessAnnotation(uint64_t                         block_index,
                                    gfxrecon::format::AnnotationType type,
@@ -90,6 +131,9 @@ public:
     {
         return std::move(m_draw_call_counts_map);
     }
+    // The arguments of the commands returned by TakeSubmits() and TakeVkCommandsCache() are
+    // stored in this arena, which must outlive them
+    std::shared_ptr<const DiveArgArena> GetArgArena() const { return m_arg_arena; }
 
 private:
     // This is a per submit cache that keeps all vk commands that are not in any command buffer
@@ -98,4 +142,6 @@ private:
     std::unordered_map<uint64_t, std::vector<VulkanCommandInfo>> m_cmd_vk_commands_cache = {};
     std::unordered_map<uint64_t, DrawCallCounts>                 m_draw_call_counts_map = {};
     std::vector<std::unique_ptr<SubmitInfo>>                     m_submits = {};
+    std::shared_ptr<DiveArgArena>                                m_arg_arena = nullptr;
+    std::vector<FunctionObserver*>                               m_function_observers = {};
 };
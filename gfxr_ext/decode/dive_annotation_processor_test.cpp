@@ -31,7 +31,7 @@ MATCHER_P3(VulkanCommandInfoEqual, expected_name, expected_index, expected_args,
 {
     EXPECT_EQ(arg.name, expected_name);
     EXPECT_EQ(arg.index, expected_index);
-    EXPECT_EQ(arg.args, expected_args);
+    EXPECT_EQ(arg.GetArgs(), expected_args);
     return true;
 }
 
@@ -369,5 +369,40 @@ TEST(WriteBlockEndTest, DrawCallsAreCorrectlyCountedInMultipleRenderPasses)
                 testing::ElementsAre(2, 3));
 }
 
+class RecordingObserver : public DiveAnnotationProcessor::FunctionObserver
+{
+public:
+    void OnFunction(const std::string&            function_name,
+                    uint64_t                      block_index,
+                    const nlohmann::ordered_json& args) override
+    {
+        functions.push_back(function_name);
+        block_indices.push_back(block_index);
+    }
+
+    std::vector<std::string> functions;
+    std::vector<uint64_t>    block_indices;
+};
+
+TEST(WriteBlockEndTest, ObserversSeeAllFunctionsInOrder)
+{
+    DiveAnnotationProcessor processor;
+    RecordingObserver       observer;
+    processor.AddFunctionObserver(&observer);
+
+    uint64_t handle = 1001;
+    processor.WriteBlockEnd(CreateCommandData("vkBeginCommandBuffer", handle, 0, 4));
+    processor.WriteBlockEnd(CreateCommandData("vkCmdDraw", handle, 1, 5));
+    processor.WriteBlockEnd(CreateCommandData("vkEndCommandBuffer", handle, 0, 6));
+    processor.WriteBlockEnd(gfxrecon::util::DiveFunctionData("vkQueueSubmit", 0, 7, {}));
+
+    EXPECT_THAT(observer.functions,
+                testing::ElementsAre("vkBeginCommandBuffer",
+                                     "vkCmdDraw",
+                                     "vkEndCommandBuffer",
+                                     "vkQueueSubmit"));
+    EXPECT_THAT(observer.block_indices, testing::ElementsAre(4, 5, 6, 7));
+}
+
 }  // namespace
 }  // namespace gfxrecon::decode
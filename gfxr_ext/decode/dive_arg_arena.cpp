@@ -0,0 +1,197 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_arg_arena.h"
+
+#include <cstring>
+#include "util/logging.h"
+
+//--------------------------------------------------------------------------------------------------
+DiveArgArena::Offset DiveArgArena::Add(const nlohmann::ordered_json& value)
+{
+    Offset offset = m_data.size();
+    Encode(value);
+    return offset;
+}
+
+//--------------------------------------------------------------------------------------------------
+nlohmann::ordered_json DiveArgArena::Get(Offset offset) const
+{
+    GFXRECON_ASSERT(offset < m_data.size());
+    const uint8_t* ptr = m_data.data() + offset;
+    return Decode(ptr);
+}
+
+//--------------------------------------------------------------------------------------------------
+void DiveArgArena::Encode(const nlohmann::ordered_json& value)
+{
+    switch (value.type())
+    {
+    case nlohmann::ordered_json::value_t::boolean:
+        m_data.push_back(value.get<bool>() ? kTrue : kFalse);
+        break;
+    case nlohmann::ordered_json::value_t::number_integer:
+    {
+        int64_t  int_value = value.get<int64_t>();
+        uint64_t zigzag = (static_cast<uint64_t>(int_value) << 1) ^
+                          static_cast<uint64_t>(int_value >> 63);
+        m_data.push_back(kInt);
+        WriteVarint(zigzag);
+        break;
+    }
+    case nlohmann::ordered_json::value_t::number_unsigned:
+        m_data.push_back(kUint);
+        WriteVarint(value.get<uint64_t>());
+        break;
+    case nlohmann::ordered_json::value_t::number_float:
+    {
+        double float_value = value.get<double>();
+        m_data.push_back(kFloat);
+        size_t pos = m_data.size();
+        m_data.resize(pos + sizeof(float_value));
+        std::memcpy(m_data.data() + pos, &float_value, sizeof(float_value));
+        break;
+    }
+    case nlohmann::ordered_json::value_t::string:
+        m_data.push_back(kString);
+        WriteVarint(InternString(value.get_ref<const std::string&>()));
+        break;
+    case nlohmann::ordered_json::value_t::object:
+    case nlohmann::ordered_json::value_t::array:
+    {
+        bool is_object = value.is_object();
+        m_data.push_back(is_object ? kObject : kArray);
+
+        // The payload size is patched once the members are encoded
+        size_t size_pos = m_data.size();
+        m_data.resize(size_pos + sizeof(uint32_t));
+        WriteVarint(value.size());
+        if (is_object)
+        {
+            for (const auto& [key, member] : value.items())
+            {
+                WriteVarint(InternString(key));
+                Encode(member);
+            }
+        }
+        else
+        {
+            for (const auto& element : value)
+            {
+                Encode(element);
+            }
+        }
+        uint32_t payload_size = static_cast<uint32_t>(m_data.size() - size_pos - sizeof(uint32_t));
+        std::memcpy(m_data.data() + size_pos, &payload_size, sizeof(payload_size));
+        break;
+    }
+    default:
+        // null, and the binary/discarded values that the dive consumer never produces
+        m_data.push_back(kNull);
+        break;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+void DiveArgArena::WriteVarint(uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        m_data.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    m_data.push_back(static_cast<uint8_t>(value));
+}
+
+//--------------------------------------------------------------------------------------------------
+uint32_t DiveArgArena::InternString(const std::string& str)
+{
+    auto [it, inserted] = m_string_ids.try_emplace(str, static_cast<uint32_t>(m_strings.size()));
+    if (inserted)
+    {
+        m_strings.push_back(&it->first);
+    }
+    return it->second;
+}
+
+//--------------------------------------------------------------------------------------------------
+nlohmann::ordered_json DiveArgArena::Decode(const uint8_t*& ptr) const
+{
+    Tag tag = static_cast<Tag>(*ptr++);
+    switch (tag)
+    {
+    case kFalse:
+        return false;
+    case kTrue:
+        return true;
+    case kInt:
+    {
+        uint64_t zigzag = ReadVarint(ptr);
+        return static_cast<int64_t>((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+    }
+    case kUint:
+        return ReadVarint(ptr);
+    case kFloat:
+    {
+        double float_value;
+        std::memcpy(&float_value, ptr, sizeof(float_value));
+        ptr += sizeof(float_value);
+        return float_value;
+    }
+    case kString:
+        return *m_strings[ReadVarint(ptr)];
+    case kObject:
+    {
+        ptr += sizeof(uint32_t);
+        uint64_t               count = ReadVarint(ptr);
+        nlohmann::ordered_json object = nlohmann::ordered_json::object();
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            const std::string& key = *m_strings[ReadVarint(ptr)];
+            object[key] = Decode(ptr);
+        }
+        return object;
+    }
+    case kArray:
+    {
+        ptr += sizeof(uint32_t);
+        uint64_t               count = ReadVarint(ptr);
+        nlohmann::ordered_json array = nlohmann::ordered_json::array();
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            array.push_back(Decode(ptr));
+        }
+        return array;
+    }
+    case kNull:
+    default:
+        return nullptr;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+uint64_t DiveArgArena::ReadVarint(const uint8_t*& ptr) const
+{
+    uint64_t value = 0;
+    uint32_t shift = 0;
+    while (*ptr & 0x80)
+    {
+        value |= static_cast<uint64_t>(*ptr++ & 0x7f) << shift;
+        shift += 7;
+    }
+    value |= static_cast<uint64_t>(*ptr++) << shift;
+    return value;
+}
@@ -0,0 +1,80 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "util/dive_function_data.h"
+
+// Compact storage for the arguments of the vulkan commands of a capture. Keeping a json tree per
+// command costs several allocations per field, which does not scale to captures with millions of
+// commands. Instead, the arguments of all commands are appended to a single byte buffer, and are
+// only converted back to json when needed (e.g. when displaying a specific command).
+//
+// Encoding of a value, starting with a one byte Tag:
+//  - kNull, kFalse, kTrue: no payload
+//  - kInt: zigzag encoded varint, kUint: varint, kFloat: 8 bytes
+//  - kString: varint id in the string table. Keys and string values (mostly enum names) are
+//    interned, so each distinct string is stored once per arena.
+//  - kObject, kArray: 4 byte size of the payload that follows, so the whole value can be skipped,
+//    then a varint count, then the members (varint key id followed by the value) or the elements
+class DiveArgArena
+{
+public:
+    using Offset = uint64_t;
+
+    DiveArgArena() = default;
+    DiveArgArena(const DiveArgArena&) = delete;
+    DiveArgArena& operator=(const DiveArgArena&) = delete;
+
+    // Append a value and return its offset
+    Offset Add(const nlohmann::ordered_json& value);
+
+    // Decode the value added at `offset`
+    nlohmann::ordered_json Get(Offset offset) const;
+
+    size_t GetDataSize() const { return m_data.size(); }
+    size_t GetStringCount() const { return m_strings.size(); }
+
+private:
+    enum Tag : uint8_t
+    {
+        kNull,
+        kFalse,
+        kTrue,
+        kInt,
+        kUint,
+        kFloat,
+        kString,
+        kObject,
+        kArray,
+    };
+
+    void     Encode(const nlohmann::ordered_json& value);
+    void     WriteVarint(uint64_t value);
+    uint32_t InternString(const std::string& str);
+
+    nlohmann::ordered_json Decode(const uint8_t*& ptr) const;
+    uint64_t               ReadVarint(const uint8_t*& ptr) const;
+
+    std::vector<uint8_t>                      m_data = {};
+    std::unordered_map<std::string, uint32_t> m_string_ids = {};
+    // Points to the keys of m_string_ids, which are stable
+    std::vector<const std::string*> m_strings = {};
+};
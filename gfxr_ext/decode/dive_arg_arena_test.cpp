@@ -0,0 +1,86 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "dive_arg_arena.h"
+
+#include <gtest/gtest.h>
+
+namespace gfxrecon::decode
+{
+namespace
+{
+
+TEST(DiveArgArenaTest, ScalarsRoundTrip)
+{
+    DiveArgArena arena;
+    const nlohmann::ordered_json values[] = { nullptr,
+                                              true,
+                                              false,
+                                              0,
+                                              -1,
+                                              INT64_MIN,
+                                              INT64_MAX,
+                                              UINT64_MAX,
+                                              0.5,
+                                              "VK_FORMAT_R8G8B8A8_UNORM" };
+    std::vector<DiveArgArena::Offset> offsets;
+    for (const auto& value : values)
+    {
+        offsets.push_back(arena.Add(value));
+    }
+    for (size_t i = 0; i < offsets.size(); ++i)
+    {
+        nlohmann::ordered_json decoded = arena.Get(offsets[i]);
+        EXPECT_EQ(decoded, values[i]);
+        EXPECT_EQ(decoded.type(), values[i].type());
+    }
+}
+
+TEST(DiveArgArenaTest, NestedValuesKeepTheirOrder)
+{
+    DiveArgArena           arena;
+    nlohmann::ordered_json args = {
+        { "commandBuffer", 1001 },
+        { "pLabelInfo", { { "sType", "VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT" },
+                          { "pLabelName", "Shadow pass" },
+                          { "color", { 1.0, 0.5, 0.25, 1.0 } } } },
+        { "pOffsets", { { 0, 1 }, nlohmann::ordered_json::array(), { 2 } } },
+        { "pNext", nullptr },
+        { "empty", nlohmann::ordered_json::object() },
+    };
+    DiveArgArena::Offset offset = arena.Add(args);
+    EXPECT_EQ(arena.Get(offset), args);
+    EXPECT_EQ(arena.Get(offset).dump(), args.dump());
+}
+
+TEST(DiveArgArenaTest, StringsAreInterned)
+{
+    DiveArgArena           arena;
+    nlohmann::ordered_json args = { { "commandBuffer", 1001 },
+                                    { "layout", "VK_IMAGE_LAYOUT_GENERAL" } };
+    DiveArgArena::Offset   first = arena.Add(args);
+    size_t                 string_count = arena.GetStringCount();
+    size_t                 first_size = arena.GetDataSize();
+    DiveArgArena::Offset   second = arena.Add(args);
+
+    EXPECT_EQ(string_count, 3u);
+    EXPECT_EQ(arena.GetStringCount(), string_count);
+    EXPECT_EQ(arena.GetDataSize(), 2 * first_size);
+    EXPECT_EQ(arena.Get(first), arena.Get(second));
+}
+
+}  // namespace
+}  // namespace gfxrecon::decode
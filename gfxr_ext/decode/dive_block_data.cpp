@@ -14,9 +14,15 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <algorithm>
 #include <fstream>
 #include <memory>
 
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#include <unistd.h>
+#endif
+
 #include "dive_block_data.h"
 
 #include "util/logging.h"
@@ -56,24 +62,17 @@ bool WriterBlockVisitor::Visit(const DiveOriginalBlock& block)
         // Found empty block in original file, presumably a block in the asset file, no need to copy
         return true;
     }
-    if (!util::platform::FileSeek(original_file_ptr_, block.offset_, util::platform::FileSeekSet))
+    if (pending_size_ > 0 && pending_offset_ + pending_size_ == block.offset_)
     {
-        GFXRECON_LOG_ERROR("Could not seek block at offset %d in original file", block.offset_);
-        return false;
+        pending_size_ += block.size_;
+        return true;
     }
-    uint64_t bytes_left_to_copy = block.size_;
-    while (bytes_left_to_copy > 0)
+    if (!Flush())
     {
-        uint64_t bytes_to_copy = bytes_left_to_copy;
-        if (bytes_left_to_copy > kDiveBlockBufferSize)
-        {
-            bytes_to_copy = kDiveBlockBufferSize;
-        }
-        bytes_left_to_copy -= bytes_to_copy;
-
-        util::platform::FileRead(copy_buffer_, bytes_to_copy, original_file_ptr_);
-        util::platform::FileWrite(copy_buffer_, bytes_to_copy, new_file_ptr_);
+        return false;
     }
+    pending_offset_ = block.offset_;
+    pending_size_ = block.size_;
     return true;
 }
 
@@ -84,7 +83,11 @@ bool WriterBlockVisitor::Visit(const DiveModificationBlock& block)
         GFXRECON_LOG_ERROR("WriterBlockVisitor encountered empty modification block");
         return false;
     }
-    if (!util::platform::FileWrite(block.blob_ptr_.get(), block.blob_ptr_->size(), new_file_ptr_))
+    if (!Flush())
+    {
+        return false;
+    }
+    if (!util::platform::FileWrite(block.blob_ptr_->data(), block.blob_ptr_->size(), new_file_ptr_))
     {
         GFXRECON_LOG_ERROR("Writing modified block, could not write to new file");
         return false;
@@ -92,6 +95,104 @@ bool WriterBlockVisitor::Visit(const DiveModificationBlock& block)
     return true;
 }
 
+bool WriterBlockVisitor::Flush()
+{
+    if (pending_size_ == 0)
+    {
+        return true;
+    }
+    uint64_t offset = pending_offset_;
+    uint64_t size = pending_size_;
+    pending_size_ = 0;
+    return CopyOriginalRange(offset, size);
+}
+
+bool WriterBlockVisitor::CopyOriginalRange(uint64_t offset, uint64_t size)
+{
+#if defined(__linux__)
+    // The data is written to the file descriptor directly, so the data buffered by the stream must
+    // be written first
+    if (util::platform::FileFlush(new_file_ptr_) != 0)
+    {
+        GFXRECON_LOG_ERROR("Could not flush new file");
+        return false;
+    }
+
+    int      original_fd = fileno(original_file_ptr_);
+    int      new_fd = fileno(new_file_ptr_);
+    uint64_t bytes_left_to_copy = size;
+#if !defined(__ANDROID__)
+    // Copies in the kernel, and lets file systems which support it share the extents (reflink)
+    loff_t copy_offset = static_cast<loff_t>(offset);
+    while (bytes_left_to_copy > 0)
+    {
+        ssize_t copied =
+        copy_file_range(original_fd, &copy_offset, new_fd, nullptr, bytes_left_to_copy, 0);
+        if (copied <= 0)
+        {
+            break;
+        }
+        bytes_left_to_copy -= copied;
+    }
+    offset = static_cast<uint64_t>(copy_offset);
+#endif
+    // Not supported by older kernels, nor across file systems before 5.3
+    off_t send_offset = static_cast<off_t>(offset);
+    while (bytes_left_to_copy > 0)
+    {
+        ssize_t copied = sendfile(new_fd, original_fd, &send_offset, bytes_left_to_copy);
+        if (copied <= 0)
+        {
+            break;
+        }
+        bytes_left_to_copy -= copied;
+    }
+    offset = static_cast<uint64_t>(send_offset);
+
+    if (bytes_left_to_copy == 0)
+    {
+        return true;
+    }
+    size = bytes_left_to_copy;
+#endif
+    return CopyOriginalRangeBuffered(offset, size);
+}
+
+bool WriterBlockVisitor::CopyOriginalRangeBuffered(uint64_t offset, uint64_t size)
+{
+    if (!util::platform::FileSeek(original_file_ptr_, offset, util::platform::FileSeekSet))
+    {
+        GFXRECON_LOG_ERROR("Could not seek block at offset %d in original file", offset);
+        return false;
+    }
+    if (copy_buffer_.empty())
+    {
+        copy_buffer_.resize(kDiveBlockBufferSize);
+    }
+    uint64_t bytes_left_to_copy = size;
+    while (bytes_left_to_copy > 0)
+    {
+        uint64_t bytes_to_copy = bytes_left_to_copy;
+        if (bytes_left_to_copy > kDiveBlockBufferSize)
+        {
+            bytes_to_copy = kDiveBlockBufferSize;
+        }
+        bytes_left_to_copy -= bytes_to_copy;
+
+        if (!util::platform::FileRead(copy_buffer_.data(), bytes_to_copy, original_file_ptr_))
+        {
+            GFXRECON_LOG_ERROR("Could not read block at offset %d in original file", offset);
+            return false;
+        }
+        if (!util::platform::FileWrite(copy_buffer_.data(), bytes_to_copy, new_file_ptr_))
+        {
+            GFXRECON_LOG_ERROR("Writing original block, could not write to new file");
+            return false;
+        }
+    }
+    return true;
+}
+
 bool DiveBlockData::AddOriginalBlock(size_t index, uint64_t offset)
 {
     if (original_blocks_map_locked_)
@@ -100,15 +201,15 @@ bool DiveBlockData::AddOriginalBlock(size_t index, uint64_t offset)
         return false;
     }
 
-    if (index != original_blocks_map_.size())
+    if (index != original_block_offsets_.size())
     {
         GFXRECON_LOG_ERROR("Unexpected block id mismatch with index: %d, expected index: %d",
                            index,
-                           original_blocks_map_.size());
+                           original_block_offsets_.size());
         return false;
     }
 
-    original_blocks_map_.emplace_back(std::make_shared<DiveOriginalBlock>(offset));
+    original_block_offsets_.push_back(offset);
 
     return true;
 }
@@ -120,7 +221,7 @@ bool DiveBlockData::FinalizeOriginalBlocksMapSizes()
         return true;
     }
 
-    if (original_blocks_map_.empty())
+    if (original_block_offsets_.empty())
     {
         GFXRECON_LOG_ERROR("Original block map is empty");
         return false;
@@ -128,13 +229,13 @@ bool DiveBlockData::FinalizeOriginalBlocksMapSizes()
 
     // Calculating block size for header (before block id 0)
     original_header_block_.offset_ = 0;
-    original_header_block_.size_ = original_blocks_map_[0]->offset_;
+    original_header_block_.size_ = original_block_offsets_[0];
 
-    // Calculating block sizes
-    for (size_t i = 0; i < original_blocks_map_.size() - 1; i++)
+    // Checking block sizes
+    for (size_t i = 0; i < original_block_offsets_.size() - 1; i++)
     {
-        uint64_t current_block_start = original_blocks_map_[i]->offset_;
-        uint64_t current_block_end = original_blocks_map_[i + 1]->offset_;
+        uint64_t current_block_start = original_block_offsets_[i];
+        uint64_t current_block_end = original_block_offsets_[i + 1];
         if (current_block_start > current_block_end)
         {
             GFXRECON_LOG_ERROR("Original block with id (%d) has invalid offsets (%d-%d)",
@@ -143,40 +244,42 @@ bool DiveBlockData::FinalizeOriginalBlocksMapSizes()
                                current_block_end);
             return false;
         }
-        uint64_t size = current_block_end - current_block_start;
-        if (size > kDiveBlockBufferSize)
-        {
-            GFXRECON_LOG_WARNING("Original block with id (%d) is larger than kDiveBlockBufferSize: "
-                                 "%d > %d, will cause "
-                                 "more copy operations when writing new file",
-                                 i,
-                                 size,
-                                 kDiveBlockBufferSize);
-        }
-
-        original_blocks_map_[i]->size_ = size;
     }
 
-    // The file processor calls AddOriginalBlock() even at the very end of the GFXR file, so this
-    // last block has a size of 0 and its offset is equal to the file size. The info was used in the
-    // calculation of the size of the penultimate block and now the last block needs to be trimmed.
-    original_blocks_map_.pop_back();
+    // The file processor calls AddOriginalBlock() even at the very end of the GFXR file, so the
+    // last offset is equal to the file size. It is not a block, only the end of the last one.
+    original_block_offsets_.shrink_to_fit();
 
     original_blocks_map_locked_ = true;
     return true;
 }
 
-bool DiveBlockData::ModificationExists(uint32_t primary_id, int32_t secondary_id) const
+size_t DiveBlockData::GetOriginalBlockCount() const
 {
-    if (modifications_map_.count(primary_id) != 1)
-    {
-        return false;
-    }
-    if (modifications_map_.at(primary_id).count(secondary_id) != 1)
+    if (!original_blocks_map_locked_)
     {
-        return false;
+        return 0;
     }
-    return true;
+    return original_block_offsets_.size() - 1;
+}
+
+size_t DiveBlockData::FindModification(uint32_t primary_id, int32_t secondary_id) const
+{
+    auto it = std::lower_bound(modifications_.begin(),
+                               modifications_.end(),
+                               std::make_pair(primary_id, secondary_id),
+                               [](const Modification& modification, const auto& ids) {
+                                   return std::make_pair(modification.primary_id,
+                                                         modification.secondary_id) < ids;
+                               });
+    return it - modifications_.begin();
+}
+
+bool DiveBlockData::ModificationExists(uint32_t primary_id, int32_t secondary_id) const
+{
+    size_t index = FindModification(primary_id, secondary_id);
+    return index < modifications_.size() && modifications_[index].primary_id == primary_id &&
+           modifications_[index].secondary_id == secondary_id;
 }
 
 bool DiveBlockData::AddModification(uint32_t                           primary_id,
@@ -198,32 +301,27 @@ bool DiveBlockData::AddModification(uint32_t                           primary_i
         return false;
     }
 
-    if (primary_id >= original_blocks_map_.size())
+    if (primary_id >= GetOriginalBlockCount())
     {
         GFXRECON_LOG_ERROR("Primary index (%d) is out of bounds, largest original block id: %d",
                            primary_id,
-                           original_blocks_map_.size() - 1);
+                           GetOriginalBlockCount() - 1);
         return false;
     }
 
-    if (blob_ptr == nullptr)
+    // The only time an empty blob is used is to indicate a deletion modficiation of the original
+    // block
+    if (blob_ptr == nullptr && secondary_id != 0)
     {
-        if (secondary_id != 0)
-        {
-            GFXRECON_LOG_ERROR("Invalid blob provided for modification at: (%d, %d)",
-                               primary_id,
-                               secondary_id);
-            return false;
-        }
-        // The only time an empty blob is used is to indicate a deletion modficiation of the
-        // original block
-        modifications_map_[primary_id][secondary_id] = nullptr;
-        return true;
+        GFXRECON_LOG_ERROR("Invalid blob provided for modification at: (%d, %d)",
+                           primary_id,
+                           secondary_id);
+        return false;
     }
 
-    auto new_block_ptr = std::make_shared<DiveModificationBlock>(blob_ptr);
-
-    modifications_map_[primary_id][secondary_id] = std::move(new_block_ptr);
+    size_t index = FindModification(primary_id, secondary_id);
+    modifications_.insert(modifications_.begin() + index,
+                          { primary_id, secondary_id, DiveModificationBlock(std::move(blob_ptr)) });
 
     return true;
 }
@@ -238,42 +336,52 @@ bool DiveBlockData::RemoveModification(uint32_t primary_id, int32_t secondary_id
         return false;
     }
 
-    modifications_map_[primary_id].erase(secondary_id);
+    modifications_.erase(modifications_.begin() + FindModification(primary_id, secondary_id));
     return true;
 }
 
 bool DiveBlockData::TraverseBlocks(BlockVisitor& visitor) const
 {
-    // Go through block-by-block in order of primary_id
-    for (uint32_t primary_id = 0; primary_id < original_blocks_map_.size(); primary_id++)
-    {
-        std::map<int32_t, std::shared_ptr<IDiveBlock>> blocks_to_write = {};
-        if (modifications_map_.count(primary_id) > 0)
-        {
-            // Copy all the modifications relating to the original block with primary_id
-            blocks_to_write = modifications_map_.at(primary_id);
-        }
-
-        // If there is no modification of the original block, insert a pointer to the original block
-        // into the map of blocks ordered by secondary_id
-        if (blocks_to_write.count(0) == 0)
+    auto visit_original_block = [&](uint32_t primary_id) {
+        DiveOriginalBlock block(original_block_offsets_[primary_id]);
+        block.size_ = original_block_offsets_[primary_id + 1] - block.offset_;
+        if (!visitor.Visit(block))
         {
-            blocks_to_write[0] = original_blocks_map_.at(primary_id);
+            GFXRECON_LOG_ERROR("Couldn't write block with ids (%d, %d)", primary_id, 0);
+            return false;
         }
+        return true;
+    };
 
-        // For a given primary_id, go through block-by-block in order of secondary_id
-        for (auto it = blocks_to_write.begin(); it != blocks_to_write.end(); ++it)
+    // Go through block-by-block in order of primary_id, merging in the modifications which are in
+    // the same order
+    size_t block_count = GetOriginalBlockCount();
+    auto   modification_it = modifications_.begin();
+    for (uint32_t primary_id = 0; primary_id < block_count; primary_id++)
+    {
+        // For a given primary_id, go through the modifications in order of secondary_id, with the
+        // original block at a secondary_id of 0 unless it is modified
+        bool original_written = false;
+        for (; modification_it != modifications_.end() && modification_it->primary_id == primary_id;
+             ++modification_it)
         {
-            int32_t                     secondary_id = it->first;
-            std::shared_ptr<IDiveBlock> current_modification_ptr = it->second;
+            int32_t secondary_id = modification_it->secondary_id;
+            if (!original_written && secondary_id >= 0)
+            {
+                original_written = true;
+                if (secondary_id > 0 && !visit_original_block(primary_id))
+                {
+                    return false;
+                }
+            }
 
-            if (current_modification_ptr == nullptr)
+            if (modification_it->block.blob_ptr_ == nullptr)
             {
                 GFXRECON_LOG_INFO("Original block (%d) was marked for deletion", primary_id);
                 continue;
             }
 
-            if (!current_modification_ptr->Accept(visitor))
+            if (!visitor.Visit(modification_it->block))
             {
                 GFXRECON_LOG_ERROR("Couldn't write block with ids (%d, %d)",
                                    primary_id,
@@ -281,6 +389,11 @@ bool DiveBlockData::TraverseBlocks(BlockVisitor& visitor) const
                 return false;
             }
         }
+
+        if (!original_written && !visit_original_block(primary_id))
+        {
+            return false;
+        }
     }
     return true;
 }
@@ -319,7 +432,7 @@ bool DiveBlockData::WriteGFXRFile(const std::string& original_file_path,
         return false;
     }
 
-    if (!TraverseBlocks(writer))
+    if (!TraverseBlocks(writer) || !writer.Flush())
     {
         GFXRECON_LOG_ERROR("Could not copy blocks in order");
         return false;
@@ -23,12 +23,13 @@ limitations under the License.
 
 #include "util/defines.h"
 
-#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
-static constexpr size_t kDiveBlockBufferSize = 4096;
+// Size of the buffer used to copy original data when the platform cannot copy between files
+// directly
+static constexpr size_t kDiveBlockBufferSize = 1024 * 1024;
 
 GFXRECON_BEGIN_NAMESPACE(gfxrecon)
 GFXRECON_BEGIN_NAMESPACE(decode)
@@ -57,6 +58,9 @@ private:
 };
 
 // A visitor that writes out a IDiveBlock into a provided file new_file_ptr_
+// Original blocks which follow each other in the original file are coalesced into a single range,
+// which is copied without going through user space where the platform allows it (copy_file_range
+// or sendfile on Linux). Flush() must be called after the last block.
 class WriterBlockVisitor : public BlockVisitor
 {
 public:
@@ -69,10 +73,18 @@ public:
     bool Visit(const DiveOriginalBlock& block) override;
     bool Visit(const DiveModificationBlock& block) override;
 
+    // Write out the pending range of original blocks
+    bool Flush();
+
 private:
-    FILE* original_file_ptr_ = nullptr;
-    FILE* new_file_ptr_ = nullptr;
-    char  copy_buffer_[kDiveBlockBufferSize] = {};
+    bool CopyOriginalRange(uint64_t offset, uint64_t size);
+    bool CopyOriginalRangeBuffered(uint64_t offset, uint64_t size);
+
+    FILE*             original_file_ptr_ = nullptr;
+    FILE*             new_file_ptr_ = nullptr;
+    uint64_t          pending_offset_ = 0;
+    uint64_t          pending_size_ = 0;
+    std::vector<char> copy_buffer_ = {};
 };
 
 // Abstract class representing a single binary block encoded in .gfxr format
@@ -123,7 +135,8 @@ public:
     // Add info for the next block in the original GFXR file
     bool AddOriginalBlock(size_t index, uint64_t offset);
 
-    // Calculate block sizes, drop the file-end block and lock the map
+    // Check the block offsets, keep the file-end offset as the end of the last block and lock the
+    // map
     bool FinalizeOriginalBlocksMapSizes();
     bool IsOriginalBlocksMapLocked() const { return original_blocks_map_locked_; }
 
@@ -133,7 +146,7 @@ public:
                          int32_t                            secondary_id,
                          std::shared_ptr<std::vector<char>> blob_ptr);
     bool RemoveModification(uint32_t primary_id, int32_t secondary_id);
-    void ClearAllModifications() { modifications_map_.clear(); }
+    void ClearAllModifications() { modifications_.clear(); }
 
     // Write modified GFXR file at the specified path
     bool TraverseBlocks(BlockVisitor& visitor) const;
@@ -141,25 +154,40 @@ public:
                        const std::string& new_file_path) const;
 
 private:
+    struct Modification
+    {
+        uint32_t primary_id = 0;
+        int32_t  secondary_id = 0;
+        // A blob_ptr_ of nullptr marks the deletion of the original block
+        DiveModificationBlock block = {};
+    };
+
+    size_t GetOriginalBlockCount() const;
+
+    // Index of the first modification which is not ordered before (primary_id, secondary_id)
+    size_t FindModification(uint32_t primary_id, int32_t secondary_id) const;
+
     // Info for the blocks in the original GFXR file
-    std::vector<std::shared_ptr<DiveOriginalBlock>>
-                      original_blocks_map_ = {};  // Starting block index of 0
-    DiveOriginalBlock original_header_block_ = {};
-    bool              original_blocks_map_locked_ = false;
+    //
+    // Offsets of the blocks, starting with block index 0. Once the map is locked, the last offset
+    // is the end of the last block, and the size of each block is the distance to the next offset.
+    std::vector<uint64_t> original_block_offsets_ = {};
+    DiveOriginalBlock     original_header_block_ = {};
+    bool                  original_blocks_map_locked_ = false;
 
     // Info for modifications
     //
-    // The first key (uint32_t) is the primary_id which is the original_id. Valid values:
-    // [0...original_blocks_map_.size()-1]
+    // The primary_id is the original_id. Valid values: [0...GetOriginalBlockCount()-1]
     //
-    // The second key (int32_t) is the secondary_id which represents the position of
-    // this modified block relative to the primary_id block, with negative values coming before the
-    // original block and positive values after. A secondary_id of 0 represents a modification
-    // overwriting the original block, and only these modifications are allowed to have a value of
-    // nullptr.
+    // The secondary_id represents the position of this modified block relative to the primary_id
+    // block, with negative values coming before the original block and positive values after. A
+    // secondary_id of 0 represents a modification overwriting the original block, and only these
+    // modifications are allowed to have a blob of nullptr.
     //
-    // Each modification has an unique pair of primary_id and secondary_id.
-    std::map<uint32_t, std::map<int32_t, std::shared_ptr<IDiveBlock>>> modifications_map_ = {};
+    // Each modification has an unique pair of primary_id and secondary_id, and the modifications
+    // are sorted by primary_id and then secondary_id, which is the order they are written in.
+    // Adding modifications in that order appends them.
+    std::vector<Modification> modifications_ = {};
 };
 
 GFXRECON_END_NAMESPACE(decode)
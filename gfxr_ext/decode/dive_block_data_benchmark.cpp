@@ -0,0 +1,113 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+// Measures building and traversing the block map of a large capture.
+//
+// Usage: dive_block_data_benchmark [block_count] [modification_interval]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "dive_block_data.h"
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+double ElapsedMs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Accumulates the sizes, so that the traversal is not optimized away
+class CountingBlockVisitor : public gfxrecon::decode::BlockVisitor
+{
+public:
+    bool Visit(const gfxrecon::decode::DiveOriginalBlock& block) override
+    {
+        block_count_++;
+        byte_count_ += block.size_;
+        return true;
+    }
+    bool Visit(const gfxrecon::decode::DiveModificationBlock& block) override
+    {
+        block_count_++;
+        byte_count_ += block.blob_ptr_->size();
+        return true;
+    }
+
+    uint64_t block_count_ = 0;
+    uint64_t byte_count_ = 0;
+};
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    uint32_t block_count = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 20'000'000;
+    uint32_t modification_interval = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 1000;
+    if (block_count == 0 || modification_interval == 0)
+    {
+        std::fprintf(stderr, "Usage: %s [block_count] [modification_interval]\n", argv[0]);
+        return 1;
+    }
+
+    gfxrecon::decode::DiveBlockData block_data;
+
+    // Mimic the file processor: a 64 byte header, blocks of varying sizes, and the file-end block
+    Clock::time_point start = Clock::now();
+    uint64_t          offset = 64;
+    for (uint32_t i = 0; i <= block_count; i++)
+    {
+        block_data.AddOriginalBlock(i, offset);
+        offset += 32 + (i % 7) * 16;
+    }
+    if (!block_data.FinalizeOriginalBlocksMapSizes())
+    {
+        return 1;
+    }
+    std::printf("Add %u original blocks: %.1f ms\n", block_count, ElapsedMs(start));
+
+    // Insert around and replace every modification_interval-th block, in capture order like the
+    // tools which edit a capture
+    auto     blob = std::make_shared<std::vector<char>>(128, 'x');
+    uint32_t modification_count = 0;
+    start = Clock::now();
+    for (uint32_t i = 0; i < block_count; i += modification_interval)
+    {
+        block_data.AddModification(i, -1, blob);
+        block_data.AddModification(i, 0, blob);
+        block_data.AddModification(i, 1, blob);
+        modification_count += 3;
+    }
+    std::printf("Add %u modifications: %.1f ms\n", modification_count, ElapsedMs(start));
+
+    CountingBlockVisitor visitor;
+    start = Clock::now();
+    if (!block_data.TraverseBlocks(visitor))
+    {
+        return 1;
+    }
+    std::printf("Traverse %llu blocks (%llu bytes): %.1f ms\n",
+                static_cast<unsigned long long>(visitor.block_count_),
+                static_cast<unsigned long long>(visitor.byte_count_),
+                ElapsedMs(start));
+    return 0;
+}
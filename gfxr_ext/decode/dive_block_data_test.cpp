@@ -18,6 +18,10 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
 namespace gfxrecon::decode
 {
 namespace
@@ -291,5 +295,32 @@ TEST_F(DiveBlockDataTestFixture, TraverseBlocks_OrderSecondary)
     EXPECT_EQ(GetExampleString(o[2]), traversed_strings[6]);
 }
 
+TEST_F(DiveBlockDataTestFixture, WriteGFXRFile_CopiesOriginalsAroundModifications)
+{
+    // Original file: 100 byte header followed by the blocks in o
+    std::string original_contents;
+    for (int i = 0; i < 250; i++)
+    {
+        original_contents.push_back(static_cast<char>('a' + i % 26));
+    }
+    std::string original_path = testing::TempDir() + "dive_block_data_original.gfxr";
+    std::string new_path = testing::TempDir() + "dive_block_data_new.gfxr";
+    std::ofstream(original_path, std::ios::binary) << original_contents;
+
+    LockExampleOriginals();
+    PopulateExampleModifications();
+    EXPECT_TRUE(d.AddModification(1, 1, m[3]));
+    EXPECT_TRUE(d.AddModification(2, 0, nullptr));
+    EXPECT_TRUE(d.WriteGFXRFile(original_path, new_path));
+
+    std::ifstream     new_file(new_path, std::ios::binary);
+    std::stringstream new_contents;
+    new_contents << new_file.rdbuf();
+    EXPECT_EQ(original_contents.substr(0, 200) + "123", new_contents.str());
+
+    std::remove(original_path.c_str());
+    std::remove(new_path.c_str());
+}
+
 }  // namespace
 }  // namespace gfxrecon::decode
\ No newline at end of file
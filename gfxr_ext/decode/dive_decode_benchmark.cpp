@@ -0,0 +1,99 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+// Measures the decoding of the frames of a trimmed capture, looped like a replay, with a consumer
+// which does nothing. Needs no GPU, so the decoding performance can be tracked on any machine.
+//
+// Usage: dive_decode_benchmark <capture.gfxr> [warmup_frames] [frames] [report.json|report.csv]
+//
+// Without a report path, the JSON report is printed.
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "dive_file_processor.h"
+#include "dive_replay_benchmark.h"
+#include "generated/generated_vulkan_consumer.h"
+#include "generated/generated_vulkan_decoder.h"
+#include "util/logging.h"
+
+int main(int argc, char** argv)
+{
+    if (argc < 2 || argc > 5)
+    {
+        std::fprintf(stderr,
+                     "Usage: %s <capture.gfxr> [warmup_frames] [frames] [report.json|report.csv]\n",
+                     argv[0]);
+        return 1;
+    }
+    std::string capture_path = argv[1];
+    uint64_t    warmup_frames = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 10;
+    uint64_t    frames = (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 100;
+    std::string report_path = (argc > 4) ? argv[4] : "";
+    if (frames == 0)
+    {
+        std::fprintf(stderr, "The benchmark needs at least 1 frame\n");
+        return 1;
+    }
+
+    gfxrecon::util::Log::Init(gfxrecon::util::Log::kWarningSeverity);
+
+    auto benchmark = std::make_shared<gfxrecon::decode::DiveReplayBenchmark>(warmup_frames, frames);
+    gfxrecon::decode::DiveFileProcessor file_processor;
+    if (!file_processor.Initialize(capture_path))
+    {
+        std::fprintf(stderr, "Could not open %s\n", capture_path.c_str());
+        gfxrecon::util::Log::Release();
+        return 1;
+    }
+    file_processor.SetBenchmark(benchmark);
+
+    // The base consumer ignores every call, only the decoding is measured
+    gfxrecon::decode::VulkanConsumer null_consumer;
+    gfxrecon::decode::VulkanDecoder  decoder;
+    decoder.AddConsumer(&null_consumer);
+    file_processor.AddDecoder(&decoder);
+
+    bool success = file_processor.ProcessAllFrames() &&
+                   file_processor.GetErrorState() == gfxrecon::decode::FileProcessor::kErrorNone;
+    gfxrecon::util::Log::Release();
+    if (!success || !benchmark->IsComplete())
+    {
+        std::fprintf(stderr,
+                     "Could not decode %llu frames of %s, is it a trimmed capture?\n",
+                     static_cast<unsigned long long>(warmup_frames + frames),
+                     capture_path.c_str());
+        return 1;
+    }
+
+    std::string report = report_path.ends_with(".csv") ? benchmark->GetCsvReport() :
+                                                         benchmark->GetJsonReport();
+    if (report_path.empty())
+    {
+        std::fputs(report.c_str(), stdout);
+        return 0;
+    }
+    std::ofstream report_file(report_path, std::ios::binary);
+    if (!(report_file << report))
+    {
+        std::fprintf(stderr, "Could not write %s\n", report_path.c_str());
+        return 1;
+    }
+    return 0;
+}
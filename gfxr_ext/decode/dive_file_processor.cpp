@@ -18,6 +18,7 @@ limitations under the License.
 
 #include "dive_file_processor.h"
 
+#include <cinttypes>
 #include <fstream>
 
 #include "util/logging.h"
@@ -44,6 +45,23 @@ bool ShouldCreateRenderDocCapture()
     return property == "true" || property == "1";
 }
 
+// Finalize the RenderDoc capture started after the trimmed state was loaded
+void EndRenderDocCapture()
+{
+    if (const RENDERDOC_API_1_0_0* renderdoc = GetRenderDocApi(); renderdoc != nullptr)
+    {
+        if (renderdoc->EndFrameCapture(/*device=*/nullptr, /*wndHandle=*/nullptr) != 1)
+        {
+            GFXRECON_LOG_WARNING(
+            "EndFrameCapture failed, RenderDoc .rdc capture likely not created!");
+        }
+    }
+    else
+    {
+        GFXRECON_LOG_WARNING("GetRenderDocApi failed. Could not end RenderDoc capture!");
+    }
+}
+
 }  // namespace
 
 // TODO GH #1195: frame numbering should be 1-based.
@@ -51,7 +69,15 @@ const uint32_t kFirstFrame = 0;
 
 void DiveFileProcessor::SetLoopSingleFrameCount(uint64_t loop_single_frame_count)
 {
+    if (benchmark_ != nullptr)
+    {
+        GFXRECON_LOG_WARNING("Ignoring the loop count %" PRIu64 ", the benchmark loops the frames "
+                             "until it is complete",
+                             loop_single_frame_count);
+        return;
+    }
     loop_single_frame_count_ = loop_single_frame_count;
+    loop_single_frame_count_set_ = true;
     GFXRECON_LOG_INFO("Setting DiveFileProcessor::loop_single_frame_count_: %d",
                       loop_single_frame_count);
 }
@@ -64,6 +90,46 @@ void DiveFileProcessor::SetDiveBlockData(std::shared_ptr<DiveBlockData> p_block_
     run_without_decoders_ = true;
 }
 
+void DiveFileProcessor::SetFrameIndexBuilder(std::shared_ptr<DiveFrameIndex> frame_index)
+{
+    frame_index_builder_ = frame_index;
+    frame_index_builder_->Clear();
+    frame_start_pending_ = true;
+}
+
+bool DiveFileProcessor::SetFrameRange(std::shared_ptr<const DiveFrameIndex> frame_index,
+                                      uint64_t                              first_frame,
+                                      uint64_t                              last_frame)
+{
+    if (frame_index == nullptr || first_frame > last_frame ||
+        last_frame >= frame_index->GetFrameCount())
+    {
+        GFXRECON_LOG_ERROR("Invalid frame range %" PRIu64 "-%" PRIu64, first_frame, last_frame);
+        return false;
+    }
+
+    frame_index_ = frame_index;
+    frame_range_first_ = first_frame;
+    frame_range_last_ = last_frame;
+    GFXRECON_LOG_INFO("Setting DiveFileProcessor frame range: %" PRIu64 "-%" PRIu64,
+                      first_frame,
+                      last_frame);
+    return true;
+}
+
+void DiveFileProcessor::SetBenchmark(std::shared_ptr<DiveReplayBenchmark> benchmark)
+{
+    if (loop_single_frame_count_set_)
+    {
+        GFXRECON_LOG_WARNING("Ignoring the loop count %" PRIu64 ", the benchmark loops the frames "
+                             "until it is complete",
+                             loop_single_frame_count_);
+    }
+    benchmark_ = benchmark;
+    // Loop until the benchmark is complete
+    loop_single_frame_count_ = 0;
+}
+
 bool DiveFileProcessor::WriteFile(const std::string& name, const std::string& content)
 {
     std::string new_file_path = absolute_path_ + "/" + name;
@@ -106,9 +172,9 @@ bool DiveFileProcessor::ProcessFrameMarker(const format::BlockHeader& block_head
     if (success)
     {
         // Validate frame end marker's frame number matches first_frame_ when
-        // capture_uses_frame_markers_ is true.
+        // capture_uses_frame_markers_ is true. A range of frames has several frame numbers.
         GFXRECON_ASSERT((marker_type != format::kEndMarker) || (!UsesFrameMarkers()) ||
-                        (frame_number == GetFirstFrame()));
+                        (frame_index_ != nullptr) || (frame_number == GetFirstFrame()));
 
         for (auto decoder : decoders_)
         {
@@ -151,6 +217,32 @@ bool DiveFileProcessor::ProcessFrameMarker(const format::BlockHeader& block_head
         ++block_index_;
         should_break = true;
 
+        if (frame_index_builder_ != nullptr)
+        {
+            frame_start_pending_ = true;
+        }
+
+        if (benchmark_ != nullptr)
+        {
+            benchmark_->EndFrame();
+            if (benchmark_->IsComplete())
+            {
+                GFXRECON_LOG_INFO("Benchmark complete, terminating replay asap");
+                // The frames after the benchmark are not processed
+                SeekActiveFile(gfxr_file_name_, 0, util::platform::FileSeekEnd);
+                return success;
+            }
+        }
+
+        if (frame_index_ != nullptr)
+        {
+            if (current_frame_number_ > frame_range_last_)
+            {
+                EndFrameRange();
+            }
+            return success;
+        }
+
         // At the last frame in the capture file, determine whether to jump back to the state end
         // marker, or terminate replay if the loop count has been reached
         if ((loop_single_frame_count_ > 0) && (current_frame_number_ >= loop_single_frame_count_))
@@ -161,19 +253,7 @@ bool DiveFileProcessor::ProcessFrameMarker(const format::BlockHeader& block_head
                 // use case is to capture only 1 frame (which can be accomplished by setting
                 // loop_single_frame_count_), I don't see any reason to prevent the user from
                 // capturing all loops if they really want to.
-                if (const RENDERDOC_API_1_0_0* renderdoc = GetRenderDocApi(); renderdoc != nullptr)
-                {
-                    if (renderdoc->EndFrameCapture(/*device=*/nullptr, /*wndHandle=*/nullptr) != 1)
-                    {
-                        GFXRECON_LOG_WARNING(
-                        "EndFrameCapture failed, RenderDoc .rdc capture likely not created!");
-                    }
-                }
-                else
-                {
-                    GFXRECON_LOG_WARNING(
-                    "GetRenderDocApi failed. Could not end RenderDoc capture!");
-                }
+                EndRenderDocCapture();
             }
 
             GFXRECON_LOG_INFO("Looped %d frames, terminating replay asap", current_frame_number_);
@@ -192,6 +272,16 @@ bool DiveFileProcessor::ProcessStateMarker(const format::BlockHeader& block_head
 {
     bool success = FileProcessor::ProcessStateMarker(block_header, marker_type);
 
+    if (success && frame_index_builder_ != nullptr)
+    {
+        // Frame 0 starts after the trimmed state
+        if (marker_type == format::kBeginMarker)
+        {
+            frame_index_builder_->Clear();
+        }
+        frame_start_pending_ = (marker_type == format::kEndMarker);
+    }
+
     if ((success) && (marker_type == format::kEndMarker))
     {
         // Store state end marker offset
@@ -200,6 +290,10 @@ bool DiveFileProcessor::ProcessStateMarker(const format::BlockHeader& block_head
         state_end_marker_block_index_ = block_index_;
         GFXRECON_LOG_INFO("Stored state end marker offset %d", state_end_marker_file_offset_);
         GFXRECON_LOG_INFO("Single frame number %d", GetFirstFrame());
+        if (benchmark_ != nullptr)
+        {
+            benchmark_->BeginFrames();
+        }
 #if defined(__ANDROID__)
         if (DivePM4Capture::GetInstance().IsPM4CaptureEnabled())
         {
@@ -234,6 +328,38 @@ bool DiveFileProcessor::ProcessStateMarker(const format::BlockHeader& block_head
     return success;
 }
 
+void DiveFileProcessor::SeekToFrame(uint64_t frame)
+{
+    GFXRECON_ASSERT(!gfxr_file_name_.empty());
+    const DiveFrameIndex::Position& start = frame_index_->GetFrameStart(frame);
+    SeekActiveFile(gfxr_file_name_, start.file_offset, util::platform::FileSeekSet);
+    block_index_ = start.block_index;
+    current_frame_number_ = frame;
+    // The index is built from the frame markers. Frame numbering must not be reset by the next one.
+    SetUsesFrameMarkers(true);
+}
+
+void DiveFileProcessor::EndFrameRange()
+{
+    ++frame_range_loop_count_;
+    if ((loop_single_frame_count_ > 0) && (frame_range_loop_count_ >= loop_single_frame_count_))
+    {
+        if (ShouldCreateRenderDocCapture())
+        {
+            EndRenderDocCapture();
+        }
+        GFXRECON_LOG_INFO("Looped frames %" PRIu64 "-%" PRIu64 " %" PRIu64
+                          " times, terminating replay asap",
+                          frame_range_first_,
+                          frame_range_last_,
+                          frame_range_loop_count_);
+        // The frames after the range are not processed
+        SeekActiveFile(gfxr_file_name_, 0, util::platform::FileSeekEnd);
+        return;
+    }
+    SeekToFrame(frame_range_first_);
+}
+
 void DiveFileProcessor::StoreBlockInfo()
 {
     if (gfxr_file_name_.empty())
@@ -243,6 +369,27 @@ void DiveFileProcessor::StoreBlockInfo()
         GFXRECON_LOG_INFO("Storing active filename %s", gfxr_file_name_.c_str());
     }
 
+    if (frame_index_builder_ && frame_start_pending_)
+    {
+        frame_start_pending_ = false;
+        int64_t offset = TellFile(gfxr_file_name_);
+        GFXRECON_ASSERT(offset > 0);
+        frame_index_builder_->AddFrameStart(static_cast<uint64_t>(offset), block_index_);
+    }
+
+    if (frame_index_ && !frame_range_started_ &&
+        block_index_ == frame_index_->GetFrameStart(0).block_index &&
+        static_cast<uint64_t>(TellFile(gfxr_file_name_)) ==
+        frame_index_->GetFrameStart(0).file_offset)
+    {
+        frame_range_started_ = true;
+        if (frame_range_first_ != 0)
+        {
+            GFXRECON_LOG_INFO("Skipping to frame %" PRIu64, frame_range_first_);
+            SeekToFrame(frame_range_first_);
+        }
+    }
+
     if (!dive_block_data_)
     {
         return;
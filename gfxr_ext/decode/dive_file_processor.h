@@ -16,6 +16,8 @@ limitations under the License.
 
 // Implementing a custom file processor is necessary to support these changes:
 // - Loop a single frame for N times, or infinitely
+// - Process a range of frames, jumping to its first frame with a frame index
+// - Benchmark the looped frames
 
 #ifndef GFXRECON_DECODE_DIVE_FILE_PROCESSOR_H
 #define GFXRECON_DECODE_DIVE_FILE_PROCESSOR_H
@@ -25,6 +27,8 @@ limitations under the License.
 #include "decode/file_processor.h"
 
 #include "dive_block_data.h"
+#include "dive_frame_index.h"
+#include "dive_replay_benchmark.h"
 
 GFXRECON_BEGIN_NAMESPACE(gfxrecon)
 GFXRECON_BEGIN_NAMESPACE(decode)
@@ -36,6 +40,24 @@ public:
 
     void SetDiveBlockData(std::shared_ptr<DiveBlockData> p_block_data);
 
+    // Record the positions of the frames in `frame_index` while processing the file
+    void SetFrameIndexBuilder(std::shared_ptr<DiveFrameIndex> frame_index);
+
+    // Only process the frames [first_frame, last_frame] of the file. When the processing reaches
+    // the start of frame 0, it jumps to first_frame with the positions of `frame_index`. After
+    // last_frame, the range is looped like a single frame (see SetLoopSingleFrameCount()).
+    //
+    // The blocks of the skipped frames are not processed, so the frames of the range must not
+    // depend on objects created by the frames before them, other than the trimmed state.
+    bool SetFrameRange(std::shared_ptr<const DiveFrameIndex> frame_index,
+                       uint64_t                              first_frame,
+                       uint64_t                              last_frame);
+
+    // Measure the processed frames with `benchmark`. The frames are looped until the benchmark is
+    // complete, and the rest of the file is skipped. The loop count of SetLoopSingleFrameCount() is
+    // ignored, with a warning (the replay tool rejects both flags together).
+    void SetBenchmark(std::shared_ptr<DiveReplayBenchmark> benchmark);
+
     // Writes content to a new file that is put in the same dir as the capture file,
     // overwriting existing file if present
     bool WriteFile(const std::string& name, const std::string& content);
@@ -51,11 +73,19 @@ protected:
     void StoreBlockInfo() override;
 
 private:
+    // Continue processing at the start of `frame`
+    void SeekToFrame(uint64_t frame);
+
+    // Loop the frame range, or skip the rest of the file if the loop count has been reached
+    void EndFrameRange();
+
     // The block index of the state end marker
     uint64_t state_end_marker_block_index_{ 0 };
     // Application will terminate after the single frame has been looped loop_single_frame_count_
     // times. If 0, application will loop infinitely.
     uint64_t loop_single_frame_count_{ 1 };
+    // Whether loop_single_frame_count_ was set by SetLoopSingleFrameCount()
+    bool loop_single_frame_count_set_{ false };
 
     // Capture file offset of the marker that indicates the end of resources setup.
     int64_t state_end_marker_file_offset_{ 0 };
@@ -66,6 +96,19 @@ private:
 
     // Need to store this because the active file is sometimes the .gfxa one
     std::string gfxr_file_name_ = "";
+
+    // The frame index being built, and whether the next block starts a frame
+    std::shared_ptr<DiveFrameIndex> frame_index_builder_ = nullptr;
+    bool                            frame_start_pending_{ true };
+
+    // The frame index used to process a range of frames, see SetFrameRange()
+    std::shared_ptr<const DiveFrameIndex> frame_index_ = nullptr;
+    uint64_t                              frame_range_first_{ 0 };
+    uint64_t                              frame_range_last_{ 0 };
+    uint64_t                              frame_range_loop_count_{ 0 };
+    bool                                  frame_range_started_{ false };
+
+    std::shared_ptr<DiveReplayBenchmark> benchmark_ = nullptr;
 };
 
 GFXRECON_END_NAMESPACE(decode)
@@ -0,0 +1,45 @@
+/*
+Copyright 2025 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "dive_filtered_vulkan_decoder.h"
+
+#include "util/logging.h"
+
+GFXRECON_BEGIN_NAMESPACE(gfxrecon)
+GFXRECON_BEGIN_NAMESPACE(decode)
+
+DiveFilteredVulkanDecoder::DiveFilteredVulkanDecoder(
+std::initializer_list<format::ApiCallId> call_ids) :
+    supported_calls_(0x10000, false)
+{
+    for (format::ApiCallId call_id : call_ids)
+    {
+        AddApiCall(call_id);
+    }
+}
+
+void DiveFilteredVulkanDecoder::AddApiCall(format::ApiCallId call_id)
+{
+    if (format::GetApiCallFamily(call_id) != format::ApiFamilyId::ApiFamily_Vulkan)
+    {
+        GFXRECON_LOG_WARNING("Ignoring call id 0x%x which is not a Vulkan call", call_id);
+        return;
+    }
+    supported_calls_[call_id & 0xffff] = true;
+}
+
+GFXRECON_END_NAMESPACE(decode)
+GFXRECON_END_NAMESPACE(gfxrecon)
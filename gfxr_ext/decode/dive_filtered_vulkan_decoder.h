@@ -0,0 +1,67 @@
+/*
+Copyright 2025 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Implementing a filtered Vulkan decoder is necessary to support these changes:
+// - Scan large captures for a few commands without decoding the others
+
+#ifndef GFXRECON_DECODE_DIVE_FILTERED_VULKAN_DECODER_H
+#define GFXRECON_DECODE_DIVE_FILTERED_VULKAN_DECODER_H
+
+#include <initializer_list>
+#include <vector>
+
+#include "format/api_call_id.h"
+#include "generated/generated_vulkan_decoder.h"
+
+GFXRECON_BEGIN_NAMESPACE(gfxrecon)
+GFXRECON_BEGIN_NAMESPACE(decode)
+
+// Vulkan decoder which only decodes the function calls a tool declares. The other calls are not
+// dispatched to the consumers, so consumers such as VulkanExportDiveConsumer do not export their
+// arguments. With FileProcessor::SetSkipUnsupportedFunctionCalls(), their parameters are not even
+// read from the file.
+//
+// Consumers which track per-command-buffer state, like the command index of
+// VulkanExportDiveConsumer, only see the declared calls.
+//
+// Usage:
+//     DiveFilteredVulkanDecoder decoder({ format::ApiCallId::ApiCall_vkCmdDraw,
+//                                         format::ApiCallId::ApiCall_vkQueueSubmit });
+//     decoder.AddConsumer(&consumer);
+//     file_processor.SetSkipUnsupportedFunctionCalls(true);
+//     file_processor.AddDecoder(&decoder);
+class DiveFilteredVulkanDecoder : public VulkanDecoder
+{
+public:
+    DiveFilteredVulkanDecoder(std::initializer_list<format::ApiCallId> call_ids);
+
+    void AddApiCall(format::ApiCallId call_id);
+
+    bool SupportsApiCall(format::ApiCallId call_id) override
+    {
+        return (format::GetApiCallFamily(call_id) == format::ApiFamilyId::ApiFamily_Vulkan) &&
+               supported_calls_[call_id & 0xffff];
+    }
+
+private:
+    // Indexed by the Vulkan call index, the low 16 bits of the call id
+    std::vector<bool> supported_calls_;
+};
+
+GFXRECON_END_NAMESPACE(decode)
+GFXRECON_END_NAMESPACE(gfxrecon)
+
+#endif  // GFXRECON_DECODE_DIVE_FILTERED_VULKAN_DECODER_H
@@ -0,0 +1,49 @@
+/*
+Copyright 2025 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "dive_filtered_vulkan_decoder.h"
+
+#include <gtest/gtest.h>
+
+namespace gfxrecon::decode
+{
+namespace
+{
+
+TEST(DiveFilteredVulkanDecoderTest, OnlySupportsDeclaredCalls)
+{
+    DiveFilteredVulkanDecoder decoder({ format::ApiCallId::ApiCall_vkCmdDraw });
+    EXPECT_TRUE(decoder.SupportsApiCall(format::ApiCallId::ApiCall_vkCmdDraw));
+    EXPECT_FALSE(decoder.SupportsApiCall(format::ApiCallId::ApiCall_vkCmdDrawIndexed));
+
+    decoder.AddApiCall(format::ApiCallId::ApiCall_vkQueueSubmit);
+    EXPECT_TRUE(decoder.SupportsApiCall(format::ApiCallId::ApiCall_vkQueueSubmit));
+}
+
+TEST(DiveFilteredVulkanDecoderTest, IgnoresOtherApis)
+{
+    // Same call index as vkQueueSubmit, in another API family
+    format::ApiCallId other_api_call = static_cast<format::ApiCallId>(
+    format::MakeApiCallId(format::ApiFamilyId::ApiFamily_D3D12,
+                          format::ApiCallId::ApiCall_vkQueueSubmit & 0xffff));
+
+    DiveFilteredVulkanDecoder decoder({ format::ApiCallId::ApiCall_vkQueueSubmit, other_api_call });
+    EXPECT_TRUE(decoder.SupportsApiCall(format::ApiCallId::ApiCall_vkQueueSubmit));
+    EXPECT_FALSE(decoder.SupportsApiCall(other_api_call));
+}
+
+}  // namespace
+}  // namespace gfxrecon::decode
@@ -0,0 +1,220 @@
+/*
+Copyright 2025 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "dive_frame_index.h"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include "util/logging.h"
+
+GFXRECON_BEGIN_NAMESPACE(gfxrecon)
+GFXRECON_BEGIN_NAMESPACE(decode)
+
+namespace
+{
+
+// The index is a header followed by the frame starts, all in the byte order of the host
+constexpr char     kDiveFrameIndexMagic[8] = { 'D', 'I', 'V', 'E', 'F', 'R', 'M', 'S' };
+constexpr uint32_t kDiveFrameIndexVersion = 2;
+
+// Bytes of the GFXR file covered by the content hash: the start of the file (file header, options
+// and the beginning of the trimmed state), and the block header at each frame start
+constexpr uint64_t kHashedHeadSize = 64 * 1024;
+constexpr uint64_t kHashedBlockHeaderSize = 16;
+
+struct DiveFrameIndexHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t gfxr_file_size;
+    int64_t  gfxr_modification_time;
+    uint64_t gfxr_content_hash;
+    uint64_t frame_start_count;
+};
+
+// Size and modification time (seconds since the Unix epoch on all platforms) of a file
+bool GetFileInfo(const std::string& file_path, uint64_t& file_size, int64_t& modification_time)
+{
+#if defined(WIN32)
+    struct _stat64 info;
+    if (_stat64(file_path.c_str(), &info) != 0)
+#else
+    struct stat info;
+    if (stat(file_path.c_str(), &info) != 0)
+#endif
+    {
+        return false;
+    }
+    file_size = static_cast<uint64_t>(info.st_size);
+    modification_time = static_cast<int64_t>(info.st_mtime);
+    return true;
+}
+
+// FNV-1a
+void HashBytes(const char* data, size_t size, uint64_t& hash)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash = (hash ^ static_cast<uint8_t>(data[i])) * 0x100000001b3ull;
+    }
+}
+
+bool ComputeContentHash(const std::string&                           file_path,
+                        uint64_t                                     file_size,
+                        const std::vector<DiveFrameIndex::Position>& frame_starts,
+                        uint64_t&                                    content_hash)
+{
+    std::ifstream file(file_path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    uint64_t          hash = 0xcbf29ce484222325ull;
+    std::vector<char> head(std::min(file_size, kHashedHeadSize));
+    if (!file.read(head.data(), head.size()))
+    {
+        return false;
+    }
+    HashBytes(head.data(), head.size(), hash);
+
+    char block_header[kHashedBlockHeaderSize];
+    for (const DiveFrameIndex::Position& frame_start : frame_starts)
+    {
+        // The end of the last frame may be the end of the file
+        uint64_t size = std::min(file_size - frame_start.file_offset, kHashedBlockHeaderSize);
+        file.seekg(static_cast<std::streamoff>(frame_start.file_offset));
+        if (!file.read(block_header, size))
+        {
+            return false;
+        }
+        HashBytes(block_header, size, hash);
+    }
+    content_hash = hash;
+    return true;
+}
+
+}  // namespace
+
+std::string DiveFrameIndex::GetIndexFilePath(const std::string& gfxr_file_path)
+{
+    return gfxr_file_path + ".frame_index";
+}
+
+void DiveFrameIndex::AddFrameStart(uint64_t file_offset, uint64_t block_index)
+{
+    frame_starts_.push_back({ file_offset, block_index });
+}
+
+bool DiveFrameIndex::Save(const std::string& index_file_path,
+                          const std::string& gfxr_file_path) const
+{
+    DiveFrameIndexHeader header = {};
+    std::memcpy(header.magic, kDiveFrameIndexMagic, sizeof(header.magic));
+    header.version = kDiveFrameIndexVersion;
+    header.frame_start_count = frame_starts_.size();
+    if (!GetFileInfo(gfxr_file_path, header.gfxr_file_size, header.gfxr_modification_time) ||
+        !ComputeContentHash(gfxr_file_path,
+                            header.gfxr_file_size,
+                            frame_starts_,
+                            header.gfxr_content_hash))
+    {
+        GFXRECON_LOG_WARNING("Could not read %s to index it", gfxr_file_path.c_str());
+        return false;
+    }
+
+    std::ofstream file(index_file_path, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        GFXRECON_LOG_WARNING("Could not create frame index %s", index_file_path.c_str());
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(frame_starts_.data()),
+               frame_starts_.size() * sizeof(Position));
+    if (!file)
+    {
+        GFXRECON_LOG_WARNING("Could not write frame index %s", index_file_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool DiveFrameIndex::Load(const std::string& index_file_path, const std::string& gfxr_file_path)
+{
+    std::ifstream file(index_file_path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    uint64_t gfxr_file_size = 0;
+    int64_t  gfxr_modification_time = 0;
+    if (!GetFileInfo(gfxr_file_path, gfxr_file_size, gfxr_modification_time))
+    {
+        return false;
+    }
+
+    DiveFrameIndexHeader header = {};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, kDiveFrameIndexMagic, sizeof(header.magic)) != 0 ||
+        header.version != kDiveFrameIndexVersion || header.frame_start_count > gfxr_file_size)
+    {
+        GFXRECON_LOG_WARNING("Ignoring invalid frame index %s", index_file_path.c_str());
+        return false;
+    }
+    if (header.gfxr_file_size != gfxr_file_size ||
+        header.gfxr_modification_time != gfxr_modification_time)
+    {
+        GFXRECON_LOG_WARNING("Ignoring stale frame index %s", index_file_path.c_str());
+        return false;
+    }
+
+    std::vector<Position> frame_starts(header.frame_start_count);
+    if (!file.read(reinterpret_cast<char*>(frame_starts.data()),
+                   frame_starts.size() * sizeof(Position)))
+    {
+        GFXRECON_LOG_WARNING("Ignoring truncated frame index %s", index_file_path.c_str());
+        return false;
+    }
+    for (size_t i = 0; i < frame_starts.size(); ++i)
+    {
+        if (frame_starts[i].file_offset > gfxr_file_size ||
+            (i > 0 && frame_starts[i].file_offset <= frame_starts[i - 1].file_offset))
+        {
+            GFXRECON_LOG_WARNING("Ignoring invalid frame index %s", index_file_path.c_str());
+            return false;
+        }
+    }
+
+    uint64_t content_hash = 0;
+    if (!ComputeContentHash(gfxr_file_path, gfxr_file_size, frame_starts, content_hash) ||
+        content_hash != header.gfxr_content_hash)
+    {
+        GFXRECON_LOG_WARNING("Ignoring stale frame index %s", index_file_path.c_str());
+        return false;
+    }
+    frame_starts_ = std::move(frame_starts);
+    return true;
+}
+
+GFXRECON_END_NAMESPACE(decode)
+GFXRECON_END_NAMESPACE(gfxrecon)
@@ -0,0 +1,83 @@
+/*
+Copyright 2025 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Implementing a frame index of GFXR files is necessary to support these changes:
+// - Replay or analyze a range of frames of a capture without processing the frames before it
+
+#ifndef GFXRECON_DECODE_DIVE_FRAME_INDEX_H
+#define GFXRECON_DECODE_DIVE_FRAME_INDEX_H
+
+#include "util/defines.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+GFXRECON_BEGIN_NAMESPACE(gfxrecon)
+GFXRECON_BEGIN_NAMESPACE(decode)
+
+// Positions of the frames in a GFXR file, built by DiveFileProcessor from the frame end markers of
+// the file. Frame 0 starts with the first block after the trimmed state, if any. Each frame end
+// marker ends a frame, and the next frame starts with the following block.
+//
+// Dive builds the index while it loads a GFXR file and keeps it in memory. It is only persisted on
+// request (see host_cli --frame_index_path): the replay of a range of frames on Android reads it
+// from GetIndexFilePath(), so the index must be pushed to the device with the capture.
+class DiveFrameIndex
+{
+public:
+    struct Position
+    {
+        // Offset of the first block of the frame in the GFXR file
+        uint64_t file_offset = 0;
+        // Index of the first block of the frame
+        uint64_t block_index = 0;
+    };
+
+    // Path where the replay looks for the index of `gfxr_file_path`
+    static std::string GetIndexFilePath(const std::string& gfxr_file_path);
+
+    // Record the start of the next frame. The position after the last frame end marker is also
+    // recorded, it is where the last frame ends.
+    void AddFrameStart(uint64_t file_offset, uint64_t block_index);
+    void Clear() { frame_starts_.clear(); }
+
+    // Number of complete frames
+    uint64_t GetFrameCount() const
+    {
+        return frame_starts_.empty() ? 0 : frame_starts_.size() - 1;
+    }
+    // Start of `frame`. GetFrameStart(GetFrameCount()) is the end of the last frame.
+    const Position& GetFrameStart(uint64_t frame) const { return frame_starts_[frame]; }
+
+    // Write the index of the GFXR file `gfxr_file_path`, tagged with the size, the modification
+    // time and a content hash of the file
+    bool Save(const std::string& index_file_path, const std::string& gfxr_file_path) const;
+
+    // Read an index written by Save() for `gfxr_file_path`. Fails if the file changed since: if its
+    // size or modification time differ (adb push keeps the modification time), or its content
+    // hash. The content hash covers the start of the file and the block header at each frame
+    // start, so the file is not read in full.
+    bool Load(const std::string& index_file_path, const std::string& gfxr_file_path);
+
+private:
+    std::vector<Position> frame_starts_ = {};
+};
+
+GFXRECON_END_NAMESPACE(decode)
+GFXRECON_END_NAMESPACE(gfxrecon)
+
+#endif  // GFXRECON_DECODE_DIVE_FRAME_INDEX_H
@@ -0,0 +1,108 @@
+/*
+Copyright 2025 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "dive_frame_index.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace gfxrecon::decode
+{
+namespace
+{
+
+DiveFrameIndex CreateFrameIndex()
+{
+    DiveFrameIndex frame_index;
+    frame_index.AddFrameStart(100, 5);
+    frame_index.AddFrameStart(200, 9);
+    frame_index.AddFrameStart(300, 14);
+    return frame_index;
+}
+
+TEST(DiveFrameIndexTest, LastFrameStartIsTheEndOfTheLastFrame)
+{
+    DiveFrameIndex frame_index;
+    EXPECT_EQ(frame_index.GetFrameCount(), 0);
+    frame_index.AddFrameStart(100, 5);
+    EXPECT_EQ(frame_index.GetFrameCount(), 0);
+
+    frame_index = CreateFrameIndex();
+    EXPECT_EQ(frame_index.GetFrameCount(), 2);
+    EXPECT_EQ(frame_index.GetFrameStart(1).file_offset, 200);
+    EXPECT_EQ(frame_index.GetFrameStart(1).block_index, 9);
+}
+
+// A GFXR file large enough for the frame starts of CreateFrameIndex()
+std::string WriteGfxrFile(const std::string& name, char fill)
+{
+    std::string path = testing::TempDir() + name;
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << std::string(1000, fill);
+    return path;
+}
+
+TEST(DiveFrameIndexTest, SaveAndLoad)
+{
+    std::string gfxr_path = WriteGfxrFile("dive_frame_index.gfxr", 'a');
+    std::string path = DiveFrameIndex::GetIndexFilePath(gfxr_path);
+    ASSERT_TRUE(CreateFrameIndex().Save(path, gfxr_path));
+
+    DiveFrameIndex frame_index;
+    ASSERT_TRUE(frame_index.Load(path, gfxr_path));
+    std::remove(path.c_str());
+    std::remove(gfxr_path.c_str());
+    ASSERT_EQ(frame_index.GetFrameCount(), 2);
+    for (uint64_t frame = 0; frame <= 2; frame++)
+    {
+        EXPECT_EQ(frame_index.GetFrameStart(frame).file_offset,
+                  CreateFrameIndex().GetFrameStart(frame).file_offset);
+        EXPECT_EQ(frame_index.GetFrameStart(frame).block_index,
+                  CreateFrameIndex().GetFrameStart(frame).block_index);
+    }
+}
+
+TEST(DiveFrameIndexTest, LoadRejectsStaleAndInvalidIndices)
+{
+    std::string    gfxr_path = WriteGfxrFile("dive_frame_index_stale.gfxr", 'a');
+    std::string    path = DiveFrameIndex::GetIndexFilePath(gfxr_path);
+    DiveFrameIndex frame_index;
+    EXPECT_FALSE(frame_index.Load(path, gfxr_path));
+
+    // The capture changed size since the index was written
+    ASSERT_TRUE(CreateFrameIndex().Save(path, gfxr_path));
+    std::ofstream(gfxr_path, std::ios::binary | std::ios::app) << "b";
+    EXPECT_FALSE(frame_index.Load(path, gfxr_path));
+
+    // The capture changed content, with the same size and modification time
+    gfxr_path = WriteGfxrFile("dive_frame_index_stale.gfxr", 'a');
+    std::filesystem::file_time_type modification_time = std::filesystem::last_write_time(gfxr_path);
+    ASSERT_TRUE(CreateFrameIndex().Save(path, gfxr_path));
+    WriteGfxrFile("dive_frame_index_stale.gfxr", 'b');
+    std::filesystem::last_write_time(gfxr_path, modification_time);
+    EXPECT_FALSE(frame_index.Load(path, gfxr_path));
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "not a frame index";
+    EXPECT_FALSE(frame_index.Load(path, gfxr_path));
+    std::remove(path.c_str());
+    std::remove(gfxr_path.c_str());
+    EXPECT_EQ(frame_index.GetFrameCount(), 0);
+}
+
+}  // namespace
+}  // namespace gfxrecon::decode
@@ -0,0 +1,237 @@
+/*
+Copyright 2025 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "dive_replay_benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <numeric>
+#include <sstream>
+
+#include "nlohmann/json.hpp"
+#include "util/date_time.h"
+
+GFXRECON_BEGIN_NAMESPACE(gfxrecon)
+GFXRECON_BEGIN_NAMESPACE(decode)
+
+namespace
+{
+
+// Two-sided 95% critical values of the Student's t-distribution, by degrees of freedom. Past the
+// table, the value of the largest tabulated degrees of freedom below is used, which is
+// conservative.
+constexpr double kStudentT95[] = { 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306,
+                                   2.262,  2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120,
+                                   2.110,  2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064,
+                                   2.060,  2.056, 2.052, 2.048, 2.045, 2.042 };
+
+double GetStudentT95(uint64_t degrees_of_freedom)
+{
+    if (degrees_of_freedom <= std::size(kStudentT95))
+    {
+        return kStudentT95[degrees_of_freedom - 1];
+    }
+    if (degrees_of_freedom < 40)
+    {
+        return 2.042;
+    }
+    if (degrees_of_freedom < 60)
+    {
+        return 2.021;
+    }
+    if (degrees_of_freedom < 120)
+    {
+        return 2.000;
+    }
+    return 1.980;
+}
+
+// Percentile `p` in [0, 1] of sorted samples
+double GetPercentile(const std::vector<double>& sorted_samples, double p)
+{
+    double rank = p * (sorted_samples.size() - 1);
+    size_t lower = static_cast<size_t>(rank);
+    size_t upper = std::min(lower + 1, sorted_samples.size() - 1);
+    double weight = rank - lower;
+    return sorted_samples[lower] + weight * (sorted_samples[upper] - sorted_samples[lower]);
+}
+
+nlohmann::ordered_json StatsToJson(const DiveReplayBenchmark::Stats& stats)
+{
+    return { { "count", stats.count },         { "mean", stats.mean },
+             { "stddev", stats.stddev },       { "min", stats.min },
+             { "p50", stats.p50 },             { "p90", stats.p90 },
+             { "p95", stats.p95 },             { "p99", stats.p99 },
+             { "max", stats.max },             { "ci95_low", stats.ci95_low },
+             { "ci95_high", stats.ci95_high } };
+}
+
+std::vector<double> GetMeasuredGpuTimes(const std::vector<std::optional<double>>& gpu_time_ms)
+{
+    std::vector<double> samples;
+    for (const std::optional<double>& sample : gpu_time_ms)
+    {
+        if (sample.has_value())
+        {
+            samples.push_back(*sample);
+        }
+    }
+    return samples;
+}
+
+}  // namespace
+
+DiveReplayBenchmark::Stats DiveReplayBenchmark::ComputeStats(std::vector<double> samples)
+{
+    Stats stats;
+    if (samples.empty())
+    {
+        return stats;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    stats.count = samples.size();
+    stats.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+    stats.min = samples.front();
+    stats.max = samples.back();
+    stats.p50 = GetPercentile(samples, 0.50);
+    stats.p90 = GetPercentile(samples, 0.90);
+    stats.p95 = GetPercentile(samples, 0.95);
+    stats.p99 = GetPercentile(samples, 0.99);
+    stats.ci95_low = stats.mean;
+    stats.ci95_high = stats.mean;
+    if (samples.size() > 1)
+    {
+        double variance = 0.0;
+        for (double sample : samples)
+        {
+            variance += (sample - stats.mean) * (sample - stats.mean);
+        }
+        stats.stddev = std::sqrt(variance / (samples.size() - 1));
+
+        double margin = GetStudentT95(samples.size() - 1) * stats.stddev /
+                        std::sqrt(static_cast<double>(samples.size()));
+        stats.ci95_low = stats.mean - margin;
+        stats.ci95_high = stats.mean + margin;
+    }
+    return stats;
+}
+
+DiveReplayBenchmark::DiveReplayBenchmark(uint64_t warmup_frame_count, uint64_t frame_count) :
+    warmup_frame_count_(warmup_frame_count), frame_count_(frame_count)
+{
+    wall_time_ms_.reserve(frame_count);
+    cpu_time_ms_.reserve(frame_count);
+    gpu_time_ms_.reserve(frame_count);
+}
+
+void DiveReplayBenchmark::BeginFrames()
+{
+    frame_started_ = true;
+    frame_start_timestamp_ = util::datetime::GetTimestamp();
+    frame_start_cpu_time_ = util::datetime::GetProcessTime();
+    frame_gpu_time_ms_ = std::nullopt;
+}
+
+void DiveReplayBenchmark::EndFrame()
+{
+    int64_t timestamp = util::datetime::GetTimestamp();
+    double  cpu_time = util::datetime::GetProcessTime();
+    if (frame_started_)
+    {
+        AddFrame(util::datetime::ConvertTimestampToMilliseconds(
+                 util::datetime::DiffTimestamps(frame_start_timestamp_, timestamp)),
+                 (cpu_time - frame_start_cpu_time_) * 1000.0,
+                 frame_gpu_time_ms_);
+    }
+
+    frame_started_ = true;
+    frame_start_timestamp_ = timestamp;
+    frame_start_cpu_time_ = cpu_time;
+    frame_gpu_time_ms_ = std::nullopt;
+}
+
+void DiveReplayBenchmark::SetFrameGpuTime(double gpu_time_ms)
+{
+    frame_gpu_time_ms_ = gpu_time_ms;
+}
+
+void DiveReplayBenchmark::AddFrame(double                wall_time_ms,
+                                   double                cpu_time_ms,
+                                   std::optional<double> gpu_time_ms)
+{
+    ++ended_frame_count_;
+    if (ended_frame_count_ <= warmup_frame_count_ || IsComplete())
+    {
+        return;
+    }
+    wall_time_ms_.push_back(wall_time_ms);
+    cpu_time_ms_.push_back(cpu_time_ms);
+    gpu_time_ms_.push_back(gpu_time_ms);
+}
+
+std::string DiveReplayBenchmark::GetJsonReport() const
+{
+    std::vector<double>    gpu_time_ms = GetMeasuredGpuTimes(gpu_time_ms_);
+    nlohmann::ordered_json report;
+    report["warmup_frames"] = warmup_frame_count_;
+    report["frames"] = wall_time_ms_.size();
+    report["wall_time_ms"] = StatsToJson(ComputeStats(wall_time_ms_));
+    report["cpu_time_ms"] = StatsToJson(ComputeStats(cpu_time_ms_));
+    if (!gpu_time_ms.empty())
+    {
+        report["gpu_time_ms"] = StatsToJson(ComputeStats(gpu_time_ms));
+    }
+
+    nlohmann::ordered_json samples = nlohmann::ordered_json::array();
+    for (size_t i = 0; i < wall_time_ms_.size(); ++i)
+    {
+        nlohmann::ordered_json sample = { { "wall_time_ms", wall_time_ms_[i] },
+                                          { "cpu_time_ms", cpu_time_ms_[i] } };
+        if (gpu_time_ms_[i].has_value())
+        {
+            sample["gpu_time_ms"] = *gpu_time_ms_[i];
+        }
+        samples.push_back(std::move(sample));
+    }
+    report["samples"] = std::move(samples);
+    return report.dump(4) + "\n";
+}
+
+std::string DiveReplayBenchmark::GetCsvReport() const
+{
+    std::ostringstream csv;
+    csv << "Metric,Count,Mean [ms],Stddev [ms],Min [ms],P50 [ms],P90 [ms],P95 [ms],P99 [ms],"
+           "Max [ms],CI95 Low [ms],CI95 High [ms]\n";
+    auto WriteStats = [&csv](const char* metric, const Stats& stats) {
+        csv << metric << "," << stats.count << "," << stats.mean << "," << stats.stddev << ","
+            << stats.min << "," << stats.p50 << "," << stats.p90 << "," << stats.p95 << ","
+            << stats.p99 << "," << stats.max << "," << stats.ci95_low << "," << stats.ci95_high
+            << "\n";
+    };
+    WriteStats("wall_time", ComputeStats(wall_time_ms_));
+    WriteStats("cpu_time", ComputeStats(cpu_time_ms_));
+    std::vector<double> gpu_time_ms = GetMeasuredGpuTimes(gpu_time_ms_);
+    if (!gpu_time_ms.empty())
+    {
+        WriteStats("gpu_time", ComputeStats(gpu_time_ms));
+    }
+    return csv.str();
+}
+
+GFXRECON_END_NAMESPACE(decode)
+GFXRECON_END_NAMESPACE(gfxrecon)
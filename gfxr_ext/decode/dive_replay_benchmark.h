@@ -0,0 +1,106 @@
+/*
+Copyright 2025 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Implementing a replay benchmark is necessary to support these changes:
+// - Measure the replay of looped frames, or their decoding only, over many iterations
+// - Report the distribution of the frame times instead of their mean
+
+#ifndef GFXRECON_DECODE_DIVE_REPLAY_BENCHMARK_H
+#define GFXRECON_DECODE_DIVE_REPLAY_BENCHMARK_H
+
+#include "util/defines.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+GFXRECON_BEGIN_NAMESPACE(gfxrecon)
+GFXRECON_BEGIN_NAMESPACE(decode)
+
+// Measures the frames processed by DiveFileProcessor, see DiveFileProcessor::SetBenchmark().
+//
+// Each frame gets a wall time, the CPU time of the process, and the GPU time if the replay
+// consumer measures it. The first frames are a warmup and are not measured.
+class DiveReplayBenchmark
+{
+public:
+    // Distribution of the samples of a metric, in milliseconds
+    struct Stats
+    {
+        uint64_t count = 0;
+        double   mean = 0.0;
+        double   stddev = 0.0;
+        double   min = 0.0;
+        double   max = 0.0;
+        double   p50 = 0.0;
+        double   p90 = 0.0;
+        double   p95 = 0.0;
+        double   p99 = 0.0;
+        // 95% confidence interval of the mean
+        double ci95_low = 0.0;
+        double ci95_high = 0.0;
+    };
+
+    // Percentiles are interpolated between the closest ranks. The confidence interval uses the
+    // Student's t-distribution, since benchmarks usually have few samples.
+    static Stats ComputeStats(std::vector<double> samples);
+
+    // Measure `frame_count` frames after `warmup_frame_count` frames
+    DiveReplayBenchmark(uint64_t warmup_frame_count, uint64_t frame_count);
+
+    // Start the first frame, once the trimmed state is loaded
+    void BeginFrames();
+
+    // End the current frame and start the next one. Without BeginFrames(), the first call only
+    // starts the next frame.
+    void EndFrame();
+
+    // Set the GPU time of the current frame
+    void SetFrameGpuTime(double gpu_time_ms);
+
+    // Add a frame measured by the caller
+    void AddFrame(double wall_time_ms, double cpu_time_ms, std::optional<double> gpu_time_ms);
+
+    bool IsComplete() const { return wall_time_ms_.size() >= frame_count_; }
+
+    // Statistics of the metrics, and the samples of each frame
+    std::string GetJsonReport() const;
+
+    // Statistics of the metrics, one metric per row
+    std::string GetCsvReport() const;
+
+private:
+    uint64_t warmup_frame_count_ = 0;
+    uint64_t frame_count_ = 0;
+    uint64_t ended_frame_count_ = 0;
+
+    // Start of the current frame
+    bool                  frame_started_ = false;
+    int64_t               frame_start_timestamp_ = 0;
+    double                frame_start_cpu_time_ = 0.0;
+    std::optional<double> frame_gpu_time_ms_ = std::nullopt;
+
+    // Samples of the measured frames
+    std::vector<double>                wall_time_ms_ = {};
+    std::vector<double>                cpu_time_ms_ = {};
+    std::vector<std::optional<double>> gpu_time_ms_ = {};
+};
+
+GFXRECON_END_NAMESPACE(decode)
+GFXRECON_END_NAMESPACE(gfxrecon)
+
+#endif  // GFXRECON_DECODE_DIVE_REPLAY_BENCHMARK_H
@@ -0,0 +1,113 @@
+/*
+Copyright 2025 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "dive_replay_benchmark.h"
+
+#include <gtest/gtest.h>
+
+#include "nlohmann/json.hpp"
+
+namespace gfxrecon::decode
+{
+namespace
+{
+
+TEST(DiveReplayBenchmarkTest, ComputeStats)
+{
+    DiveReplayBenchmark::Stats stats = DiveReplayBenchmark::ComputeStats({ 4.0, 1.0, 3.0, 2.0 });
+    EXPECT_EQ(stats.count, 4);
+    EXPECT_DOUBLE_EQ(stats.mean, 2.5);
+    EXPECT_DOUBLE_EQ(stats.min, 1.0);
+    EXPECT_DOUBLE_EQ(stats.max, 4.0);
+    // Interpolated between the 2nd and 3rd samples
+    EXPECT_DOUBLE_EQ(stats.p50, 2.5);
+    EXPECT_DOUBLE_EQ(stats.p90, 3.7);
+    // Sample stddev of { 1, 2, 3, 4 } is sqrt(5/3), with a t-value of 3.182 for 3 degrees of
+    // freedom
+    EXPECT_NEAR(stats.stddev, 1.290994, 1e-6);
+    EXPECT_NEAR(stats.ci95_low, 2.5 - 3.182 * 1.290994 / 2.0, 1e-5);
+    EXPECT_NEAR(stats.ci95_high, 2.5 + 3.182 * 1.290994 / 2.0, 1e-5);
+
+    stats = DiveReplayBenchmark::ComputeStats({ 7.0 });
+    EXPECT_EQ(stats.count, 1);
+    EXPECT_DOUBLE_EQ(stats.p99, 7.0);
+    EXPECT_DOUBLE_EQ(stats.stddev, 0.0);
+    EXPECT_DOUBLE_EQ(stats.ci95_low, 7.0);
+    EXPECT_DOUBLE_EQ(stats.ci95_high, 7.0);
+
+    EXPECT_EQ(DiveReplayBenchmark::ComputeStats({}).count, 0);
+}
+
+TEST(DiveReplayBenchmarkTest, SkipsWarmupFrames)
+{
+    DiveReplayBenchmark benchmark(/*warmup_frame_count=*/2, /*frame_count=*/3);
+    benchmark.AddFrame(100.0, 100.0, std::nullopt);
+    benchmark.AddFrame(100.0, 100.0, 100.0);
+    EXPECT_FALSE(benchmark.IsComplete());
+    benchmark.AddFrame(1.0, 0.5, 0.25);
+    benchmark.AddFrame(2.0, 1.0, std::nullopt);
+    benchmark.AddFrame(3.0, 1.5, 0.75);
+    EXPECT_TRUE(benchmark.IsComplete());
+    // Ignored, the benchmark is complete
+    benchmark.AddFrame(100.0, 100.0, 100.0);
+
+    nlohmann::json report = nlohmann::json::parse(benchmark.GetJsonReport());
+    EXPECT_EQ(report["warmup_frames"], 2);
+    EXPECT_EQ(report["frames"], 3);
+    EXPECT_DOUBLE_EQ(report["wall_time_ms"]["mean"].get<double>(), 2.0);
+    EXPECT_DOUBLE_EQ(report["cpu_time_ms"]["max"].get<double>(), 1.5);
+    // Only the frames with a GPU time are counted
+    EXPECT_EQ(report["gpu_time_ms"]["count"], 2);
+    EXPECT_DOUBLE_EQ(report["gpu_time_ms"]["mean"].get<double>(), 0.5);
+    ASSERT_EQ(report["samples"].size(), 3);
+    EXPECT_FALSE(report["samples"][1].contains("gpu_time_ms"));
+}
+
+TEST(DiveReplayBenchmarkTest, CsvReport)
+{
+    DiveReplayBenchmark benchmark(/*warmup_frame_count=*/0, /*frame_count=*/2);
+    benchmark.AddFrame(1.0, 1.0, std::nullopt);
+    benchmark.AddFrame(3.0, 1.0, std::nullopt);
+
+    std::string csv = benchmark.GetCsvReport();
+    EXPECT_EQ(csv.find("Metric,Count,Mean [ms]"), 0);
+    EXPECT_NE(csv.find("\nwall_time,2,2,"), std::string::npos);
+    EXPECT_NE(csv.find("\ncpu_time,2,1,0,"), std::string::npos);
+    // Without GPU time
+    EXPECT_EQ(csv.find("gpu_time"), std::string::npos);
+}
+
+TEST(DiveReplayBenchmarkTest, MeasuresFramesBetweenFrameEnds)
+{
+    DiveReplayBenchmark benchmark(/*warmup_frame_count=*/0, /*frame_count=*/2);
+    // Without BeginFrames(), the first frame end only starts the next frame
+    benchmark.EndFrame();
+    benchmark.SetFrameGpuTime(5.0);
+    benchmark.EndFrame();
+    EXPECT_FALSE(benchmark.IsComplete());
+    benchmark.EndFrame();
+    EXPECT_TRUE(benchmark.IsComplete());
+
+    nlohmann::json report = nlohmann::json::parse(benchmark.GetJsonReport());
+    EXPECT_GE(report["wall_time_ms"]["min"].get<double>(), 0.0);
+    // The GPU time belongs to the frame it was set in
+    ASSERT_EQ(report["samples"].size(), 2);
+    EXPECT_DOUBLE_EQ(report["samples"][0]["gpu_time_ms"].get<double>(), 5.0);
+    EXPECT_FALSE(report["samples"][1].contains("gpu_time_ms"));
+}
+
+}  // namespace
+}  // namespace gfxrecon::decode
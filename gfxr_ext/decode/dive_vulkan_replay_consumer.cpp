@@ -387,6 +387,10 @@ format::HandleId                            fence)
         {
             GFXRECON_LOG_INFO(gpu_time_.GetStatsString().c_str());
             gpu_time_stats_csv_str_ = gpu_time_.GetStatsCSVString();
+            if (benchmark_ != nullptr && gpu_time_.GetLastFrameTime().has_value())
+            {
+                benchmark_->SetFrameGpuTime(*gpu_time_.GetLastFrameTime());
+            }
         }
     }
 }
@@ -19,6 +19,8 @@ limitations under the License.
 
 #include "generated/generated_vulkan_replay_consumer.h"
 #include "gpu_time/gpu_time.h"
+#include "dive_replay_benchmark.h"
+#include <memory>
 #include <set>
 #include <vector>
 #include <unordered_map>
@@ -197,6 +199,9 @@ public:
         return gpu_time_stats_csv_header_str_ + gpu_time_stats_csv_str_;
     }
 
+    // Report the GPU time of each frame to `benchmark`, when the GPU time is enabled
+    void SetBenchmark(std::shared_ptr<DiveReplayBenchmark> benchmark) { benchmark_ = benchmark; }
+
 private:
     // Keeps the fences status after setup phase
     enum class FenceStatus
@@ -218,6 +223,8 @@ private:
     std::string gpu_time_stats_csv_str_ = "";
     VkDevice    device_ = VK_NULL_HANDLE;
     bool        enable_gpu_time_ = false;
+    // Receives the GPU time of each frame
+    std::shared_ptr<DiveReplayBenchmark> benchmark_ = nullptr;
     // This is a flag that indicates if the Setup Phase is finised or not for gfx Replay
     // The Setup Phase is done when StateEndMarker is triggered
     bool setup_finished_ = false;
@@ -776,6 +776,7 @@ PFN_vkGetQueryPoolResults pfn_get_query_pool_results)
     if (m_valid_frame)
     {
         m_metrics.AddFrameData(frame_time, cmds_time, renderpasses_time, cmd_renderpass_count_vec);
+        m_last_frame_time = frame_time;
     }
 
     return GPUTime::GpuTimeStatus();
@@ -861,6 +862,7 @@ GPUTime::SubmitStatus GPUTime::OnQueueSubmit(uint32_t                  submit_co
         pfn_device_wait_idle(m_device);
 
         GPUTime::GpuTimeStatus update_status;
+        m_last_frame_time.reset();
         if (m_valid_frame)
         {
             update_status = UpdateFrameMetrics(pfn_get_query_pool_results);
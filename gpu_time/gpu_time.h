@@ -24,6 +24,7 @@ limitations under the License.
 #include <unordered_map>
 #include <limits>
 #include <atomic>
+#include <optional>
 
 namespace Dive
 {
@@ -134,6 +135,8 @@ public:
     {
         return m_metrics.GetCmdRenderPassCount(index);
     }
+    // Time of the frame ended by the last frame boundary, if it could be measured
+    std::optional<double> GetLastFrameTime() const { return m_last_frame_time; }
     std::string GetStatsString() const;
     // Gives a CSV format string representing the GPU timing data for objects in the current frame
     // Type, id, mean [ms], median [ms]
@@ -227,6 +230,7 @@ private:
     const VkAllocationCallbacks* m_allocator = nullptr;
     VkQueryPool                  m_query_pool = VK_NULL_HANDLE;
     uint64_t                     m_frame_index = 0;
+    std::optional<double>        m_last_frame_time;
     uint32_t                     m_timestamp_counter = 0;
     float                        m_timestamp_period = 0.0f;
     bool                         m_valid_frame = true;
@@ -426,6 +426,10 @@ TEST(GPUTimeTest, MultipleFramesUpdateMetricsCorrectly)
     expected_stats.stddev = 10.0;
     EXPECT_THAT(stats, StatsEq(expected_stats));
 
+    // The last frame time is the time of frame 3
+    ASSERT_TRUE(gpu_time.GetLastFrameTime().has_value());
+    EXPECT_DOUBLE_EQ(*gpu_time.GetLastFrameTime(), 30.0);
+
     ASSERT_NO_FATAL_FAILURE(DestroyGPUTime(gpu_time));
 }
 
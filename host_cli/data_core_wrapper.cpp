@@ -16,6 +16,7 @@
 
 #include "data_core_wrapper.h"
 
+#include "absl/strings/str_format.h"
 #include "dive_core/capture_data.h"
 #include "dive_core/data_core.h"
 
@@ -48,6 +49,12 @@ absl::Status DataCoreWrapper::LoadGfxrFile(const std::string& original_gfxr_file
     return absl::OkStatus();
 }
 
+void DataCoreWrapper::AddGfxrLoadObserver(DiveAnnotationProcessor::FunctionObserver* observer)
+{
+    assert(m_data_core != nullptr);
+    m_data_core->GetMutableGfxrCaptureData().AddLoadObserver(observer);
+}
+
 absl::Status DataCoreWrapper::WriteNewGfxrFile(const std::string& new_gfxr_file_path)
 {
     assert(m_data_core != nullptr);
@@ -66,4 +73,43 @@ absl::Status DataCoreWrapper::WriteNewGfxrFile(const std::string& new_gfxr_file_
     return absl::OkStatus();
 }
 
+absl::Status DataCoreWrapper::WriteFrameIndex(const std::string& frame_index_path)
+{
+    assert(m_data_core != nullptr);
+    if (!IsGfxrLoaded())
+    {
+        return absl::FailedPreconditionError("Must load original GFXR first");
+    }
+
+    if (!m_data_core->GetGfxrCaptureData().WriteFrameIndex(frame_index_path))
+    {
+        return absl::InternalError(
+        absl::StrFormat("Could not write frame index: %s", frame_index_path));
+    }
+    return absl::OkStatus();
+}
+
+absl::Status DataCoreWrapper::ApplyGfxrEdits(const std::vector<GfxrEdit>& edits)
+{
+    assert(m_data_core != nullptr);
+    if (!IsGfxrLoaded())
+    {
+        return absl::FailedPreconditionError("Must load original GFXR first");
+    }
+
+    std::shared_ptr<gfxrecon::decode::DiveBlockData> block_data =
+    m_data_core->GetMutableGfxrCaptureData().GetMutableGfxrData();
+    block_data->ClearAllModifications();
+    for (const GfxrEdit& edit : edits)
+    {
+        if (!block_data->AddModification(edit.primary_id, edit.secondary_id, edit.blob))
+        {
+            return absl::InvalidArgumentError(absl::StrFormat("Could not apply edit at (%d, %d)",
+                                                              edit.primary_id,
+                                                              edit.secondary_id));
+        }
+    }
+    return absl::OkStatus();
+}
+
 }  // namespace Dive::HostCli
@@ -22,6 +22,7 @@
 #include "dive_core/data_core.h"
 
 #include "absl/status/status.h"
+#include "gfxr_edit_script.h"
 
 namespace Dive::HostCli
 {
@@ -34,7 +35,15 @@ public:
     bool         IsGfxrLoaded() const;
     bool         IsDataCoreInitialized() const { return m_data_core != nullptr; }
     absl::Status LoadGfxrFile(const std::string& original_gfxr_file_path);
+    // Observe the vulkan commands during the next LoadGfxrFile(), see GfxrCaptureData
+    void AddGfxrLoadObserver(DiveAnnotationProcessor::FunctionObserver* observer);
     absl::Status WriteNewGfxrFile(const std::string& new_gfxr_file_path);
+    // Write the frame index built by LoadGfxrFile(), see DiveFrameIndex
+    absl::Status WriteFrameIndex(const std::string& frame_index_path);
+
+    // Replace the modifications of the loaded GFXR file with `edits`. The original blocks are only
+    // indexed once by LoadGfxrFile(), so several variants can be written from one load.
+    absl::Status ApplyGfxrEdits(const std::vector<GfxrEdit>& edits);
 
 private:
     std::unique_ptr<Dive::DataCore> m_data_core = nullptr;
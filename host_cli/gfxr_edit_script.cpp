@@ -0,0 +1,253 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "gfxr_edit_script.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <map>
+
+#include <nlohmann/json.hpp>
+
+#include "absl/strings/str_format.h"
+
+namespace Dive::HostCli
+{
+namespace
+{
+
+using BlobCache = std::map<std::string, std::shared_ptr<std::vector<char>>>;
+
+absl::StatusOr<std::shared_ptr<std::vector<char>>> ReadDataFile(const std::filesystem::path& path,
+                                                                BlobCache&                   cache)
+{
+    std::string key = path.lexically_normal().string();
+    auto        it = cache.find(key);
+    if (it != cache.end())
+    {
+        return it->second;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return absl::NotFoundError(absl::StrFormat("Could not open data file: %s", key));
+    }
+    auto blob = std::make_shared<std::vector<char>>(std::istreambuf_iterator<char>(file),
+                                                    std::istreambuf_iterator<char>());
+    cache[key] = blob;
+    return blob;
+}
+
+int HexDigitValue(char c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F')
+    {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+absl::StatusOr<std::shared_ptr<std::vector<char>>> ParseHex(const std::string& hex)
+{
+    if (hex.size() % 2 != 0)
+    {
+        return absl::InvalidArgumentError("data_hex must have an even number of digits");
+    }
+    auto blob = std::make_shared<std::vector<char>>();
+    blob->reserve(hex.size() / 2);
+    for (size_t i = 0; i < hex.size(); i += 2)
+    {
+        int high = HexDigitValue(hex[i]);
+        int low = HexDigitValue(hex[i + 1]);
+        if (high < 0 || low < 0)
+        {
+            return absl::InvalidArgumentError(
+            absl::StrFormat("Invalid hex digits in data_hex: %s", hex.substr(i, 2)));
+        }
+        blob->push_back(static_cast<char>((high << 4) | low));
+    }
+    return blob;
+}
+
+// Whether `value` is an integer within the range of T
+template<typename T> bool IsNumberInRange(const nlohmann::json& value)
+{
+    if (value.is_number_unsigned())
+    {
+        return value.get<uint64_t>() <= static_cast<uint64_t>(std::numeric_limits<T>::max());
+    }
+    if (value.is_number_integer())
+    {
+        int64_t number = value.get<int64_t>();
+        return number >= static_cast<int64_t>(std::numeric_limits<T>::min()) &&
+               number <= static_cast<int64_t>(std::numeric_limits<T>::max());
+    }
+    return false;
+}
+
+absl::StatusOr<GfxrEdit> ParseEdit(const nlohmann::json&        edit_json,
+                                   const std::filesystem::path& base_dir,
+                                   BlobCache&                   cache)
+{
+    if (!edit_json.is_object() || !edit_json.contains("block") ||
+        !IsNumberInRange<uint32_t>(edit_json["block"]))
+    {
+        return absl::InvalidArgumentError(
+        "Each edit must have a \"block\" index between 0 and 4294967295");
+    }
+
+    GfxrEdit edit;
+    edit.primary_id = edit_json["block"].get<uint32_t>();
+    if (edit_json.contains("position"))
+    {
+        if (!IsNumberInRange<int32_t>(edit_json["position"]))
+        {
+            return absl::InvalidArgumentError(
+            absl::StrFormat("Position of the edit of block %d must be a 32-bit integer",
+                            edit.primary_id));
+        }
+        edit.secondary_id = edit_json["position"].get<int32_t>();
+    }
+
+    bool is_delete = false;
+    if (edit_json.contains("delete"))
+    {
+        if (!edit_json["delete"].is_boolean())
+        {
+            return absl::InvalidArgumentError(
+            absl::StrFormat("\"delete\" of the edit of block %d must be a boolean",
+                            edit.primary_id));
+        }
+        is_delete = edit_json["delete"].get<bool>();
+    }
+    for (const char* key : { "data_file", "data_hex" })
+    {
+        if (edit_json.contains(key) && !edit_json[key].is_string())
+        {
+            return absl::InvalidArgumentError(
+            absl::StrFormat("\"%s\" of the edit of block %d must be a string",
+                            key,
+                            edit.primary_id));
+        }
+    }
+
+    int data_count = edit_json.contains("data_file") + edit_json.contains("data_hex");
+    if (is_delete)
+    {
+        if (data_count != 0 || edit.secondary_id != 0)
+        {
+            return absl::InvalidArgumentError(
+            absl::StrFormat("Deletion of block %d cannot have data or a position",
+                            edit.primary_id));
+        }
+        return edit;
+    }
+    if (data_count != 1)
+    {
+        return absl::InvalidArgumentError(
+        absl::StrFormat("Edit of block %d needs exactly one of data_file or data_hex",
+                        edit.primary_id));
+    }
+
+    absl::StatusOr<std::shared_ptr<std::vector<char>>> blob;
+    if (edit_json.contains("data_file"))
+    {
+        blob = ReadDataFile(base_dir / edit_json["data_file"].get<std::string>(), cache);
+    }
+    else
+    {
+        blob = ParseHex(edit_json["data_hex"].get<std::string>());
+    }
+    if (!blob.ok())
+    {
+        return blob.status();
+    }
+    if ((*blob)->empty())
+    {
+        return absl::InvalidArgumentError(
+        absl::StrFormat("Edit of block %d has no data", edit.primary_id));
+    }
+    edit.blob = *std::move(blob);
+    return edit;
+}
+
+}  // namespace
+
+absl::StatusOr<std::vector<GfxrEditVariant>> ParseGfxrEditScript(const std::string& script_path)
+{
+    std::ifstream script_file(script_path);
+    if (!script_file)
+    {
+        return absl::NotFoundError(absl::StrFormat("Could not open edit script: %s", script_path));
+    }
+
+    nlohmann::json script = nlohmann::json::parse(script_file, nullptr, /*allow_exceptions=*/false);
+    if (script.is_discarded() || !script.is_object() || !script.contains("variants") ||
+        !script["variants"].is_array())
+    {
+        return absl::InvalidArgumentError(
+        absl::StrFormat("Edit script must be a JSON object with a \"variants\" array: %s",
+                        script_path));
+    }
+
+    std::filesystem::path        base_dir = std::filesystem::path(script_path).parent_path();
+    BlobCache                    cache;
+    std::vector<GfxrEditVariant> variants;
+    for (const nlohmann::json& variant_json : script["variants"])
+    {
+        if (!variant_json.is_object() || !variant_json.contains("output") ||
+            !variant_json["output"].is_string())
+        {
+            return absl::InvalidArgumentError("Each variant must have an \"output\" path");
+        }
+
+        GfxrEditVariant variant;
+        variant.output_path = (base_dir / variant_json["output"].get<std::string>()).string();
+        if (variant_json.contains("edits"))
+        {
+            if (!variant_json["edits"].is_array())
+            {
+                return absl::InvalidArgumentError(
+                absl::StrFormat("\"edits\" of variant %s must be an array",
+                                variant.output_path));
+            }
+            for (const nlohmann::json& edit_json : variant_json["edits"])
+            {
+                absl::StatusOr<GfxrEdit> edit = ParseEdit(edit_json, base_dir, cache);
+                if (!edit.ok())
+                {
+                    return edit.status();
+                }
+                variant.edits.push_back(*std::move(edit));
+            }
+        }
+        variants.push_back(std::move(variant));
+    }
+    return variants;
+}
+
+}  // namespace Dive::HostCli
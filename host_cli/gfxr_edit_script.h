@@ -0,0 +1,67 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/status/statusor.h"
+
+namespace Dive::HostCli
+{
+
+// A block-level edit of a GFXR file, see DiveBlockData::AddModification()
+struct GfxrEdit
+{
+    // Index of the original block the edit is anchored to
+    uint32_t primary_id = 0;
+    // Position relative to the original block: negative before, 0 replaces it, positive after
+    int32_t secondary_id = 0;
+    // Encoded block(s) to write, or nullptr to delete the original block
+    std::shared_ptr<std::vector<char>> blob = nullptr;
+};
+
+// A GFXR file to generate from the original file and a set of edits
+struct GfxrEditVariant
+{
+    std::string           output_path;
+    std::vector<GfxrEdit> edits;
+};
+
+// Parse a JSON edit script, which describes variants of a GFXR file:
+//
+//  {
+//    "variants": [
+//      {
+//        "output": "no_draw.gfxr",
+//        "edits": [
+//          { "block": 1200, "delete": true },
+//          { "block": 1300, "position": -1, "data_file": "marker.bin" },
+//          { "block": 1300, "position": 0, "data_hex": "0a0b0c0d" }
+//        ]
+//      }
+//    ]
+//  }
+//
+// "position" defaults to 0. The data of an edit is the raw encoded block(s), either read from
+// "data_file" or given in hex by "data_hex". Relative paths are relative to the directory of the
+// script. A data file used by several edits is only read once, and its data is shared.
+absl::StatusOr<std::vector<GfxrEditVariant>> ParseGfxrEditScript(const std::string& script_path);
+
+}  // namespace Dive::HostCli
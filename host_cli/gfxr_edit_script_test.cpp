@@ -0,0 +1,151 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "gfxr_edit_script.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+namespace Dive::HostCli
+{
+namespace
+{
+
+std::string WriteTempFile(const std::string& name, const std::string& contents)
+{
+    std::string path = (std::filesystem::temp_directory_path() / name).string();
+    std::ofstream(path, std::ios::binary) << contents;
+    return path;
+}
+
+TEST(GfxrEditScriptTest, ParsesVariants)
+{
+    std::string data_path = WriteTempFile("gfxr_edit_script_marker.bin", "marker");
+    std::string script_path = WriteTempFile("gfxr_edit_script_variants.json", R"({
+        "variants": [
+            {
+                "output": "variant_0.gfxr",
+                "edits": [
+                    { "block": 12, "delete": true },
+                    { "block": 20, "position": -1, "data_file": "gfxr_edit_script_marker.bin" },
+                    { "block": 30, "data_hex": "0aFf" }
+                ]
+            },
+            {
+                "output": "variant_1.gfxr",
+                "edits": [
+                    { "block": 40, "position": 2, "data_file": "gfxr_edit_script_marker.bin" }
+                ]
+            }
+        ]
+    })");
+
+    absl::StatusOr<std::vector<GfxrEditVariant>> variants = ParseGfxrEditScript(script_path);
+    std::filesystem::remove(data_path);
+    std::filesystem::remove(script_path);
+    ASSERT_TRUE(variants.ok());
+    ASSERT_EQ(variants->size(), 2u);
+
+    const GfxrEditVariant& variant_0 = (*variants)[0];
+    EXPECT_EQ(variant_0.output_path,
+              (std::filesystem::temp_directory_path() / "variant_0.gfxr").string());
+    ASSERT_EQ(variant_0.edits.size(), 3u);
+    EXPECT_EQ(variant_0.edits[0].primary_id, 12u);
+    EXPECT_EQ(variant_0.edits[0].secondary_id, 0);
+    EXPECT_EQ(variant_0.edits[0].blob, nullptr);
+    EXPECT_EQ(variant_0.edits[1].primary_id, 20u);
+    EXPECT_EQ(variant_0.edits[1].secondary_id, -1);
+    ASSERT_NE(variant_0.edits[1].blob, nullptr);
+    EXPECT_EQ(std::string(variant_0.edits[1].blob->begin(), variant_0.edits[1].blob->end()),
+              "marker");
+    ASSERT_NE(variant_0.edits[2].blob, nullptr);
+    EXPECT_EQ(*variant_0.edits[2].blob, std::vector<char>({ 0x0a, static_cast<char>(0xff) }));
+
+    // The data file is read once and shared by the variants
+    const GfxrEditVariant& variant_1 = (*variants)[1];
+    ASSERT_EQ(variant_1.edits.size(), 1u);
+    EXPECT_EQ(variant_1.edits[0].secondary_id, 2);
+    EXPECT_EQ(variant_1.edits[0].blob, variant_0.edits[1].blob);
+}
+
+TEST(GfxrEditScriptTest, RejectsInvalidEdits)
+{
+    const char* invalid_edits[] = {
+        R"({ "delete": true })",
+        R"({ "block": 1, "position": 1, "delete": true })",
+        R"({ "block": 1 })",
+        R"({ "block": 1, "data_hex": "abc" })",
+        R"({ "block": 1, "data_hex": "zz" })",
+        R"({ "block": 1, "data_file": "gfxr_edit_script_missing.bin" })",
+        // Wrong types and out of range values
+        R"({ "block": 4294967296, "data_hex": "00" })",
+        R"({ "block": 1.5, "data_hex": "00" })",
+        R"({ "block": 1, "position": "1", "data_hex": "00" })",
+        R"({ "block": 1, "position": 2147483648, "data_hex": "00" })",
+        R"({ "block": 1, "position": -2147483649, "data_hex": "00" })",
+        R"({ "block": 1, "delete": 1 })",
+        R"({ "block": 1, "data_file": 1 })",
+        R"({ "block": 1, "data_hex": [ 0 ] })",
+    };
+    for (const char* invalid_edit : invalid_edits)
+    {
+        std::string script = std::string(R"({ "variants": [ { "output": "o", "edits": [ )") +
+                             invalid_edit + " ] } ] }";
+        std::string script_path = WriteTempFile("gfxr_edit_script_invalid.json", script);
+        EXPECT_FALSE(ParseGfxrEditScript(script_path).ok());
+        std::filesystem::remove(script_path);
+    }
+}
+
+TEST(GfxrEditScriptTest, AcceptsPositionRange)
+{
+    std::string script_path = WriteTempFile("gfxr_edit_script_range.json", R"({
+        "variants": [
+            {
+                "output": "o",
+                "edits": [
+                    { "block": 4294967295, "position": -2147483648, "data_hex": "00" },
+                    { "block": 0, "position": 2147483647, "data_hex": "00" }
+                ]
+            }
+        ]
+    })");
+    absl::StatusOr<std::vector<GfxrEditVariant>> variants = ParseGfxrEditScript(script_path);
+    std::filesystem::remove(script_path);
+    ASSERT_TRUE(variants.ok());
+    ASSERT_EQ((*variants)[0].edits.size(), 2u);
+    EXPECT_EQ((*variants)[0].edits[0].primary_id, 4294967295u);
+    EXPECT_EQ((*variants)[0].edits[0].secondary_id, -2147483647 - 1);
+    EXPECT_EQ((*variants)[0].edits[1].secondary_id, 2147483647);
+}
+
+TEST(GfxrEditScriptTest, RejectsMalformedScript)
+{
+    std::string script_path = WriteTempFile("gfxr_edit_script_malformed.json", "{ \"variants\": ");
+    EXPECT_FALSE(ParseGfxrEditScript(script_path).ok());
+    std::filesystem::remove(script_path);
+    EXPECT_FALSE(ParseGfxrEditScript(script_path).ok());
+
+    script_path = WriteTempFile("gfxr_edit_script_malformed.json",
+                                R"({ "variants": [ { "output": "o", "edits": 1 } ] })");
+    EXPECT_FALSE(ParseGfxrEditScript(script_path).ok());
+    std::filesystem::remove(script_path);
+}
+
+}  // namespace
+}  // namespace Dive::HostCli
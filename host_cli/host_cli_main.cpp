@@ -18,7 +18,9 @@
 // and the old cli will be deprecated
 
 #include <filesystem>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "absl/flags/flag.h"
 #include "absl/flags/parse.h"
@@ -29,6 +31,8 @@
 
 #include "common/dive_version.h"
 #include "data_core_wrapper.h"
+#include "gfxr_dump_resources/dump_entry_finder.h"
+#include "gfxr_dump_resources/gfxr_dump_resources.h"
 
 namespace
 {
@@ -47,6 +51,25 @@ ABSL_FLAG(std::string,
           "",
           "If specified, a new .gfxr file will be generated from the original file "
           "(--input_file_path) and any specified modifications");
+ABSL_FLAG(std::string,
+          gfxr_edit_script,
+          "",
+          "If specified, a JSON edit script describing variants of the .gfxr file "
+          "(--input_file_path). The file is loaded once and each variant is written to its own "
+          "output path with its block-level edits applied. See host_cli/gfxr_edit_script.h for "
+          "the format");
+ABSL_FLAG(std::string,
+          frame_index_path,
+          "",
+          "If specified, the frame index of the loaded .gfxr file (--input_file_path) is written to "
+          "this path. Push it next to the capture on the device, as <capture>.gfxr.frame_index, to "
+          "replay a range of frames with the GFXR replay flag --loop-frame-range");
+ABSL_FLAG(std::vector<std::string>,
+          dump_resources_plans,
+          {},
+          "If specified, a comma-separated list of PLAN=OUTPUT.JSON. The dumpable resources of the "
+          "loaded .gfxr file (--input_file_path) are found while loading it, and a JSON file for "
+          "GFXR --dump-resources is written for each plan. See gfxr_dump_resources for the plans");
 
 absl::Status ValidateFlags()
 {
@@ -78,6 +101,95 @@ absl::Status ValidateFlags()
         }
     }
 
+    std::string gfxr_edit_script = absl::GetFlag(FLAGS_gfxr_edit_script);
+    if (!gfxr_edit_script.empty())
+    {
+        if (input_file_ext != ".gfxr")
+        {
+            return absl::InvalidArgumentError(
+            "if --gfxr_edit_script is specified, then --input_file_path must also be specified for "
+            "a .gfxr file");
+        }
+    }
+
+    std::string frame_index_path = absl::GetFlag(FLAGS_frame_index_path);
+    if (!frame_index_path.empty())
+    {
+        if (input_file_ext != ".gfxr")
+        {
+            return absl::InvalidArgumentError(
+            "if --frame_index_path is specified, then --input_file_path must also be specified for "
+            "a .gfxr file");
+        }
+    }
+
+    std::vector<std::string> dump_resources_plans = absl::GetFlag(FLAGS_dump_resources_plans);
+    if (!dump_resources_plans.empty())
+    {
+        if (input_file_ext != ".gfxr")
+        {
+            return absl::InvalidArgumentError(
+            "if --dump_resources_plans is specified, then --input_file_path must also be specified "
+            "for a .gfxr file");
+        }
+        for (const std::string &plan : dump_resources_plans)
+        {
+            if (!Dive::gfxr::ParseDumpPlan(plan).has_value())
+            {
+                return absl::InvalidArgumentError(
+                absl::StrFormat("invalid plan in --dump_resources_plans: %s", plan));
+            }
+        }
+    }
+
+    return absl::OkStatus();
+}
+
+// Write the dump resources JSON of each plan
+absl::Status WriteDumpResourcesPlans(const std::vector<Dive::gfxr::DumpEntry> &dumpables,
+                                     const std::vector<std::string>           &plans)
+{
+    for (const std::string &plan_flag : plans)
+    {
+        Dive::gfxr::DumpPlan plan = *Dive::gfxr::ParseDumpPlan(plan_flag);
+        if (!Dive::gfxr::SaveAsJsonFile(Dive::gfxr::ApplyDumpPlan(dumpables, plan),
+                                        plan.output_path.c_str()))
+        {
+            return absl::InternalError(
+            absl::StrFormat("Could not write dump resources: %s", plan.output_path));
+        }
+        std::cout << "Wrote " << plan.output_path << std::endl;
+    }
+    return absl::OkStatus();
+}
+
+// Write each variant of the edit script from the loaded .gfxr file
+absl::Status WriteGfxrEditVariants(Dive::HostCli::DataCoreWrapper &data_core,
+                                   const std::string              &script_path)
+{
+    absl::StatusOr<std::vector<Dive::HostCli::GfxrEditVariant>> variants =
+    Dive::HostCli::ParseGfxrEditScript(script_path);
+    if (!variants.ok())
+    {
+        return variants.status();
+    }
+
+    for (const Dive::HostCli::GfxrEditVariant &variant : *variants)
+    {
+        absl::Status res = data_core.ApplyGfxrEdits(variant.edits);
+        if (!res.ok())
+        {
+            return absl::Status(res.code(),
+                                absl::StrCat(variant.output_path, ": ", res.message()));
+        }
+        res = data_core.WriteNewGfxrFile(variant.output_path);
+        if (!res.ok())
+        {
+            return res;
+        }
+        std::cout << "Wrote " << variant.output_path << " (" << variant.edits.size() << " edits)"
+                  << std::endl;
+    }
     return absl::OkStatus();
 }
 
@@ -123,6 +235,18 @@ int main(int argc, char **argv)
     std::filesystem::path input_file_path = absl::GetFlag(FLAGS_input_file_path);
     if (input_file_path.extension().string() == ".gfxr")
     {
+        // The dumpable resources are found during the load, which already decodes the commands
+        std::vector<std::string> dump_resources_plans = absl::GetFlag(FLAGS_dump_resources_plans);
+        std::vector<Dive::gfxr::DumpEntry> dumpables;
+        Dive::gfxr::DumpEntryFinder        dump_entry_finder(
+        [&dumpables](Dive::gfxr::DumpEntry dump_entry) {
+            dumpables.push_back(std::move(dump_entry));
+        });
+        if (!dump_resources_plans.empty())
+        {
+            data_core.AddGfxrLoadObserver(&dump_entry_finder);
+        }
+
         absl::Status res = data_core.LoadGfxrFile(input_file_path.string());
         if (!res.ok())
         {
@@ -130,6 +254,35 @@ int main(int argc, char **argv)
             return 1;
         }
 
+        res = WriteDumpResourcesPlans(dumpables, dump_resources_plans);
+        if (!res.ok())
+        {
+            std::cout << res << std::endl;
+            return 1;
+        }
+
+        std::string frame_index_path = absl::GetFlag(FLAGS_frame_index_path);
+        if (!frame_index_path.empty())
+        {
+            res = data_core.WriteFrameIndex(frame_index_path);
+            if (!res.ok())
+            {
+                std::cout << res << std::endl;
+                return 1;
+            }
+        }
+
+        std::string gfxr_edit_script = absl::GetFlag(FLAGS_gfxr_edit_script);
+        if (!gfxr_edit_script.empty())
+        {
+            res = WriteGfxrEditVariants(data_core, gfxr_edit_script);
+            if (!res.ok())
+            {
+                std::cout << res << std::endl;
+                return 1;
+            }
+        }
+
         std::string output_gfxr_path = absl::GetFlag(FLAGS_output_gfxr_path);
         if (output_gfxr_path.empty())
         {
@@ -137,7 +290,12 @@ int main(int argc, char **argv)
             return 0;
         }
 
-        res = data_core.WriteNewGfxrFile(output_gfxr_path);
+        // Written without the edits of the variants, if any
+        res = data_core.ApplyGfxrEdits({});
+        if (res.ok())
+        {
+            res = data_core.WriteNewGfxrFile(output_gfxr_path);
+        }
         if (!res.ok())
         {
             std::cout << res << std::endl;
@@ -0,0 +1,442 @@
+/*
+ Copyright 2025 Google LLC
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+// Python module "dive": loads captures and exposes their command hierarchy, events, event state
+// and perf metrics as NumPy arrays, for vectorized analyses in notebooks.
+//
+// The arrays are read-only views of the parsed capture, not copies: their base object is the
+// Capture (or PerfMetrics) they come from, which stays alive as long as any of its arrays does.
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "dive_core/available_metrics.h"
+#include "dive_core/command_hierarchy.h"
+#include "dive_core/data_core.h"
+#include "dive_core/event_state_fields.h"
+#include "dive_core/perf_metrics_data.h"
+#include "pm4_info.h"
+
+namespace py = pybind11;
+
+namespace Dive
+{
+namespace python
+{
+namespace
+{
+
+//--------------------------------------------------------------------------------------------------
+// Read-only array of `size` elements at `data`, `stride` bytes apart, which keeps `owner` alive.
+// Enums are exposed as their underlying integer type.
+template<typename T>
+py::array MakeArrayView(const T* data, size_t size, size_t stride, py::handle owner)
+{
+    using ElementType = typename std::conditional_t<std::is_enum_v<T>,
+                                                    std::underlying_type<T>,
+                                                    std::type_identity<T>>::type;
+    static_assert(sizeof(ElementType) == sizeof(T), "Unexpected size!");
+
+    py::array array(py::dtype::of<ElementType>(),
+                    { static_cast<py::ssize_t>(size) },
+                    { static_cast<py::ssize_t>(stride) },
+                    size != 0 ? data : nullptr,
+                    owner);
+    py::detail::array_proxy(array.ptr())->flags &= ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+    return array;
+}
+
+template<typename T> py::array MakeArrayView(const T* data, size_t size, py::handle owner)
+{
+    return MakeArrayView(data, size, sizeof(T), owner);
+}
+
+//--------------------------------------------------------------------------------------------------
+// A loaded and parsed capture. Immutable, so the arrays pointing into it stay valid.
+class Capture
+{
+public:
+    Capture() :
+        m_data_core(std::make_unique<DataCore>(nullptr))
+    {
+    }
+
+    void Load(const std::string& file_name, bool use_analysis_cache)
+    {
+        m_file_name = file_name;
+        m_data_core->SetAnalysisCacheEnabled(use_analysis_cache);
+        if (m_data_core->LoadPm4CaptureData(file_name) != CaptureData::LoadResult::kSuccess)
+        {
+            throw std::runtime_error("Can't load " + file_name);
+        }
+        if (!m_data_core->ParsePm4CaptureData())
+        {
+            throw std::runtime_error("Can't parse " + file_name);
+        }
+    }
+
+    const std::string&      GetFileName() const { return m_file_name; }
+    const CaptureMetadata&  GetMetadata() const { return m_data_core->GetCaptureMetadata(); }
+    const CommandHierarchy& GetCommandHierarchy() const
+    {
+        return GetMetadata().m_command_hierarchy;
+    }
+
+    const SharedNodeTopology& GetTopology(const std::string& topology) const
+    {
+        if (topology == "all_event")
+        {
+            return GetCommandHierarchy().GetAllEventHierarchyTopology();
+        }
+        if (topology == "submit")
+        {
+            return GetCommandHierarchy().GetSubmitHierarchyTopology();
+        }
+        throw py::value_error("Unknown topology " + topology + ", expected all_event or submit");
+    }
+
+private:
+    std::string               m_file_name;
+    std::unique_ptr<DataCore> m_data_core;
+};
+
+//--------------------------------------------------------------------------------------------------
+// The scalar fields of EventStateInfo (see DIVE_EVENT_STATE_SCALAR_FIELDS)
+struct EventStateField
+{
+    const char* m_name;
+    py::array (*m_values)(const EventStateInfo& state, py::handle owner);
+    bool (*m_is_set)(const EventStateInfo& state, EventStateId id);
+};
+
+#define DIVE_PY_STATE_FIELD(field)                                                                 \
+    {                                                                                              \
+        #field,                                                                                    \
+        [](const EventStateInfo& state, py::handle owner) {                                        \
+            return MakeArrayView(state.field##Ptr(), state.size(), owner);                         \
+        },                                                                                         \
+        [](const EventStateInfo& state, EventStateId id) { return state.Is##field##Set(id); }      \
+    },
+
+const EventStateField kEventStateFields[] = {
+    DIVE_EVENT_STATE_SCALAR_FIELDS(DIVE_PY_STATE_FIELD)
+};
+
+#undef DIVE_PY_STATE_FIELD
+
+const EventStateField& GetEventStateField(const std::string& name)
+{
+    for (const EventStateField& field : kEventStateFields)
+    {
+        if (name == field.m_name)
+        {
+            return field;
+        }
+    }
+    throw py::key_error("Unknown event state field " + name);
+}
+
+//--------------------------------------------------------------------------------------------------
+// The computed perf metrics records of a capture (one per draw), laid out by column so that each
+// column is a contiguous array
+class PerfMetrics
+{
+public:
+    explicit PerfMetrics(const PerfMetricsDataProvider& provider)
+    {
+        const std::vector<PerfMetricsRecord>& records = provider.GetComputedRecords();
+        m_num_records = records.size();
+        m_metric_names = provider.GetMetricsNames();
+        m_ids.resize(kNumIdColumns * m_num_records);
+        m_draw_indices.resize(m_num_records);
+        m_values.resize(m_metric_names.size() * m_num_records);
+        for (size_t i = 0; i < m_num_records; ++i)
+        {
+            const PerfMetricsRecord& record = records[i];
+            const uint64_t           ids[kNumIdColumns] = { record.m_context_id,
+                                                            record.m_process_id,
+                                                            record.m_frame_id,
+                                                            record.m_cmd_buffer_id,
+                                                            record.m_draw_id,
+                                                            record.m_draw_type,
+                                                            record.m_draw_label,
+                                                            record.m_program_id,
+                                                            record.m_lrz_state };
+            for (size_t column = 0; column < kNumIdColumns; ++column)
+            {
+                m_ids[column * m_num_records + i] = ids[column];
+            }
+            std::optional<uint64_t> draw_index = provider.GetDrawIndexFromComputedRecordIndex(i);
+            m_draw_indices[i] = draw_index ? static_cast<int64_t>(*draw_index) : -1;
+            size_t num_values = std::min(record.m_metric_values.size(), m_metric_names.size());
+            for (size_t metric = 0; metric < num_values; ++metric)
+            {
+                m_values[metric * m_num_records + i] = record.m_metric_values[metric];
+            }
+        }
+    }
+
+    // Columns by name, to build a pandas.DataFrame from
+    py::dict GetColumns(py::handle owner) const
+    {
+        py::dict columns;
+        columns["draw_index"] = MakeArrayView(m_draw_indices.data(), m_num_records, owner);
+        for (size_t column = 0; column < kNumIdColumns; ++column)
+        {
+            columns[py::str(kFixedHeaders[column])] = MakeArrayView(m_ids.data() +
+                                                                    column * m_num_records,
+                                                                    m_num_records,
+                                                                    owner);
+        }
+        for (size_t metric = 0; metric < m_metric_names.size(); ++metric)
+        {
+            columns[py::str(m_metric_names[metric])] = MakeArrayView(m_values.data() +
+                                                                     metric * m_num_records,
+                                                                     m_num_records,
+                                                                     owner);
+        }
+        return columns;
+    }
+
+    size_t                          GetNumRecords() const { return m_num_records; }
+    const std::vector<std::string>& GetMetricNames() const { return m_metric_names; }
+
+private:
+    static constexpr size_t kNumIdColumns = kFixedPerfMetricsDataHeaderCount;
+
+    size_t                   m_num_records = 0;
+    std::vector<std::string> m_metric_names;
+    std::vector<uint64_t>    m_ids;           // kNumIdColumns columns of m_num_records
+    std::vector<int64_t>     m_draw_indices;  // -1 if not correlated with a draw of the capture
+    std::vector<double>      m_values;        // One column of m_num_records per metric
+};
+
+std::unique_ptr<PerfMetrics> LoadPerfMetrics(const Capture&     capture,
+                                             const std::string& perf_counters_file,
+                                             const std::string& metrics_description_file)
+{
+    std::unique_ptr<AvailableMetrics> available_metrics = AvailableMetrics::LoadFromCsv(
+    metrics_description_file);
+    if (!available_metrics)
+    {
+        throw std::runtime_error("Can't load " + metrics_description_file);
+    }
+    std::unique_ptr<PerfMetricsData> data = PerfMetricsData::LoadFromCsv(perf_counters_file,
+                                                                         *available_metrics);
+    if (!data)
+    {
+        throw std::runtime_error("Can't load " + perf_counters_file);
+    }
+
+    // The metric infos of `data` point into available_metrics, which outlives the provider
+    std::unique_ptr<PerfMetricsDataProvider> provider = PerfMetricsDataProvider::Create(
+    std::move(data));
+    provider->Analyze(&capture.GetCommandHierarchy());
+    return std::make_unique<PerfMetrics>(*provider);
+}
+
+}  // namespace
+
+}  // namespace python
+}  // namespace Dive
+
+//--------------------------------------------------------------------------------------------------
+PYBIND11_MODULE(dive, m)
+{
+    using namespace Dive;
+    using namespace Dive::python;
+
+    m.doc() = "Dive capture analysis";
+
+    Pm4InfoInit();
+
+    py::enum_<NodeType>(m, "NodeType", py::arithmetic())
+    .value("kRootNode", NodeType::kRootNode)
+    .value("kEngineNode", NodeType::kEngineNode)
+    .value("kSubmitNode", NodeType::kSubmitNode)
+    .value("kIbNode", NodeType::kIbNode)
+    .value("kMarkerNode", NodeType::kMarkerNode)
+    .value("kDrawDispatchNode", NodeType::kDrawDispatchNode)
+    .value("kBlitNode", NodeType::kBlitNode)
+    .value("kSyncNode", NodeType::kSyncNode)
+    .value("kPostambleStateNode", NodeType::kPostambleStateNode)
+    .value("kPacketNode", NodeType::kPacketNode)
+    .value("kRegNode", NodeType::kRegNode)
+    .value("kFieldNode", NodeType::kFieldNode)
+    .value("kPresentNode", NodeType::kPresentNode)
+    .value("kRenderMarkerNode", NodeType::kRenderMarkerNode);
+
+    py::enum_<EventInfo::EventType>(m, "EventType", py::arithmetic())
+    .value("kDraw", EventInfo::EventType::kDraw)
+    .value("kDispatch", EventInfo::EventType::kDispatch)
+    .value("kBlit", EventInfo::EventType::kBlit)
+    .value("kColorSysMemToGmemResolve", EventInfo::EventType::kColorSysMemToGmemResolve)
+    .value("kColorGmemToSysMemResolve", EventInfo::EventType::kColorGmemToSysMemResolve)
+    .value("kColorGmemToSysMemResolveAndClear",
+           EventInfo::EventType::kColorGmemToSysMemResolveAndClear)
+    .value("kColorClearGmem", EventInfo::EventType::kColorClearGmem)
+    .value("kDepthSysMemToGmemResolve", EventInfo::EventType::kDepthSysMemToGmemResolve)
+    .value("kDepthGmemToSysMemResolve", EventInfo::EventType::kDepthGmemToSysMemResolve)
+    .value("kDepthGmemToSysMemResolveAndClear",
+           EventInfo::EventType::kDepthGmemToSysMemResolveAndClear)
+    .value("kDepthClearGmem", EventInfo::EventType::kDepthClearGmem)
+    .value("kSysmemToGmemResolve", EventInfo::EventType::kSysmemToGmemResolve)
+    .value("kWaitMemWrites", EventInfo::EventType::kWaitMemWrites)
+    .value("kWaitForIdle", EventInfo::EventType::kWaitForIdle)
+    .value("kWaitForMe", EventInfo::EventType::kWaitForMe)
+    .value("kEventWriteStart", EventInfo::EventType::kEventWriteStart)
+    .value("kEventWriteEnd", EventInfo::EventType::kEventWriteEnd);
+
+    py::class_<PerfMetrics>(m, "PerfMetrics")
+    .def_property_readonly("num_records", &PerfMetrics::GetNumRecords)
+    .def_property_readonly("metric_names", &PerfMetrics::GetMetricNames)
+    .def(
+    "columns",
+    [](py::object self) { return self.cast<const PerfMetrics&>().GetColumns(self); },
+    "Dict of column name to array: draw_index (-1 if not correlated), the record ids, then one "
+    "column per metric");
+
+    py::class_<Capture>(m, "Capture")
+    .def_property_readonly("file_name", &Capture::GetFileName)
+    .def_property_readonly("num_nodes",
+                           [](const Capture& self) { return self.GetCommandHierarchy().size(); })
+    .def_property_readonly("num_events",
+                           [](const Capture& self) {
+                               return self.GetMetadata().m_event_info.size();
+                           })
+    .def(
+    "node_types",
+    [](py::object self) {
+        const CommandHierarchy& hierarchy = self.cast<const Capture&>().GetCommandHierarchy();
+        return MakeArrayView(hierarchy.GetNodeTypes(), hierarchy.size(), self);
+    },
+    "NodeType of each node")
+    .def(
+    "node_parents",
+    [](py::object self, const std::string& topology_name) {
+        const SharedNodeTopology& topology = self.cast<const Capture&>().GetTopology(topology_name);
+        return MakeArrayView(topology.GetParentNodeIndices(), topology.GetNumNodes(), self);
+    },
+    "Parent node of each node in the topology, all_event or submit (UINT64_MAX for the root)",
+    py::arg("topology") = "all_event")
+    .def(
+    "node_child_indices",
+    [](py::object self, const std::string& topology_name) {
+        const SharedNodeTopology& topology = self.cast<const Capture&>().GetTopology(topology_name);
+        return MakeArrayView(topology.GetChildIndices(), topology.GetNumNodes(), self);
+    },
+    "Index of each node among the children of its parent in the topology",
+    py::arg("topology") = "all_event")
+    .def(
+    "node_description",
+    [](const Capture& self, uint64_t node_index) {
+        const CommandHierarchy& hierarchy = self.GetCommandHierarchy();
+        if (node_index >= hierarchy.size())
+        {
+            throw py::index_error("Invalid node index");
+        }
+        return std::string(hierarchy.GetNodeDesc(node_index));
+    },
+    py::arg("node_index"))
+    .def(
+    "event_node_indices",
+    [](py::object self) {
+        const DiveVector<uint64_t>& indices = self.cast<const Capture&>()
+                                              .GetCommandHierarchy()
+                                              .GetEventNodeIndices();
+        return MakeArrayView(indices.data(), indices.size(), self);
+    },
+    "Node of each event")
+    .def(
+    "events",
+    [](py::object self) {
+        const std::vector<EventInfo>& events = self.cast<const Capture&>()
+                                               .GetMetadata()
+                                               .m_event_info;
+        // Strided views of a field of the EventInfo array
+        auto view = [&](auto member) {
+            return MakeArrayView(events.empty() ? nullptr : &(events[0].*member),
+                                 events.size(),
+                                 sizeof(EventInfo),
+                                 self);
+        };
+        py::dict columns;
+        columns["type"] = view(&EventInfo::m_type);
+        columns["num_indices"] = view(&EventInfo::m_num_indices);
+        columns["submit_index"] = view(&EventInfo::m_submit_index);
+        columns["render_mode"] = view(&EventInfo::m_render_mode);
+        return columns;
+    },
+    "Dict of column name to array, one element per event: type (EventType), num_indices, "
+    "submit_index and render_mode")
+    .def(
+    "event_state",
+    [](py::object self) {
+        const EventStateInfo& state = self.cast<const Capture&>().GetMetadata().m_event_state;
+        py::dict              columns;
+        for (const EventStateField& field : kEventStateFields)
+        {
+            columns[field.m_name] = field.m_values(state, self);
+        }
+        return columns;
+    },
+    "Dict of EventStateInfo field name to array, one element per event. Enums are integers.")
+    .def(
+    "event_state_is_set",
+    [](const Capture& self, const std::string& name) {
+        // Not a view: the is-set bits of all the fields are interleaved
+        const EventStateInfo&  state = self.GetMetadata().m_event_state;
+        const EventStateField& field = GetEventStateField(name);
+        py::array_t<bool>      is_set(static_cast<py::ssize_t>(state.size()));
+        bool*                  data = is_set.mutable_data();
+        for (uint32_t id = 0; id < state.size(); ++id)
+        {
+            data[id] = field.m_is_set(state, EventStateId(id));
+        }
+        return is_set;
+    },
+    "Whether the field of the event state is set, for each event",
+    py::arg("field"))
+    .def("load_perf_metrics",
+         &LoadPerfMetrics,
+         "Load the perf counters csv of the capture, and correlate them with its draws",
+         py::arg("perf_counters_file"),
+         py::arg("metrics_description_file"),
+         py::call_guard<py::gil_scoped_release>());
+
+    m.def(
+    "load",
+    [](const std::string& file_name, bool use_analysis_cache) {
+        auto capture = std::make_unique<Capture>();
+        capture->Load(file_name, use_analysis_cache);
+        return capture;
+    },
+    "Load and parse a .rd or .dive capture. With use_analysis_cache, the parse is saved next to "
+    "the capture and the shader disassembly in the user cache directory, and reused on reload.",
+    py::arg("file_name"),
+    py::arg("use_analysis_cache") = false,
+    py::call_guard<py::gil_scoped_release>());
+}
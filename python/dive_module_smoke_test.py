@@ -0,0 +1,69 @@
+#
+# Copyright 2025 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+# Usage: dive_module_smoke_test.py <dir of the dive module> <.rd capture>
+#
+# Imports the built "dive" module and checks that the arrays of a loaded capture are consistent.
+
+import sys
+
+sys.path.insert(0, sys.argv[1])
+
+import dive
+import numpy as np
+
+
+def main(capture_file):
+    capture = dive.load(capture_file)
+    assert capture.num_events > 0, "No event"
+    assert capture.num_nodes > capture.num_events
+
+    node_types = capture.node_types()
+    assert len(node_types) == capture.num_nodes
+    assert not node_types.flags.writeable
+    assert node_types[0] == int(dive.NodeType.kRootNode)
+
+    for topology in ("all_event", "submit"):
+        assert len(capture.node_parents(topology)) == capture.num_nodes
+        assert len(capture.node_child_indices(topology)) == capture.num_nodes
+
+    event_nodes = capture.event_node_indices()
+    assert len(event_nodes) == capture.num_events
+    assert np.all(event_nodes < capture.num_nodes)
+
+    events = capture.events()
+    assert all(len(column) == capture.num_events for column in events.values())
+    assert np.any(events["type"] == int(dive.EventType.kDraw)), "No draw"
+
+    event_state = capture.event_state()
+    assert all(len(column) == capture.num_events for column in event_state.values())
+    field = next(iter(event_state))
+    assert len(capture.event_state_is_set(field)) == capture.num_events
+
+    try:
+        capture.node_parents("unknown")
+        raise AssertionError("Unknown topology accepted")
+    except ValueError:
+        pass
+
+    print("%s: %d nodes, %d events" % (capture_file, capture.num_nodes, capture.num_events))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        print("usage: dive_module_smoke_test.py <dir of the dive module> <.rd capture>")
+        sys.exit(1)
+    main(sys.argv[2])
@@ -63,7 +63,8 @@ class DecodeAllocator
 
   private:
     static const size_t     kAllocatorBlockSize{ 64 * 1024 };
-    static DecodeAllocator* instance_;
+    // GOOGLE: One allocator per thread, so that blocks can be decoded on several threads at once
+    static thread_local DecodeAllocator* instance_;
 
     util::MonotonicAllocator allocator_;
     bool                     can_allocate_;
@@ -32,6 +32,7 @@
 #include "util/logging.h"
 #include "util/platform.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <memory>
@@ -653,7 +654,20 @@ bool FileProcessor::ProcessFunctionCall(const format::BlockHeader& block_header,
     {
         parameter_buffer_size -= sizeof(call_info.thread_id);
 
-        if (format::IsBlockCompressed(block_header.type))
+        // GOOGLE: [skip-unsupported-calls] No decoder needs the parameters
+        if (skip_unsupported_function_calls_ &&
+            std::none_of(decoders_.begin(), decoders_.end(), [call_id](ApiDecoder* decoder) {
+                return decoder->SupportsApiCall(call_id);
+            }))
+        {
+            success = SkipBytes(parameter_buffer_size);
+
+            if (!success)
+            {
+                HandleBlockReadError(kErrorReadingBlockData, "Failed to skip function call block data");
+            }
+        }
+        else if (format::IsBlockCompressed(block_header.type))
         {
             parameter_buffer_size -= sizeof(uncompressed_size);
             success = ReadBytes(&uncompressed_size, sizeof(uncompressed_size));
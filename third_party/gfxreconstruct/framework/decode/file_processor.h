@@ -134,6 +134,10 @@ class FileProcessor
         block_index_to_          = block_index_to;
     }
 
+    // GOOGLE: [skip-unsupported-calls] Skip the parameters of the function calls that no decoder supports, instead of
+    // reading and decompressing them. Not supported by PreloadFileProcessor, which does not read from the file.
+    void SetSkipUnsupportedFunctionCalls(bool skip) { skip_unsupported_function_calls_ = skip; }
+
   protected:
     bool ContinueDecoding();
 
@@ -287,6 +291,8 @@ class FileProcessor
     virtual void StoreBlockInfo() {}
 
     bool        run_without_decoders_ = false;
+    // GOOGLE: [skip-unsupported-calls]
+    bool skip_unsupported_function_calls_ = false;
     std::string absolute_path_;
 };
 
@@ -35,6 +35,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 GFXRECON_BEGIN_NAMESPACE(gfxrecon)
@@ -121,6 +122,12 @@ struct VulkanReplayOptions : public ReplayOptions
     // GOOGLE: [single-frame-looping]
     std::optional<uint64_t> loop_single_frame_count = std::nullopt;
 
+    // GOOGLE: [frame-range-looping] First and last frame to replay, looped like a single frame
+    std::optional<std::pair<uint64_t, uint64_t>> loop_frame_range = std::nullopt;
+
+    // GOOGLE: [replay-benchmark] Number of warmup frames and of measured frames of the benchmark
+    std::optional<std::pair<uint64_t, uint64_t>> benchmark_frames = std::nullopt;
+
     // GOOGLE: [enable-gpu-time]
     bool enable_gpu_time;
 };
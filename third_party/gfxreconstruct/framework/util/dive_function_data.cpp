@@ -27,7 +27,7 @@ uint32_t DiveFunctionData::GetCmdBufferIndex() const {
 uint64_t DiveFunctionData::GetBlockIndex() const{
     return m_block_index;
 }
-const nlohmann::ordered_json DiveFunctionData::GetArgs() const {
+const nlohmann::ordered_json& DiveFunctionData::GetArgs() const {
     return m_args;
 }
 
@@ -33,7 +33,8 @@ class DiveFunctionData
     const std::string& GetFunctionName() const;
     uint32_t GetCmdBufferIndex() const;
     uint64_t GetBlockIndex() const;
-    const nlohmann::ordered_json GetArgs() const;
+    // GOOGLE: Return a reference, copying the args of every command is expensive
+    const nlohmann::ordered_json& GetArgs() const;
 private:
     nlohmann::ordered_json m_args;
     uint64_t m_block_index;
@@ -154,6 +154,9 @@ void android_main(struct android_app* app)
                 gfxrecon::decode::VulkanReplayOptions          replay_options =
                     GetVulkanReplayOptions(arg_parser, filename, &tracked_object_info_table);
 
+                // GOOGLE: [replay-benchmark] Measures the replayed frames
+                std::shared_ptr<gfxrecon::decode::DiveReplayBenchmark> benchmark;
+
                 // GOOGLE: Pass replay options to DiveFileProcessor after initialization
                 if (use_dive_file_processor)
                 {
@@ -164,6 +167,28 @@ void android_main(struct android_app* app)
                     {
                         dive_file_processor->SetLoopSingleFrameCount(*(replay_options.loop_single_frame_count));
                     }
+                    // GOOGLE: [frame-range-looping] Jump to the frame range with the frame index of the capture
+                    if (replay_options.loop_frame_range.has_value())
+                    {
+                        // The index is not built on the device, it is pushed with the capture
+                        auto frame_index = std::make_shared<gfxrecon::decode::DiveFrameIndex>();
+                        if (!frame_index->Load(gfxrecon::decode::DiveFrameIndex::GetIndexFilePath(filename),
+                                               filename) ||
+                            !dive_file_processor->SetFrameRange(frame_index,
+                                                                replay_options.loop_frame_range->first,
+                                                                replay_options.loop_frame_range->second))
+                        {
+                            GFXRECON_LOG_WARNING("No usable frame index for %s, replaying all the frames",
+                                                 filename.c_str());
+                        }
+                    }
+                    // GOOGLE: [replay-benchmark] Loop the frames until the benchmark is complete
+                    if (replay_options.benchmark_frames.has_value())
+                    {
+                        benchmark = std::make_shared<gfxrecon::decode::DiveReplayBenchmark>(
+                            replay_options.benchmark_frames->first, replay_options.benchmark_frames->second);
+                        dive_file_processor->SetBenchmark(benchmark);
+                    }
                 }
 
                 file_processor->SetPrintBlockInfoFlag(replay_options.enable_print_block_info,
@@ -179,6 +204,8 @@ void android_main(struct android_app* app)
                 {
                     vulkan_replay_consumer.SetEnableGPUTime(replay_options.enable_gpu_time);
                 }
+                // GOOGLE: [replay-benchmark] Report the GPU time of the frames to the benchmark
+                vulkan_replay_consumer.SetBenchmark(benchmark);
 
                 ApiReplayOptions  api_replay_options;
                 ApiReplayConsumer api_replay_consumer;
@@ -299,6 +326,23 @@ void android_main(struct android_app* app)
                         GFXRECON_WRITE_CONSOLE("Unable to write GPU stats file");
                     }
                 }
+
+                // GOOGLE: [replay-benchmark] Save the benchmark reports
+                if (benchmark != nullptr)
+                {
+                    auto* dive_file_processor =
+                        dynamic_cast<gfxrecon::decode::DiveFileProcessor*>(file_processor.get());
+                    GFXRECON_ASSERT(dive_file_processor)
+                    if (!benchmark->IsComplete())
+                    {
+                        GFXRECON_WRITE_CONSOLE("Replay ended before the benchmark was complete");
+                    }
+                    if (!dive_file_processor->WriteFile("benchmark.json", benchmark->GetJsonReport()) ||
+                        !dive_file_processor->WriteFile("benchmark.csv", benchmark->GetCsvReport()))
+                    {
+                        GFXRECON_WRITE_CONSOLE("Unable to write benchmark reports");
+                    }
+                }
             }
         }
         catch (std::runtime_error& error)
@@ -50,7 +50,7 @@ const char kArguments[] =
     "skip-get-fence-ranges,--dump-resources,--dump-resources-scale,--dump-resources-"
     "image-format,--dump-resources-dir,"
     "--dump-resources-dump-color-attachment-index,--pbis,--pcj|--pipeline-creation-jobs,--save-pipeline-cache,--load-"
-    "pipeline-cache,--quit-after-frame,--loop-single-frame-count";
+    "pipeline-cache,--quit-after-frame,--loop-single-frame-count,--loop-frame-range,--benchmark";
 
 static void PrintUsage(const char* exe_name)
 {
@@ -103,6 +103,10 @@ static void PrintUsage(const char* exe_name)
 
     // GOOGLE: [single-frame-looping] Usage message
     GFXRECON_WRITE_CONSOLE("\t\t\t[--loop-single-frame-count <n>]");
+    // GOOGLE: [frame-range-looping] Usage message
+    GFXRECON_WRITE_CONSOLE("\t\t\t[--loop-frame-range <first>-<last>]");
+    // GOOGLE: [replay-benchmark] Usage message
+    GFXRECON_WRITE_CONSOLE("\t\t\t[--benchmark <warmup_frames>,<frames>]");
     // GOOGLE: [enable-gpu-time] Usage message
     GFXRECON_WRITE_CONSOLE("\t\t\t[--enable-gpu-time]");
 
@@ -218,6 +222,25 @@ static void PrintUsage(const char* exe_name)
     GFXRECON_WRITE_CONSOLE("          \t\t(replay a single frame), and 0 indicates looping infinitely ");
     GFXRECON_WRITE_CONSOLE("          \t\tuntil the app is forced to stop.");
 
+    // GOOGLE: [frame-range-looping] Usage message details
+    GFXRECON_WRITE_CONSOLE("  --loop-frame-range <first>-<last>");
+    GFXRECON_WRITE_CONSOLE("          \t\tOnly replay frames <first> to <last> (0-based, inclusive) of a ");
+    GFXRECON_WRITE_CONSOLE("          \t\tcapture with frame markers, jumping to <first> after the trimmed ");
+    GFXRECON_WRITE_CONSOLE("          \t\tstate is loaded. Requires the frame index of the capture, written ");
+    GFXRECON_WRITE_CONSOLE("          \t\tby Dive's host_cli --frame_index_path and pushed next to the ");
+    GFXRECON_WRITE_CONSOLE("          \t\tcapture as <capture>.gfxr.frame_index with adb push, which keeps ");
+    GFXRECON_WRITE_CONSOLE("          \t\tthe modification time the index is validated with. The range is ");
+    GFXRECON_WRITE_CONSOLE("          \t\tlooped like a single frame, see --loop-single-frame-count.");
+
+    // GOOGLE: [replay-benchmark] Usage message details
+    GFXRECON_WRITE_CONSOLE("  --benchmark <warmup_frames>,<frames>");
+    GFXRECON_WRITE_CONSOLE("          \t\tLoop the replayed frames until <warmup_frames> frames followed ");
+    GFXRECON_WRITE_CONSOLE("          \t\tby <frames> measured frames are replayed, then write the ");
+    GFXRECON_WRITE_CONSOLE("          \t\tpercentiles and confidence intervals of their wall, CPU and ");
+    GFXRECON_WRITE_CONSOLE("          \t\tGPU times (with --enable-gpu-time) to benchmark.json and ");
+    GFXRECON_WRITE_CONSOLE("          \t\tbenchmark.csv next to the capture. Cannot be used with ");
+    GFXRECON_WRITE_CONSOLE("          \t\t--loop-single-frame-count, the benchmark sets the loop count.");
+
     // GOOGLE: [enable-gpu-time] Usage message details
     GFXRECON_WRITE_CONSOLE("  --enable-gpu-time");
     GFXRECON_WRITE_CONSOLE("          \t\tWhen enabled, gpu time measurement will be enabled for replay.");
@@ -173,6 +173,12 @@ const char kDumpResourcesDumpUnusedVertexBindings[] = "--dump-resources-dump-unu
 // GOOGLE: [single-frame-looping]
 const char kLoopSingleFrameCount[] = "--loop-single-frame-count";
 
+// GOOGLE: [frame-range-looping]
+const char kLoopFrameRange[] = "--loop-frame-range";
+
+// GOOGLE: [replay-benchmark]
+const char kBenchmark[] = "--benchmark";
+
 // GOOGLE: [enable-gpu-time]
 const char kEnableGPUTime[] = "--enable-gpu-time";
 
@@ -934,6 +940,82 @@ static std::vector<int32_t> GetFilteredMsgs(const gfxrecon::util::ArgumentParser
     return msgs;
 }
 
+// GOOGLE: [frame-range-looping] Parse value for flag "--loop-frame-range", as <first>-<last>
+static std::optional<std::pair<uint64_t, uint64_t>> GetLoopFrameRange(const gfxrecon::util::ArgumentParser& arg_parser)
+{
+    const auto& value = arg_parser.GetArgumentValue(kLoopFrameRange);
+    if (value.empty())
+    {
+        return std::nullopt;
+    }
+
+    size_t separator = value.find('-');
+    if ((separator == std::string::npos) || (separator == 0) || (separator + 1 == value.size()) ||
+        (value.find_first_not_of("0123456789-") != std::string::npos) ||
+        (value.find('-', separator + 1) != std::string::npos))
+    {
+        GFXRECON_LOG_WARNING("Ignoring invalid '%s' value: '%s'", kLoopFrameRange, value.c_str());
+        return std::nullopt;
+    }
+
+    uint64_t first = 0;
+    uint64_t last  = 0;
+    try
+    {
+        first = std::stoull(value.substr(0, separator));
+        last  = std::stoull(value.substr(separator + 1));
+    }
+    catch (std::exception& e)
+    {
+        GFXRECON_LOG_WARNING(
+            "Ignoring invalid '%s' value: '%s', error: %s", kLoopFrameRange, value.c_str(), e.what());
+        return std::nullopt;
+    }
+    if (first > last)
+    {
+        GFXRECON_LOG_WARNING("Ignoring invalid '%s' empty range: '%s'", kLoopFrameRange, value.c_str());
+        return std::nullopt;
+    }
+    return std::make_pair(first, last);
+}
+
+// GOOGLE: [replay-benchmark] Parse value for flag "--benchmark", as <warmup_frames>,<frames>
+static std::optional<std::pair<uint64_t, uint64_t>> GetBenchmarkFrames(const gfxrecon::util::ArgumentParser& arg_parser)
+{
+    const auto& value = arg_parser.GetArgumentValue(kBenchmark);
+    if (value.empty())
+    {
+        return std::nullopt;
+    }
+
+    std::vector<std::string> values = gfxrecon::util::strings::SplitString(value, ',');
+    if ((values.size() != 2) || values[0].empty() || values[1].empty() ||
+        (value.find_first_not_of("0123456789,") != std::string::npos))
+    {
+        GFXRECON_LOG_WARNING("Ignoring invalid '%s' value: '%s'", kBenchmark, value.c_str());
+        return std::nullopt;
+    }
+
+    uint64_t warmup_frames = 0;
+    uint64_t frames        = 0;
+    try
+    {
+        warmup_frames = std::stoull(values[0]);
+        frames        = std::stoull(values[1]);
+    }
+    catch (std::exception& e)
+    {
+        GFXRECON_LOG_WARNING("Ignoring invalid '%s' value: '%s', error: %s", kBenchmark, value.c_str(), e.what());
+        return std::nullopt;
+    }
+    if (frames == 0)
+    {
+        GFXRECON_LOG_WARNING("Ignoring invalid '%s' value without frames: '%s'", kBenchmark, value.c_str());
+        return std::nullopt;
+    }
+    return std::make_pair(warmup_frames, frames);
+}
+
 // GOOGLE: [single-frame-looping] Parse value for flag "--loop-single-frame-count"
 static std::optional<uint64_t> GetLoopSingleFrameCount(const gfxrecon::util::ArgumentParser& arg_parser)
 {
@@ -1306,6 +1388,16 @@ GetVulkanReplayOptions(const gfxrecon::util::ArgumentParser&           arg_parse
         replay_options.enable_gpu_time = true;
     }
 
+    // GOOGLE: [frame-range-looping] Parse additional parameters
+    replay_options.loop_frame_range = GetLoopFrameRange(arg_parser);
+    if ((replay_options.preload_measurement_range) && (replay_options.loop_frame_range.has_value()))
+    {
+        GFXRECON_LOG_FATAL("Flag '%s' cannot be used with '%s'. Closing the program.",
+                           kPreloadMeasurementRangeOption,
+                           kLoopFrameRange);
+        abort();
+    }
+
     // GOOGLE: [single-frame-looping] Parse additional parameters
     replay_options.loop_single_frame_count = GetLoopSingleFrameCount(arg_parser);
     if ((replay_options.preload_measurement_range) && (replay_options.loop_single_frame_count.has_value()))
@@ -1316,6 +1408,24 @@ GetVulkanReplayOptions(const gfxrecon::util::ArgumentParser&           arg_parse
         abort();
     }
 
+    // GOOGLE: [replay-benchmark] Parse additional parameters
+    replay_options.benchmark_frames = GetBenchmarkFrames(arg_parser);
+    if ((replay_options.preload_measurement_range) && (replay_options.benchmark_frames.has_value()))
+    {
+        GFXRECON_LOG_FATAL("Flag '%s' cannot be used with '%s'. Closing the program.",
+                           kPreloadMeasurementRangeOption,
+                           kBenchmark);
+        abort();
+    }
+    if ((replay_options.loop_single_frame_count.has_value()) && (replay_options.benchmark_frames.has_value()))
+    {
+        GFXRECON_LOG_FATAL("Flag '%s' cannot be used with '%s', the benchmark loops the frames until it is "
+                           "complete. Closing the program.",
+                           kLoopSingleFrameCount,
+                           kBenchmark);
+        abort();
+    }
+
     return replay_options;
 }
 
@@ -16,112 +16,13 @@
 
 #include "trace_stats.h"
 
-#include <functional>
-#include <thread>
 #include <mutex>
-#include <condition_variable>
-#include <deque>
 
 #include "dive_core/event_state.h"
+#include "dive_core/thread_pool.h"
 
 namespace Dive
 {
-namespace
-{
-
-class ThreadPool
-{
-public:
-    ThreadPool() = default;
-    ThreadPool(const ThreadPool &) = delete;
-    ThreadPool &operator=(const ThreadPool &) = delete;
-    ~ThreadPool() { Stop(); }
-
-    void Run(std::function<void()> &&func)
-    {
-        {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            m_tasks.push_back(std::move(func));
-        }
-        m_condition_variable.notify_one();
-    }
-
-    void Start(unsigned int num_workers = 0)
-    {
-        num_workers = (num_workers > 0 ? num_workers : GetDefaultThreadCount());
-
-        std::unique_lock<std::mutex> lock(m_mutex);
-        m_running = true;
-        for (unsigned int i = static_cast<unsigned int>(m_workers.size()); i < num_workers; ++i)
-        {
-            m_workers.emplace_back([this]() { this->WorkerImpl(); });
-        }
-    }
-
-    void Stop()
-    {
-        std::deque<std::thread> workers;
-        {
-            std::unique_lock<std::mutex> lock(m_mutex);
-            if (!m_running)
-            {
-                return;
-            }
-            m_running = false;
-            std::swap(workers, m_workers);
-        }
-        m_condition_variable.notify_all();
-        for (std::thread &worker : workers)
-        {
-            worker.join();
-        }
-    }
-
-    static unsigned int SuggestedNumberOfWorkers(unsigned int task_count)
-    {
-        // We are still bottlenecked by the slowest disassembly task.
-        // 4x less worker than disassembly tasks seems be the point of diminishing return.
-        constexpr unsigned int kLoadFactor = 4;
-        return std::min<unsigned int>((task_count + kLoadFactor - 1) / kLoadFactor,
-                                      GetDefaultThreadCount());
-    }
-
-private:
-    std::function<void()> NextTask()
-    {
-        std::unique_lock<std::mutex> lock(m_mutex);
-        m_condition_variable.wait(lock, [this] { return !m_running || !m_tasks.empty(); });
-        if (!m_running || m_tasks.empty())
-        {
-            return {};
-        }
-        std::function<void()> result = m_tasks.front();
-        m_tasks.pop_front();
-        return result;
-    }
-
-    static unsigned int GetDefaultThreadCount()
-    {
-        unsigned int count = std::thread::hardware_concurrency();
-        return (count > 1 ? count - 1 : 1);
-    }
-
-    void WorkerImpl()
-    {
-        while (auto task = NextTask())
-        {
-            task();
-        }
-    }
-
-    bool                              m_running;
-    std::mutex                        m_mutex;
-    std::deque<std::thread>           m_workers;
-    std::deque<std::function<void()>> m_tasks;
-    std::condition_variable           m_condition_variable;
-};
-
-}  // namespace
 
 #define CHECK_AND_TRACK_STATE_1(stats_enum, state)                   \
     if (event_state_it->Is##state##Set() && event_state_it->state()) \
@@ -190,25 +91,33 @@ private:
         stats_list[Dive::Stats::k##type##Resolves]++; \
     } while (0)
 
-//--------------------------------------------------------------------------------------------------
-void TraceStats::GatherTraceStats(const Dive::Context         &context,
-                                  const Dive::CaptureMetadata &meta_data,
-                                  CaptureStats                &capture_stats)
+namespace
 {
-    capture_stats = CaptureStats();  // Reset any previous stats
 
+constexpr size_t kMinEventsPerChunk = 1024;
+
+//--------------------------------------------------------------------------------------------------
+// Gather the per-event statistics of the events in [begin, end) into capture_stats.
+// Returns false if the operation was cancelled.
+bool GatherEventStats(const Dive::Context         &context,
+                      const Dive::CaptureMetadata &meta_data,
+                      size_t                       begin,
+                      size_t                       end,
+                      CaptureStats                &capture_stats)
+{
     std::array<uint64_t, Dive::Stats::kNumStats> &stats_list = capture_stats.m_stats_list;
 
-    size_t                      event_count = meta_data.m_event_info.size();
     const Dive::EventStateInfo &event_state = meta_data.m_event_state;
 
-    Dive::RenderModeType cur_type = Dive::RenderModeType::kUnknown;
-    for (size_t i = 0; i < event_count; ++i)
+    // Seed the render mode from the preceding event so that pass transitions crossing a chunk
+    // boundary are counted exactly once
+    Dive::RenderModeType cur_type = (begin > 0) ? meta_data.m_event_info[begin - 1].m_render_mode :
+                                                  Dive::RenderModeType::kUnknown;
+    for (size_t i = begin; i < end; ++i)
     {
         if (context.Cancelled())
         {
-            capture_stats = CaptureStats();
-            return;
+            return false;
         }
         const Dive::EventInfo &info = meta_data.m_event_info[i];
 
@@ -326,6 +235,33 @@ void TraceStats::GatherTraceStats(const Dive::Context         &context,
             if (info.m_shader_references[ref].m_shader_index != UINT32_MAX)
                 capture_stats.m_shader_ref_set.insert(info.m_shader_references[ref]);
     }
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Merge the per-event statistics of a chunk into the running totals. Only the counters which
+// are accumulated by GatherEventStats() are summed; derived stats are computed afterwards.
+void MergeEventStats(CaptureStats &capture_stats, CaptureStats &&partial)
+{
+    for (uint32_t i = 0; i < Dive::Stats::kNumStats; ++i)
+    {
+        capture_stats.m_stats_list[i] += partial.m_stats_list[i];
+    }
+    capture_stats.m_event_num_indices.insert(capture_stats.m_event_num_indices.end(),
+                                             partial.m_event_num_indices.begin(),
+                                             partial.m_event_num_indices.end());
+    capture_stats.m_shader_ref_set.merge(partial.m_shader_ref_set);
+    capture_stats.m_viewports.merge(partial.m_viewports);
+    capture_stats.m_window_scissors.merge(partial.m_window_scissors);
+    capture_stats.m_num_binning_passes += partial.m_num_binning_passes;
+    capture_stats.m_num_tiling_passes += partial.m_num_tiling_passes;
+}
+
+//--------------------------------------------------------------------------------------------------
+// Fill in the stats derived from the per-event data
+void FinalizeEventStats(CaptureStats &capture_stats)
+{
+    std::array<uint64_t, Dive::Stats::kNumStats> &stats_list = capture_stats.m_stats_list;
 
     stats_list[Dive::Stats::kNumBinningPasses] = capture_stats.m_num_binning_passes;
     stats_list[Dive::Stats::kNumTilingPasses] = capture_stats.m_num_tiling_passes;
@@ -334,33 +270,123 @@ void TraceStats::GatherTraceStats(const Dive::Context         &context,
     {
         GATHER_TOTAL_MIN_MAX_MEDIAN(capture_stats.m_event_num_indices, Indices);
     }
+}
 
-    std::vector<size_t>   shaders_num_instructions;
-    std::vector<uint32_t> shaders_num_gprs;
-
-    stats_list[Dive::Stats::kShaders] = meta_data.m_shaders.size();
+//--------------------------------------------------------------------------------------------------
+// Total, min and max of the indices of the draws merged so far, updated chunk by chunk so that
+// partial results do not need the indices of all the draws
+struct IndicesSummary
+{
+    uint64_t m_count = 0;
+    uint64_t m_total = 0;
+    uint32_t m_min = UINT32_MAX;
+    uint32_t m_max = 0;
 
-    ThreadPool thread_pool;
-    if (meta_data.m_shaders.size() > 0)
+    void Add(const std::vector<uint32_t> &event_num_indices)
     {
-        auto task_count = static_cast<unsigned int>(meta_data.m_shaders.size());
-        thread_pool.Start(thread_pool.SuggestedNumberOfWorkers(task_count));
-        for (const Dive::Disassembly &disassembly : meta_data.m_shaders)
+        for (uint32_t num_indices : event_num_indices)
         {
-            thread_pool.Run([&context, &disassembly]() {
-                if (context.Cancelled())
-                {
-                    return;
-                }
-                disassembly.EagerEval();
-            });
+            m_total += num_indices;
+            m_min = std::min(m_min, num_indices);
+            m_max = std::max(m_max, num_indices);
         }
+        m_count += event_num_indices.size();
+    }
+};
+
+//--------------------------------------------------------------------------------------------------
+// Partial result of the chunks merged so far: the counters only, so that it is cheap to copy. The
+// sets, and the median indices which need the indices of all the draws, are left empty.
+CaptureStats GetPartialStats(const CaptureStats &capture_stats, const IndicesSummary &indices)
+{
+    CaptureStats partial_stats;
+    partial_stats.m_stats_list = capture_stats.m_stats_list;
+    partial_stats.m_num_binning_passes = capture_stats.m_num_binning_passes;
+    partial_stats.m_num_tiling_passes = capture_stats.m_num_tiling_passes;
+    FinalizeEventStats(partial_stats);
+    if (indices.m_count > 0)
+    {
+        partial_stats.m_stats_list[Dive::Stats::kTotalIndices] = indices.m_total;
+        partial_stats.m_stats_list[Dive::Stats::kMinIndices] = indices.m_min;
+        partial_stats.m_stats_list[Dive::Stats::kMaxIndices] = indices.m_max;
     }
+    return partial_stats;
+}
+
+}  // namespace
+
+//--------------------------------------------------------------------------------------------------
+void TraceStats::GatherTraceStats(const Dive::Context         &context,
+                                  const Dive::CaptureMetadata &meta_data,
+                                  CaptureStats                &capture_stats,
+                                  const PartialStatsCallback  &partial_stats_callback)
+{
+    capture_stats = CaptureStats();  // Reset any previous stats
+
+    std::array<uint64_t, Dive::Stats::kNumStats> &stats_list = capture_stats.m_stats_list;
+
+    size_t event_count = meta_data.m_event_info.size();
+
+    ThreadPool &thread_pool = ThreadPool::Shared();
+
+    // Disassemble the shaders on the pool while the events are reduced
+    TaskGroup shader_group(thread_pool, context);
+    stats_list[Dive::Stats::kShaders] = meta_data.m_shaders.size();
+    for (const Dive::Disassembly &disassembly : meta_data.m_shaders)
+    {
+        shader_group.Run([&disassembly]() { disassembly.EagerEval(); });
+    }
+
+    // Split the events into contiguous chunks, each reduced into its own CaptureStats on the
+    // thread pool and merged into the totals as it completes. The merged stats are all sums,
+    // sets and an unordered list of indices, so the result does not depend on the merge order.
+    size_t num_chunks = ParallelForNumChunks(thread_pool, event_count, kMinEventsPerChunk);
+    size_t events_per_chunk = (event_count + num_chunks - 1) / num_chunks;
+
+    std::mutex     merge_mutex;
+    size_t         num_merged_chunks = 0;
+    IndicesSummary indices;
+    TaskGroup      event_group(thread_pool, context);
+    for (size_t c = 0; c < num_chunks; ++c)
+    {
+        event_group.Run([&, c]() {
+            size_t       begin = std::min(c * events_per_chunk, event_count);
+            size_t       end = std::min(begin + events_per_chunk, event_count);
+            CaptureStats chunk_stats;
+            if (!GatherEventStats(context, meta_data, begin, end, chunk_stats))
+            {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(merge_mutex);
+            indices.Add(chunk_stats.m_event_num_indices);
+            MergeEventStats(capture_stats, std::move(chunk_stats));
+            if (partial_stats_callback && ++num_merged_chunks < num_chunks)
+            {
+                partial_stats_callback(GetPartialStats(capture_stats, indices));
+            }
+        });
+    }
+    if (!event_group.Wait())
+    {
+        shader_group.Wait();
+        capture_stats = CaptureStats();
+        return;
+    }
+    FinalizeEventStats(capture_stats);
+    if (partial_stats_callback)
+    {
+        partial_stats_callback(capture_stats);
+    }
+
+    std::vector<size_t>   shaders_num_instructions;
+    std::vector<uint32_t> shaders_num_gprs;
 
     for (const Dive::ShaderReference &ref : capture_stats.m_shader_ref_set)
     {
         if (context.Cancelled())
         {
+            shader_group.Wait();
             capture_stats = CaptureStats();
             return;
         }
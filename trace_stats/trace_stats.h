@@ -19,6 +19,7 @@
 
 #include "vulkan/vulkan_core.h"
 #include <array>
+#include <functional>
 #include <set>
 #include <vector>
 #include "dive_core/context.h"
@@ -235,10 +236,20 @@ public:
     TraceStats() = default;
     ~TraceStats() = default;
 
+    // Invoked with a snapshot of the statistics gathered so far. Until the last call, the snapshot
+    // only has the counters of m_stats_list (no median indices, and empty sets), so that it stays
+    // cheap to copy however large the capture is. It may be called from the threads of the
+    // ThreadPool, though never concurrently, so the callee is responsible for any synchronization.
+    using PartialStatsCallback = std::function<void(const CaptureStats &)>;
+
     // Gather the trace statistics from the metadata
+    // The per-event pass is split into chunks which are reduced in parallel. If provided,
+    // partial_stats_callback is called as chunks complete, and once more when all per-event
+    // stats are available (before the shader stats are computed).
     void GatherTraceStats(const Dive::Context         &context,
                           const Dive::CaptureMetadata &meta_data,
-                          CaptureStats                &capture_stats);
+                          CaptureStats                &capture_stats,
+                          const PartialStatsCallback  &partial_stats_callback = {});
 
     // Print the capture statistics to the output stream
     void PrintTraceStats(const CaptureStats &capture_stats, std::ostream &ostream);
@@ -17,8 +17,10 @@
 #include <QString>
 #include <QStringList>
 #include <QTreeWidget>
+#include <algorithm>
 
 #include "dive_core/command_hierarchy.h"
+#include "dive_core/command_hierarchy_search_index.h"
 
 static_assert(sizeof(void *) == sizeof(uint64_t),
               "Unable to store a uint64_t into internalPointer()!");
@@ -61,9 +63,17 @@ void CommandModel::SetTopologyToView(const Dive::SharedNodeTopology *topology_pt
     BeginResetModel();
     m_topology_ptr = topology_ptr;
     m_node_lookup.clear();
+    m_node_order.clear();
     EndResetModel();
 }
 
+//--------------------------------------------------------------------------------------------------
+void CommandModel::SetSearchIndex(
+std::shared_ptr<const Dive::CommandHierarchySearchIndex> search_index)
+{
+    m_search_index = std::move(search_index);
+}
+
 //--------------------------------------------------------------------------------------------------
 QVariant CommandModel::data(const QModelIndex &index, int role) const
 {
@@ -234,6 +244,9 @@ void CommandModel::BuildNodeLookup(const QModelIndex &parent) const
     {
         m_node_lookup.clear();
         m_node_lookup.resize(m_command_hierarchy.size());
+        m_node_order.clear();
+        m_node_order.resize(m_command_hierarchy.size(), UINT64_MAX);
+        m_next_node_order = 0;
     }
     int n = rowCount(parent);
     for (int r = 0; r < n; ++r)
@@ -241,7 +254,10 @@ void CommandModel::BuildNodeLookup(const QModelIndex &parent) const
         auto     idx = index(r, 0, parent);
         uint64_t node_index = (uint64_t)idx.internalPointer();
         if (node_index < m_node_lookup.size())
+        {
             m_node_lookup[node_index] = QPersistentModelIndex(idx);
+            m_node_order[node_index] = m_next_node_order++;
+        }
         BuildNodeLookup(idx);
     }
 }
@@ -249,6 +265,18 @@ void CommandModel::BuildNodeLookup(const QModelIndex &parent) const
 //--------------------------------------------------------------------------------------------------
 QList<QModelIndex> CommandModel::search(const QModelIndex &start, const QVariant &value) const
 {
+    // The index only covers a search of the whole model. Its case-insensitive search only folds
+    // ASCII letters, so a text with other characters is searched with the Unicode-aware folding
+    // of QString below.
+    QString search_text = value.toString();
+    bool    is_ascii = std::all_of(search_text.begin(), search_text.end(), [](QChar c) {
+        return c.unicode() < 0x80;
+    });
+    if (m_search_index && is_ascii && !parent(start).isValid() && start.row() == 0)
+    {
+        return SearchWithIndex(search_text);
+    }
+
     QList<QModelIndex>  result;
     Qt::CaseSensitivity cs = Qt::CaseInsensitive;
 
@@ -277,3 +305,32 @@ QList<QModelIndex> CommandModel::search(const QModelIndex &start, const QVariant
 
     return result;
 }
+
+//--------------------------------------------------------------------------------------------------
+QList<QModelIndex> CommandModel::SearchWithIndex(const QString &text) const
+{
+    Dive::CommandHierarchySearchQuery query;
+    query.m_text = text.toStdString();
+    std::vector<uint64_t> node_indices;
+    if (!m_search_index->Search(query, node_indices))
+        return QList<QModelIndex>();
+
+    // Only the nodes shown by the model, in the order of the recursive search
+    if (m_node_lookup.size() != m_command_hierarchy.size())
+        BuildNodeLookup();
+    auto end = std::remove_if(node_indices.begin(),
+                              node_indices.end(),
+                              [this](uint64_t node_index) {
+                                  return !m_node_lookup[node_index].isValid();
+                              });
+    node_indices.erase(end, node_indices.end());
+    std::sort(node_indices.begin(),
+              node_indices.end(),
+              [this](uint64_t a, uint64_t b) { return m_node_order[a] < m_node_order[b]; });
+
+    QList<QModelIndex> result;
+    result.reserve(node_indices.size());
+    for (uint64_t node_index : node_indices)
+        result.append(m_node_lookup[node_index]);
+    return result;
+}
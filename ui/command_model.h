@@ -17,11 +17,13 @@
 #include <QList>
 #include <QModelIndex>
 #include <QVariant>
+#include <memory>
 
 // Forward Declarations
 namespace Dive
 {
 class CommandHierarchy;
+class CommandHierarchySearchIndex;
 class SharedNodeTopology;
 };  // namespace Dive
 
@@ -44,6 +46,9 @@ public:
     void BeginResetModel();
     void EndResetModel();
     void SetTopologyToView(const Dive::SharedNodeTopology *topology_ptr);
+    const Dive::SharedNodeTopology *GetTopology() const { return m_topology_ptr; }
+    // Index of m_command_hierarchy used by search(), or nullptr while it is being built
+    void SetSearchIndex(std::shared_ptr<const Dive::CommandHierarchySearchIndex> search_index);
 
     QVariant      data(const QModelIndex &index, int role) const override;
     Qt::ItemFlags flags(const QModelIndex &index) const override;
@@ -76,7 +81,14 @@ private:
     uint32_t GetEventNodeIndexInStream(uint64_t node_index) const;
     void     BuildNodeLookup(const QModelIndex &parent = QModelIndex()) const;
 
+    QList<QModelIndex> SearchWithIndex(const QString &text) const;
+
     const Dive::CommandHierarchy              &m_command_hierarchy;
     const Dive::SharedNodeTopology            *m_topology_ptr;
     mutable std::vector<QPersistentModelIndex> m_node_lookup;
+    // Position of each node of m_node_lookup in a depth-first traversal of the model
+    mutable std::vector<uint64_t>              m_node_order;
+    mutable uint64_t                           m_next_node_order = 0;
+
+    std::shared_ptr<const Dive::CommandHierarchySearchIndex> m_search_index;
 };
@@ -56,47 +56,40 @@ void DiveFilterModel::applyNewFilterMode(FilterMode new_mode)
     beginResetModel();
     m_filter_mode = new_mode;
 
-    // Clear the vector of pm4 draw call indices.
-    m_pm4_draw_call_indices.clear();
     // Recollect pm4 draw call indices when new filter is applied.
-    CollectPm4DrawCallIndices(QModelIndex());
+    CollectPm4DrawCallIndices();
 
     // invalidateFilter() doesn't invalidate all nodes
     // begin/endResetModel() will cause a full re-evaluation and rebuild of the proxy's internal
-    // mapping.
+    // mapping. The proxy only maps the rows that are shown, so this is cheap.
     endResetModel();
 }
 
-bool DiveFilterModel::IncludeIndex(uint64_t node_index) const
+Dive::CommandHierarchy::FilterListType DiveFilterModel::GetFilterListType(FilterMode filter_mode)
 {
-    Dive::CommandHierarchy::FilterListType
-    filter_list_type = Dive::CommandHierarchy::kFilterListTypeCount;
-
-    switch (m_filter_mode)
+    switch (filter_mode)
     {
     case kBinningPassOnly:
-        filter_list_type = Dive::CommandHierarchy::kBinningPassOnly;
-        break;
+        return Dive::CommandHierarchy::kBinningPassOnly;
     case kFirstTilePassOnly:
-        filter_list_type = Dive::CommandHierarchy::kFirstTilePassOnly;
-        break;
+        return Dive::CommandHierarchy::kFirstTilePassOnly;
     case kBinningAndFirstTilePass:
-        filter_list_type = Dive::CommandHierarchy::kBinningAndFirstTilePass;
-        break;
+        return Dive::CommandHierarchy::kBinningAndFirstTilePass;
     default:
-        return true;
+        return Dive::CommandHierarchy::kFilterListTypeCount;
     }
+}
 
-    const auto &filter_exclude_indices = m_command_hierarchy.GetFilterExcludeIndices(
-    filter_list_type);
-
-    // If the node index is in the exclude list, we exclude the index.
-    if (filter_exclude_indices.find(node_index) != filter_exclude_indices.end())
+bool DiveFilterModel::IncludeIndex(uint64_t node_index) const
+{
+    Dive::CommandHierarchy::FilterListType filter_list_type = GetFilterListType(m_filter_mode);
+    if (filter_list_type == Dive::CommandHierarchy::kFilterListTypeCount)
     {
-        return false;
+        return true;
     }
 
-    return true;
+    // If the node index is in the exclude list, we exclude the index.
+    return !m_command_hierarchy.IsFilterExcluded(node_index, filter_list_type);
 }
 
 void DiveFilterModel::SetMode(FilterMode filter_mode)
@@ -104,43 +97,43 @@ void DiveFilterModel::SetMode(FilterMode filter_mode)
     applyNewFilterMode(filter_mode);
 }
 
-void DiveFilterModel::CollectPm4DrawCallIndices(const QModelIndex &parent_index)
+const Dive::CommandHierarchy::FilteredTopology *DiveFilterModel::GetFilteredTopology() const
 {
-    if (!parent_index.isValid())
+    const CommandModel *command_model = qobject_cast<const CommandModel *>(sourceModel());
+    if (command_model == nullptr || command_model->GetTopology() == nullptr)
     {
-        m_pm4_draw_call_indices.clear();
+        return nullptr;
     }
-    else
-    {
-        // Check if the current parent node is filtered out.
-        uint64_t parent_node_index = (uint64_t)parent_index.internalPointer();
 
-        if (!IncludeIndex(parent_node_index))
-        {
-            return;
-        }
+    std::optional<Dive::CommandHierarchy::FilteredTopology>
+    &filtered_topology = m_filtered_topologies[m_filter_mode];
+    if (!filtered_topology.has_value())
+    {
+        filtered_topology = m_command_hierarchy
+                            .ComputeFilteredTopology(*command_model->GetTopology(),
+                                                     GetFilterListType(m_filter_mode));
     }
+    return &*filtered_topology;
+}
 
-    int row_count = sourceModel()->rowCount(parent_index);
-    for (int row = 0; row < row_count; ++row)
+void DiveFilterModel::ClearFilteredTopologies()
+{
+    for (std::optional<Dive::CommandHierarchy::FilteredTopology> &filtered_topology :
+         m_filtered_topologies)
     {
-        QModelIndex index = sourceModel()->index(row, 0, parent_index);
-        if (index.isValid())
-        {
-            uint64_t       node_index = (uint64_t)index.internalPointer();
-            Dive::NodeType node_type = m_command_hierarchy.GetNodeType(node_index);
-            if (Dive::IsDrawDispatchNode(node_type))
-            {
-                m_pm4_draw_call_indices.push_back(node_index);
-            }
+        filtered_topology.reset();
+    }
+}
 
-            // Only recurse into children if the current node is not a Vulkan submit node.
-            if (node_type != Dive::NodeType::kGfxrVulkanSubmitNode)
-            {
-                CollectPm4DrawCallIndices(index);
-            }
-        }
+void DiveFilterModel::CollectPm4DrawCallIndices()
+{
+    const Dive::CommandHierarchy::FilteredTopology *filtered_topology = GetFilteredTopology();
+    if (filtered_topology == nullptr)
+    {
+        m_pm4_draw_call_indices.clear();
+        return;
     }
+    m_pm4_draw_call_indices = filtered_topology->m_draw_call_indices;
 }
 
 void DiveFilterModel::ClearDrawCallIndices()
@@ -148,6 +141,38 @@ void DiveFilterModel::ClearDrawCallIndices()
     m_pm4_draw_call_indices.clear();
 }
 
+void DiveFilterModel::setSourceModel(QAbstractItemModel *source_model)
+{
+    if (sourceModel() != nullptr)
+    {
+        disconnect(sourceModel(), nullptr, this, nullptr);
+    }
+    ClearFilteredTopologies();
+    QSortFilterProxyModel::setSourceModel(source_model);
+    if (source_model != nullptr)
+    {
+        // A reset of the source model means another topology, or another capture
+        connect(source_model,
+                &QAbstractItemModel::modelReset,
+                this,
+                &DiveFilterModel::ClearFilteredTopologies);
+    }
+}
+
+bool DiveFilterModel::hasChildren(const QModelIndex &parent) const
+{
+    // Without the filtered child counts, the proxy filters all the children of each row shown, to
+    // know whether to draw its expand indicator
+    const Dive::CommandHierarchy::FilteredTopology *filtered_topology = GetFilteredTopology();
+    if (!parent.isValid() || filtered_topology == nullptr)
+    {
+        return QSortFilterProxyModel::hasChildren(parent);
+    }
+    uint64_t node_index = (uint64_t)mapToSource(parent).internalPointer();
+    return node_index < filtered_topology->m_num_children.size() &&
+           filtered_topology->m_num_children[node_index] > 0;
+}
+
 bool DiveFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
 {
     QModelIndex index = sourceModel()->index(sourceRow, 0, sourceParent);
@@ -23,6 +23,9 @@
 #include <QTreeView>
 #include <qabstractitemmodel.h>
 #include <qsortfilterproxymodel.h>
+#include <optional>
+
+#include "dive_core/command_hierarchy.h"
 
 // Forward declarations
 class CommandModel;
@@ -34,7 +37,6 @@ class GfxrVulkanCommandArgumentsFilterProxyModel;
 
 namespace Dive
 {
-class CommandHierarchy;
 class DataCore;
 };  // namespace Dive
 
@@ -54,9 +56,12 @@ public:
     DiveFilterModel(const Dive::CommandHierarchy &command_hierarchy, QObject *parent = nullptr);
     bool IncludeIndex(uint64_t node_index) const;
     void SetMode(FilterMode filter_mode);
-    void CollectPm4DrawCallIndices(const QModelIndex &parent_index = QModelIndex());
+    void CollectPm4DrawCallIndices();
     void ClearDrawCallIndices();
     const std::vector<uint64_t> &GetPm4DrawCallIndices() { return m_pm4_draw_call_indices; }
+
+    void setSourceModel(QAbstractItemModel *source_model) override;
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
 public slots:
     void applyNewFilterMode(FilterMode new_mode);
 
@@ -64,9 +69,20 @@ protected:
     bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
 
 private:
+    static Dive::CommandHierarchy::FilterListType GetFilterListType(FilterMode filter_mode);
+
+    // What the current mode leaves of the topology viewed by the source CommandModel, or nullptr
+    // if there is none. Computed on the first use of each mode, so that switching back and forth
+    // only costs the rows shown.
+    const Dive::CommandHierarchy::FilteredTopology *GetFilteredTopology() const;
+    void                                            ClearFilteredTopologies();
+
     const Dive::CommandHierarchy &m_command_hierarchy;
     FilterMode                    m_filter_mode = kNone;
     std::vector<uint64_t>         m_pm4_draw_call_indices;
+
+    mutable std::optional<Dive::CommandHierarchy::FilteredTopology>
+    m_filtered_topologies[kFilterModeCount];
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -25,6 +25,7 @@
 #include <string>
 #include "gfxr_vulkan_command_filter_proxy_model.h"
 #include "gfxr_vulkan_command_arguments_filter_proxy_model.h"
+#include "gfxr_vulkan_command_model.h"
 #include "search_bar.h"
 #include "shortcuts.h"
 
@@ -35,17 +36,15 @@
 // GfxrVulkanCommandArgumentsTabView
 // =================================================================================================
 GfxrVulkanCommandArgumentsTabView::GfxrVulkanCommandArgumentsTabView(
-const Dive::CommandHierarchy               &vulkan_command_hierarchy,
-GfxrVulkanCommandArgumentsFilterProxyModel *proxy_model,
-GfxrVulkanCommandModel                     *command_hierarchy_model,
-QWidget                                    *parent) :
-    m_vulkan_command_hierarchy(vulkan_command_hierarchy),
-    m_arg_proxy_model(proxy_model),
-    m_command_hierarchy_model(command_hierarchy_model)
+const Dive::CommandHierarchy &vulkan_command_hierarchy,
+QWidget                      *parent) :
+    m_vulkan_command_hierarchy(vulkan_command_hierarchy)
 {
-    m_command_hierarchy_view = new DiveTreeView(m_vulkan_command_hierarchy);
+    m_command_hierarchy_view = new DiveTreeView(m_arg_hierarchy);
 
-    m_arg_proxy_model->setSourceModel(m_command_hierarchy_model);
+    m_arg_model = new GfxrVulkanCommandModel(m_arg_hierarchy);
+    m_arg_proxy_model = new GfxrVulkanCommandArgumentsFilterProxyModel(this, &m_arg_hierarchy);
+    m_arg_proxy_model->setSourceModel(m_arg_model);
     m_command_hierarchy_view->setModel(m_arg_proxy_model);
 
     m_search_trigger_button = new QPushButton;
@@ -75,16 +74,13 @@ QWidget                                    *parent) :
                      SLOT(OnSearchBarVisibilityChange(bool)));
 }
 
-//--------------------------------------------------------------------------------------------------
-void GfxrVulkanCommandArgumentsTabView::SetTopologyToView(const Dive::Topology *topology_ptr)
-{
-    m_command_hierarchy_model->SetTopologyToView(topology_ptr);
-}
-
 //--------------------------------------------------------------------------------------------------
 void GfxrVulkanCommandArgumentsTabView::ResetModel()
 {
-    m_command_hierarchy_model->Reset();
+    m_arg_proxy_model->SetTargetParentSourceIndex(QModelIndex());
+    m_arg_model->Reset();
+    m_arg_hierarchy = Dive::CommandHierarchy();
+    m_arg_hierarchy_node_index = UINT64_MAX;
     // Reset search results
     m_command_hierarchy_view->reset();
     if (m_search_bar->isVisible())
@@ -99,6 +95,8 @@ void GfxrVulkanCommandArgumentsTabView::OnSelectionChanged(const QModelIndex &in
     if (!index.isValid())
     {
         m_arg_proxy_model->SetTargetParentSourceIndex(QModelIndex());
+        m_arg_model->Reset();
+        m_arg_hierarchy_node_index = UINT64_MAX;
         return;
     }
 
@@ -116,10 +114,25 @@ void GfxrVulkanCommandArgumentsTabView::OnSelectionChanged(const QModelIndex &in
     }
 
     // Always use the source_index, regardless of whether a proxy was involved.
-    m_arg_proxy_model->SetTargetParentSourceIndex(source_index);
+    uint64_t node_index = (uint64_t)(source_index.internalPointer());
+    if (node_index == m_arg_hierarchy_node_index)
+    {
+        // Both the view and its selection model report the same change
+        return;
+    }
+
+    // Create the argument nodes of the newly selected command only
+    m_arg_proxy_model->SetTargetParentSourceIndex(QModelIndex());
+    m_arg_model->Reset();
+    m_arg_hierarchy_node_index = node_index;
+    Dive::GfxrVulkanCommandHierarchyCreator arg_hierarchy_creator(m_arg_hierarchy);
+    if (arg_hierarchy_creator.CreateArgTrees(m_vulkan_command_hierarchy, node_index))
+    {
+        m_arg_model->SetTopologyToView(&m_arg_hierarchy.GetAllEventHierarchyTopology());
+        m_arg_proxy_model->SetTargetParentSourceIndex(m_arg_model->index(0, 0, QModelIndex()));
+    }
 
-    uint32_t column_count = static_cast<uint32_t>(
-    m_command_hierarchy_model->columnCount(QModelIndex()));
+    uint32_t column_count = static_cast<uint32_t>(m_arg_model->columnCount(QModelIndex()));
     for (uint32_t column = 0; column < column_count; ++column)
         m_command_hierarchy_view->resizeColumnToContents(column);
 
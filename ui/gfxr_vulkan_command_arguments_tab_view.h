@@ -16,6 +16,7 @@
 
 #include <QFrame>
 #include <QSortFilterProxyModel>
+#include "dive_core/command_hierarchy.h"
 
 #pragma once
 // Forward declaration
@@ -27,24 +28,18 @@ class GfxrVulkanCommandFilterProxyModel;
 class GfxrVulkanCommandArgumentsFilterProxyModel;
 class DiveTreeView;
 class GfxrVulkanCommandModel;
-namespace Dive
-{
-class CommandHierarchy;
-class Topology;
-};  // namespace Dive
 
 //--------------------------------------------------------------------------------------------------
+// Displays the arguments of the vulkan command selected in the command hierarchy. The argument
+// nodes are not part of the command hierarchy: they are created in m_arg_hierarchy for the selected
+// command only.
 class GfxrVulkanCommandArgumentsTabView : public QFrame
 {
     Q_OBJECT
 
 public:
     GfxrVulkanCommandArgumentsTabView(const Dive::CommandHierarchy &vulkan_command_hierarchy,
-                                      GfxrVulkanCommandArgumentsFilterProxyModel *proxy_model,
-                                      GfxrVulkanCommandModel *command_hierarchy_model,
-                                      QWidget                *parent = nullptr);
-
-    void SetTopologyToView(const Dive::Topology *topology_ptr);
+                                      QWidget                      *parent = nullptr);
 
     void ResetModel();
 
@@ -65,7 +60,12 @@ private:
     QPushButton  *m_search_trigger_button;
     SearchBar    *m_search_bar = nullptr;
 
-    const Dive::CommandHierarchy               &m_vulkan_command_hierarchy;
+    const Dive::CommandHierarchy &m_vulkan_command_hierarchy;
+    // Selected command and its arguments
+    Dive::CommandHierarchy m_arg_hierarchy;
+    // Index of the selected command in m_vulkan_command_hierarchy
+    uint64_t m_arg_hierarchy_node_index = UINT64_MAX;
+
     GfxrVulkanCommandArgumentsFilterProxyModel *m_arg_proxy_model;
-    GfxrVulkanCommandModel                     *m_command_hierarchy_model;
+    GfxrVulkanCommandModel                     *m_arg_model;
 };
@@ -29,6 +29,7 @@ void GpuTimingModel::OnGpuTimingResultsGenerated(const QString &file_path)
     emit beginResetModel();
     m_available_gpu_timing_data = {};  // Need to create a new AvailableGpuTiming object because it
                                        // can only be loaded once
+    m_cell_strings.clear();
 
     if (file_path.size() == 0)
     {
@@ -48,6 +49,19 @@ void GpuTimingModel::ParseCsv(const QString &file_path)
     {
         qDebug() << "Could not load GPU timing info from CSV file: "
                  << file_path.toStdString().c_str();
+        return;
+    }
+
+    int rows = m_available_gpu_timing_data.GetRows();
+    int columns = m_available_gpu_timing_data.GetColumns();
+    m_cell_strings.reserve(static_cast<size_t>(rows) * columns);
+    for (int row = 0; row < rows; ++row)
+    {
+        for (int column = 0; column < columns; ++column)
+        {
+            std::string cell = m_available_gpu_timing_data.GetCell(row, column);
+            m_cell_strings.push_back(QString::fromStdString(cell));
+        }
     }
 }
 
@@ -92,14 +106,14 @@ QVariant GpuTimingModel::data(const QModelIndex &index, int role) const
         return QVariant();
     }
 
-    std::string ret = m_available_gpu_timing_data.GetCell(index.row(), index.column());
-    if (ret.size() == 0)
+    size_t cell_index = static_cast<size_t>(index.row()) * columnCount() + index.column();
+    if ((cell_index >= m_cell_strings.size()) || m_cell_strings[cell_index].isEmpty())
     {
         qDebug() << "Could not get GPU timing stats for row: " << index;
         return QVariant();
     }
 
-    return QString(ret.c_str());
+    return m_cell_strings[cell_index];
 }
 
 //--------------------------------------------------------------------------------------------------
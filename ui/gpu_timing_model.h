@@ -14,6 +14,7 @@
 #include <QAbstractItemModel>
 #include <QVector>
 #include <QStringList>
+#include <vector>
 
 #include "dive_core/available_gpu_time.h"
 
@@ -41,4 +42,8 @@ public slots:
 private:
     void                     ParseCsv(const QString &file_path);
     Dive::AvailableGpuTiming m_available_gpu_timing_data;
+
+    // Display strings of all the cells, row-major, converted once per load rather than on every
+    // repaint
+    std::vector<QString> m_cell_strings;
 };
@@ -59,6 +59,7 @@ void GpuTimingTabView::CollectIndicesFromModel(const QAbstractItemModel &command
     {
         qDebug() << "GpuTimingTabView::CollectIndicesFromModel()";
         m_timed_event_indices.clear();
+        m_timed_event_rows.clear();
     }
 
     for (int row = 0; row < command_hierarchy_model.rowCount(parent_index); ++row)
@@ -98,6 +99,7 @@ void GpuTimingTabView::CollectTimingIndex(Dive::NodeType     node_type,
     kGfxrVulkanBeginRenderPassCommandNode:  // AvailableGpuTiming::ObjectType::kRenderPass
     {
         uint64_t index_address = (uint64_t)model_index.internalPointer();
+        m_timed_event_rows.emplace(index_address, static_cast<int>(m_timed_event_indices.size()));
         m_timed_event_indices.push_back(index_address);
     }
     default:
@@ -127,15 +129,13 @@ int GpuTimingTabView::EventIndexToRow(const QModelIndex &model_index)
 
     uint64_t index_address = (uint64_t)model_index.internalPointer();
 
-    const auto it = std::find(m_timed_event_indices.cbegin(),
-                              m_timed_event_indices.cend(),
-                              index_address);
-    if (it == m_timed_event_indices.cend())
+    const auto it = m_timed_event_rows.find(index_address);
+    if (it == m_timed_event_rows.cend())
     {
         return -1;
     }
 
-    return std::distance(m_timed_event_indices.cbegin(), it);
+    return it->second;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -14,6 +14,7 @@
 #include <QWidget>
 #include <QTableView>
 #include <QVBoxLayout>
+#include <unordered_map>
 #include <vector>
 
 #include "dive_core/command_hierarchy.h"
@@ -70,4 +71,7 @@ private:
     //
     // The Qt index of all events for which there is GPU timing data
     std::vector<uint64_t> m_timed_event_indices = {};
+
+    // Row of each entry of m_timed_event_indices, so that selecting an event is O(1)
+    std::unordered_map<uint64_t, int> m_timed_event_rows = {};
 };
@@ -53,7 +53,9 @@
 #include "command_model.h"
 #include "dive_core/capture_data.h"
 #include "dive_core/command_hierarchy.h"
+#include "dive_core/command_hierarchy_search_index.h"
 #include "dive_core/log.h"
+#include "dive_core/submit_metadata_cache.h"
 #include "dive_tree_view.h"
 #include "object_names.h"
 #include "settings.h"
@@ -68,7 +70,6 @@
 #include "event_state_view.h"
 #include "gfxr_vulkan_command_model.h"
 #include "gfxr_vulkan_command_filter_proxy_model.h"
-#include "gfxr_vulkan_command_arguments_filter_proxy_model.h"
 #include "gfxr_vulkan_command_arguments_tab_view.h"
 #include "gpu_timing_model.h"
 #include "gpu_timing_tab_view.h"
@@ -110,6 +111,14 @@ constexpr DiveFilterModel::FilterMode kDefaultFilterMode = DiveFilterModel::kFir
 static constexpr const char *kMetricsFilePath = ":/resources/available_metrics.csv";
 static constexpr const char *kMetricsFileName = "available_metrics.csv";
 
+// .rd captures of at least this size first show a preview of their first kNumPreviewSubmits
+// submits. The whole capture, those submits included, is then parsed again in the background and
+// replaces the preview once done. Submits are not streamed in one by one.
+static constexpr uint64_t kPreviewMinFileSize = 64 << 20;
+static constexpr uint32_t kNumPreviewSubmits = 4;
+// Minimum time between two updates of the loading progress
+static constexpr std::chrono::milliseconds kProgressUpdateInterval(100);
+
 namespace
 {
 
@@ -294,10 +303,6 @@ MainWindow::MainWindow()
         new GfxrVulkanCommandFilterProxyModel(m_data_core->GetCommandHierarchy(),
                                               m_command_hierarchy_view);
 
-        m_gfxr_vulkan_commands_arguments_filter_proxy_model =
-        new GfxrVulkanCommandArgumentsFilterProxyModel(m_command_hierarchy_view,
-                                                       &m_data_core->GetCommandHierarchy());
-
         m_filter_model = new DiveFilterModel(m_data_core->GetCommandHierarchy(), this);
         m_filter_model->setSourceModel(m_command_hierarchy_model);
         // Set the proxy model as the view's model
@@ -472,15 +477,14 @@ MainWindow::MainWindow()
         m_trace_stats = std::make_unique<Dive::TraceStats>();
         m_capture_stats = std::make_unique<Dive::CaptureStats>();
         m_async_capture_stats = std::make_unique<Dive::CaptureStats>();
+        m_partial_capture_stats = std::make_unique<Dive::CaptureStats>();
         m_overview_tab_view = new OverviewTabView(m_data_core->GetCaptureMetadata(),
                                                   *m_capture_stats);
         m_event_state_view = new EventStateView(*m_data_core);
 
         m_perf_counter_tab_view = new PerfCounterTabView(*m_perf_counter_model, this);
-        m_gfxr_vulkan_command_arguments_tab_view =
-        new GfxrVulkanCommandArgumentsTabView(m_data_core->GetCommandHierarchy(),
-                                              m_gfxr_vulkan_commands_arguments_filter_proxy_model,
-                                              m_gfxr_vulkan_command_hierarchy_model);
+        m_gfxr_vulkan_command_arguments_tab_view = new GfxrVulkanCommandArgumentsTabView(
+        m_data_core->GetCommandHierarchy());
         m_gpu_timing_tab_view = new GpuTimingTabView(*m_gpu_timing_model,
                                                      m_data_core->GetCommandHierarchy(),
                                                      this);
@@ -598,6 +602,11 @@ MainWindow::MainWindow()
                      this,
                      &MainWindow::OnPendingPerfCounterResults);
     QObject::connect(this, &MainWindow::PendingScreenshot, this, &MainWindow::OnPendingScreenshot);
+    QObject::connect(this,
+                     &MainWindow::AsyncTraceStatsProgress,
+                     this,
+                     &MainWindow::OnAsyncTraceStatsProgress,
+                     Qt::QueuedConnection);
     QObject::connect(this,
                      &MainWindow::AsyncTraceStatsDone,
                      this,
@@ -617,7 +626,11 @@ MainWindow::MainWindow()
     QObject::connect(&m_progress_tracker,
                      SIGNAL(sendMessageSignal(const QString &)),
                      this,
-                     SLOT(UpdateOverlay(const QString &)));
+                     SLOT(OnLoadingMessage(const QString &)));
+    QObject::connect(&m_progress_tracker,
+                     &ProgressTrackerCallback::sendProgressSignal,
+                     this,
+                     &MainWindow::OnLoadingProgress);
     QObject::connect(this, &MainWindow::HideOverlay, this, &MainWindow::OnHideOverlay);
 
 #ifndef NDEBUG
@@ -633,7 +646,11 @@ MainWindow::MainWindow()
 }
 
 //--------------------------------------------------------------------------------------------------
-MainWindow::~MainWindow() {}
+MainWindow::~MainWindow()
+{
+    // The background parse reads m_data_core
+    CancelFullParse();
+}
 
 //--------------------------------------------------------------------------------------------------
 bool MainWindow::InitializePlugins()
@@ -958,7 +975,7 @@ void MainWindow::OnDiveFileLoaded()
     m_gfxr_vulkan_commands_filter_proxy_model->CollectGfxrDrawCallIndices();
 
     // Collect the PM4 draw call indices for the current filter
-    m_filter_model->CollectPm4DrawCallIndices(QModelIndex());
+    m_filter_model->CollectPm4DrawCallIndices();
 
     // Iterate m_gfxr_vulkan_command_hierarchy_model to collect the indices of the vulkan events
     // where gpu timing data will be collected
@@ -968,6 +985,7 @@ void MainWindow::OnDiveFileLoaded()
     // Ensure there is no previous tab index set
     m_previous_tab_index = -1;
 
+    StartSearchIndex();
     StartTraceStats();
 }
 
@@ -990,8 +1008,15 @@ void MainWindow::OnAdrenoRdFileLoaded()
     // Reset the tab widget.
     ResetTabWidget();
 
+    // In bounded-memory mode, only the submit shown is parsed and its events are numbered from 0,
+    // so the stats of the whole capture are not available
+    bool bounded_memory = (m_submit_metadata_cache != nullptr);
+
     // Add the tabs required for an AdrenoRd file.
-    m_overview_view_tab_index = m_tab_widget->addTab(m_overview_tab_view, "Overview");
+    if (!bounded_memory)
+    {
+        m_overview_view_tab_index = m_tab_widget->addTab(m_overview_tab_view, "Overview");
+    }
     m_command_view_tab_index = m_tab_widget->addTab(m_command_tab_view, "PM4 Packets");
     m_shader_view_tab_index = m_tab_widget->addTab(m_shader_view, "Shaders");
     m_event_state_view_tab_index = m_tab_widget->addTab(m_event_state_view, "Event State");
@@ -1030,12 +1055,16 @@ void MainWindow::OnAdrenoRdFileLoaded()
     m_command_hierarchy_model->EndResetModel();
 
     // Collect the PM4 draw call indices for the current filter
-    m_filter_model->CollectPm4DrawCallIndices(QModelIndex());
+    m_filter_model->CollectPm4DrawCallIndices();
 
     // Ensure there is no previous tab index set
     m_previous_tab_index = -1;
 
-    StartTraceStats();
+    StartSearchIndex();
+    if (!bounded_memory)
+    {
+        StartTraceStats();
+    }
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1045,6 +1074,7 @@ void MainWindow::OnGfxrFileLoaded()
     m_left_group_box->setTitle(kFrameTitleStrings[1]);
     m_middle_group_box->setTitle(kFrameTitleStrings[0]);
     m_middle_group_box->hide();
+    m_gfxr_vulkan_command_arguments_tab_view->ResetModel();
     m_gfxr_vulkan_command_hierarchy_model->Reset();
     m_prev_command_view_mode = QString();
     m_filter_gfxr_commands_combo_box->Reset();
@@ -1110,9 +1140,22 @@ void MainWindow::StartTraceStats()
 
         QReadLocker locker(&m_data_core_lock);
         // Gather the trace stats and display in the overview tab
+        // Partial results are published so the overview tab fills in progressively
         m_trace_stats->GatherTraceStats(context,
                                         m_data_core->GetCaptureMetadata(),
-                                        *m_async_capture_stats);
+                                        *m_async_capture_stats,
+                                        [this, &context](const Dive::CaptureStats &partial) {
+                                            if (context.Cancelled())
+                                            {
+                                                return;
+                                            }
+                                            {
+                                                std::lock_guard<std::mutex> lock(
+                                                m_partial_capture_stats_mutex);
+                                                *m_partial_capture_stats = partial;
+                                            }
+                                            AsyncTraceStatsProgress();
+                                        });
 
         [[maybe_unused]] int64_t
         time_used_to_load_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -1132,6 +1175,328 @@ void MainWindow::StartTraceStats()
     });
 }
 
+//--------------------------------------------------------------------------------------------------
+void MainWindow::StartSearchIndex()
+{
+    if (!m_search_index_context.IsNull())
+    {
+        m_search_index_context->Cancel();
+    }
+    m_command_hierarchy_model->SetSearchIndex(nullptr);
+
+    // Queued before the trace stats on the worker, since building the index is much faster
+    m_search_index_context = Dive::SimpleContext::Create();
+    m_worker->Run([this, context = Dive::Context{ m_search_index_context }]() {
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+        QReadLocker locker(&m_data_core_lock);
+        auto        search_index = std::make_shared<Dive::CommandHierarchySearchIndex>();
+        if (!search_index->Build(m_data_core->GetCommandHierarchy(), context))
+        {
+            return;
+        }
+
+        [[maybe_unused]] int64_t
+        time_used_to_build_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                std::chrono::steady_clock::now() - begin)
+                                .count();
+        DIVE_DEBUG_LOG("Time used to build the search index is %f seconds.\n",
+                       (time_used_to_build_ms / 1000.0));
+
+        RunOnUIThread([this, context, search_index]() {
+            // Another capture may have been loaded meanwhile
+            if (!context.Cancelled())
+            {
+                m_command_hierarchy_model->SetSearchIndex(search_index);
+            }
+        });
+    });
+}
+
+//--------------------------------------------------------------------------------------------------
+void MainWindow::StartFullParse()
+{
+    // The first submits are parsed again, so that the whole capture is one consistent parse. Their
+    // nodes keep the same indices, so the current node stays selected when the capture is swapped.
+    m_full_parse_result = std::async([this, context = Dive::Context{ m_loading_context }]() {
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+        auto capture_metadata = std::make_shared<Dive::CaptureMetadata>();
+        {
+            // The capture data is only read, so the preview stays usable meanwhile
+            QReadLocker locker(&m_data_core_lock);
+            if (!m_data_core->ParsePm4CaptureMetadata(context,
+                                                      Dive::SubmitRange(),
+                                                      *capture_metadata))
+            {
+                capture_metadata = nullptr;
+            }
+        }
+
+        [[maybe_unused]] int64_t
+        time_used_to_parse_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                std::chrono::steady_clock::now() - begin)
+                                .count();
+        DIVE_DEBUG_LOG("Time used to parse the whole capture is %f seconds.\n",
+                       (time_used_to_parse_ms / 1000.0));
+
+        RunOnUIThread([this, context, capture_metadata]() {
+            // Another capture may have been loaded meanwhile
+            if (!context.Cancelled())
+            {
+                OnFullParseDone(capture_metadata);
+            }
+        });
+    });
+    OnLoadingMessage(tr("Processing command buffers..."));
+}
+
+//--------------------------------------------------------------------------------------------------
+void MainWindow::OnFullParseDone(std::shared_ptr<Dive::CaptureMetadata> capture_metadata)
+{
+    // It should return almost immediately, the result is posted just before the async call return
+    m_full_parse_result.get();
+    if (!capture_metadata)
+    {
+        m_status_bar->clearMessage();
+        OnParseFailure(m_capture_file.toStdString());
+        return;
+    }
+
+    CancelBackgroundReads([this, context = Dive::Context{ m_loading_context }, capture_metadata]() {
+        // Another capture may have been loaded meanwhile
+        if (!context.Cancelled())
+        {
+            SwapInFullParse(capture_metadata);
+        }
+    });
+}
+
+//--------------------------------------------------------------------------------------------------
+void MainWindow::SwapInFullParse(std::shared_ptr<Dive::CaptureMetadata> capture_metadata)
+{
+    std::optional<uint64_t> current_node;
+    QModelIndex             current_index = m_command_hierarchy_view->currentIndex();
+    if (current_index.isValid())
+    {
+        current_node = m_command_hierarchy_view->GetNodeSourceIndex(current_index);
+    }
+
+    // Nothing else reads the capture anymore, so the write lock is taken right away
+    m_data_core_lock.unlock();
+    m_data_core_lock.lockForWrite();
+    m_data_core->SetCaptureMetadata(std::move(*capture_metadata));
+    m_data_core_lock.unlock();
+    m_data_core_lock.lockForRead();
+
+    OnAdrenoRdFileLoaded();
+    ExpandResizeHierarchyView(*m_command_hierarchy_view, *m_filter_model);
+    if (current_node)
+    {
+        m_command_hierarchy_view->setCurrentNode(*current_node);
+    }
+    m_status_bar->clearMessage();
+    ShowTempStatus(tr("Whole capture parsed, it replaces the preview of the first %1 submits")
+                   .arg(kNumPreviewSubmits));
+}
+
+//--------------------------------------------------------------------------------------------------
+void MainWindow::CancelBackgroundReads(std::function<void()> on_done)
+{
+    if (!m_async_capture_stats_context.IsNull())
+    {
+        m_async_capture_stats_context->Cancel();
+    }
+    if (!m_search_index_context.IsNull())
+    {
+        m_search_index_context->Cancel();
+    }
+    m_command_hierarchy_model->SetSearchIndex(nullptr);
+
+    // The trace stats and the search index run on m_worker, one task after the other, so this task
+    // runs once they have returned and released their read locks
+    m_worker->Run([this, on_done = std::move(on_done)]() { RunOnUIThread(on_done); });
+}
+
+//--------------------------------------------------------------------------------------------------
+void MainWindow::OnSubmitChanged(int submit_index)
+{
+    if (!m_submit_metadata_cache || uint32_t(submit_index) == m_current_submit)
+    {
+        return;
+    }
+
+    // Only the last submit selected is shown. The previous decode is cancelled but not waited for
+    // here: the new one waits for it in the background, since it takes submits from the same cache.
+    if (!m_loading_context.IsNull())
+    {
+        m_loading_context->Cancel();
+    }
+    std::future<void> previous_result = std::move(m_full_parse_result);
+    m_loading_context = Dive::SimpleContext::Create();
+    m_status_bar->showMessage(tr("Decoding submit %1...").arg(submit_index));
+    m_full_parse_result = std::async([this,
+                                      previous_result = std::move(previous_result),
+                                      submit_index = uint32_t(submit_index),
+                                      context = Dive::Context{ m_loading_context }]() mutable {
+        if (previous_result.valid())
+        {
+            previous_result.get();
+        }
+
+        auto capture_metadata = std::make_shared<Dive::CaptureMetadata>();
+        {
+            // The capture data is only read, so the current submit stays usable meanwhile
+            QReadLocker locker(&m_data_core_lock);
+            if (!m_submit_metadata_cache->Take(context, submit_index, *capture_metadata))
+            {
+                capture_metadata = nullptr;
+            }
+            else if (context.Cancelled())
+            {
+                m_submit_metadata_cache->Put(submit_index, std::move(*capture_metadata));
+                capture_metadata = nullptr;
+            }
+        }
+
+        RunOnUIThread([this, context, submit_index, capture_metadata]() {
+            // Another submit or capture may have been selected meanwhile
+            if (!context.Cancelled())
+            {
+                OnSubmitDecoded(submit_index, capture_metadata);
+            }
+        });
+    });
+}
+
+//--------------------------------------------------------------------------------------------------
+void MainWindow::OnSubmitDecoded(uint32_t                               submit_index,
+                                 std::shared_ptr<Dive::CaptureMetadata> capture_metadata)
+{
+    // It should return almost immediately, the result is posted just before the async call return
+    m_full_parse_result.get();
+    m_status_bar->clearMessage();
+    if (!capture_metadata)
+    {
+        QSignalBlocker blocker(m_submit_spin_box);
+        m_submit_spin_box->setValue(m_current_submit);
+        OnParseFailure(m_capture_file.toStdString());
+        return;
+    }
+
+    // If another submit or capture is selected meanwhile, this one is dropped and decoded again
+    // when selected
+    CancelBackgroundReads(
+    [this, context = Dive::Context{ m_loading_context }, submit_index, capture_metadata]() {
+        if (!context.Cancelled())
+        {
+            SwapInSubmit(submit_index, capture_metadata);
+        }
+    });
+}
+
+//--------------------------------------------------------------------------------------------------
+void MainWindow::SwapInSubmit(uint32_t                               submit_index,
+                              std::shared_ptr<Dive::CaptureMetadata> capture_metadata)
+{
+    // The nodes of the submits differ, so nothing stays selected
+    m_command_hierarchy_view->setCurrentIndex(QModelIndex());
+    DisconnectAllTabs();
+
+    // Nothing else reads the capture anymore, so the write lock is taken right away
+    m_data_core_lock.unlock();
+    m_data_core_lock.lockForWrite();
+    Dive::CaptureMetadata previous_metadata = m_data_core->SetCaptureMetadata(
+    std::move(*capture_metadata));
+    m_data_core_lock.unlock();
+    m_submit_metadata_cache->Put(m_current_submit, std::move(previous_metadata));
+    m_current_submit = submit_index;
+    m_data_core_lock.lockForRead();
+
+    OnAdrenoRdFileLoaded();
+    ExpandResizeHierarchyView(*m_command_hierarchy_view, *m_filter_model);
+}
+
+//--------------------------------------------------------------------------------------------------
+void MainWindow::CancelFullParse()
+{
+    if (!m_loading_context.IsNull())
+    {
+        m_loading_context->Cancel();
+    }
+    if (m_full_parse_result.valid())
+    {
+        m_full_parse_result.get();
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+void MainWindow::OnLoadingMessage(const QString &message)
+{
+    // The capture is usable while it is parsed in the background, so it is not covered
+    if (m_full_parse_result.valid())
+    {
+        if (m_submit_metadata_cache)
+        {
+            m_status_bar->showMessage(message);
+        }
+        else
+        {
+            m_status_bar->showMessage(tr("Preview of the first %1 submits (capture of %2 MB or "
+                                         "more). Parsing the whole capture again: %3")
+                                      .arg(kNumPreviewSubmits)
+                                      .arg(kPreviewMinFileSize >> 20)
+                                      .arg(message));
+        }
+        return;
+    }
+    UpdateOverlay(message);
+}
+
+//--------------------------------------------------------------------------------------------------
+void MainWindow::OnLoadingProgress(const Dive::LoadProgress &progress)
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (now - m_last_progress_time < kProgressUpdateInterval)
+    {
+        return;
+    }
+    m_last_progress_time = now;
+
+    QString message;
+    switch (progress.m_stage)
+    {
+    case Dive::LoadProgress::Stage::kReadingFile:
+        message = QString("Loading capture... %1 / %2 MB")
+                  .arg(progress.m_bytes_read >> 20)
+                  .arg(progress.m_total_bytes >> 20);
+        break;
+    case Dive::LoadProgress::Stage::kParsingSubmits:
+        message = QString("Processing command buffers... submit %1 / %2, %3 events")
+                  .arg(progress.m_submits_parsed)
+                  .arg(progress.m_total_submits)
+                  .arg(progress.m_num_events);
+        break;
+    }
+    OnLoadingMessage(message);
+}
+
+//--------------------------------------------------------------------------------------------------
+void MainWindow::OnAsyncTraceStatsProgress()
+{
+    if (m_async_capture_stats_state != AsyncCaptureStatsState::kRunning)
+    {
+        // A restart is pending, so the partial result is already stale
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_partial_capture_stats_mutex);
+        *m_capture_stats = *m_partial_capture_stats;
+    }
+    m_overview_tab_view->LoadStatistics();
+}
+
+//--------------------------------------------------------------------------------------------------
 void MainWindow::OnAsyncTraceStatsDone()
 {
     *m_capture_stats = *m_async_capture_stats;
@@ -1231,17 +1596,28 @@ bool MainWindow::LoadFile(const std::string &file_name, bool is_temp_file, bool
     m_gpu_timing_model->OnGpuTimingResultsGenerated("");
     m_data_core_lock.unlock();
 
+    CancelFullParse();
+    m_submit_metadata_cache = nullptr;
+    m_current_submit = 0;
+    m_submit_spin_box_action->setVisible(false);
     if (!m_async_capture_stats_context.IsNull())
     {
         m_async_capture_stats_context->Cancel();
     }
+    if (!m_search_index_context.IsNull())
+    {
+        m_search_index_context->Cancel();
+    }
+    m_command_hierarchy_model->SetSearchIndex(nullptr);
+    m_loading_context = Dive::SimpleContext::Create();
     if (async)
     {
         // Start async file loading, at the end of loading FileLoaded will be triggered.
         m_loading_result = std::async([this, file_name = file_name, is_temp_file = is_temp_file]() {
             std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
 
-            auto file_type = LoadFileImpl(file_name, is_temp_file);
+            bool is_preview = false;
+            auto file_type = LoadFileImpl(file_name, is_temp_file, &is_preview);
             [[maybe_unused]] int64_t
             time_used_to_load_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
                                    std::chrono::steady_clock::now() - begin)
@@ -1251,7 +1627,7 @@ bool MainWindow::LoadFile(const std::string &file_name, bool is_temp_file, bool
                            (time_used_to_load_ms / 1000.0));
             // Now that the file is loaded, we can send a signal to UI thread.
             FileLoaded();
-            return LoadFileResult{ file_type, file_name, is_temp_file };
+            return LoadFileResult{ file_type, file_name, is_temp_file, is_preview };
         });
     }
     else
@@ -1286,6 +1662,13 @@ void MainWindow::OnPendingPerfCounterResults(const QString &file_name)
 
     auto file_path = std::filesystem::path(file_name.toStdString());
     auto task = [=, this]() {
+        // In bounded-memory mode, the draws of the submit shown are numbered from 0, so the
+        // counters of the whole capture can't be correlated with them
+        if (m_submit_metadata_cache && !file_path.empty())
+        {
+            ShowTempStatus(tr("Perf counters are not available in bounded-memory mode"));
+            return;
+        }
         m_perf_counter_model->OnPerfCounterResultsGenerated(file_path, *m_available_metrics);
         if (!file_path.empty())
         {
@@ -1307,6 +1690,12 @@ void MainWindow::OnPendingGpuTimingResults(const QString &file_name)
         return;
     }
     auto task = [=, this]() {
+        // Like the perf counters, GPU timing is of the whole capture
+        if (m_submit_metadata_cache && !file_name.isEmpty())
+        {
+            ShowTempStatus(tr("GPU timing is not available in bounded-memory mode"));
+            return;
+        }
         m_gpu_timing_model->OnGpuTimingResultsGenerated(file_name);
         if (!file_name.isEmpty())
         {
@@ -1343,7 +1732,9 @@ void MainWindow::OnPendingScreenshot(const QString &file_name)
 }
 
 //--------------------------------------------------------------------------------------------------
-MainWindow::LoadedFileType MainWindow::LoadFileImpl(const std::string &file_name, bool is_temp_file)
+MainWindow::LoadedFileType MainWindow::LoadFileImpl(const std::string &file_name,
+                                                    bool               is_temp_file,
+                                                    bool              *is_preview)
 {
     QWriteLocker locker(&m_data_core_lock);
     // Note: this function might not run on UI thread, thus can't do any UI modification.
@@ -1497,6 +1888,7 @@ MainWindow::LoadedFileType MainWindow::LoadFileImpl(const std::string &file_name
     break;
     case LoadedFileType::kRdFile:
     {
+        m_data_core->SetAnalysisCacheEnabled(Settings::Get()->ReadAnalysisCacheEnabled());
         if (Dive::CaptureData::LoadResult load_res = m_data_core->LoadPm4CaptureData(file_name);
             load_res != Dive::CaptureData::LoadResult::kSuccess)
         {
@@ -1504,11 +1896,45 @@ MainWindow::LoadedFileType MainWindow::LoadFileImpl(const std::string &file_name
             return LoadedFileType::kUnknown;
         }
 
-        if (!m_data_core->ParsePm4CaptureData())
+        // In bounded-memory mode, only the first submit is parsed, and the others on demand (see
+        // OnSubmitChanged()). Otherwise, parse the first submits of a large capture to show them
+        // sooner, see StartFullParse()
+        bool              preview = false;
+        Dive::SubmitRange submit_range;
+        uint32_t          num_submits = m_data_core->GetPm4CaptureData().GetNumSubmits();
+        uint64_t          memory_budget = uint64_t(Settings::Get()->ReadMemoryBudgetMB()) << 20;
+        if (is_preview != nullptr && memory_budget > 0 && num_submits > 1)
         {
-            OnParseFailure(file_name);
+            m_submit_metadata_cache = std::make_unique<Dive::SubmitMetadataCache>(*m_data_core,
+                                                                                  memory_budget);
+            submit_range.m_last = 0;
+        }
+        else if (is_preview != nullptr)
+        {
+            std::error_code ec;
+            uint64_t        file_size = std::filesystem::file_size(file_name, ec);
+            preview = !ec && file_size >= kPreviewMinFileSize && num_submits > kNumPreviewSubmits;
+            if (preview)
+            {
+                submit_range.m_last = kNumPreviewSubmits - 1;
+            }
+        }
+        m_data_core->SetSubmitRange(submit_range);
+        bool parsed = m_data_core->ParsePm4CaptureData(m_loading_context);
+        m_data_core->SetSubmitRange(Dive::SubmitRange());
+        if (!parsed)
+        {
+            m_submit_metadata_cache = nullptr;
+            if (!m_loading_context.Cancelled())
+            {
+                OnParseFailure(file_name);
+            }
             return LoadedFileType::kUnknown;
         }
+        if (preview)
+        {
+            *is_preview = true;
+        }
     }
     break;
     case LoadedFileType::kGfxrFile:
@@ -1564,6 +1990,18 @@ void MainWindow::OnFileLoaded()
     case LoadedFileType::kRdFile:
         OnAdrenoRdFileLoaded();
         ExpandResizeHierarchyView(*m_command_hierarchy_view, *m_filter_model);
+        if (result.is_preview)
+        {
+            StartFullParse();
+        }
+        if (m_submit_metadata_cache)
+        {
+            QSignalBlocker blocker(m_submit_spin_box);
+            m_submit_spin_box->setRange(0,
+                                        m_data_core->GetPm4CaptureData().GetNumSubmits() - 1);
+            m_submit_spin_box->setValue(0);
+            m_submit_spin_box_action->setVisible(true);
+        }
         break;
     case LoadedFileType::kGfxrFile:
         OnGfxrFileLoaded();
@@ -1679,6 +2117,33 @@ void MainWindow::OnCaptureTrigger()
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+void MainWindow::OnMemoryBudget()
+{
+    QInputDialog input_dialog;
+    input_dialog.setWindowTitle("Memory budget");
+    input_dialog.setLabelText("Memory for the decoded submits of .rd captures, in MB\n"
+                              "(0 to load whole captures, applies to the next capture loaded)\n"
+                              "Captures are then shown one submit at a time, without the\n"
+                              "overview, perf counters and GPU timing of the whole capture");
+    input_dialog.setInputMode(QInputDialog::IntInput);
+    input_dialog.setIntRange(0, INT_MAX);
+    input_dialog.setIntValue(Settings::Get()->ReadMemoryBudgetMB());
+
+    bool ok = input_dialog.exec();
+    if (ok)
+    {
+        Settings::Get()->WriteMemoryBudgetMB(input_dialog.intValue());
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+void MainWindow::OnAnalysisCacheToggled(bool checked)
+{
+    // Applies to the next capture loaded
+    Settings::Get()->WriteAnalysisCacheEnabled(checked);
+}
+
 //--------------------------------------------------------------------------------------------------
 void MainWindow::OnCapture(bool is_capture_delayed, bool is_gfxr_capture)
 {
@@ -2126,6 +2591,20 @@ void MainWindow::CreateActions()
     m_capture_delay_action->setShortcut(QKeySequence("Ctrl+f5"));
     connect(m_capture_delay_action, &QAction::triggered, this, &MainWindow::OnCaptureTrigger);
 
+    // Memory budget action
+    m_memory_budget_action = new QAction(tr("Memory budget..."), this);
+    m_memory_budget_action->setStatusTip(
+    tr("Browse .rd captures one submit at a time within a memory budget"));
+    connect(m_memory_budget_action, &QAction::triggered, this, &MainWindow::OnMemoryBudget);
+
+    // Analysis cache action
+    m_analysis_cache_action = new QAction(tr("Cache analysis next to captures"), this);
+    m_analysis_cache_action->setStatusTip(
+    tr("Save the analysis of .rd captures next to them (.divecache) to reopen them faster"));
+    m_analysis_cache_action->setCheckable(true);
+    m_analysis_cache_action->setChecked(Settings::Get()->ReadAnalysisCacheEnabled());
+    connect(m_analysis_cache_action, &QAction::toggled, this, &MainWindow::OnAnalysisCacheToggled);
+
     // Analyze action
     m_analyze_action = new QAction(tr("Analyze Capture"), this);
     m_analyze_action->setStatusTip(tr("Analyze a Capture"));
@@ -2159,6 +2638,9 @@ void MainWindow::CreateMenus()
     for (int i = 0; i < MaxRecentFiles; ++i)
         m_recent_captures_menu->addAction(m_recent_file_actions[i]);
     m_file_menu->addSeparator();
+    m_file_menu->addAction(m_memory_budget_action);
+    m_file_menu->addAction(m_analysis_cache_action);
+    m_file_menu->addSeparator();
     m_file_menu->addAction(m_exit_action);
 
     m_capture_menu = menuBar()->addMenu(tr("&Capture"));
@@ -2192,6 +2674,20 @@ void MainWindow::CreateToolBars()
     for (int i = 0; i < MaxRecentFiles; ++i)
         m_file_tool_bar->addAction(m_recent_file_actions[i]);
 
+    // Submit shown in bounded-memory mode
+    m_submit_spin_box = new QSpinBox(this);
+    m_submit_spin_box->setPrefix(tr("Submit "));
+    m_submit_spin_box->setKeyboardTracking(false);
+    m_submit_spin_box->setToolTip(tr("Submit shown (bounded-memory mode). Its events are numbered "
+                                     "from 0, and the overview, perf counters and GPU timing of "
+                                     "the whole capture are not available."));
+    m_submit_spin_box_action = m_file_tool_bar->addWidget(m_submit_spin_box);
+    m_submit_spin_box_action->setVisible(false);
+    connect(m_submit_spin_box,
+            QOverload<int>::of(&QSpinBox::valueChanged),
+            this,
+            &MainWindow::OnSubmitChanged);
+
     m_file_tool_bar->setSizePolicy(QSizePolicy::Minimum, QSizePolicy::Fixed);
     m_file_tool_bar->setMinimumSize(m_file_tool_bar->sizeHint());
 
@@ -2401,7 +2897,8 @@ void MainWindow::UpdateTabAvailability()
     SetTabAvailable(m_tab_widget, m_event_state_view_tab_index, true);
 
 #ifndef NDEBUG
-    SetTabAvailable(m_tab_widget, m_event_timing_view_tab_index, true);
+    // Event timings are of the whole capture, not of the submit shown in bounded-memory mode
+    SetTabAvailable(m_tab_widget, m_event_timing_view_tab_index, !m_submit_metadata_cache);
 #endif
 }
 
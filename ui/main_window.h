@@ -15,7 +15,9 @@
 */
 
 #pragma once
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <future>
 #include <functional>
@@ -45,7 +47,6 @@ class EventTimingView;
 class PerfCounterTabView;
 class PerfCounterModel;
 class GfxrVulkanCommandArgumentsTabView;
-class GfxrVulkanCommandArgumentsFilterProxyModel;
 class GfxrVulkanCommandFilterProxyModel;
 class GfxrVulkanCommandModel;
 class GpuTimingModel;
@@ -73,16 +74,19 @@ class QSortFilterProxyModel;
 class QAbstractProxyModel;
 class FrameTabView;
 class QScrollArea;
+class QSpinBox;
 
 enum class EventMode;
 
 namespace Dive
 {
 class DataCore;
+struct CaptureMetadata;
 class PluginLoader;
 class AvailableMetrics;
 class TraceStats;
 struct CaptureStats;
+class SubmitMetadataCache;
 
 enum DrawCallContextMenuOption : uint32_t
 {
@@ -130,6 +134,7 @@ signals:
     void PendingPerfCounterResults(const QString &file_name);
     void PendingGpuTimingResults(const QString &file_name);
     void PendingScreenshot(const QString &file_name);
+    void AsyncTraceStatsProgress();
     void AsyncTraceStatsDone();
 
 public slots:
@@ -158,6 +163,9 @@ private slots:
     void OnGFXRCapture();
     void OnNormalCapture();
     void OnCaptureTrigger();
+    void OnMemoryBudget();
+    void OnAnalysisCacheToggled(bool checked);
+    void OnSubmitChanged(int submit_index);
     void OnAnalyzeCapture();
     void OnExpandToLevel();
     void OnAbout();
@@ -167,6 +175,8 @@ private slots:
     void OpenRecentFile();
     void UpdateOverlay(const QString &);
     void OnHideOverlay();
+    void OnLoadingMessage(const QString &);
+    void OnLoadingProgress(const Dive::LoadProgress &);
     void OnCrossReference(Dive::CrossRef);
     void OnFileLoaded();
     void OnTraceAvailable(const QString &);
@@ -180,6 +190,7 @@ private slots:
     void ConnectPm4SearchBar();
     void DisconnectPm4SearchBar();
     void DisconnectAllTabs();
+    void OnAsyncTraceStatsProgress();
     void OnAsyncTraceStatsDone();
 
 private:
@@ -196,6 +207,8 @@ private:
         LoadedFileType file_type;
         std::string    file_name;
         bool           is_temp_file;
+        // Only the first submits of the capture were parsed, see StartFullParse()
+        bool           is_preview = false;
     };
 
     enum class CorrelationTarget
@@ -211,7 +224,11 @@ private:
         kPendingRestart,
     };
 
-    LoadedFileType LoadFileImpl(const std::string &file_name, bool is_temp_file = false);
+    // If `is_preview` is set, only the first submits of a large .rd capture may be parsed, in
+    // which case it is set to true
+    LoadedFileType LoadFileImpl(const std::string &file_name,
+                                bool               is_temp_file = false,
+                                bool              *is_preview = nullptr);
 
     void OnDiveFileLoaded();
     void OnAdrenoRdFileLoaded();
@@ -224,6 +241,23 @@ private:
     void OnUnsupportedFile(const std::string &file_name);
 
     void StartTraceStats();
+    // Index the command hierarchy in the background, for the searches of m_command_hierarchy_model
+    void StartSearchIndex();
+    // Parse the whole capture in the background once its first submits are shown, and show it
+    // in place of them when done
+    void StartFullParse();
+    void OnFullParseDone(std::shared_ptr<Dive::CaptureMetadata> capture_metadata);
+    void SwapInFullParse(std::shared_ptr<Dive::CaptureMetadata> capture_metadata);
+    void CancelFullParse();
+    // Cancel the background tasks reading m_data_core, and call `on_done` on the UI thread once
+    // they are done, so that the write lock can be taken without waiting for them
+    void CancelBackgroundReads(std::function<void()> on_done);
+    // Show the submit decoded by OnSubmitChanged() in place of the current one, which is put back
+    // in m_submit_metadata_cache
+    void OnSubmitDecoded(uint32_t                               submit_index,
+                         std::shared_ptr<Dive::CaptureMetadata> capture_metadata);
+    void SwapInSubmit(uint32_t                               submit_index,
+                      std::shared_ptr<Dive::CaptureMetadata> capture_metadata);
 
     void    CreateActions();
     void    CreateMenus();
@@ -265,6 +299,8 @@ private:
     QAction       *m_capture_action;
     QAction       *m_capture_delay_action;
     QAction       *m_capture_setting_action;
+    QAction       *m_memory_budget_action;
+    QAction       *m_analysis_cache_action;
     QMenu         *m_analyze_menu;
     QAction       *m_analyze_action;
     QMenu         *m_help_menu;
@@ -272,6 +308,8 @@ private:
     QAction       *m_shortcuts_action;
     QToolBar      *m_file_tool_bar;
     QScrollArea   *m_file_tool_bar_scroll_area;
+    QSpinBox      *m_submit_spin_box;
+    QAction       *m_submit_spin_box_action;
     TraceDialog   *m_trace_dig;
     AnalyzeDialog *m_analyze_dig;
 
@@ -380,16 +418,30 @@ private:
     // Overlay to be displayed while capture
     Overlay *m_overlay;
 
-    std::unique_ptr<Dive::PluginLoader>         m_plugin_manager;
-    GfxrVulkanCommandArgumentsFilterProxyModel *m_gfxr_vulkan_commands_arguments_filter_proxy_model;
-    std::unique_ptr<Dive::AvailableMetrics>     m_available_metrics;
-    std::unique_ptr<Dive::TraceStats>           m_trace_stats;
-    std::unique_ptr<Dive::CaptureStats>         m_capture_stats;
-    std::unique_ptr<Dive::CaptureStats>         m_async_capture_stats;
+    std::unique_ptr<Dive::PluginLoader>     m_plugin_manager;
+    std::unique_ptr<Dive::AvailableMetrics> m_available_metrics;
+    std::unique_ptr<Dive::TraceStats>       m_trace_stats;
+    std::unique_ptr<Dive::CaptureStats>     m_capture_stats;
+    std::unique_ptr<Dive::CaptureStats>     m_async_capture_stats;
+    // Latest partial result published by the trace stats worker
+    std::unique_ptr<Dive::CaptureStats>     m_partial_capture_stats;
+    std::mutex                              m_partial_capture_stats_mutex;
 
     Dive::SimpleContext    m_async_capture_stats_context;
     AsyncCaptureStatsState m_async_capture_stats_state = AsyncCaptureStatsState::kNone;
+    Dive::SimpleContext    m_search_index_context;
 
     std::future<LoadFileResult>        m_loading_result;
     std::vector<std::function<void()>> m_loading_pending_task;
+
+    // Cancels the parsing of the capture being loaded
+    Dive::SimpleContext                   m_loading_context;
+    // Parse of the whole capture, or of a submit in bounded-memory mode
+    std::future<void>                     m_full_parse_result;
+    std::chrono::steady_clock::time_point m_last_progress_time;
+
+    // Bounded-memory mode (see Settings::ReadMemoryBudgetMB()): .rd captures are shown one submit
+    // at a time, and the other decoded submits are kept within the budget
+    std::unique_ptr<Dive::SubmitMetadataCache> m_submit_metadata_cache;
+    uint32_t                                   m_current_submit = 0;
 };
@@ -20,6 +20,8 @@ ProgressTrackerCallback::ProgressTrackerCallback() :
     QObject(),
     Dive::ProgressTracker()
 {
+    // Progress is sent from the loading thread
+    qRegisterMetaType<Dive::LoadProgress>();
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -27,3 +29,9 @@ void ProgressTrackerCallback::sendMessage(std::string message)
 {
     emit sendMessageSignal(QString::fromStdString(message));
 }
+
+//--------------------------------------------------------------------------------------------------
+void ProgressTrackerCallback::sendProgress(const Dive::LoadProgress &progress)
+{
+    emit sendProgressSignal(progress);
+}
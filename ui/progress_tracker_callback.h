@@ -27,7 +27,11 @@ public:
     ProgressTrackerCallback();
 
     virtual void sendMessage(std::string message);
+    virtual void sendProgress(const Dive::LoadProgress &progress);
 
 signals:
     void sendMessageSignal(const QString &message);
+    void sendProgressSignal(const Dive::LoadProgress &progress);
 };
+
+Q_DECLARE_METATYPE(Dive::LoadProgress)
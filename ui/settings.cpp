@@ -84,6 +84,32 @@ void Settings::WriteCaptureDelay(uint32_t capture_delay)
     settings.setValue("captureDelay", capture_delay);
 }
 
+//--------------------------------------------------------------------------------------------------
+uint32_t Settings::ReadMemoryBudgetMB()
+{
+    QSettings settings;
+    return settings.value("memoryBudgetMB", 0).toUInt();
+}
+//--------------------------------------------------------------------------------------------------
+void Settings::WriteMemoryBudgetMB(uint32_t memory_budget_mb)
+{
+    QSettings settings;
+    settings.setValue("memoryBudgetMB", memory_budget_mb);
+}
+
+//--------------------------------------------------------------------------------------------------
+bool Settings::ReadAnalysisCacheEnabled()
+{
+    QSettings settings;
+    return settings.value("analysisCacheEnabled", false).toBool();
+}
+//--------------------------------------------------------------------------------------------------
+void Settings::WriteAnalysisCacheEnabled(bool enabled)
+{
+    QSettings settings;
+    settings.setValue("analysisCacheEnabled", enabled);
+}
+
 //--------------------------------------------------------------------------------------------------
 Settings::DisplayUnit Settings::ReadRulerDisplayUnit()
 {
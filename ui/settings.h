@@ -40,6 +40,15 @@ public:
     uint32_t ReadCaptureDelay();
     void     WriteCaptureDelay(uint32_t capture_delay);
 
+    // Budget of the decoded submits kept in memory, in MB. 0 to load whole captures.
+    uint32_t ReadMemoryBudgetMB();
+    void     WriteMemoryBudgetMB(uint32_t memory_budget_mb);
+
+    // Whether the analysis of .rd captures is saved next to them and reused when they are reopened
+    // (see Dive::DataCore::SetAnalysisCacheEnabled())
+    bool ReadAnalysisCacheEnabled();
+    void WriteAnalysisCacheEnabled(bool enabled);
+
     DisplayUnit ReadRulerDisplayUnit();
     void        WriteRulerDisplayUnit(DisplayUnit display_unit);
 